@@ -24,6 +24,7 @@
 #include "gflags/gflags.h"
 #include "modules/common/log.h"
 #include "modules/common/status/status.h"
+#include "modules/common/trace/trace.h"
 #include "modules/common/util/string_util.h"
 
 #include "ros/include/ros/ros.h"
@@ -79,6 +80,10 @@ int ApolloApp::Spin() {
   }
   ros::waitForShutdown();
   Stop();
+  if (FLAGS_enable_latency_trace) {
+    trace::Tracer::instance()->ExportChromeTrace(
+        util::StrCat(FLAGS_log_dir, "/", Name(), ".trace.json"));
+  }
   AINFO << Name() << " exited.";
   return 0;
 }
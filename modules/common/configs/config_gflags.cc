@@ -51,3 +51,9 @@ DEFINE_string(
     navigation_mode_end_way_point_file,
     "modules/dreamview/conf/navigation_mode_default_end_way_point.txt",
     "end_way_point file used if navigation mode is set.");
+
+DEFINE_bool(enable_latency_trace, false,
+            "Record latency trace spans, and export them as a Chrome trace "
+            "file in the log dir when the module exits.");
+DEFINE_int32(latency_trace_buffer_size, 8192,
+             "Number of trace spans kept per thread.");
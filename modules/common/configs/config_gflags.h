@@ -40,4 +40,7 @@ DECLARE_string(localization_tf2_child_frame_id);
 DECLARE_bool(use_navigation_mode);
 DECLARE_string(navigation_mode_end_way_point_file);
 
+DECLARE_bool(enable_latency_trace);
+DECLARE_int32(latency_trace_buffer_size);
+
 #endif  // MODULES_COMMON_CONFIGS_GFLAGS_H_
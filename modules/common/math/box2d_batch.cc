@@ -0,0 +1,312 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/box2d_batch.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// The number of boxes tested per call of the kernel by HasOverlapWithAny.
+constexpr std::size_t kAnyOverlapChunkSize = 64;
+
+#if defined(__AVX__)
+
+struct Lanes {
+  using Vector = __m256d;
+  static constexpr std::size_t kSize = 4;
+  static constexpr const char *kName = "avx";
+  static Vector Set(const double value) { return _mm256_set1_pd(value); }
+  static Vector Load(const double *data) { return _mm256_loadu_pd(data); }
+  static Vector Add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+  static Vector Sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+  static Vector Mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+  // Clears the sign bit, as std::abs does.
+  static Vector Abs(Vector a) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+  }
+  static Vector Le(Vector a, Vector b) {
+    return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+  }
+  static Vector Lt(Vector a, Vector b) {
+    return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+  }
+  static Vector Gt(Vector a, Vector b) {
+    return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+  }
+  static Vector And(Vector a, Vector b) { return _mm256_and_pd(a, b); }
+  static Vector Or(Vector a, Vector b) { return _mm256_or_pd(a, b); }
+  // Computes (~a) & b.
+  static Vector AndNot(Vector a, Vector b) { return _mm256_andnot_pd(a, b); }
+  static int Mask(Vector a) { return _mm256_movemask_pd(a); }
+};
+
+#elif defined(__SSE2__)
+
+struct Lanes {
+  using Vector = __m128d;
+  static constexpr std::size_t kSize = 2;
+  static constexpr const char *kName = "sse2";
+  static Vector Set(const double value) { return _mm_set1_pd(value); }
+  static Vector Load(const double *data) { return _mm_loadu_pd(data); }
+  static Vector Add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+  static Vector Sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+  static Vector Mul(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+  // Clears the sign bit, as std::abs does.
+  static Vector Abs(Vector a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+  static Vector Le(Vector a, Vector b) { return _mm_cmple_pd(a, b); }
+  static Vector Lt(Vector a, Vector b) { return _mm_cmplt_pd(a, b); }
+  static Vector Gt(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+  static Vector And(Vector a, Vector b) { return _mm_and_pd(a, b); }
+  static Vector Or(Vector a, Vector b) { return _mm_or_pd(a, b); }
+  // Computes (~a) & b.
+  static Vector AndNot(Vector a, Vector b) { return _mm_andnot_pd(a, b); }
+  static int Mask(Vector a) { return _mm_movemask_pd(a); }
+};
+
+#endif
+
+}  // namespace
+
+Box2dBatch::Box2dBatch(const std::vector<Box2d> &boxes) {
+  Reserve(boxes.size());
+  for (const auto &box : boxes) {
+    Add(box);
+  }
+}
+
+void Box2dBatch::Add(const Box2d &box) {
+  boxes_.push_back(box);
+  center_x_.push_back(box.center_x());
+  center_y_.push_back(box.center_y());
+  cos_heading_.push_back(box.cos_heading());
+  sin_heading_.push_back(box.sin_heading());
+  half_length_.push_back(box.half_length());
+  half_width_.push_back(box.half_width());
+  dx3_.push_back(box.cos_heading() * box.half_length());
+  dy3_.push_back(box.sin_heading() * box.half_length());
+  dx4_.push_back(box.sin_heading() * box.half_width());
+  dy4_.push_back(-box.cos_heading() * box.half_width());
+  min_x_.push_back(box.min_x());
+  max_x_.push_back(box.max_x());
+  min_y_.push_back(box.min_y());
+  max_y_.push_back(box.max_y());
+}
+
+void Box2dBatch::Clear() {
+  boxes_.clear();
+  for (auto *field : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                      &half_length_, &half_width_, &dx3_, &dy3_, &dx4_, &dy4_,
+                      &min_x_, &max_x_, &min_y_, &max_y_}) {
+    field->clear();
+  }
+}
+
+void Box2dBatch::Reserve(const std::size_t size) {
+  boxes_.reserve(size);
+  for (auto *field : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                      &half_length_, &half_width_, &dx3_, &dy3_, &dx4_, &dy4_,
+                      &min_x_, &max_x_, &min_y_, &max_y_}) {
+    field->reserve(size);
+  }
+}
+
+void Box2dBatch::HasOverlap(const Box2d &box,
+                            std::vector<uint8_t> *const overlaps) const {
+  overlaps->resize(size());
+  Overlaps(box, 0, size(), overlaps->data());
+}
+
+void Box2dBatch::HasOverlap(const std::vector<Box2d> &boxes,
+                            std::vector<uint8_t> *const overlaps) const {
+  overlaps->resize(boxes.size() * size());
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    Overlaps(boxes[i], 0, size(), overlaps->data() + i * size());
+  }
+}
+
+bool Box2dBatch::HasOverlapWithAny(const Box2d &box) const {
+  uint8_t overlaps[kAnyOverlapChunkSize];
+  for (std::size_t begin = 0; begin < size(); begin += kAnyOverlapChunkSize) {
+    const std::size_t end = std::min(begin + kAnyOverlapChunkSize, size());
+    if (Overlaps(box, begin, end, overlaps)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Box2dBatch::DistanceTo(const Vec2d &point,
+                            std::vector<double> *const distances) const {
+  // Most of the time goes to the hypot of Box2d::DistanceTo, which has no
+  // vector form giving the same results, so the boxes are done one by one.
+  distances->resize(size());
+  for (std::size_t i = 0; i < size(); ++i) {
+    (*distances)[i] = boxes_[i].DistanceTo(point);
+  }
+}
+
+void Box2dBatch::DistanceTo(const Box2d &box,
+                            std::vector<double> *const distances) const {
+  DistanceTo(box, std::numeric_limits<double>::infinity(), distances);
+}
+
+void Box2dBatch::DistanceTo(const Box2d &box, const double max_distance,
+                            std::vector<double> *const distances) const {
+  distances->assign(size(), std::numeric_limits<double>::infinity());
+  if (empty()) {
+    return;
+  }
+  // Box2d::DistanceTo builds the polygons of both boxes on every call, so
+  // the one of the argument is built only once here.
+  const Polygon2d polygon(box);
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (min_x_[i] - box.max_x() > max_distance ||
+        box.min_x() - max_x_[i] > max_distance ||
+        min_y_[i] - box.max_y() > max_distance ||
+        box.min_y() - max_y_[i] > max_distance) {
+      continue;
+    }
+    (*distances)[i] = polygon.DistanceTo(boxes_[i]);
+  }
+}
+
+const char *Box2dBatch::KernelName() {
+#if defined(__AVX__) || defined(__SSE2__)
+  return Lanes::kName;
+#else
+  return "scalar";
+#endif
+}
+
+bool Box2dBatch::Overlaps(const Box2d &box, const std::size_t begin,
+                          const std::size_t end,
+                          uint8_t *const overlaps) const {
+  bool has_overlap = false;
+  std::size_t i = begin;
+#if defined(__AVX__) || defined(__SSE2__)
+  // The same expressions as Box2d::HasOverlap, where "box" is the argument
+  // and this is the box of the batch.
+  using V = Lanes::Vector;
+  const V min_x = Lanes::Set(box.min_x());
+  const V max_x = Lanes::Set(box.max_x());
+  const V min_y = Lanes::Set(box.min_y());
+  const V max_y = Lanes::Set(box.max_y());
+  const V center_x = Lanes::Set(box.center_x());
+  const V center_y = Lanes::Set(box.center_y());
+  const V cos_heading = Lanes::Set(box.cos_heading());
+  const V sin_heading = Lanes::Set(box.sin_heading());
+  const V half_length = Lanes::Set(box.half_length());
+  const V half_width = Lanes::Set(box.half_width());
+  const V dx1 = Lanes::Set(box.cos_heading() * box.half_length());
+  const V dy1 = Lanes::Set(box.sin_heading() * box.half_length());
+  const V dx2 = Lanes::Set(box.sin_heading() * box.half_width());
+  const V dy2 = Lanes::Set(-box.cos_heading() * box.half_width());
+
+  for (; i + Lanes::kSize <= end; i += Lanes::kSize) {
+    const V reject = Lanes::Or(
+        Lanes::Or(Lanes::Lt(Lanes::Load(&max_x_[i]), min_x),
+                  Lanes::Gt(Lanes::Load(&min_x_[i]), max_x)),
+        Lanes::Or(Lanes::Lt(Lanes::Load(&max_y_[i]), min_y),
+                  Lanes::Gt(Lanes::Load(&min_y_[i]), max_y)));
+    // Most of the boxes are far apart, so skip the separating axis test
+    // when the bounding boxes of all lanes are disjoint.
+    if (Lanes::Mask(reject) == (1 << Lanes::kSize) - 1) {
+      for (std::size_t k = 0; k < Lanes::kSize; ++k) {
+        overlaps[i - begin + k] = 0;
+      }
+      continue;
+    }
+
+    const V shift_x = Lanes::Sub(Lanes::Load(&center_x_[i]), center_x);
+    const V shift_y = Lanes::Sub(Lanes::Load(&center_y_[i]), center_y);
+    const V dx3 = Lanes::Load(&dx3_[i]);
+    const V dy3 = Lanes::Load(&dy3_[i]);
+    const V dx4 = Lanes::Load(&dx4_[i]);
+    const V dy4 = Lanes::Load(&dy4_[i]);
+    const V box_cos_heading = Lanes::Load(&cos_heading_[i]);
+    const V box_sin_heading = Lanes::Load(&sin_heading_[i]);
+
+    const V axis1 = Lanes::Le(
+        Lanes::Abs(Lanes::Add(Lanes::Mul(shift_x, cos_heading),
+                              Lanes::Mul(shift_y, sin_heading))),
+        Lanes::Add(
+            Lanes::Add(Lanes::Abs(Lanes::Add(Lanes::Mul(dx3, cos_heading),
+                                             Lanes::Mul(dy3, sin_heading))),
+                       Lanes::Abs(Lanes::Add(Lanes::Mul(dx4, cos_heading),
+                                             Lanes::Mul(dy4, sin_heading)))),
+            half_length));
+    const V axis2 = Lanes::Le(
+        Lanes::Abs(Lanes::Sub(Lanes::Mul(shift_x, sin_heading),
+                              Lanes::Mul(shift_y, cos_heading))),
+        Lanes::Add(
+            Lanes::Add(Lanes::Abs(Lanes::Sub(Lanes::Mul(dx3, sin_heading),
+                                             Lanes::Mul(dy3, cos_heading))),
+                       Lanes::Abs(Lanes::Sub(Lanes::Mul(dx4, sin_heading),
+                                             Lanes::Mul(dy4, cos_heading)))),
+            half_width));
+    const V axis3 = Lanes::Le(
+        Lanes::Abs(Lanes::Add(Lanes::Mul(shift_x, box_cos_heading),
+                              Lanes::Mul(shift_y, box_sin_heading))),
+        Lanes::Add(
+            Lanes::Add(
+                Lanes::Abs(Lanes::Add(Lanes::Mul(dx1, box_cos_heading),
+                                      Lanes::Mul(dy1, box_sin_heading))),
+                Lanes::Abs(Lanes::Add(Lanes::Mul(dx2, box_cos_heading),
+                                      Lanes::Mul(dy2, box_sin_heading)))),
+            Lanes::Load(&half_length_[i])));
+    const V axis4 = Lanes::Le(
+        Lanes::Abs(Lanes::Sub(Lanes::Mul(shift_x, box_sin_heading),
+                              Lanes::Mul(shift_y, box_cos_heading))),
+        Lanes::Add(
+            Lanes::Add(
+                Lanes::Abs(Lanes::Sub(Lanes::Mul(dx1, box_sin_heading),
+                                      Lanes::Mul(dy1, box_cos_heading))),
+                Lanes::Abs(Lanes::Sub(Lanes::Mul(dx2, box_sin_heading),
+                                      Lanes::Mul(dy2, box_cos_heading)))),
+            Lanes::Load(&half_width_[i])));
+
+    const V overlap =
+        Lanes::And(Lanes::And(axis1, axis2), Lanes::And(axis3, axis4));
+    const int mask = Lanes::Mask(Lanes::AndNot(reject, overlap));
+    for (std::size_t k = 0; k < Lanes::kSize; ++k) {
+      overlaps[i - begin + k] = static_cast<uint8_t>((mask >> k) & 1);
+    }
+    has_overlap = has_overlap || mask != 0;
+  }
+#endif
+  for (; i < end; ++i) {
+    overlaps[i - begin] = box.HasOverlap(boxes_[i]);
+    has_overlap = has_overlap || overlaps[i - begin] != 0;
+  }
+  return has_overlap;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
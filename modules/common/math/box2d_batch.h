@@ -0,0 +1,192 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A set of boxes tested for overlap and distance against one box at
+ *        a time.
+ */
+
+#ifndef MODULES_COMMON_MATH_BOX2D_BATCH_H_
+#define MODULES_COMMON_MATH_BOX2D_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class Box2dBatch
+ * @brief Boxes stored as structure of arrays, so that the separating axis
+ *        test of Box2d::HasOverlap runs on several boxes per instruction.
+ *
+ * The AVX kernel is used when the file is built with -mavx, the SSE2 kernel
+ * on the other x86-64 builds, and a scalar loop elsewhere. All of them do
+ * the same floating point operations in the same order as Box2d::HasOverlap,
+ * so box.HasOverlap(batch.box(i)) and the i-th result of the batch are
+ * always equal. The distances are computed by Box2d and Polygon2d, so they
+ * are equal to the ones of Box2d::DistanceTo as well.
+ */
+class Box2dBatch {
+ public:
+  Box2dBatch() = default;
+  /**
+   * @brief Constructor which takes a list of boxes.
+   * @param boxes The boxes of the batch.
+   */
+  explicit Box2dBatch(const std::vector<Box2d> &boxes);
+
+  /**
+   * @brief Appends a box to the batch.
+   * @param box The box to append.
+   */
+  void Add(const Box2d &box);
+
+  /**
+   * @brief Removes all the boxes.
+   */
+  void Clear();
+
+  /**
+   * @brief Reserves the memory of a number of boxes.
+   * @param size The number of boxes.
+   */
+  void Reserve(const std::size_t size);
+
+  /**
+   * @brief Gets the number of boxes.
+   * @return The number of boxes.
+   */
+  std::size_t size() const { return boxes_.size(); }
+
+  /**
+   * @brief Checks whether the batch has no box.
+   * @return True if the batch has no box.
+   */
+  bool empty() const { return boxes_.empty(); }
+
+  /**
+   * @brief Gets a box of the batch.
+   * @param index The index of the box.
+   * @return The box at the index.
+   */
+  const Box2d &box(const std::size_t index) const { return boxes_[index]; }
+
+  /**
+   * @brief Gets all the boxes of the batch.
+   * @return The boxes of the batch.
+   */
+  const std::vector<Box2d> &boxes() const { return boxes_; }
+
+  /**
+   * @brief Tests a box against every box of the batch.
+   * @param box The box to test.
+   * @param overlaps Set to the results, where (*overlaps)[i] is
+   *        box.HasOverlap(this->box(i)).
+   */
+  void HasOverlap(const Box2d &box, std::vector<uint8_t> *const overlaps) const;
+
+  /**
+   * @brief Tests a list of boxes against every box of the batch.
+   * @param boxes The boxes to test.
+   * @param overlaps Set to the results, where (*overlaps)[i * size() + j] is
+   *        boxes[i].HasOverlap(this->box(j)).
+   */
+  void HasOverlap(const std::vector<Box2d> &boxes,
+                  std::vector<uint8_t> *const overlaps) const;
+
+  /**
+   * @brief Checks whether a box overlaps any box of the batch.
+   * @param box The box to test.
+   * @return True if box.HasOverlap(this->box(i)) for some i.
+   */
+  bool HasOverlapWithAny(const Box2d &box) const;
+
+  /**
+   * @brief Computes the distance from every box of the batch to a point.
+   * @param point The point.
+   * @param distances Set to the results, where (*distances)[i] is
+   *        this->box(i).DistanceTo(point).
+   */
+  void DistanceTo(const Vec2d &point,
+                  std::vector<double> *const distances) const;
+
+  /**
+   * @brief Computes the distance from every box of the batch to a box.
+   * @param box The box.
+   * @param distances Set to the results, where (*distances)[i] is
+   *        this->box(i).DistanceTo(box).
+   */
+  void DistanceTo(const Box2d &box,
+                  std::vector<double> *const distances) const;
+
+  /**
+   * @brief Computes the distance from every box of the batch to a box, and
+   *        skips the boxes whose bounding boxes are more than max_distance
+   *        apart along x or y, as they are farther than max_distance.
+   * @param box The box.
+   * @param max_distance The distance beyond which the boxes are skipped.
+   * @param distances Set to the results, where (*distances)[i] is
+   *        this->box(i).DistanceTo(box), or infinity for a skipped box.
+   */
+  void DistanceTo(const Box2d &box, const double max_distance,
+                  std::vector<double> *const distances) const;
+
+  /**
+   * @brief Gets the name of the kernel chosen at compile time.
+   * @return "avx", "sse2" or "scalar".
+   */
+  static const char *KernelName();
+
+ private:
+  // Tests the boxes in [begin, end) and returns whether any overlaps.
+  bool Overlaps(const Box2d &box, const std::size_t begin,
+                const std::size_t end, uint8_t *const overlaps) const;
+
+  std::vector<Box2d> boxes_;
+
+  // The fields of the boxes, and the corner offsets which Box2d::HasOverlap
+  // computes from the box argument.
+  std::vector<double> center_x_;
+  std::vector<double> center_y_;
+  std::vector<double> cos_heading_;
+  std::vector<double> sin_heading_;
+  std::vector<double> half_length_;
+  std::vector<double> half_width_;
+  std::vector<double> dx3_;
+  std::vector<double> dy3_;
+  std::vector<double> dx4_;
+  std::vector<double> dy4_;
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif /* MODULES_COMMON_MATH_BOX2D_BATCH_H_ */
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the throughput of the box overlap and distance tests done
+ *        one pair per call of Box2d, versus with a Box2dBatch. The query boxes
+ *        move along a road among the obstacle boxes, as the ego boxes of a
+ *        trajectory in CollisionChecker and TrajectoryCost.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/box2d_batch.h"
+
+DEFINE_int32(benchmark_num_boxes, 64, "Number of obstacle boxes.");
+DEFINE_int32(benchmark_num_queries, 200000, "Number of query boxes.");
+DEFINE_int32(benchmark_num_distance_queries, 20000,
+             "Number of query boxes of the box distance test.");
+DEFINE_double(benchmark_max_distance, 20.0,
+              "Distance beyond which the batch skips the boxes, as the "
+              "obstacle_ignore_distance of TrajectoryCost.");
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+double ElapsedNs(const std::chrono::steady_clock::time_point start,
+                 const std::size_t num_tests) {
+  const std::chrono::duration<double, std::nano> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count() / num_tests;
+}
+
+int Run() {
+  std::mt19937 random(2018);
+  std::uniform_real_distribution<double> s(0.0, 200.0);
+  std::uniform_real_distribution<double> l(-6.0, 6.0);
+  std::uniform_real_distribution<double> heading(-0.3, 0.3);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < FLAGS_benchmark_num_boxes; ++i) {
+    boxes.emplace_back(Vec2d(s(random), l(random)), heading(random), 4.5, 2.0);
+  }
+  std::vector<Box2d> queries;
+  for (int i = 0; i < FLAGS_benchmark_num_queries; ++i) {
+    queries.emplace_back(Vec2d(s(random), l(random)), heading(random), 5.0,
+                         2.2);
+  }
+  const Box2dBatch batch(boxes);
+  const std::size_t num_tests = queries.size() * boxes.size();
+
+  std::vector<uint8_t> scalar_overlaps(num_tests);
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    for (std::size_t j = 0; j < boxes.size(); ++j) {
+      scalar_overlaps[i * boxes.size() + j] = queries[i].HasOverlap(boxes[j]);
+    }
+  }
+  double scalar_ns = ElapsedNs(start, num_tests);
+
+  std::vector<uint8_t> batch_overlaps;
+  start = std::chrono::steady_clock::now();
+  batch.HasOverlap(queries, &batch_overlaps);
+  double batch_ns = ElapsedNs(start, num_tests);
+
+  bool is_same = scalar_overlaps == batch_overlaps;
+  std::cout << "boxes: " << boxes.size() << ", queries: " << queries.size()
+            << ", kernel: " << Box2dBatch::KernelName() << std::endl
+            << std::fixed << std::setprecision(2)
+            << "Box2d::HasOverlap:             " << scalar_ns << " ns/test"
+            << std::endl
+            << "Box2dBatch::HasOverlap:        " << batch_ns << " ns/test"
+            << std::endl;
+
+  std::vector<double> scalar_distances(num_tests);
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    for (std::size_t j = 0; j < boxes.size(); ++j) {
+      scalar_distances[i * boxes.size() + j] =
+          boxes[j].DistanceTo(queries[i].center());
+    }
+  }
+  scalar_ns = ElapsedNs(start, num_tests);
+
+  std::vector<double> distances;
+  std::vector<double> batch_distances;
+  batch_distances.reserve(num_tests);
+  start = std::chrono::steady_clock::now();
+  for (const auto &query : queries) {
+    batch.DistanceTo(query.center(), &distances);
+    batch_distances.insert(batch_distances.end(), distances.begin(),
+                           distances.end());
+  }
+  batch_ns = ElapsedNs(start, num_tests);
+  is_same = is_same && scalar_distances == batch_distances;
+  std::cout << "Box2d::DistanceTo(point):      " << scalar_ns << " ns/test"
+            << std::endl
+            << "Box2dBatch::DistanceTo(point): " << batch_ns << " ns/test"
+            << std::endl;
+
+  // The distance between boxes takes microseconds, so fewer queries.
+  queries.resize(std::min<std::size_t>(
+      queries.size(), FLAGS_benchmark_num_distance_queries));
+  const std::size_t num_box_tests = queries.size() * boxes.size();
+  scalar_distances.resize(num_box_tests);
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    for (std::size_t j = 0; j < boxes.size(); ++j) {
+      scalar_distances[i * boxes.size() + j] = boxes[j].DistanceTo(queries[i]);
+    }
+  }
+  scalar_ns = ElapsedNs(start, num_box_tests);
+
+  batch_distances.clear();
+  start = std::chrono::steady_clock::now();
+  for (const auto &query : queries) {
+    batch.DistanceTo(query, FLAGS_benchmark_max_distance, &distances);
+    batch_distances.insert(batch_distances.end(), distances.begin(),
+                           distances.end());
+  }
+  batch_ns = ElapsedNs(start, num_box_tests);
+  for (std::size_t i = 0; i < num_box_tests; ++i) {
+    if (std::isinf(batch_distances[i])) {
+      is_same = is_same &&
+                scalar_distances[i] > FLAGS_benchmark_max_distance;
+    } else {
+      is_same = is_same && scalar_distances[i] == batch_distances[i];
+    }
+  }
+  std::cout << "Box2d::DistanceTo(box):        " << scalar_ns << " ns/test"
+            << std::endl
+            << "Box2dBatch::DistanceTo(box):   " << batch_ns << " ns/test"
+            << std::endl
+            << "same result: " << (is_same ? "yes" : "no") << std::endl;
+  return is_same ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::common::math::Run();
+}
@@ -0,0 +1,212 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+Box2d RandomBox(std::mt19937 *const random) {
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.0, 6.0);
+  return Box2d({position(*random), position(*random)}, heading(*random),
+               size(*random), size(*random));
+}
+
+// Boxes which touch the query box along an axis, where the separating axis
+// test compares equal values up to the rounding errors.
+std::vector<Box2d> TouchingBoxes(const Box2d &box) {
+  std::vector<Box2d> boxes;
+  const double headings[] = {box.heading(), box.heading() + M_PI_2,
+                             box.heading() + M_PI, box.heading() + 0.3};
+  for (const double heading : headings) {
+    for (const double gap : {-1e-12, 0.0, 1e-12}) {
+      const double distance = box.half_length() + 1.0 + gap;
+      boxes.emplace_back(
+          Vec2d(box.center_x() + distance * std::cos(box.heading()),
+                box.center_y() + distance * std::sin(box.heading())),
+          heading, 2.0, 2.0);
+    }
+  }
+  return boxes;
+}
+
+void ExpectSameOverlaps(const Box2d &box, const Box2dBatch &batch) {
+  std::vector<uint8_t> overlaps;
+  batch.HasOverlap(box, &overlaps);
+  ASSERT_EQ(batch.size(), overlaps.size());
+  bool has_overlap = false;
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    EXPECT_EQ(box.HasOverlap(batch.box(i)), overlaps[i] != 0)
+        << box.DebugString() << " " << batch.box(i).DebugString();
+    has_overlap = has_overlap || overlaps[i] != 0;
+  }
+  EXPECT_EQ(has_overlap, batch.HasOverlapWithAny(box));
+}
+
+// Checks the distances bit for bit, and that the skipped boxes are farther
+// than the maximum distance.
+void ExpectSameDistances(const Box2d &box, const Box2dBatch &batch,
+                         const double max_distance) {
+  std::vector<double> distances;
+  batch.DistanceTo(box.center(), &distances);
+  ASSERT_EQ(batch.size(), distances.size());
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    EXPECT_EQ(batch.box(i).DistanceTo(box.center()), distances[i]);
+  }
+  batch.DistanceTo(box, max_distance, &distances);
+  ASSERT_EQ(batch.size(), distances.size());
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    const double distance = batch.box(i).DistanceTo(box);
+    if (std::isinf(distances[i])) {
+      EXPECT_GT(distance, max_distance);
+    } else {
+      EXPECT_EQ(distance, distances[i]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Box2dBatchTest, Add) {
+  Box2dBatch batch;
+  EXPECT_TRUE(batch.empty());
+  const Box2d box({1.0, 2.0}, 0.5, 4.0, 2.0);
+  batch.Add(box);
+  batch.Add(box);
+  EXPECT_EQ(2, batch.size());
+  EXPECT_EQ(box.DebugString(), batch.box(1).DebugString());
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_FALSE(batch.HasOverlapWithAny(box));
+  EXPECT_NE(nullptr, Box2dBatch::KernelName());
+}
+
+TEST(Box2dBatchTest, HasOverlap) {
+  const Box2d box({0.0, 0.0}, 0.0, 4.0, 2.0);
+  Box2dBatch batch({Box2d({1.0, 1.0}, M_PI_4, 1.0, 1.0),
+                    Box2d({5.0, 0.0}, 0.0, 2.0, 2.0),
+                    Box2d({3.0, 0.0}, 0.0, 2.0, 2.0),
+                    Box2d({0.0, 3.0}, M_PI_2, 2.0, 2.0),
+                    Box2d({10.0, 10.0}, 0.0, 1.0, 1.0)});
+  std::vector<uint8_t> overlaps;
+  batch.HasOverlap(box, &overlaps);
+  EXPECT_EQ(std::vector<uint8_t>({1, 0, 1, 0, 0}), overlaps);
+  EXPECT_TRUE(batch.HasOverlapWithAny(box));
+  EXPECT_FALSE(batch.HasOverlapWithAny(Box2d({-10.0, 0.0}, 0.0, 1.0, 1.0)));
+}
+
+TEST(Box2dBatchTest, RandomBoxes) {
+  std::mt19937 random(2018);
+  for (int test = 0; test < 200; ++test) {
+    // Sizes which are not a multiple of the number of lanes as well.
+    Box2dBatch batch;
+    const int size = test % 70;
+    for (int i = 0; i < size; ++i) {
+      batch.Add(RandomBox(&random));
+    }
+    for (int k = 0; k < 20; ++k) {
+      ExpectSameOverlaps(RandomBox(&random), batch);
+    }
+  }
+}
+
+TEST(Box2dBatchTest, TouchingBoxes) {
+  std::mt19937 random(2018);
+  for (int test = 0; test < 500; ++test) {
+    const Box2d box = RandomBox(&random);
+    ExpectSameOverlaps(box, Box2dBatch(TouchingBoxes(box)));
+  }
+}
+
+TEST(Box2dBatchTest, DegenerateBoxes) {
+  const Box2d box({0.0, 0.0}, 0.0, 2.0, 2.0);
+  ExpectSameOverlaps(box, Box2dBatch({Box2d({1.0, 0.0}, 0.0, 0.0, 0.0),
+                                      Box2d({1.0, 1.0}, 0.3, 0.0, 0.0),
+                                      Box2d({0.0, 0.0}, 0.0, 2.0, 2.0),
+                                      Box2d({2.0, 0.0}, M_PI_2, 2.0, 0.0),
+                                      Box2d({0.0, 1.0}, 0.0, 0.0, 0.0)}));
+}
+
+TEST(Box2dBatchTest, DistanceTo) {
+  Box2dBatch batch({Box2d({0.0, 0.0}, 0.0, 4.0, 2.0),
+                    Box2d({10.0, 0.0}, 0.0, 2.0, 2.0),
+                    Box2d({0.0, 10.0}, M_PI_2, 2.0, 2.0)});
+  std::vector<double> distances;
+  batch.DistanceTo(Vec2d(1.0, 0.5), &distances);
+  EXPECT_EQ(std::vector<double>({0.0, 8.0, 8.5}), distances);
+
+  const Box2d box({5.0, 0.0}, 0.0, 2.0, 2.0);
+  batch.DistanceTo(box, &distances);
+  ASSERT_EQ(3, distances.size());
+  EXPECT_NEAR(2.0, distances[0], 1e-5);
+  EXPECT_NEAR(3.0, distances[1], 1e-5);
+  EXPECT_NEAR(std::hypot(3.0, 8.0), distances[2], 1e-5);
+  batch.DistanceTo(box, 5.0, &distances);
+  EXPECT_NEAR(2.0, distances[0], 1e-5);
+  EXPECT_NEAR(3.0, distances[1], 1e-5);
+  EXPECT_TRUE(std::isinf(distances[2]));
+
+  batch.Clear();
+  batch.DistanceTo(box, &distances);
+  EXPECT_TRUE(distances.empty());
+}
+
+TEST(Box2dBatchTest, RandomDistances) {
+  std::mt19937 random(2018);
+  for (int test = 0; test < 200; ++test) {
+    Box2dBatch batch;
+    const int size = test % 70;
+    for (int i = 0; i < size; ++i) {
+      batch.Add(RandomBox(&random));
+    }
+    for (int k = 0; k < 5; ++k) {
+      ExpectSameDistances(RandomBox(&random), batch, 0.1 * (test % 50));
+    }
+  }
+}
+
+TEST(Box2dBatchTest, HasOverlapOfBoxList) {
+  std::mt19937 random(2018);
+  std::vector<Box2d> boxes;
+  Box2dBatch batch;
+  for (int i = 0; i < 13; ++i) {
+    boxes.push_back(RandomBox(&random));
+    batch.Add(RandomBox(&random));
+  }
+  std::vector<uint8_t> overlaps;
+  batch.HasOverlap(boxes, &overlaps);
+  ASSERT_EQ(boxes.size() * batch.size(), overlaps.size());
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    for (std::size_t j = 0; j < batch.size(); ++j) {
+      EXPECT_EQ(boxes[i].HasOverlap(batch.box(j)),
+                overlaps[i * batch.size() + j] != 0);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
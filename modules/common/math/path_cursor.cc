@@ -0,0 +1,183 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/path_cursor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 16;
+
+// The bounding boxes of kBlockSize consecutive blocks each.
+std::vector<PathCursor::Block> GroupBlocks(
+    const std::vector<PathCursor::Block> &blocks) {
+  std::vector<PathCursor::Block> groups;
+  for (std::size_t begin = 0; begin < blocks.size(); begin += kBlockSize) {
+    const std::size_t end = std::min(begin + kBlockSize, blocks.size());
+    PathCursor::Block group = blocks[begin];
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      group.min_x = std::min(group.min_x, blocks[i].min_x);
+      group.max_x = std::max(group.max_x, blocks[i].max_x);
+      group.min_y = std::min(group.min_y, blocks[i].min_y);
+      group.max_y = std::max(group.max_y, blocks[i].max_y);
+    }
+    groups.push_back(group);
+  }
+  return groups;
+}
+
+// Whether a block whose first point has the index may hold a point nearer
+// than the nearest point so far. The distance to the bounding box, computed
+// in the same way as the distance to a point, is never more than the
+// distance to any point in the box.
+bool MayHoldNearerPoint(const PathCursor::Block &block, const std::size_t index,
+                        const double x, const double y,
+                        const double distance_min,
+                        const std::size_t index_min) {
+  const double dx = x < block.min_x ? block.min_x - x
+                                    : (x > block.max_x ? x - block.max_x : 0.0);
+  const double dy = y < block.min_y ? block.min_y - y
+                                    : (y > block.max_y ? y - block.max_y : 0.0);
+  const double bound = dx * dx + dy * dy;
+  return bound < distance_min || (bound == distance_min && index < index_min);
+}
+
+}  // namespace
+
+PathCursor::PathCursor(std::vector<Vec2d> points) : points_(std::move(points)) {
+  CHECK(!points_.empty());
+  for (std::size_t begin = 0; begin < points_.size(); begin += kBlockSize) {
+    const std::size_t end = std::min(begin + kBlockSize, points_.size());
+    Block block = {points_[begin].x(), points_[begin].x(), points_[begin].y(),
+                   points_[begin].y()};
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      block.min_x = std::min(block.min_x, points_[i].x());
+      block.max_x = std::max(block.max_x, points_[i].x());
+      block.min_y = std::min(block.min_y, points_[i].y());
+      block.max_y = std::max(block.max_y, points_[i].y());
+    }
+    blocks_.push_back(block);
+  }
+  groups_ = GroupBlocks(blocks_);
+}
+
+double PathCursor::DistanceSquare(const std::size_t index, const double x,
+                                  const double y) const {
+  const double dx = points_[index].x() - x;
+  const double dy = points_[index].y() - y;
+  return dx * dx + dy * dy;
+}
+
+std::size_t PathCursor::FindNearestIndex(const double x, const double y) {
+  last_index_ = FindNearestIndex(x, y, last_index_);
+  return last_index_;
+}
+
+std::size_t PathCursor::FindNearestIndex(const double x, const double y,
+                                         const std::size_t hint) const {
+  CHECK(!points_.empty());
+  std::size_t index_min = std::min(hint, points_.size() - 1);
+  double distance_min = DistanceSquare(index_min, x, y);
+  if (std::isnan(distance_min)) {
+    return FindNearestIndexByScan(x, y);
+  }
+
+  // Walk along the path while the points get nearer, where a point before
+  // is preferred on ties as by the linear scan.
+  while (true) {
+    if (index_min > 0) {
+      const double distance = DistanceSquare(index_min - 1, x, y);
+      if (distance <= distance_min) {
+        --index_min;
+        distance_min = distance;
+        continue;
+      }
+    }
+    if (index_min + 1 < points_.size()) {
+      const double distance = DistanceSquare(index_min + 1, x, y);
+      if (distance < distance_min) {
+        ++index_min;
+        distance_min = distance;
+        continue;
+      }
+    }
+    break;
+  }
+
+  // Scan the blocks which may hold a nearer point.
+  for (std::size_t g = 0; g < groups_.size(); ++g) {
+    const std::size_t group_begin = g * kBlockSize;
+    if (!MayHoldNearerPoint(groups_[g], group_begin * kBlockSize, x, y,
+                            distance_min, index_min)) {
+      continue;
+    }
+    const std::size_t group_end =
+        std::min(group_begin + kBlockSize, blocks_.size());
+    for (std::size_t b = group_begin; b < group_end; ++b) {
+      const std::size_t begin = b * kBlockSize;
+      if (!MayHoldNearerPoint(blocks_[b], begin, x, y, distance_min,
+                              index_min)) {
+        continue;
+      }
+      const std::size_t end = std::min(begin + kBlockSize, points_.size());
+      for (std::size_t i = begin; i < end; ++i) {
+        const double distance = DistanceSquare(i, x, y);
+        if (distance < distance_min ||
+            (distance == distance_min && i < index_min)) {
+          distance_min = distance;
+          index_min = i;
+        }
+      }
+    }
+  }
+  return index_min;
+}
+
+void PathCursor::FindNearestIndices(const std::vector<Vec2d> &queries,
+                                    std::vector<std::size_t> *indices) {
+  indices->clear();
+  indices->reserve(queries.size());
+  for (const Vec2d &query : queries) {
+    indices->push_back(FindNearestIndex(query.x(), query.y()));
+  }
+}
+
+std::size_t PathCursor::FindNearestIndexByScan(const double x,
+                                               const double y) const {
+  double distance_min = DistanceSquare(0, x, y);
+  std::size_t index_min = 0;
+  for (std::size_t i = 1; i < points_.size(); ++i) {
+    const double distance = DistanceSquare(i, x, y);
+    if (distance < distance_min) {
+      distance_min = distance;
+      index_min = i;
+    }
+  }
+  return index_min;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
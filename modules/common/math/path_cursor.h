@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Nearest point queries on the points of a path, for query points
+ *        which move along it.
+ */
+
+#ifndef MODULES_COMMON_MATH_PATH_CURSOR_H_
+#define MODULES_COMMON_MATH_PATH_CURSOR_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class PathCursor
+ * @brief Finds the point of a path nearest to a query point, with the same
+ *        result as a linear scan over the points which keeps the first of
+ *        the nearest ones.
+ *
+ * The search starts from the last found point and walks along the path
+ * while the points get nearer, which finds the answer in a few steps when
+ * the query points move along the path. The answer is then checked against
+ * the bounding boxes of the groups of blocks of consecutive points, and only
+ * the blocks which may hold a nearer point are scanned, so a jump away from
+ * the last point costs a scan of the bounding boxes rather than of all
+ * points.
+ */
+class PathCursor {
+ public:
+  PathCursor() = default;
+  /**
+   * @brief Constructor which takes the points of a path.
+   * @param points The points of the path, which must not be empty.
+   */
+  explicit PathCursor(std::vector<Vec2d> points);
+
+  /**
+   * @brief Finds the point nearest to a query point, starting from the last
+   * found point.
+   * @param x The x of the query point.
+   * @param y The y of the query point.
+   * @return The index of the first of the nearest points.
+   */
+  std::size_t FindNearestIndex(const double x, const double y);
+
+  /**
+   * @brief Finds the point nearest to a query point, starting from a hint.
+   * @param x The x of the query point.
+   * @param y The y of the query point.
+   * @param hint The index of a point near the query point.
+   * @return The index of the first of the nearest points.
+   */
+  std::size_t FindNearestIndex(const double x, const double y,
+                               const std::size_t hint) const;
+
+  /**
+   * @brief Finds the nearest points of query points in order, each starting
+   * from the point found for the previous one.
+   * @param queries The query points.
+   * @param indices The indices of the nearest points, one per query point.
+   */
+  void FindNearestIndices(const std::vector<Vec2d> &queries,
+                          std::vector<std::size_t> *indices);
+
+  /**
+   * @brief Gets the number of points of the path.
+   * @return The number of points.
+   */
+  std::size_t num_points() const { return points_.size(); }
+
+  /**
+   * @brief The bounding box of consecutive points.
+   */
+  struct Block {
+    double min_x;
+    double max_x;
+    double min_y;
+    double max_y;
+  };
+
+ private:
+  double DistanceSquare(const std::size_t index, const double x,
+                        const double y) const;
+  std::size_t FindNearestIndexByScan(const double x, const double y) const;
+
+  std::vector<Vec2d> points_;
+  // The bounding boxes of 16 consecutive points each.
+  std::vector<Block> blocks_;
+  // The bounding boxes of 16 consecutive blocks each.
+  std::vector<Block> groups_;
+  std::size_t last_index_ = 0;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_PATH_CURSOR_H_
@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the time of the nearest point queries on trajectories done
+ *        by a linear scan, versus with a PathCursor built for each query or
+ *        kept across the queries. The query points follow the trajectory
+ *        with some noise, as the positions of the vehicle matched by the
+ *        controllers, or jump to random points.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/path_cursor.h"
+
+DEFINE_int32(benchmark_num_points, 1000, "Number of trajectory points.");
+DEFINE_int32(benchmark_num_trajectories, 100, "Number of trajectories.");
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+double ElapsedNs(const std::chrono::steady_clock::time_point start,
+                 const std::size_t num_queries) {
+  const std::chrono::duration<double, std::nano> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count() / num_queries;
+}
+
+std::size_t FindNearestIndexByScan(const std::vector<Vec2d> &points,
+                                   const Vec2d &query) {
+  double distance_min = points.front().DistanceSquareTo(query);
+  std::size_t index_min = 0;
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    const double distance = points[i].DistanceSquareTo(query);
+    if (distance < distance_min) {
+      distance_min = distance;
+      index_min = i;
+    }
+  }
+  return index_min;
+}
+
+// A curvy trajectory at 0.2m between points, which starts with the vehicle
+// standing still.
+std::vector<Vec2d> CreateTrajectory(std::mt19937 *const random) {
+  std::uniform_real_distribution<double> curvature(-0.02, 0.02);
+  std::vector<Vec2d> points;
+  double x = 0.0;
+  double y = 0.0;
+  double heading = 0.0;
+  for (int i = 0; i < FLAGS_benchmark_num_points; ++i) {
+    if (i >= 20) {
+      const double step = 0.2;
+      heading += curvature(*random) * step;
+      x += step * std::cos(heading);
+      y += step * std::sin(heading);
+    }
+    points.emplace_back(x, y);
+  }
+  return points;
+}
+
+// Measures the queries of all trajectories, and counts the mismatches with
+// the linear scan.
+template <typename Query>
+double Measure(const std::vector<std::vector<Vec2d>> &trajectories,
+               const std::vector<std::vector<Vec2d>> &queries,
+               const std::vector<std::vector<std::size_t>> &expected,
+               const Query &query, int *num_mismatches) {
+  std::size_t num_queries = 0;
+  std::vector<std::size_t> indices;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < trajectories.size(); ++i) {
+    query(trajectories[i], queries[i], &indices);
+    num_queries += queries[i].size();
+    if (indices != expected[i]) {
+      ++*num_mismatches;
+    }
+  }
+  return ElapsedNs(start, num_queries);
+}
+
+int Run() {
+  std::mt19937 random(2018);
+  std::normal_distribution<double> noise(0.0, 0.3);
+  std::uniform_real_distribution<double> jump(-100.0, 300.0);
+  std::vector<std::vector<Vec2d>> trajectories;
+  std::vector<std::vector<Vec2d>> following_queries;
+  std::vector<std::vector<Vec2d>> jumping_queries;
+  for (int i = 0; i < FLAGS_benchmark_num_trajectories; ++i) {
+    trajectories.push_back(CreateTrajectory(&random));
+    following_queries.emplace_back();
+    jumping_queries.emplace_back();
+    for (const Vec2d &point : trajectories.back()) {
+      following_queries.back().emplace_back(point.x() + noise(random),
+                                            point.y() + noise(random));
+      jumping_queries.back().emplace_back(jump(random), jump(random));
+    }
+  }
+
+  const auto scan = [](const std::vector<Vec2d> &points,
+                       const std::vector<Vec2d> &queries,
+                       std::vector<std::size_t> *indices) {
+    indices->clear();
+    for (const Vec2d &query : queries) {
+      indices->push_back(FindNearestIndexByScan(points, query));
+    }
+  };
+  // A cursor built for each query, as when a controller builds its
+  // trajectory analyzer for every control cycle.
+  const auto cursor_per_query = [](const std::vector<Vec2d> &points,
+                                   const std::vector<Vec2d> &queries,
+                                   std::vector<std::size_t> *indices) {
+    indices->clear();
+    for (const Vec2d &query : queries) {
+      PathCursor cursor(points);
+      indices->push_back(cursor.FindNearestIndex(query.x(), query.y()));
+    }
+  };
+  // A cursor kept across the queries, as the controllers keep the trajectory
+  // analyzer until a new trajectory arrives.
+  const auto cursor_kept = [](const std::vector<Vec2d> &points,
+                              const std::vector<Vec2d> &queries,
+                              std::vector<std::size_t> *indices) {
+    indices->clear();
+    PathCursor cursor(points);
+    for (const Vec2d &query : queries) {
+      indices->push_back(cursor.FindNearestIndex(query.x(), query.y()));
+    }
+  };
+
+  int num_mismatches = 0;
+  std::cout << "trajectories: " << trajectories.size()
+            << ", points: " << FLAGS_benchmark_num_points << std::endl
+            << std::fixed << std::setprecision(1);
+  for (const auto *queries : {&following_queries, &jumping_queries}) {
+    std::vector<std::vector<std::size_t>> expected;
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < trajectories.size(); ++i) {
+      scan(trajectories[i], (*queries)[i], &indices);
+      expected.push_back(indices);
+    }
+    std::cout << (queries == &following_queries ? "following" : "jumping")
+              << " queries:" << std::endl
+              << "  linear scan:          "
+              << Measure(trajectories, *queries, expected, scan,
+                         &num_mismatches)
+              << " ns/query" << std::endl
+              << "  cursor per query:     "
+              << Measure(trajectories, *queries, expected, cursor_per_query,
+                         &num_mismatches)
+              << " ns/query" << std::endl
+              << "  cursor kept:          "
+              << Measure(trajectories, *queries, expected, cursor_kept,
+                         &num_mismatches)
+              << " ns/query" << std::endl;
+  }
+  std::cout << "mismatched trajectories: " << num_mismatches << std::endl;
+  return num_mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::common::math::Run();
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/path_cursor.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+std::size_t FindNearestIndexByScan(const std::vector<Vec2d> &points,
+                                   const double x, const double y) {
+  auto distance_square = [x, y](const Vec2d &point) {
+    const double dx = point.x() - x;
+    const double dy = point.y() - y;
+    return dx * dx + dy * dy;
+  };
+  double distance_min = distance_square(points.front());
+  std::size_t index_min = 0;
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    const double distance = distance_square(points[i]);
+    if (distance < distance_min) {
+      distance_min = distance;
+      index_min = i;
+    }
+  }
+  return index_min;
+}
+
+// A path which winds around and crosses itself, with runs of repeated points
+// as a trajectory of a stopped vehicle.
+std::vector<Vec2d> WindingPath(const std::size_t num_points) {
+  std::vector<Vec2d> points;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double t = 0.05 * static_cast<double>(i);
+    if (i % 97 < 10) {
+      points.push_back(points.empty() ? Vec2d(0.0, 0.0) : points.back());
+    } else {
+      points.emplace_back(10.0 * std::sin(0.7 * t) + t,
+                          8.0 * std::sin(1.3 * t));
+    }
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(PathCursorTest, FindNearestIndexAlongPath) {
+  const std::vector<Vec2d> points = WindingPath(1000);
+  PathCursor cursor(points);
+  EXPECT_EQ(points.size(), cursor.num_points());
+  std::mt19937 random(2018);
+  std::normal_distribution<double> offset(0.0, 0.5);
+  for (const Vec2d &point : points) {
+    const double x = point.x() + offset(random);
+    const double y = point.y() + offset(random);
+    EXPECT_EQ(FindNearestIndexByScan(points, x, y),
+              cursor.FindNearestIndex(x, y));
+  }
+  for (std::size_t i = points.size(); i > 0; --i) {
+    const double x = points[i - 1].x() + offset(random);
+    const double y = points[i - 1].y() + offset(random);
+    EXPECT_EQ(FindNearestIndexByScan(points, x, y),
+              cursor.FindNearestIndex(x, y));
+  }
+}
+
+TEST(PathCursorTest, FindNearestIndexWithJumps) {
+  const std::vector<Vec2d> points = WindingPath(500);
+  PathCursor cursor(points);
+  std::mt19937 random(2018);
+  std::uniform_real_distribution<double> x(-20.0, 50.0);
+  std::uniform_real_distribution<double> y(-20.0, 20.0);
+  std::uniform_int_distribution<std::size_t> hint(0, 2 * points.size());
+  for (int i = 0; i < 2000; ++i) {
+    const double query_x = x(random);
+    const double query_y = y(random);
+    const std::size_t expected =
+        FindNearestIndexByScan(points, query_x, query_y);
+    EXPECT_EQ(expected, cursor.FindNearestIndex(query_x, query_y));
+    EXPECT_EQ(expected,
+              cursor.FindNearestIndex(query_x, query_y, hint(random)));
+  }
+}
+
+TEST(PathCursorTest, FindNearestIndexOnTies) {
+  // Points on a circle around the query point, and repeated points.
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 40; ++i) {
+    const double angle = 0.25 * M_PI * (i % 8);
+    points.emplace_back(std::cos(angle) * 2.0, std::sin(angle) * 2.0);
+  }
+  points.emplace_back(0.0, 1.0);
+  points.emplace_back(0.0, 1.0);
+  points.emplace_back(1.0, 0.0);
+  PathCursor cursor(points);
+  for (std::size_t hint = 0; hint < points.size(); ++hint) {
+    EXPECT_EQ(FindNearestIndexByScan(points, 0.0, 0.0),
+              cursor.FindNearestIndex(0.0, 0.0, hint));
+    EXPECT_EQ(FindNearestIndexByScan(points, 5.0, 0.0),
+              cursor.FindNearestIndex(5.0, 0.0, hint));
+  }
+  EXPECT_EQ(40, cursor.FindNearestIndex(0.0, 0.0, 42));
+}
+
+TEST(PathCursorTest, FindNearestIndices) {
+  const std::vector<Vec2d> points = WindingPath(300);
+  PathCursor cursor(points);
+  std::vector<Vec2d> queries;
+  for (std::size_t i = 0; i < points.size(); i += 3) {
+    queries.emplace_back(points[i].x() + 0.1, points[i].y() - 0.2);
+  }
+  queries.emplace_back(100.0, 100.0);
+  queries.emplace_back(points.front());
+  std::vector<std::size_t> indices;
+  cursor.FindNearestIndices(queries, &indices);
+  ASSERT_EQ(queries.size(), indices.size());
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    EXPECT_EQ(FindNearestIndexByScan(points, queries[i].x(), queries[i].y()),
+              indices[i]);
+  }
+}
+
+TEST(PathCursorTest, SinglePoint) {
+  PathCursor cursor({Vec2d(1.0, 2.0)});
+  EXPECT_EQ(0, cursor.FindNearestIndex(5.0, 5.0));
+  EXPECT_EQ(0, cursor.FindNearestIndex(5.0, 5.0, 3));
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 #include "glog/logging.h"
@@ -53,6 +54,30 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
     }
   }
 
+  return ProjectToPath(reference_line, x, y, index_min);
+}
+
+PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
+                                   const double x, const double y,
+                                   PathCursor* cursor) {
+  CHECK_GT(reference_line.size(), 0);
+  CHECK_EQ(cursor->num_points(), reference_line.size());
+  return ProjectToPath(reference_line, x, y, cursor->FindNearestIndex(x, y));
+}
+
+PathCursor PathMatcher::CreatePathCursor(
+    const std::vector<PathPoint>& reference_line) {
+  std::vector<Vec2d> points;
+  points.reserve(reference_line.size());
+  for (const PathPoint& point : reference_line) {
+    points.emplace_back(point.x(), point.y());
+  }
+  return PathCursor(std::move(points));
+}
+
+PathPoint PathMatcher::ProjectToPath(
+    const std::vector<PathPoint>& reference_line, const double x,
+    const double y, const std::size_t index_min) {
   std::size_t index_start = (index_min == 0) ? index_min : index_min - 1;
   std::size_t index_end =
       (index_min + 1 == reference_line.size()) ? index_min : index_min + 1;
@@ -21,9 +21,11 @@
 #ifndef MODULES_COMMON_MATH_PATH_MATCHER_H_
 #define MODULES_COMMON_MATH_PATH_MATCHER_H_
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/path_cursor.h"
 #include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
@@ -37,6 +39,19 @@ class PathMatcher {
   static PathPoint MatchToPath(const std::vector<PathPoint>& reference_line,
                                const double x, const double y);
 
+  /**
+   * @brief Same as MatchToPath(reference_line, x, y), for query points which
+   * move along the reference line.
+   * @param cursor The cursor created by CreatePathCursor(reference_line),
+   * which starts from the point matched by the last call.
+   */
+  static PathPoint MatchToPath(const std::vector<PathPoint>& reference_line,
+                               const double x, const double y,
+                               PathCursor* cursor);
+
+  static PathCursor CreatePathCursor(
+      const std::vector<PathPoint>& reference_line);
+
   static std::pair<double, double> GetPathFrenetCoordinate(
       const std::vector<PathPoint>& reference_line, const double x,
       const double y);
@@ -45,6 +60,10 @@ class PathMatcher {
                                const double s);
 
  private:
+  static PathPoint ProjectToPath(const std::vector<PathPoint>& reference_line,
+                                 const double x, const double y,
+                                 const std::size_t index_min);
+
   static PathPoint FindProjectionPoint(const PathPoint& p0, const PathPoint& p1,
                                        const double x, const double y);
 };
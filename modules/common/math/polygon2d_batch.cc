@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/polygon2d_batch.h"
+
+#include <limits>
+
+namespace apollo {
+namespace common {
+namespace math {
+
+Polygon2dBatch::Polygon2dBatch(const std::vector<Polygon2d> &polygons) {
+  Reserve(polygons.size());
+  for (const auto &polygon : polygons) {
+    Add(polygon);
+  }
+}
+
+void Polygon2dBatch::Add(const Polygon2d &polygon) {
+  polygons_.push_back(polygon);
+  min_x_.push_back(polygon.min_x());
+  max_x_.push_back(polygon.max_x());
+  min_y_.push_back(polygon.min_y());
+  max_y_.push_back(polygon.max_y());
+}
+
+void Polygon2dBatch::Clear() {
+  polygons_.clear();
+  for (auto *field : {&min_x_, &max_x_, &min_y_, &max_y_}) {
+    field->clear();
+  }
+}
+
+void Polygon2dBatch::Reserve(const std::size_t size) {
+  polygons_.reserve(size);
+  for (auto *field : {&min_x_, &max_x_, &min_y_, &max_y_}) {
+    field->reserve(size);
+  }
+}
+
+void Polygon2dBatch::HasOverlap(const Polygon2d &polygon,
+                                std::vector<uint8_t> *const overlaps) const {
+  overlaps->assign(size(), 0);
+  for (std::size_t i = 0; i < size(); ++i) {
+    // The bounding box test of Polygon2d::HasOverlap.
+    if (!IsFar(i, polygon, 0.0)) {
+      (*overlaps)[i] = polygon.HasOverlap(polygons_[i]);
+    }
+  }
+}
+
+void Polygon2dBatch::HasOverlap(const Polygon2d &polygon,
+                                const std::vector<int> &indices,
+                                std::vector<uint8_t> *const overlaps) const {
+  overlaps->assign(indices.size(), 0);
+  for (std::size_t k = 0; k < indices.size(); ++k) {
+    const int i = indices[k];
+    if (!IsFar(i, polygon, 0.0)) {
+      (*overlaps)[k] = polygon.HasOverlap(polygons_[i]);
+    }
+  }
+}
+
+bool Polygon2dBatch::HasOverlapWithAny(const Polygon2d &polygon) const {
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (!IsFar(i, polygon, 0.0) && polygon.HasOverlap(polygons_[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Polygon2dBatch::DistanceTo(const Vec2d &point,
+                                std::vector<double> *const distances) const {
+  distances->resize(size());
+  for (std::size_t i = 0; i < size(); ++i) {
+    (*distances)[i] = polygons_[i].DistanceTo(point);
+  }
+}
+
+void Polygon2dBatch::DistanceTo(const Polygon2d &polygon,
+                                std::vector<double> *const distances) const {
+  DistanceTo(polygon, std::numeric_limits<double>::infinity(), distances);
+}
+
+void Polygon2dBatch::DistanceTo(const Polygon2d &polygon,
+                                const double max_distance,
+                                std::vector<double> *const distances) const {
+  distances->assign(size(), std::numeric_limits<double>::infinity());
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (!IsFar(i, polygon, max_distance)) {
+      (*distances)[i] = polygons_[i].DistanceTo(polygon);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A set of polygons tested for overlap and distance against one
+ *        polygon at a time.
+ */
+
+#ifndef MODULES_COMMON_MATH_POLYGON2D_BATCH_H_
+#define MODULES_COMMON_MATH_POLYGON2D_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "modules/common/math/polygon2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class Polygon2dBatch
+ * @brief Polygons with their bounding boxes stored as structure of arrays,
+ *        so that the polygons far from the query are rejected in a tight
+ *        loop before the edge by edge tests of Polygon2d.
+ *
+ * The polygons which pass are tested by Polygon2d itself, so the results
+ * are always equal to the ones of Polygon2d.
+ */
+class Polygon2dBatch {
+ public:
+  Polygon2dBatch() = default;
+  /**
+   * @brief Constructor which takes a list of polygons.
+   * @param polygons The polygons of the batch, with 3 points at least.
+   */
+  explicit Polygon2dBatch(const std::vector<Polygon2d> &polygons);
+
+  /**
+   * @brief Appends a polygon to the batch.
+   * @param polygon The polygon to append, with 3 points at least.
+   */
+  void Add(const Polygon2d &polygon);
+
+  /**
+   * @brief Removes all the polygons.
+   */
+  void Clear();
+
+  /**
+   * @brief Reserves the memory of a number of polygons.
+   * @param size The number of polygons.
+   */
+  void Reserve(const std::size_t size);
+
+  /**
+   * @brief Gets the number of polygons.
+   * @return The number of polygons.
+   */
+  std::size_t size() const { return polygons_.size(); }
+
+  /**
+   * @brief Checks whether the batch has no polygon.
+   * @return True if the batch has no polygon.
+   */
+  bool empty() const { return polygons_.empty(); }
+
+  /**
+   * @brief Gets a polygon of the batch.
+   * @param index The index of the polygon.
+   * @return The polygon at the index.
+   */
+  const Polygon2d &polygon(const std::size_t index) const {
+    return polygons_[index];
+  }
+
+  /**
+   * @brief Gets all the polygons of the batch.
+   * @return The polygons of the batch.
+   */
+  const std::vector<Polygon2d> &polygons() const { return polygons_; }
+
+  /**
+   * @brief Tests a polygon against every polygon of the batch.
+   * @param polygon The polygon to test.
+   * @param overlaps Set to the results, where (*overlaps)[i] is
+   *        polygon.HasOverlap(this->polygon(i)).
+   */
+  void HasOverlap(const Polygon2d &polygon,
+                  std::vector<uint8_t> *const overlaps) const;
+
+  /**
+   * @brief Tests a polygon against some polygons of the batch, e.g. the
+   *        candidates of a spatial index.
+   * @param polygon The polygon to test.
+   * @param indices The indices of the polygons of the batch to test.
+   * @param overlaps Set to the results, where (*overlaps)[k] is
+   *        polygon.HasOverlap(this->polygon(indices[k])).
+   */
+  void HasOverlap(const Polygon2d &polygon, const std::vector<int> &indices,
+                  std::vector<uint8_t> *const overlaps) const;
+
+  /**
+   * @brief Checks whether a polygon overlaps any polygon of the batch.
+   * @param polygon The polygon to test.
+   * @return True if polygon.HasOverlap(this->polygon(i)) for some i.
+   */
+  bool HasOverlapWithAny(const Polygon2d &polygon) const;
+
+  /**
+   * @brief Computes the distance from every polygon of the batch to a point.
+   * @param point The point.
+   * @param distances Set to the results, where (*distances)[i] is
+   *        this->polygon(i).DistanceTo(point).
+   */
+  void DistanceTo(const Vec2d &point,
+                  std::vector<double> *const distances) const;
+
+  /**
+   * @brief Computes the distance from every polygon of the batch to a
+   *        polygon.
+   * @param polygon The polygon.
+   * @param distances Set to the results, where (*distances)[i] is
+   *        this->polygon(i).DistanceTo(polygon).
+   */
+  void DistanceTo(const Polygon2d &polygon,
+                  std::vector<double> *const distances) const;
+
+  /**
+   * @brief Computes the distance from every polygon of the batch to a
+   *        polygon, and skips the polygons whose bounding boxes are more
+   *        than max_distance apart along x or y, as they are farther than
+   *        max_distance.
+   * @param polygon The polygon.
+   * @param max_distance The distance beyond which the polygons are skipped.
+   * @param distances Set to the results, where (*distances)[i] is
+   *        this->polygon(i).DistanceTo(polygon), or infinity for a skipped
+   *        polygon.
+   */
+  void DistanceTo(const Polygon2d &polygon, const double max_distance,
+                  std::vector<double> *const distances) const;
+
+ private:
+  // Checks whether the bounding boxes of a polygon of the batch and of the
+  // argument are more than a distance apart along x or y.
+  bool IsFar(const std::size_t index, const Polygon2d &polygon,
+             const double distance) const {
+    return min_x_[index] - polygon.max_x() > distance ||
+           polygon.min_x() - max_x_[index] > distance ||
+           min_y_[index] - polygon.max_y() > distance ||
+           polygon.min_y() - max_y_[index] > distance;
+  }
+
+  std::vector<Polygon2d> polygons_;
+
+  // The bounding boxes of the polygons.
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif /* MODULES_COMMON_MATH_POLYGON2D_BATCH_H_ */
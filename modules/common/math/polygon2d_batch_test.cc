@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/polygon2d_batch.h"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// A convex polygon of 3 to 8 points around a random center.
+Polygon2d RandomPolygon(std::mt19937 *const random) {
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> radius(0.5, 3.0);
+  std::uniform_int_distribution<int> num_points(3, 8);
+  const Vec2d center(position(*random), position(*random));
+  const int n = num_points(*random);
+  const double r = radius(*random);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < n; ++i) {
+    const double angle = 2.0 * M_PI * i / n;
+    points.emplace_back(center.x() + r * std::cos(angle),
+                        center.y() + r * std::sin(angle));
+  }
+  return Polygon2d(points);
+}
+
+}  // namespace
+
+TEST(Polygon2dBatchTest, Add) {
+  Polygon2dBatch batch;
+  EXPECT_TRUE(batch.empty());
+  const Polygon2d polygon(Box2d({1.0, 2.0}, 0.5, 4.0, 2.0));
+  batch.Add(polygon);
+  batch.Add(polygon);
+  EXPECT_EQ(2, batch.size());
+  EXPECT_EQ(polygon.DebugString(), batch.polygon(1).DebugString());
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_FALSE(batch.HasOverlapWithAny(polygon));
+}
+
+TEST(Polygon2dBatchTest, HasOverlapAndDistanceTo) {
+  const Polygon2d polygon(Box2d({0.0, 0.0}, 0.0, 4.0, 2.0));
+  const Polygon2dBatch batch(
+      {Polygon2d(Box2d({1.0, 1.0}, M_PI_4, 1.0, 1.0)),
+       Polygon2d(Box2d({5.0, 0.0}, 0.0, 2.0, 2.0)),
+       Polygon2d({Vec2d(0.0, 3.0), Vec2d(1.0, 4.0), Vec2d(-1.0, 4.0)})});
+  std::vector<uint8_t> overlaps;
+  batch.HasOverlap(polygon, &overlaps);
+  EXPECT_EQ(std::vector<uint8_t>({1, 0, 0}), overlaps);
+  batch.HasOverlap(polygon, {2, 0}, &overlaps);
+  EXPECT_EQ(std::vector<uint8_t>({0, 1}), overlaps);
+  EXPECT_TRUE(batch.HasOverlapWithAny(polygon));
+  EXPECT_FALSE(batch.HasOverlapWithAny(
+      Polygon2d(Box2d({-10.0, 0.0}, 0.0, 1.0, 1.0))));
+
+  std::vector<double> distances;
+  batch.DistanceTo(polygon, &distances);
+  ASSERT_EQ(3, distances.size());
+  EXPECT_NEAR(0.0, distances[0], 1e-5);
+  EXPECT_NEAR(2.0, distances[1], 1e-5);
+  EXPECT_NEAR(2.0, distances[2], 1e-5);
+  batch.DistanceTo(polygon, 1.0, &distances);
+  EXPECT_NEAR(0.0, distances[0], 1e-5);
+  EXPECT_TRUE(std::isinf(distances[1]));
+  EXPECT_TRUE(std::isinf(distances[2]));
+
+  batch.DistanceTo(Vec2d(7.0, 0.0), &distances);
+  EXPECT_NEAR(1.0, distances[1], 1e-5);
+}
+
+TEST(Polygon2dBatchTest, RandomPolygons) {
+  std::mt19937 random(2018);
+  for (int test = 0; test < 100; ++test) {
+    Polygon2dBatch batch;
+    for (int i = 0; i < test % 30; ++i) {
+      batch.Add(RandomPolygon(&random));
+    }
+    const double max_distance = 0.2 * (test % 20);
+    for (int k = 0; k < 5; ++k) {
+      const Polygon2d polygon = RandomPolygon(&random);
+      std::vector<uint8_t> overlaps;
+      std::vector<double> distances;
+      std::vector<double> point_distances;
+      batch.HasOverlap(polygon, &overlaps);
+      batch.DistanceTo(polygon, max_distance, &distances);
+      batch.DistanceTo(polygon.points()[0], &point_distances);
+      ASSERT_EQ(batch.size(), overlaps.size());
+      ASSERT_EQ(batch.size(), distances.size());
+      ASSERT_EQ(batch.size(), point_distances.size());
+      bool has_overlap = false;
+      for (std::size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_EQ(polygon.HasOverlap(batch.polygon(i)), overlaps[i] != 0);
+        has_overlap = has_overlap || overlaps[i] != 0;
+        const double distance = batch.polygon(i).DistanceTo(polygon);
+        if (std::isinf(distances[i])) {
+          EXPECT_GT(distance, max_distance);
+        } else {
+          EXPECT_EQ(distance, distances[i]);
+        }
+        EXPECT_EQ(batch.polygon(i).DistanceTo(polygon.points()[0]),
+                  point_distances[i]);
+      }
+      EXPECT_EQ(has_overlap, batch.HasOverlapWithAny(polygon));
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/trace/trace.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace trace {
+namespace {
+
+void WriteJsonString(const char *str, std::ostream *out) {
+  *out << '"';
+  for (const char *c = str; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      *out << '\\';
+    }
+    *out << *c;
+  }
+  *out << '"';
+}
+
+}  // namespace
+
+TraceRingBuffer::TraceRingBuffer(const uint32_t thread_id,
+                                 const size_t capacity)
+    : thread_id_(thread_id), num_written_(0) {
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  events_.resize(size);
+  mask_ = size - 1;
+}
+
+void TraceRingBuffer::Collect(std::vector<TraceEvent> *events) const {
+  const uint64_t capacity = events_.size();
+  const uint64_t end = num_written_.load(std::memory_order_acquire);
+  const uint64_t begin = end > capacity ? end - capacity : 0;
+  const size_t offset = events->size();
+  for (uint64_t i = begin; i < end; ++i) {
+    events->push_back(events_[i & mask_]);
+  }
+
+  // The writer may have lapped us while copying, including the slot it may
+  // be writing right now.
+  const uint64_t new_end = num_written_.load(std::memory_order_acquire) + 1;
+  const uint64_t valid_begin = new_end > capacity ? new_end - capacity : 0;
+  if (valid_begin > begin) {
+    const size_t num_dropped = std::min(valid_begin, end) - begin;
+    events->erase(events->begin() + offset,
+                  events->begin() + offset + num_dropped);
+  }
+}
+
+Tracer::Tracer() {}
+
+uint64_t Tracer::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+TraceRingBuffer *Tracer::ThreadBuffer() {
+  thread_local TraceRingBuffer *buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.emplace_back(new TraceRingBuffer(
+        static_cast<uint32_t>(buffers_.size()),
+        std::max(FLAGS_latency_trace_buffer_size, 1)));
+    buffer = buffers_.back().get();
+  }
+  return buffer;
+}
+
+std::vector<TraceEvent> Tracer::Collect() const {
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &buffer : buffers_) {
+      buffer->Collect(&events);
+    }
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const TraceEvent &a, const TraceEvent &b) {
+                     return a.begin_ns < b.begin_ns;
+                   });
+  return events;
+}
+
+void Tracer::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &buffer : buffers_) {
+    buffer->Clear();
+  }
+}
+
+bool Tracer::ExportChromeTrace(const std::string &file_path) const {
+  const auto events = Collect();
+  std::ofstream fout(file_path);
+  if (!fout) {
+    AERROR << "Cannot open file " << file_path;
+    return false;
+  }
+
+  // Chrome trace timestamps are in microseconds.
+  const int pid = getpid();
+  fout << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto &event = events[i];
+    fout << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    WriteJsonString(event.name, &fout);
+    fout << ",\"cat\":\"apollo\",\"ph\":\"X\",\"pid\":" << pid
+         << ",\"tid\":" << event.thread_id
+         << ",\"ts\":" << event.begin_ns * 1e-3
+         << ",\"dur\":" << (event.end_ns - event.begin_ns) * 1e-3;
+    if (event.origin_ns != 0) {
+      // Latency from the sensor data to the end of this span.
+      const double latency_ms =
+          (static_cast<double>(event.end_ns) - event.origin_ns) * 1e-6;
+      fout << ",\"args\":{\"origin_ns\":" << event.origin_ns
+           << ",\"latency_from_origin_ms\":" << latency_ms << "}";
+    }
+    fout << "}";
+  }
+  fout << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  fout.close();
+  if (!fout) {
+    AERROR << "Failed to write " << file_path;
+    return false;
+  }
+  AINFO << "Exported " << events.size() << " trace events to " << file_path;
+  return true;
+}
+
+uint64_t GetOriginTimestampNs(const Header &header) {
+  uint64_t origin_ns = 0;
+  for (const uint64_t timestamp :
+       {header.lidar_timestamp(), header.camera_timestamp(),
+        header.radar_timestamp()}) {
+    if (timestamp != 0 && (origin_ns == 0 || timestamp < origin_ns)) {
+      origin_ns = timestamp;
+    }
+  }
+  return origin_ns;
+}
+
+void PropagateOrigin(const Header &input, Header *output) {
+  if (GetOriginTimestampNs(*output) != 0) {
+    return;
+  }
+  if (input.has_lidar_timestamp()) {
+    output->set_lidar_timestamp(input.lidar_timestamp());
+  }
+  if (input.has_camera_timestamp()) {
+    output->set_camera_timestamp(input.camera_timestamp());
+  }
+  if (input.has_radar_timestamp()) {
+    output->set_radar_timestamp(input.radar_timestamp());
+  }
+}
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Lightweight in-process latency tracing. Scoped spans are recorded
+ * into lock-free per-thread ring buffers, and can be exported as a Chrome
+ * trace JSON file (chrome://tracing).
+ */
+
+#ifndef MODULES_COMMON_TRACE_TRACE_H_
+#define MODULES_COMMON_TRACE_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/macro.h"
+#include "modules/common/proto/header.pb.h"
+
+namespace apollo {
+namespace common {
+namespace trace {
+
+/**
+ * @brief Get the earliest sensor timestamp (ns) carried by the header, or 0
+ * if there is none.
+ */
+uint64_t GetOriginTimestampNs(const Header &header);
+
+/**
+ * @brief Carry the sensor timestamps of an input message over to the header
+ * of an output message, unless the output already has its own.
+ */
+void PropagateOrigin(const Header &input, Header *output);
+
+struct TraceEvent {
+  // Must point to a string with static storage, such as a literal.
+  const char *name = nullptr;
+  uint64_t begin_ns = 0;
+  uint64_t end_ns = 0;
+  // Timestamp of the sensor data which triggered the span, 0 if unknown.
+  uint64_t origin_ns = 0;
+  uint32_t thread_id = 0;
+};
+
+/**
+ * @class TraceRingBuffer
+ * @brief Fixed-size ring buffer with a single writer thread. When full, the
+ * oldest events are overwritten.
+ */
+class TraceRingBuffer {
+ public:
+  // The capacity is rounded up to a power of two.
+  TraceRingBuffer(const uint32_t thread_id, const size_t capacity);
+
+  void Push(const char *name, const uint64_t begin_ns, const uint64_t end_ns,
+            const uint64_t origin_ns) {
+    const uint64_t index = num_written_.load(std::memory_order_relaxed);
+    TraceEvent &event = events_[index & mask_];
+    event.name = name;
+    event.begin_ns = begin_ns;
+    event.end_ns = end_ns;
+    event.origin_ns = origin_ns;
+    event.thread_id = thread_id_;
+    num_written_.store(index + 1, std::memory_order_release);
+  }
+
+  // Append the retained events, oldest first. Events which the writer
+  // overwrote while copying are dropped.
+  void Collect(std::vector<TraceEvent> *events) const;
+
+  void Clear() { num_written_.store(0, std::memory_order_release); }
+
+  uint32_t thread_id() const { return thread_id_; }
+  size_t capacity() const { return events_.size(); }
+
+ private:
+  const uint32_t thread_id_;
+  std::vector<TraceEvent> events_;
+  uint64_t mask_ = 0;
+  std::atomic<uint64_t> num_written_;
+};
+
+class Tracer {
+ public:
+  static bool IsEnabled() { return FLAGS_enable_latency_trace; }
+
+  static uint64_t NowNs();
+
+  // Record a finished span into the buffer of the calling thread.
+  void Record(const char *name, const uint64_t begin_ns, const uint64_t end_ns,
+              const uint64_t origin_ns) {
+    ThreadBuffer()->Push(name, begin_ns, end_ns, origin_ns);
+  }
+
+  // Collect events of all threads, sorted by begin time.
+  std::vector<TraceEvent> Collect() const;
+
+  // Drop all recorded events. Spans finishing concurrently may survive.
+  void Clear();
+
+  // Export the recorded events in Chrome trace event format.
+  bool ExportChromeTrace(const std::string &file_path) const;
+
+ private:
+  TraceRingBuffer *ThreadBuffer();
+
+  // Buffers are never released, so the thread-local pointers to them stay
+  // valid for the lifetime of the process.
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<TraceRingBuffer>> buffers_;
+
+  DECLARE_SINGLETON(Tracer);
+};
+
+/**
+ * @brief Records the lifetime of the object as a span if tracing is enabled.
+ * Costs a single flag check otherwise.
+ */
+class ScopedSpan {
+ public:
+  explicit ScopedSpan(const char *name, const uint64_t origin_ns = 0)
+      : name_(name),
+        origin_ns_(origin_ns),
+        begin_ns_(Tracer::IsEnabled() ? Tracer::NowNs() : 0) {}
+
+  // Set the sensor origin once the input which triggered the span is known.
+  void SetOrigin(const Header &header) {
+    if (begin_ns_ != 0) {
+      origin_ns_ = GetOriginTimestampNs(header);
+    }
+  }
+
+  ~ScopedSpan() {
+    if (begin_ns_ != 0) {
+      Tracer::instance()->Record(name_, begin_ns_, Tracer::NowNs(),
+                                 origin_ns_);
+    }
+  }
+
+ private:
+  const char *name_;
+  uint64_t origin_ns_;
+  const uint64_t begin_ns_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedSpan);
+};
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Trace the enclosing scope.
+#define TRACE_SPAN(name) \
+  apollo::common::trace::ScopedSpan TRACE_CONCAT(_trace_span_, __LINE__)(name)
+
+// Trace the enclosing scope, which is triggered by the sensor data stamped
+// in the given header.
+#define TRACE_SPAN_FROM(name, header)                                     \
+  apollo::common::trace::ScopedSpan TRACE_CONCAT(_trace_span_, __LINE__)( \
+      name, apollo::common::trace::Tracer::IsEnabled()                    \
+                ? apollo::common::trace::GetOriginTimestampNs(header)     \
+                : 0)
+
+#endif  // MODULES_COMMON_TRACE_TRACE_H_
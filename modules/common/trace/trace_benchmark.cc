@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the per-span overhead of latency tracing, both disabled and
+ *        enabled, from one or more threads.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/trace/trace.h"
+
+DEFINE_int32(benchmark_num_spans, 1000000, "Number of spans per thread.");
+DEFINE_int32(benchmark_max_threads, 4, "Max number of tracing threads.");
+
+namespace apollo {
+namespace common {
+namespace trace {
+namespace {
+
+// Defeats optimizing the traced loop away.
+volatile uint64_t sink = 0;
+
+void TraceSpans(const int num_spans) {
+  for (int i = 0; i < num_spans; ++i) {
+    TRACE_SPAN("benchmark");
+    sink = sink + i;
+  }
+}
+
+// Returns the mean cost of a span in ns.
+double Run(const bool enabled, const int num_threads) {
+  FLAGS_enable_latency_trace = enabled;
+  Tracer::instance()->Clear();
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back(TraceSpans, FLAGS_benchmark_num_spans);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double total_ns =
+      std::chrono::duration<double, std::nano>(end - start).count();
+  // Threads run concurrently, so the cost is per span of one thread.
+  return total_ns / FLAGS_benchmark_num_spans;
+}
+
+}  // namespace
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  const int num_spans = std::max(FLAGS_benchmark_num_spans, 1);
+  FLAGS_benchmark_num_spans = num_spans;
+
+  const double baseline_ns = apollo::common::trace::Run(false, 1);
+  for (int num_threads = 1; num_threads <= FLAGS_benchmark_max_threads;
+       num_threads *= 2) {
+    const double disabled_ns =
+        apollo::common::trace::Run(false, num_threads);
+    const double enabled_ns = apollo::common::trace::Run(true, num_threads);
+    std::cout << std::fixed << std::setprecision(2) << std::setw(2)
+              << num_threads << " threads: disabled " << disabled_ns
+              << " ns/span, enabled " << enabled_ns << " ns/span, overhead "
+              << enabled_ns - baseline_ns << " ns/span" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/trace/trace.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace common {
+namespace trace {
+
+class TraceTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_latency_trace = true;
+    Tracer::instance()->Clear();
+  }
+  void TearDown() override { FLAGS_enable_latency_trace = false; }
+};
+
+TEST_F(TraceTest, Disabled) {
+  FLAGS_enable_latency_trace = false;
+  { TRACE_SPAN("disabled"); }
+  EXPECT_TRUE(Tracer::instance()->Collect().empty());
+}
+
+TEST_F(TraceTest, NestedSpans) {
+  Header header;
+  header.set_lidar_timestamp(2000);
+  header.set_camera_timestamp(1000);
+  {
+    TRACE_SPAN_FROM("outer", header);
+    { TRACE_SPAN("inner"); }
+  }
+  const auto events = Tracer::instance()->Collect();
+  ASSERT_EQ(2, events.size());
+  EXPECT_STREQ("outer", events[0].name);
+  EXPECT_EQ(1000, events[0].origin_ns);
+  EXPECT_STREQ("inner", events[1].name);
+  EXPECT_EQ(0, events[1].origin_ns);
+  EXPECT_LE(events[0].begin_ns, events[1].begin_ns);
+  EXPECT_GE(events[0].end_ns, events[1].end_ns);
+}
+
+TEST_F(TraceTest, RingBuffer) {
+  TraceRingBuffer buffer(3, 3);
+  EXPECT_EQ(4, buffer.capacity());
+  for (uint64_t i = 1; i <= 6; ++i) {
+    buffer.Push("span", i, i + 1, 0);
+  }
+  std::vector<TraceEvent> events;
+  buffer.Collect(&events);
+  // The oldest events are overwritten, and the slot the writer would write
+  // next is considered unsafe.
+  ASSERT_EQ(3, events.size());
+  EXPECT_EQ(4, events[0].begin_ns);
+  EXPECT_EQ(6, events[2].begin_ns);
+  EXPECT_EQ(3, events[2].thread_id);
+}
+
+TEST_F(TraceTest, MultiThread) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 10; ++j) {
+        TRACE_SPAN("worker");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto events = Tracer::instance()->Collect();
+  EXPECT_EQ(40, events.size());
+  for (size_t i = 1; i < events.size(); ++i) {
+    EXPECT_LE(events[i - 1].begin_ns, events[i].begin_ns);
+  }
+}
+
+TEST_F(TraceTest, ExportChromeTrace) {
+  Header header;
+  header.set_radar_timestamp(Tracer::NowNs());
+  { TRACE_SPAN_FROM("Planning::RunOnce", header); }
+
+  const std::string file = "/tmp/trace_test.json";
+  EXPECT_TRUE(Tracer::instance()->ExportChromeTrace(file));
+  std::string content;
+  EXPECT_TRUE(util::GetContent(file, &content));
+  EXPECT_NE(std::string::npos, content.find("\"traceEvents\""));
+  EXPECT_NE(std::string::npos, content.find("\"name\":\"Planning::RunOnce\""));
+  EXPECT_NE(std::string::npos, content.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, content.find("\"latency_from_origin_ms\""));
+}
+
+TEST(PropagateOriginTest, Propagate) {
+  Header input;
+  input.set_lidar_timestamp(100);
+  Header output;
+  PropagateOrigin(input, &output);
+  EXPECT_EQ(100, output.lidar_timestamp());
+  EXPECT_EQ(100, GetOriginTimestampNs(output));
+
+  // Don't override the output's own sensor timestamps.
+  Header other;
+  other.set_camera_timestamp(50);
+  PropagateOrigin(other, &output);
+  EXPECT_FALSE(output.has_camera_timestamp());
+}
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
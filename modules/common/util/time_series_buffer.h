@@ -0,0 +1,172 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A fixed capacity buffer of timestamped sensor samples.
+ */
+
+#ifndef MODULES_COMMON_UTIL_TIME_SERIES_BUFFER_H_
+#define MODULES_COMMON_UTIL_TIME_SERIES_BUFFER_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class TimeSeriesBuffer
+ * @brief A ring buffer of samples with N double values each, ordered by
+ * timestamp. The timestamps and the samples are stored in two contiguous
+ * arrays, so a lookup is a binary search over the timestamps only, and the
+ * interpolation of two samples is a plain loop over N values.
+ * When the buffer is full, pushing a sample drops the oldest one.
+ */
+template <std::size_t N>
+class TimeSeriesBuffer {
+ public:
+  typedef std::array<double, N> Sample;
+
+  explicit TimeSeriesBuffer(const std::size_t capacity)
+      : timestamps_(capacity > 0 ? capacity : 1),
+        samples_(capacity > 0 ? capacity : 1) {}
+
+  /**
+   * @brief Append a sample. The timestamps must not decrease.
+   * @return false if the sample is older than the newest sample.
+   */
+  bool Push(const double timestamp_sec, const Sample &sample) {
+    if (size_ > 0 && timestamp_sec < timestamp_sec_at(size_ - 1)) {
+      return false;
+    }
+    std::size_t index = 0;
+    if (size_ < capacity()) {
+      index = Physical(size_);
+      ++size_;
+    } else {
+      index = head_;
+      head_ = Physical(1);
+    }
+    timestamps_[index] = timestamp_sec;
+    samples_[index] = sample;
+    return true;
+  }
+
+  void Clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  std::size_t size() const { return size_; }
+
+  std::size_t capacity() const { return timestamps_.size(); }
+
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief The timestamp of the i-th sample, the 0-th one is the oldest.
+   */
+  double timestamp_sec_at(const std::size_t i) const {
+    return timestamps_[Physical(i)];
+  }
+
+  /**
+   * @brief The i-th sample, the 0-th one is the oldest.
+   */
+  const Sample &sample_at(const std::size_t i) const {
+    return samples_[Physical(i)];
+  }
+
+  /**
+   * @brief Find the first sample newer than the given timestamp.
+   * @return The index of the sample, or size() if there is none.
+   */
+  std::size_t UpperBound(const double timestamp_sec) const {
+    std::size_t begin = 0;
+    std::size_t count = size_;
+    while (count > 0) {
+      const std::size_t step = count / 2;
+      if (timestamp_sec_at(begin + step) <= timestamp_sec) {
+        begin += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return begin;
+  }
+
+  /**
+   * @brief Interpolate the sample at the given timestamp. The timestamps out
+   * of the buffer are clamped to the oldest or the newest sample.
+   * @return false if the buffer is empty.
+   */
+  bool Interpolate(const double timestamp_sec, Sample *sample) const {
+    if (size_ == 0) {
+      return false;
+    }
+    const std::size_t upper = UpperBound(timestamp_sec);
+    if (upper == 0) {
+      *sample = sample_at(0);
+    } else if (upper == size_) {
+      *sample = sample_at(size_ - 1);
+    } else {
+      const double t0 = timestamp_sec_at(upper - 1);
+      const double t1 = timestamp_sec_at(upper);
+      *sample = InterpolateSamples(sample_at(upper - 1), sample_at(upper),
+                                   (timestamp_sec - t0) / (t1 - t0));
+    }
+    return true;
+  }
+
+  /**
+   * @brief Linear interpolation of two samples, value by value.
+   * @param ratio The weight of s1, in [0, 1].
+   */
+  static Sample InterpolateSamples(const Sample &s0, const Sample &s1,
+                                   const double ratio) {
+    const double ratio0 = 1.0 - ratio;
+    Sample sample;
+    for (std::size_t i = 0; i < N; ++i) {
+      sample[i] = s0[i] * ratio0 + s1[i] * ratio;
+    }
+    return sample;
+  }
+
+ private:
+  std::size_t Physical(const std::size_t i) const {
+    const std::size_t index = head_ + i;
+    return index < capacity() ? index : index - capacity();
+  }
+
+  std::vector<double> timestamps_;
+  std::vector<Sample> samples_;
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_TIME_SERIES_BUFFER_H_
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures timestamp lookups in a TimeSeriesBuffer versus a linear
+ *        scan of a list of shared messages, the way an adapter queue is
+ *        searched.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/util/time_series_buffer.h"
+
+DEFINE_int32(benchmark_num_lookups, 100000, "Number of lookups per size.");
+DEFINE_double(benchmark_frequency, 200.0, "Sample frequency, in Hz.");
+
+namespace apollo {
+namespace common {
+namespace util {
+namespace {
+
+typedef TimeSeriesBuffer<9> Buffer;
+
+struct Message {
+  double timestamp_sec;
+  Buffer::Sample sample;
+};
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+void Run(const int queue_size) {
+  const double dt = 1.0 / FLAGS_benchmark_frequency;
+  Buffer buffer(queue_size);
+  // The newest message is at the front, as in the adapter queue.
+  std::list<std::shared_ptr<Message>> queue;
+  for (int i = 0; i < queue_size; ++i) {
+    std::shared_ptr<Message> message(new Message);
+    message->timestamp_sec = i * dt;
+    message->sample.fill(i);
+    queue.push_front(message);
+    buffer.Push(message->timestamp_sec, message->sample);
+  }
+
+  std::mt19937 random(0);
+  std::uniform_real_distribution<double> timestamp(0.0, queue_size * dt);
+  std::vector<double> timestamps(FLAGS_benchmark_num_lookups);
+  for (double& t : timestamps) {
+    t = timestamp(random);
+  }
+
+  double checksum_list = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (const double t : timestamps) {
+    auto it = queue.begin();
+    while (it != queue.end() && (*it)->timestamp_sec > t) {
+      ++it;
+    }
+    if (it == queue.begin()) {
+      checksum_list += queue.front()->sample[0];
+      continue;
+    }
+    if (it == queue.end()) {
+      checksum_list += queue.back()->sample[0];
+      continue;
+    }
+    const Message& m0 = **it;
+    const Message& m1 = **std::prev(it);
+    const Buffer::Sample sample = Buffer::InterpolateSamples(
+        m0.sample, m1.sample,
+        (t - m0.timestamp_sec) / (m1.timestamp_sec - m0.timestamp_sec));
+    checksum_list += sample[0];
+  }
+  const double list_ms = ElapsedMs(start);
+
+  double checksum_buffer = 0.0;
+  start = std::chrono::steady_clock::now();
+  for (const double t : timestamps) {
+    Buffer::Sample sample;
+    buffer.Interpolate(t, &sample);
+    checksum_buffer += sample[0];
+  }
+  const double buffer_ms = ElapsedMs(start);
+
+  std::cout << std::setw(8) << queue_size << std::setw(14)
+            << list_ms * 1e6 / FLAGS_benchmark_num_lookups << std::setw(14)
+            << buffer_ms * 1e6 / FLAGS_benchmark_num_lookups << std::setw(16)
+            << checksum_list - checksum_buffer << std::endl;
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  std::cout << std::setw(8) << "size" << std::setw(14) << "list ns"
+            << std::setw(14) << "buffer ns" << std::setw(16) << "checksum diff"
+            << std::endl;
+  for (const int queue_size : {10, 50, 200, 1000}) {
+    apollo::common::util::Run(queue_size);
+  }
+  return 0;
+}
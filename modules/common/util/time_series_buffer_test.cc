@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/time_series_buffer.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+typedef TimeSeriesBuffer<2> Buffer;
+
+TEST(TimeSeriesBufferTest, PushAndWrap) {
+  Buffer buffer(3);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(3, buffer.capacity());
+  EXPECT_TRUE(buffer.Push(1.0, {{1.0, 10.0}}));
+  EXPECT_TRUE(buffer.Push(2.0, {{2.0, 20.0}}));
+  EXPECT_FALSE(buffer.Push(1.5, {{1.5, 15.0}}));
+  EXPECT_EQ(2, buffer.size());
+  EXPECT_TRUE(buffer.Push(3.0, {{3.0, 30.0}}));
+  EXPECT_TRUE(buffer.Push(4.0, {{4.0, 40.0}}));
+  EXPECT_TRUE(buffer.Push(5.0, {{5.0, 50.0}}));
+  EXPECT_EQ(3, buffer.size());
+  for (std::size_t i = 0; i < buffer.size(); ++i) {
+    EXPECT_DOUBLE_EQ(3.0 + i, buffer.timestamp_sec_at(i));
+    EXPECT_DOUBLE_EQ(3.0 + i, buffer.sample_at(i)[0]);
+    EXPECT_DOUBLE_EQ(30.0 + 10.0 * i, buffer.sample_at(i)[1]);
+  }
+  buffer.Clear();
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(TimeSeriesBufferTest, UpperBound) {
+  Buffer buffer(4);
+  Buffer::Sample sample;
+  EXPECT_EQ(0, buffer.UpperBound(1.0));
+  EXPECT_FALSE(buffer.Interpolate(1.0, &sample));
+  for (int i = 0; i < 6; ++i) {
+    buffer.Push(i, {{0.0, 0.0}});
+  }
+  // The buffer holds the timestamps 2, 3, 4 and 5.
+  EXPECT_EQ(0, buffer.UpperBound(1.0));
+  EXPECT_EQ(1, buffer.UpperBound(2.0));
+  EXPECT_EQ(2, buffer.UpperBound(3.5));
+  EXPECT_EQ(3, buffer.UpperBound(4.0));
+  EXPECT_EQ(4, buffer.UpperBound(5.0));
+  EXPECT_EQ(4, buffer.UpperBound(6.0));
+}
+
+TEST(TimeSeriesBufferTest, Interpolate) {
+  Buffer buffer(8);
+  buffer.Push(1.0, {{1.0, -1.0}});
+  buffer.Push(2.0, {{3.0, -3.0}});
+  buffer.Push(4.0, {{7.0, -7.0}});
+
+  Buffer::Sample sample;
+  EXPECT_TRUE(buffer.Interpolate(1.5, &sample));
+  EXPECT_DOUBLE_EQ(2.0, sample[0]);
+  EXPECT_DOUBLE_EQ(-2.0, sample[1]);
+  EXPECT_TRUE(buffer.Interpolate(3.0, &sample));
+  EXPECT_DOUBLE_EQ(5.0, sample[0]);
+  EXPECT_TRUE(buffer.Interpolate(0.0, &sample));
+  EXPECT_DOUBLE_EQ(1.0, sample[0]);
+  EXPECT_TRUE(buffer.Interpolate(5.0, &sample));
+  EXPECT_DOUBLE_EQ(7.0, sample[0]);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
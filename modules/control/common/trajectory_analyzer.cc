@@ -24,6 +24,7 @@
 #include "modules/common/math/linear_interpolation.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/search.h"
+#include "modules/common/math/vec2d.h"
 
 namespace math = apollo::common::math;
 using apollo::common::PathPoint;
@@ -33,14 +34,6 @@ namespace apollo {
 namespace control {
 namespace {
 
-// Squared distance from the point to (x, y).
-double PointDistanceSquare(const TrajectoryPoint &point, const double x,
-                           const double y) {
-  const double dx = point.path_point().x() - x;
-  const double dy = point.path_point().y() - y;
-  return dx * dx + dy * dy;
-}
-
 PathPoint TrajectoryPointToPathPoint(const TrajectoryPoint &point) {
   if (point.has_path_point()) {
     return point.path_point();
@@ -61,20 +54,20 @@ TrajectoryAnalyzer::TrajectoryAnalyzer(
     trajectory_points_.push_back(
         planning_published_trajectory->trajectory_point(i));
   }
+
+  if (!trajectory_points_.empty()) {
+    std::vector<math::Vec2d> points;
+    points.reserve(trajectory_points_.size());
+    for (const TrajectoryPoint &point : trajectory_points_) {
+      points.emplace_back(point.path_point().x(), point.path_point().y());
+    }
+    path_cursor_ = math::PathCursor(std::move(points));
+  }
 }
 
 PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
                                                     const double y) const {
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
+  const size_t index_min = path_cursor_.FindNearestIndex(x, y);
 
   size_t index_start = index_min == 0 ? index_min : index_min - 1;
   size_t index_end =
@@ -175,16 +168,7 @@ TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
 
 TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByPosition(
     const double x, const double y) const {
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
+  const size_t index_min = path_cursor_.FindNearestIndex(x, y);
   return trajectory_points_[index_min];
 }
 
@@ -26,6 +26,7 @@
 
 #include "modules/planning/proto/planning.pb.h"
 
+#include "modules/common/math/path_cursor.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 
@@ -133,6 +134,9 @@ class TrajectoryAnalyzer {
 
   std::vector<common::TrajectoryPoint> trajectory_points_;
 
+  // Finds the nearest trajectory points, starting from the last found one.
+  mutable common::math::PathCursor path_cursor_;
+
   double header_time_ = 0.0;
   unsigned int seq_num_ = 0;
 };
@@ -25,6 +25,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/control/common/control_gflags.h"
 
@@ -38,6 +39,7 @@ using apollo::common::VehicleStateProvider;
 using apollo::common::adapter::AdapterManager;
 using apollo::common::monitor::MonitorMessageItem;
 using apollo::common::time::Clock;
+using apollo::common::trace::ScopedSpan;
 using apollo::localization::LocalizationEstimate;
 using apollo::planning::ADCTrajectory;
 
@@ -219,6 +221,7 @@ Status Control::ProduceControlCommand(ControlCommand *control_command) {
 }
 
 void Control::OnTimer(const ros::TimerEvent &) {
+  ScopedSpan span("Control::OnTimer");
   double start_timestamp = Clock::NowInSeconds();
 
   if (FLAGS_is_control_test_mode && FLAGS_control_test_duration > 0 &&
@@ -232,6 +235,10 @@ void Control::OnTimer(const ros::TimerEvent &) {
   Status status = ProduceControlCommand(&control_command);
   AERROR_IF(!status.ok()) << "Failed to produce control command:"
                           << status.error_message();
+  // The trajectory carries the sensor timestamps for latency tracing.
+  span.SetOrigin(trajectory_.header());
+  apollo::common::trace::PropagateOrigin(trajectory_.header(),
+                                         control_command.mutable_header());
 
   double end_timestamp = Clock::NowInSeconds();
 
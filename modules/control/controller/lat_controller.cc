@@ -338,8 +338,16 @@ Status LatController::ComputeControlCommand(
     }
   }
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
+  // The analyzer is kept until a new trajectory arrives, so the nearest
+  // point queries start from the last matched point. In navigation mode the
+  // trajectory is moved to the current vehicle frame every cycle.
+  if (FLAGS_use_navigation_mode ||
+      trajectory_analyzer_.trajectory_points().empty() ||
+      trajectory_analyzer_.seq_num() !=
+          planning_published_trajectory->header().sequence_num()) {
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
+  }
 
   SimpleLateralDebug *debug = cmd->mutable_debug()->mutable_simple_lat_debug();
   debug->Clear();
@@ -275,8 +275,14 @@ Status MPCController::ComputeControlCommand(
     ControlCommand *cmd) {
   VehicleStateProvider::instance()->set_linear_velocity(chassis->speed_mps());
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  // The analyzer is kept until a new trajectory arrives, so the nearest
+  // point queries start from the last matched point.
+  if (trajectory_analyzer_.trajectory_points().empty() ||
+      trajectory_analyzer_.seq_num() !=
+          planning_published_trajectory->header().sequence_num()) {
+    trajectory_analyzer_ =
+        std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  }
 
   SimpleMPCDebug *debug = cmd->mutable_debug()->mutable_simple_mpc_debug();
   debug->Clear();
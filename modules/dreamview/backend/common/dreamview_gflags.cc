@@ -54,6 +54,16 @@ DEFINE_string(websocket_timeout_ms, "36000000",
               "Time span that CivetServer keeps the websocket connection alive "
               "without dropping it.");
 
+DEFINE_int32(websocket_max_queue_size, 32,
+             "Maximum number of messages queued for sending to a websocket "
+             "connection. While the queue is full, skippable messages are "
+             "dropped, and the others evict a queued skippable message or "
+             "exceed the bound.");
+
+DEFINE_int32(websocket_num_writer_threads, 4,
+             "Number of threads writing the queued messages to the websocket "
+             "connections.");
+
 DEFINE_string(ssl_certificate, "",
               "Path to the SSL certificate file. This option is only required "
               "when at least one of the listening_ports is SSL. The file must "
@@ -64,6 +74,10 @@ DEFINE_double(sim_map_radius, 200.0,
               "The radius within which Dreamview will find all the map "
               "elements around the car.");
 
+DEFINE_double(map_tile_size, 100.0,
+              "The size in meters of the square map tiles which Dreamview "
+              "caches and sends to the frontend.");
+
 DEFINE_int32(dreamview_worker_num, 1, "number of dreamview thread workers");
 
 DEFINE_bool(enable_update_size_check, true,
@@ -72,6 +86,18 @@ DEFINE_bool(enable_update_size_check, true,
 DEFINE_uint32(max_update_size, 1000000,
               "Number of max update bytes allowed to push to dreamview FE");
 
+DEFINE_int32(sim_world_delta_history_size, 10,
+             "Number of recent simulation worlds which a delta update pushed "
+             "to dreamview FE can be based on.");
+
+DEFINE_double(sim_world_max_push_interval_ms, 1000.0,
+              "The longest interval between two simulation worlds pushed to a "
+              "slow dreamview FE client.");
+
+DEFINE_string(sim_world_record_file, "",
+              "If set, the simulation worlds are appended to this file, e.g. "
+              "for the delta encoding benchmark.");
+
 DEFINE_bool(sim_world_with_routing_path, false,
             "Whether the routing_path is included in sim_world proto.");
 
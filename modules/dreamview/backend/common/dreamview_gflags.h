@@ -39,16 +39,28 @@ DECLARE_string(routing_response_file);
 
 DECLARE_string(websocket_timeout_ms);
 
+DECLARE_int32(websocket_max_queue_size);
+
+DECLARE_int32(websocket_num_writer_threads);
+
 DECLARE_string(ssl_certificate);
 
 DECLARE_double(sim_map_radius);
 
+DECLARE_double(map_tile_size);
+
 DECLARE_int32(dreamview_worker_num);
 
 DECLARE_bool(enable_update_size_check);
 
 DECLARE_uint32(max_update_size);
 
+DECLARE_int32(sim_world_delta_history_size);
+
+DECLARE_double(sim_world_max_push_interval_ms);
+
+DECLARE_string(sim_world_record_file);
+
 DECLARE_bool(sim_world_with_routing_path);
 
 DECLARE_string(request_timeout_ms);
@@ -15,11 +15,14 @@ limitations under the License.
 
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
 #include <utility>
 #include <vector>
 
 #include "modules/common/log.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/map_util.h"
 #include "modules/common/util/string_util.h"
@@ -29,11 +32,30 @@ namespace dreamview {
 
 using apollo::common::util::ContainsKey;
 using apollo::common::util::StrCat;
+using apollo::common::util::ThreadPool;
+
+WebSocketHandler::~WebSocketHandler() {
+  // Stop the writer tasks, so that the writer threads can be joined.
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (auto &kv : connections_) {
+    ConnectionState *state = kv.second.get();
+    {
+      std::unique_lock<std::mutex> write_lock(state->write_mutex);
+      state->is_closed = true;
+    }
+    std::unique_lock<std::mutex> state_lock(state->mutex);
+    state->queue.clear();
+  }
+}
 
 void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    connections_.emplace(conn, std::make_shared<std::mutex>());
+    if (writer_pool_ == nullptr) {
+      writer_pool_.reset(
+          new ThreadPool(std::max(1, FLAGS_websocket_num_writer_threads)));
+    }
+    connections_.emplace(conn, std::make_shared<ConnectionState>());
     AINFO << name_ << ": Accepted connection. Total connections: "
           << connections_.size();
   }
@@ -49,17 +71,32 @@ void WebSocketHandler::handleClose(CivetServer *server,
   {
     std::unique_lock<std::mutex> lock(mutex_);
 
-    // Remove from the store of currently open connections. Copy the mutex out
+    // Remove from the store of currently open connections. Copy the state out
     // so that it won't be reclaimed during map.erase().
     Connection *connection = const_cast<Connection *>(conn);
-    std::shared_ptr<std::mutex> connection_lock = connections_[connection];
-    {
-      std::unique_lock<std::mutex> lock(*connection_lock);
-      connections_.erase(connection);
+    auto iter = connections_.find(connection);
+    if (iter != connections_.end()) {
+      std::shared_ptr<ConnectionState> state = iter->second;
+      {
+        std::unique_lock<std::mutex> write_lock(state->write_mutex);
+        state->is_closed = true;
+        connections_.erase(iter);
+      }
+      std::unique_lock<std::mutex> state_lock(state->mutex);
+      state->queue.clear();
+      AINFO << name_ << ": Sent " << state->stats.num_sent
+            << " messages to the closed connection, coalesced "
+            << state->stats.num_coalesced << ", dropped "
+            << state->stats.num_dropped;
     }
     AINFO << name_
           << ": Connection closed. Total connections: " << connections_.size();
   }
+
+  // Trigger registered closed connection handlers.
+  for (const auto handler : connection_close_handlers_) {
+    handler(conn);
+  }
 }
 
 bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
@@ -75,9 +112,13 @@ bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
     }
   }
 
+  // All the send queues share the same copy of the data.
+  Message message;
+  message.data = std::make_shared<const std::string>(data);
+  message.skippable = skippable;
   bool all_success = true;
   for (Connection *conn : connections_to_send) {
-    if (!SendData(conn, data, skippable)) {
+    if (!Enqueue(conn, message)) {
       all_success = false;
     }
   }
@@ -90,9 +131,58 @@ bool WebSocketHandler::SendBinaryData(Connection *conn, const std::string &data,
   return SendData(conn, data, skippable, WEBSOCKET_OPCODE_BINARY);
 }
 
+bool WebSocketHandler::SendBinaryData(Connection *conn,
+                                      std::shared_ptr<const std::string> data,
+                                      bool skippable) {
+  return SendData(conn, std::move(data), skippable, WEBSOCKET_OPCODE_BINARY);
+}
+
 bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
                                 bool skippable, int op_code) {
-  std::shared_ptr<std::mutex> connection_lock;
+  return SendData(conn, std::make_shared<const std::string>(data), skippable,
+                  op_code);
+}
+
+bool WebSocketHandler::SendData(Connection *conn,
+                                std::shared_ptr<const std::string> data,
+                                bool skippable, int op_code) {
+  Message message;
+  message.data = std::move(data);
+  message.op_code = op_code;
+  message.skippable = skippable;
+  return Enqueue(conn, message);
+}
+
+size_t WebSocketHandler::GetQueueSize(Connection *conn) const {
+  std::shared_ptr<ConnectionState> state;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = connections_.find(conn);
+    if (iter == connections_.end()) {
+      return 0;
+    }
+    state = iter->second;
+  }
+  std::unique_lock<std::mutex> state_lock(state->mutex);
+  return state->queue.size();
+}
+
+std::unordered_map<WebSocketHandler::Connection *,
+                   WebSocketHandler::ConnectionStats>
+WebSocketHandler::GetConnectionStats() const {
+  std::unordered_map<Connection *, ConnectionStats> stats;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (const auto &kv : connections_) {
+    std::unique_lock<std::mutex> state_lock(kv.second->mutex);
+    ConnectionStats &connection_stats = stats[kv.first];
+    connection_stats = kv.second->stats;
+    connection_stats.queue_size = kv.second->queue.size();
+  }
+  return stats;
+}
+
+bool WebSocketHandler::Enqueue(Connection *conn, const Message &message) {
+  std::shared_ptr<ConnectionState> state;
   {
     std::unique_lock<std::mutex> lock(mutex_);
     if (!ContainsKey(connections_, conn)) {
@@ -100,44 +190,98 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
              << ": Trying to send to an uncached connection, skipping.";
       return false;
     }
-    // Copy the lock so that it still exists if the connection is closed after
+    // Copy the state so that it still exists if the connection is closed after
     // this block.
-    connection_lock = connections_[conn];
+    state = connections_[conn];
   }
 
-  // Lock the connection while sending.
-  if (!connection_lock->try_lock()) {
-    // Skip sending data if:
-    // 1. Data is skippable according to sender and there's higher priority data
-    // being sent.
-    // 2. The connection has been closed.
-    if (skippable) {
-      return false;
-    } else {
-      connection_lock->lock();  // Block to acquire the lock.
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (!ContainsKey(connections_, conn)) {
+  {
+    std::unique_lock<std::mutex> state_lock(state->mutex);
+    auto &queue = state->queue;
+    // The message being sent stays at the front while a writer is scheduled,
+    // it is neither replaced nor evicted.
+    const bool is_sending = state->is_scheduled && !queue.empty();
+    const auto begin = queue.begin() + (is_sending ? 1 : 0);
+    if (message.skippable) {
+      // Replace the queued message of the same kind.
+      auto iter = std::find_if(begin, queue.end(), [&](const Message &queued) {
+        return queued.skippable && queued.op_code == message.op_code;
+      });
+      if (iter != queue.end()) {
+        *iter = message;
+        ++state->stats.num_coalesced;
+        return true;
+      }
+    }
+    if (queue.size() >=
+        static_cast<size_t>(std::max(1, FLAGS_websocket_max_queue_size))) {
+      if (message.skippable) {
+        ++state->stats.num_dropped;
+        AWARN_EVERY(100) << name_ << ": Send queue is full, dropped "
+                         << state->stats.num_dropped << " messages so far.";
         return false;
       }
+      // A message which is not skippable is always queued. It evicts the
+      // oldest queued skippable message, or exceeds the bound if there is
+      // none.
+      auto iter = std::find_if(begin, queue.end(), [](const Message &queued) {
+        return queued.skippable;
+      });
+      if (iter != queue.end()) {
+        queue.erase(iter);
+        ++state->stats.num_dropped;
+      } else {
+        AWARN_EVERY(100) << name_ << ": Send queue is full, queued "
+                         << queue.size() + 1 << " messages.";
+      }
+    }
+    queue.push_back(message);
+    if (state->is_scheduled) {
+      return true;
     }
+    state->is_scheduled = true;
   }
 
-  // Note that while we are holding the connection lock, the connection won't be
-  // closed and removed.
-  int ret;
-  PERF_BLOCK(
-      StrCat(name_, ": Writing ", data.size(), " bytes via websocket took"),
-      0.1) {
-    ret = mg_websocket_write(conn, op_code, data.c_str(), data.size());
+  writer_pool_->enqueue(&WebSocketHandler::WriteNextMessage, this, conn,
+                        state);
+  return true;
+}
+
+void WebSocketHandler::WriteNextMessage(
+    Connection *conn, std::shared_ptr<ConnectionState> state) {
+  Message message;
+  {
+    std::unique_lock<std::mutex> state_lock(state->mutex);
+    if (state->queue.empty()) {
+      state->is_scheduled = false;
+      return;
+    }
+    // The message stays at the front of the queue while being sent.
+    message = state->queue.front();
   }
-  connection_lock->unlock();
 
-  if (ret != static_cast<int>(data.size())) {
-    // When data is empty, the header length (2) is returned.
-    if (data.size() == 0 && ret == 2) {
-      return true;
+  int ret = 0;
+  {
+    // Note that while we are holding the write lock, the connection won't be
+    // closed and removed.
+    std::unique_lock<std::mutex> write_lock(state->write_mutex);
+    if (state->is_closed) {
+      std::unique_lock<std::mutex> state_lock(state->mutex);
+      state->queue.clear();
+      state->is_scheduled = false;
+      return;
     }
+    const std::string &data = *message.data;
+    PERF_BLOCK(
+        StrCat(name_, ": Writing ", data.size(), " bytes via websocket took"),
+        0.1) {
+      ret = WriteData(conn, message.op_code, data);
+    }
+  }
 
+  const std::string &data = *message.data;
+  if (ret != static_cast<int>(data.size()) && !(data.empty() && ret == 2)) {
+    // When data is empty, the header length (2) is returned.
     // Determine error message based on return value.
     std::string msg;
     if (ret == 0) {
@@ -150,10 +294,27 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
     }
     AWARN << name_
           << ": Failed to send data via websocket connection. Reason: " << msg;
-    return false;
   }
 
-  return true;
+  {
+    std::unique_lock<std::mutex> state_lock(state->mutex);
+    if (!state->queue.empty()) {
+      state->queue.pop_front();
+    }
+    ++state->stats.num_sent;
+    if (state->queue.empty()) {
+      state->is_scheduled = false;
+      return;
+    }
+  }
+  // Let the writers take turns between the connections.
+  writer_pool_->enqueue(&WebSocketHandler::WriteNextMessage, this, conn,
+                        state);
+}
+
+int WebSocketHandler::WriteData(Connection *conn, int op_code,
+                                const std::string &data) {
+  return mg_websocket_write(conn, op_code, data.c_str(), data.size());
 }
 
 thread_local unsigned char WebSocketHandler::current_opcode_ = 0x00;
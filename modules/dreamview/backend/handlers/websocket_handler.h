@@ -21,6 +21,8 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_HANDLERS_WEBSOCKET_HANDLER_H_
 #define MODULES_DREAMVIEW_BACKEND_HANDLERS_WEBSOCKET_HANDLER_H_
 
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -31,6 +33,8 @@
 #include "CivetServer.h"
 #include "third_party/json/json.hpp"
 
+#include "modules/common/util/threadpool.h"
+
 /**
  * @namespace apollo::dreamview
  * @brief apollo::dreamview
@@ -43,6 +47,15 @@ namespace dreamview {
  *
  * @brief The WebSocketHandler, built on top of CivetWebSocketHandler, is a
  * websocket handler that handles different types of websocket related events.
+ *
+ * @details The data sent to a connection is put into its bounded send queue,
+ * which is written to the connection in order by a pool of writer threads, so
+ * a slow client does not hold back the senders or the other clients. A
+ * skippable message replaces the skippable message of the same opcode which is
+ * still queued, so a slow client gets the latest one. While the queue is
+ * full, new skippable messages are dropped, and the messages which are not
+ * skippable evict a queued skippable message or exceed the bound, so they
+ * are always delivered.
  */
 class WebSocketHandler : public CivetWebSocketHandler {
   // In case of receiving fragmented message,
@@ -55,8 +68,20 @@ class WebSocketHandler : public CivetWebSocketHandler {
   using Connection = struct mg_connection;
   using MessageHandler = std::function<void(const Json &, Connection *)>;
   using ConnectionReadyHandler = std::function<void(Connection *)>;
+  using ConnectionCloseHandler = std::function<void(const Connection *)>;
+
+  // The statistics of the send queue of a connection.
+  struct ConnectionStats {
+    size_t queue_size = 0;
+    uint64_t num_sent = 0;
+    // Skippable messages replaced by a later one before being sent.
+    uint64_t num_coalesced = 0;
+    // Skippable messages dropped or evicted as the queue was full.
+    uint64_t num_dropped = 0;
+  };
 
   explicit WebSocketHandler(const std::string &name) : name_(name) {}
+  virtual ~WebSocketHandler();
 
   /**
    * @brief Callback method for when the client intends to establish a websocket
@@ -114,25 +139,50 @@ class WebSocketHandler : public CivetWebSocketHandler {
   void handleClose(CivetServer *server, const Connection *conn) override;
 
   /**
-   * @brief Sends the provided data to all the connected clients.
+   * @brief Sends the provided data to all the connected clients. The data is
+   * copied once and shared by the send queues.
    * @param data The message string to be sent.
+   * @return False if the data is dropped for any of the clients.
    */
   bool BroadcastData(const std::string &data, bool skippable = false);
 
   /**
-   * @brief Sends the provided data to a specific connected client.
+   * @brief Queues the provided data to be sent to a specific connected client.
    *
    * @param conn The connection to send to.
    * @param data The message string to be sent.
-   * @param skippable whether the data is allowed to be skipped if some other is
-   * being sent to this connection.
+   * @param skippable whether the data is allowed to be replaced by a later one
+   * if it is not sent yet, or to be dropped while the queue is full.
+   * @return False if the connection is unknown or the data is dropped.
    */
   bool SendData(Connection *conn, const std::string &data,
                 bool skippable = false, int op_code = WEBSOCKET_OPCODE_TEXT);
 
+  /**
+   * @brief Queues the provided data without copying it. The data must not be
+   * modified afterwards.
+   */
+  bool SendData(Connection *conn, std::shared_ptr<const std::string> data,
+                bool skippable = false, int op_code = WEBSOCKET_OPCODE_TEXT);
+
   bool SendBinaryData(Connection *conn, const std::string &data,
                       bool skippable = false);
 
+  bool SendBinaryData(Connection *conn,
+                      std::shared_ptr<const std::string> data,
+                      bool skippable = false);
+
+  /**
+   * @brief Returns the number of messages queued for a connection, including
+   * the one being sent.
+   */
+  size_t GetQueueSize(Connection *conn) const;
+
+  /**
+   * @brief Returns the send queue statistics of all the connections.
+   */
+  std::unordered_map<Connection *, ConnectionStats> GetConnectionStats() const;
+
   /**
    * @brief Add a new message handler for a message type.
    * @param type The name/key to identify the message type.
@@ -150,7 +200,49 @@ class WebSocketHandler : public CivetWebSocketHandler {
     connection_ready_handlers_.emplace_back(handler);
   }
 
+  /**
+   * @brief Add a new handler for closed connections.
+   * @param handler The function to handle the closed connection.
+   */
+  void RegisterConnectionCloseHandler(ConnectionCloseHandler handler) {
+    connection_close_handlers_.emplace_back(handler);
+  }
+
+ protected:
+  /**
+   * @brief Writes the data to the connection, called by the writer threads.
+   * @return The number of bytes written, as mg_websocket_write.
+   */
+  virtual int WriteData(Connection *conn, int op_code,
+                        const std::string &data);
+
  private:
+  struct Message {
+    std::shared_ptr<const std::string> data;
+    int op_code = WEBSOCKET_OPCODE_TEXT;
+    bool skippable = false;
+  };
+
+  // The send queue of a connection.
+  struct ConnectionState {
+    // The mutex guarding the queue and the statistics.
+    std::mutex mutex;
+    std::deque<Message> queue;
+    // Whether a writer task is scheduled for the connection, so that its
+    // messages are written in order by one writer at a time.
+    bool is_scheduled = false;
+    ConnectionStats stats;
+
+    // The mutex held while writing, so that the connection won't be closed
+    // and removed in the middle.
+    std::mutex write_mutex;
+    bool is_closed = false;
+  };
+
+  bool Enqueue(Connection *conn, const Message &message);
+  void WriteNextMessage(Connection *conn,
+                        std::shared_ptr<ConnectionState> state);
+
   const std::string name_;
 
   // Message handlers keyed by message type.
@@ -158,14 +250,21 @@ class WebSocketHandler : public CivetWebSocketHandler {
   // New connection ready handlers.
   std::vector<ConnectionReadyHandler> connection_ready_handlers_;
 
+  // Closed connection handlers.
+  std::vector<ConnectionCloseHandler> connection_close_handlers_;
+
   // The mutex guarding the connection set. We are not using read
   // write lock, as the server is not expected to get many clients
   // (connections).
   mutable std::mutex mutex_;
 
-  // The pool of all maintained connections. Each connection has a lock to
-  // against simultaneous write.
-  std::unordered_map<Connection *, std::shared_ptr<std::mutex>> connections_;
+  // The pool of all maintained connections, with their send queues.
+  std::unordered_map<Connection *, std::shared_ptr<ConnectionState>>
+      connections_;
+
+  // The writer threads, started with the first connection. Declared last so
+  // that they are joined before the other members are destroyed.
+  std::unique_ptr<apollo::common::util::ThreadPool> writer_pool_;
 };
 
 }  // namespace dreamview
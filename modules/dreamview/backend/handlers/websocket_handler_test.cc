@@ -16,10 +16,13 @@ limitations under the License.
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 
 #include <chrono>
+#include <condition_variable>
+#include <map>
 #include <string>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "modules/common/log.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 
 using ::testing::ElementsAre;
 
@@ -103,5 +106,161 @@ TEST(WebSocketTest, handleData) {
       handler.handleData(&server, conn, 0x81, data_char, data.length()));
 }
 
+// A handler which records the data written to fake connections, and takes
+// a given time to write to each of them.
+class RecordingWebSocketHandler : public WebSocketHandler {
+ public:
+  RecordingWebSocketHandler() : WebSocketHandler("Recording") {}
+
+  void SetWriteTime(Connection *conn, std::chrono::milliseconds write_time) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    write_times_[conn] = write_time;
+  }
+
+  std::vector<std::string> GetWrittenData(Connection *conn) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return written_data_[conn];
+  }
+
+  void WaitForWrites(Connection *conn, size_t num_writes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_.wait_for(lock, std::chrono::seconds(5), [&] {
+      return written_data_[conn].size() >= num_writes;
+    });
+  }
+
+ protected:
+  int WriteData(Connection *conn, int op_code,
+                const std::string &data) override {
+    std::chrono::milliseconds write_time;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      write_time = write_times_[conn];
+    }
+    std::this_thread::sleep_for(write_time);
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_data_[conn].push_back(data);
+    written_.notify_all();
+    return data.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable written_;
+  std::map<Connection *, std::chrono::milliseconds> write_times_;
+  std::map<Connection *, std::vector<std::string>> written_data_;
+};
+
+TEST(WebSocketTest, SlowConsumer) {
+  RecordingWebSocketHandler recording_handler;
+  int fake_connections[2];
+  auto *fast = reinterpret_cast<mg_connection *>(&fake_connections[0]);
+  auto *slow = reinterpret_cast<mg_connection *>(&fake_connections[1]);
+  recording_handler.SetWriteTime(fast, std::chrono::milliseconds(1));
+  recording_handler.SetWriteTime(slow, std::chrono::milliseconds(50));
+  recording_handler.handleReadyState(nullptr, fast);
+  recording_handler.handleReadyState(nullptr, slow);
+
+  // Broadcast at 100Hz, which the slow client can't keep up with.
+  const int kNumFrames = 50;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_TRUE(recording_handler.BroadcastData(std::to_string(i), true));
+    std::this_thread::sleep_until(start + std::chrono::milliseconds(10 * i));
+  }
+  // The broadcasting thread is not blocked by the slow client.
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(10 * kNumFrames + 100));
+
+  // The fast client gets every frame.
+  recording_handler.WaitForWrites(fast, kNumFrames);
+  std::vector<std::string> fast_data = recording_handler.GetWrittenData(fast);
+  ASSERT_EQ(kNumFrames, fast_data.size());
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(std::to_string(i), fast_data[i]);
+  }
+
+  // The slow client skips frames, and still gets the latest one in the end.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  std::vector<std::string> slow_data = recording_handler.GetWrittenData(slow);
+  EXPECT_LT(slow_data.size(), kNumFrames / 2);
+  ASSERT_FALSE(slow_data.empty());
+  EXPECT_EQ(std::to_string(kNumFrames - 1), slow_data.back());
+
+  auto stats = recording_handler.GetConnectionStats();
+  EXPECT_EQ(0, stats[fast].queue_size);
+  EXPECT_EQ(kNumFrames, stats[fast].num_sent);
+  EXPECT_EQ(0, stats[slow].queue_size);
+  EXPECT_EQ(slow_data.size(), stats[slow].num_sent);
+  EXPECT_EQ(kNumFrames, stats[slow].num_sent + stats[slow].num_coalesced);
+  EXPECT_EQ(0, stats[slow].num_dropped);
+}
+
+TEST(WebSocketTest, BoundedQueue) {
+  RecordingWebSocketHandler recording_handler;
+  int fake_connection;
+  auto *conn = reinterpret_cast<mg_connection *>(&fake_connection);
+  recording_handler.SetWriteTime(conn, std::chrono::milliseconds(100));
+  recording_handler.handleReadyState(nullptr, conn);
+
+  // Fill the queue with the messages which are not skippable.
+  const int kMaxQueueSize = FLAGS_websocket_max_queue_size;
+  for (int i = 0; i < kMaxQueueSize; ++i) {
+    EXPECT_TRUE(recording_handler.SendData(conn, std::to_string(i)));
+  }
+  EXPECT_EQ(kMaxQueueSize, recording_handler.GetQueueSize(conn));
+
+  // A skippable message is dropped while the queue is full, but a message
+  // which is not skippable exceeds the bound.
+  EXPECT_FALSE(recording_handler.SendData(conn, "skippable", true));
+  EXPECT_EQ(1, recording_handler.GetConnectionStats()[conn].num_dropped);
+  EXPECT_TRUE(recording_handler.SendData(conn, "not skippable"));
+  EXPECT_EQ(kMaxQueueSize + 1, recording_handler.GetQueueSize(conn));
+
+  recording_handler.SetWriteTime(conn, std::chrono::milliseconds(0));
+  recording_handler.WaitForWrites(conn, kMaxQueueSize + 1);
+  std::vector<std::string> data = recording_handler.GetWrittenData(conn);
+  ASSERT_EQ(kMaxQueueSize + 1, data.size());
+  for (int i = 0; i < kMaxQueueSize; ++i) {
+    EXPECT_EQ(std::to_string(i), data[i]);
+  }
+  EXPECT_EQ("not skippable", data.back());
+
+  // Closed connections are not sent to.
+  recording_handler.handleClose(nullptr, conn);
+  EXPECT_FALSE(recording_handler.SendData(conn, "closed"));
+  EXPECT_EQ(0, recording_handler.GetQueueSize(conn));
+}
+
+TEST(WebSocketTest, SlowConsumerGetsNotSkippableMessages) {
+  RecordingWebSocketHandler recording_handler;
+  int fake_connection;
+  auto *conn = reinterpret_cast<mg_connection *>(&fake_connection);
+  recording_handler.SetWriteTime(conn, std::chrono::milliseconds(100));
+  recording_handler.handleReadyState(nullptr, conn);
+
+  // A full queue of responses and the latest frame of each kind.
+  const int kMaxQueueSize = FLAGS_websocket_max_queue_size;
+  for (int i = 0; i < kMaxQueueSize - 2; ++i) {
+    EXPECT_TRUE(recording_handler.SendData(conn, std::to_string(i)));
+  }
+  EXPECT_TRUE(recording_handler.SendData(conn, "text frame", true));
+  EXPECT_TRUE(recording_handler.SendBinaryData(conn, "binary frame", true));
+  EXPECT_EQ(kMaxQueueSize, recording_handler.GetQueueSize(conn));
+
+  // A response evicts the oldest frame, and the bound holds.
+  EXPECT_TRUE(recording_handler.SendData(conn, "response"));
+  EXPECT_EQ(kMaxQueueSize, recording_handler.GetQueueSize(conn));
+  EXPECT_EQ(1, recording_handler.GetConnectionStats()[conn].num_dropped);
+
+  recording_handler.SetWriteTime(conn, std::chrono::milliseconds(0));
+  recording_handler.WaitForWrites(conn, kMaxQueueSize);
+  std::vector<std::string> data = recording_handler.GetWrittenData(conn);
+  ASSERT_EQ(kMaxQueueSize, data.size());
+  EXPECT_EQ(std::to_string(kMaxQueueSize - 3), data[kMaxQueueSize - 3]);
+  EXPECT_EQ("binary frame", data[kMaxQueueSize - 2]);
+  EXPECT_EQ("response", data.back());
+}
+
 }  // namespace dreamview
 }  // namespace apollo
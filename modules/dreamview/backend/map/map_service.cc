@@ -17,10 +17,13 @@
 #include "modules/dreamview/backend/map/map_service.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <sstream>
 
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
@@ -103,6 +106,36 @@ void ExtractRoadAndLaneIds(const std::vector<LaneInfoConstPtr> &lanes,
   std::sort(road_ids->begin(), road_ids->end());
 }
 
+void SortAndRemoveDuplicates(RepeatedPtrField<std::string> *ids) {
+  std::sort(ids->begin(), ids->end());
+  ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+}
+
+// Sorts the ids of each kind, which may be repeated after merging the ids of
+// several tiles.
+void SortAndRemoveDuplicates(MapElementIds *ids) {
+  SortAndRemoveDuplicates(ids->mutable_lane());
+  SortAndRemoveDuplicates(ids->mutable_crosswalk());
+  SortAndRemoveDuplicates(ids->mutable_junction());
+  SortAndRemoveDuplicates(ids->mutable_signal());
+  SortAndRemoveDuplicates(ids->mutable_stop_sign());
+  SortAndRemoveDuplicates(ids->mutable_yield());
+  SortAndRemoveDuplicates(ids->mutable_overlap());
+  SortAndRemoveDuplicates(ids->mutable_road());
+  SortAndRemoveDuplicates(ids->mutable_clear_area());
+}
+
+// A tile id is "<x>_<y>", the indices of the tile along x and y.
+std::string TileId(const int x, const int y) {
+  return std::to_string(x) + "_" + std::to_string(y);
+}
+
+bool ParseTileId(const std::string &tile_id, int *x, int *y) {
+  std::istringstream stream(tile_id);
+  char separator = 0;
+  return stream >> *x >> separator >> *y && separator == '_' && stream.eof();
+}
+
 }  // namespace
 
 const char MapService::kMetaFileName[] = "/metaInfo.json";
@@ -120,6 +153,10 @@ bool MapService::ReloadMap(bool force_reload) {
 
   // Update the x,y-offsets if present.
   UpdateOffsets();
+
+  std::lock_guard<std::mutex> lock(tiles_mutex_);
+  tiles_.clear();
+  ++tiles_generation_;
   return ret;
 }
 
@@ -232,6 +269,79 @@ void MapService::CollectMapElementIds(const PointENU &point, double radius,
   ExtractIds(yield_signs, ids->mutable_yield());
 }
 
+void MapService::CollectMapTiles(const PointENU &point, double radius,
+                                 RepeatedPtrField<std::string> *tile_ids,
+                                 MapElementIds *ids) const {
+  if (!MapReady()) {
+    return;
+  }
+  const double size = FLAGS_map_tile_size;
+  const int min_x = static_cast<int>(std::floor((point.x() - radius) / size));
+  const int max_x = static_cast<int>(std::floor((point.x() + radius) / size));
+  const int min_y = static_cast<int>(std::floor((point.y() - radius) / size));
+  const int max_y = static_cast<int>(std::floor((point.y() + radius) / size));
+  for (int x = min_x; x <= max_x; ++x) {
+    for (int y = min_y; y <= max_y; ++y) {
+      // Skip the tiles at the corners, which are out of the circle.
+      const double dx =
+          std::max({x * size - point.x(), point.x() - (x + 1) * size, 0.0});
+      const double dy =
+          std::max({y * size - point.y(), point.y() - (y + 1) * size, 0.0});
+      if (dx * dx + dy * dy > radius * radius) {
+        continue;
+      }
+      const auto tile = GetMapTile(x, y);
+      tile_ids->Add()->assign(tile->id);
+      ids->MergeFrom(tile->ids);
+    }
+  }
+  SortAndRemoveDuplicates(ids);
+}
+
+std::shared_ptr<const std::string> MapService::RetrieveMapTile(
+    const std::string &tile_id) const {
+  int x = 0;
+  int y = 0;
+  if (!MapReady() || !ParseTileId(tile_id, &x, &y)) {
+    return nullptr;
+  }
+  return GetMapTile(x, y)->data;
+}
+
+std::shared_ptr<const MapService::MapTile> MapService::GetMapTile(
+    const int x, const int y) const {
+  const std::string tile_id = TileId(x, y);
+  uint64_t generation = 0;
+  {
+    std::lock_guard<std::mutex> lock(tiles_mutex_);
+    auto iter = tiles_.find(tile_id);
+    if (iter != tiles_.end()) {
+      return iter->second;
+    }
+    generation = tiles_generation_;
+  }
+
+  // Build the tile out of the lock from the elements within its circumcircle,
+  // so the elements crossing the tile are in it too.
+  const double size = FLAGS_map_tile_size;
+  PointENU center;
+  center.set_x((x + 0.5) * size);
+  center.set_y((y + 0.5) * size);
+  auto tile = std::make_shared<MapTile>();
+  tile->id = tile_id;
+  CollectMapElementIds(center, size * M_SQRT1_2, &tile->ids);
+  SortAndRemoveDuplicates(&tile->ids);
+  auto data = std::make_shared<std::string>();
+  RetrieveMapElements(tile->ids).SerializeToString(data.get());
+  tile->data = data;
+
+  std::lock_guard<std::mutex> lock(tiles_mutex_);
+  if (generation != tiles_generation_) {
+    return tile;
+  }
+  return tiles_.emplace(tile_id, tile).first->second;
+}
+
 Map MapService::RetrieveMapElements(const MapElementIds &ids) const {
   boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
 
@@ -21,7 +21,11 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 #define MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "boost/thread/locks.hpp"
@@ -52,6 +56,26 @@ class MapService {
   void CollectMapElementIds(const apollo::common::PointENU &point,
                             double raidus, MapElementIds *ids) const;
 
+  /**
+   * @brief Collects the ids of the map tiles within the radius of the point,
+   * and the ids of the map elements in these tiles. The tiles are squares of
+   * FLAGS_map_tile_size meters, and are cached at the first use.
+   */
+  void CollectMapTiles(
+      const apollo::common::PointENU &point, double radius,
+      google::protobuf::RepeatedPtrField<std::string> *tile_ids,
+      MapElementIds *ids) const;
+
+  /**
+   * @brief Returns the serialized hdmap::Map of the elements in a tile, as
+   * returned by RetrieveMapElements. The tile is built at the first request
+   * and served from the cache until the map is reloaded. The tiles can be
+   * concatenated into one serialized hdmap::Map.
+   * @return nullptr if the tile id is malformed or the map is not ready.
+   */
+  std::shared_ptr<const std::string> RetrieveMapTile(
+      const std::string &tile_id) const;
+
   bool GetPathsFromRouting(const apollo::routing::RoutingResponse &routing,
                            std::vector<apollo::hdmap::Path> *paths) const;
 
@@ -94,6 +118,13 @@ class MapService {
   bool AddPathFromPassageRegion(const routing::Passage &passage_region,
                                 std::vector<apollo::hdmap::Path> *paths) const;
 
+  struct MapTile {
+    std::string id;
+    MapElementIds ids;
+    std::shared_ptr<const std::string> data;
+  };
+  std::shared_ptr<const MapTile> GetMapTile(const int x, const int y) const;
+
   static const char kMetaFileName[];
 
   const bool use_sim_map_;
@@ -107,6 +138,14 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  // The cache of the map tiles, keyed by tile id.
+  mutable std::mutex tiles_mutex_;
+  mutable std::unordered_map<std::string, std::shared_ptr<const MapTile>>
+      tiles_;
+  // Incremented when the map is reloaded, so that the tiles built from the
+  // former map are not cached.
+  uint64_t tiles_generation_ = 0;
 };
 
 }  // namespace dreamview
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the CPU time the backend spends on the map requests of the
+ *        frontend along a drive, when the elements within the radius are
+ *        collected, retrieved and serialized at every request, versus when
+ *        they are served from the cached map tiles of MapService. The map is
+ *        the one of --map_dir, and the car drives straight from the start
+ *        point of Sim Control along the heading of its lane.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
+#include "modules/dreamview/backend/map/map_service.h"
+
+DEFINE_bool(benchmark_use_sim_map, true,
+            "Whether to use the downsampled map, as Dreamview does.");
+DEFINE_int32(benchmark_num_requests, 1000, "Number of map requests.");
+DEFINE_double(benchmark_step, 2.0,
+              "Distance in meters driven between two requests.");
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+using apollo::common::PointENU;
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+int Run() {
+  MapService map_service(FLAGS_benchmark_use_sim_map);
+  PointENU start_point;
+  double heading = 0.0;
+  double s = 0.0;
+  if (!map_service.GetStartPoint(&start_point) ||
+      !map_service.GetPoseWithRegardToLane(start_point.x(), start_point.y(),
+                                           &heading, &s)) {
+    std::cerr << "Failed to find a start point in " << FLAGS_map_dir
+              << std::endl;
+    return 1;
+  }
+  std::vector<PointENU> points;
+  for (int i = 0; i < FLAGS_benchmark_num_requests; ++i) {
+    PointENU point;
+    point.set_x(start_point.x() + i * FLAGS_benchmark_step * std::cos(heading));
+    point.set_y(start_point.y() + i * FLAGS_benchmark_step * std::sin(heading));
+    points.push_back(point);
+  }
+  const double radius = FLAGS_sim_map_radius;
+
+  // The former way, where every request queries the map.
+  size_t radius_bytes = 0;
+  std::string data;
+  auto start = std::chrono::steady_clock::now();
+  for (const PointENU &point : points) {
+    MapElementIds ids;
+    map_service.CollectMapElementIds(point, radius, &ids);
+    map_service.RetrieveMapElements(ids).SerializeToString(&data);
+    radius_bytes += data.size();
+  }
+  const double radius_ms = ElapsedMs(start);
+
+  // The tiles are built by the first pass along the drive, and served from
+  // the cache by the second one. The bytes count all the tiles around the
+  // car, while the frontend only fetches the ones it does not have yet.
+  double tile_ms[2] = {0.0, 0.0};
+  size_t tile_bytes = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    tile_bytes = 0;
+    start = std::chrono::steady_clock::now();
+    for (const PointENU &point : points) {
+      google::protobuf::RepeatedPtrField<std::string> tile_ids;
+      MapElementIds ids;
+      map_service.CollectMapTiles(point, radius, &tile_ids, &ids);
+      data.clear();
+      for (const std::string &tile_id : tile_ids) {
+        data.append(*map_service.RetrieveMapTile(tile_id));
+      }
+      tile_bytes += data.size();
+    }
+    tile_ms[pass] = ElapsedMs(start);
+  }
+
+  const size_t num_requests = points.size();
+  std::cout << "requests: " << num_requests << ", radius: " << radius
+            << "m, tile size: " << FLAGS_map_tile_size << "m" << std::endl
+            << std::fixed << std::setprecision(3)
+            << "radius query:      " << radius_ms / num_requests
+            << " ms/request, " << radius_bytes / 1024.0 / num_requests
+            << " KB/request" << std::endl
+            << "tiles, first pass: " << tile_ms[0] / num_requests
+            << " ms/request" << std::endl
+            << "tiles, cached:     " << tile_ms[1] / num_requests
+            << " ms/request, " << tile_bytes / 1024.0 / num_requests
+            << " KB/request" << std::endl;
+  return 0;
+}
+
+}  // namespace
+}  // namespace dreamview
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::dreamview::Run();
+}
@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/map/map_service.h"
 
+#include <algorithm>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -65,6 +67,47 @@ TEST_F(MapServiceTest, RetrieveMapElements) {
   EXPECT_EQ("l1", map.lane(0).id().id());
 }
 
+TEST_F(MapServiceTest, CollectMapTiles) {
+  PointENU p;
+  p.set_x(-1826.0);
+  p.set_y(-3027.0);
+  google::protobuf::RepeatedPtrField<std::string> tile_ids;
+  MapElementIds map_element_ids;
+  map_service->CollectMapTiles(p, 150.0, &tile_ids, &map_element_ids);
+
+  // The 4x4 tiles of 100m around the point, but the corner out of the circle.
+  EXPECT_EQ(15, tile_ids.size());
+  EXPECT_EQ(1, std::count(tile_ids.begin(), tile_ids.end(), "-19_-31"));
+  EXPECT_EQ(0, std::count(tile_ids.begin(), tile_ids.end(), "-17_-29"));
+  EXPECT_EQ(1, map_element_ids.lane_size());
+  EXPECT_EQ("l1", map_element_ids.lane(0));
+}
+
+TEST_F(MapServiceTest, RetrieveMapTile) {
+  const auto tile = map_service->RetrieveMapTile("-19_-31");
+  ASSERT_NE(nullptr, tile);
+  Map map;
+  ASSERT_TRUE(map.ParseFromString(*tile));
+  EXPECT_EQ(1, map.lane_size());
+  EXPECT_EQ("l1", map.lane(0).id().id());
+
+  // The tile is cached until the map is reloaded.
+  EXPECT_EQ(tile, map_service->RetrieveMapTile("-19_-31"));
+  EXPECT_TRUE(map_service->ReloadMap(false));
+  const auto reloaded_tile = map_service->RetrieveMapTile("-19_-31");
+  ASSERT_NE(nullptr, reloaded_tile);
+  EXPECT_NE(tile, reloaded_tile);
+  EXPECT_EQ(*tile, *reloaded_tile);
+
+  const auto empty_tile = map_service->RetrieveMapTile("0_0");
+  ASSERT_NE(nullptr, empty_tile);
+  EXPECT_TRUE(empty_tile->empty());
+
+  EXPECT_EQ(nullptr, map_service->RetrieveMapTile("-19"));
+  EXPECT_EQ(nullptr, map_service->RetrieveMapTile("-19_-31_0"));
+  EXPECT_EQ(nullptr, map_service->RetrieveMapTile("lane"));
+}
+
 TEST_F(MapServiceTest, GetStartPoint) {
   PointENU start_point;
   EXPECT_TRUE(map_service->GetStartPoint(&start_point));
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_encoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+// The voxel indices are packed into 21 bits each, which is more than 600km
+// with voxels of 0.3m.
+constexpr int64_t kIndexBias = 1 << 20;
+constexpr int64_t kIndexMask = (1 << 21) - 1;
+
+float ReadFloat(const uint8_t *data) {
+  float value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// std::floor is a library call unless SSE4.1 is enabled.
+int64_t FloorToInt(const double value) {
+  const int64_t truncated = static_cast<int64_t>(value);
+  return value < truncated ? truncated - 1 : truncated;
+}
+
+void WriteInt16(const int value, char *data) {
+  const uint16_t bits = static_cast<uint16_t>(static_cast<int16_t>(value));
+  data[0] = static_cast<char>(bits & 0xff);
+  data[1] = static_cast<char>(bits >> 8);
+}
+
+}  // namespace
+
+PointCloudEncoder::PointCloudEncoder(const double leaf_size,
+                                     const double leaf_height,
+                                     const double resolution,
+                                     const double height_offset)
+    : inverse_leaf_size_(1.0 / leaf_size),
+      inverse_leaf_height_(1.0 / leaf_height),
+      resolution_(resolution),
+      height_offset_(height_offset) {}
+
+PointCloudEncoder::Voxel *PointCloudEncoder::FindOrAddVoxel(
+    const uint64_t key) {
+  uint64_t slot = FindSlot(key);
+  if (slots_[slot].index >= 0) {
+    return &voxels_[slots_[slot].index];
+  }
+  // Keep the load factor of the hash table under 0.5.
+  if (2 * (voxels_.size() + 1) > slots_.size()) {
+    ResizeSlots(2 * slots_.size());
+    slot = FindSlot(key);
+  }
+  slots_[slot].key = key;
+  slots_[slot].index = static_cast<int>(voxels_.size());
+  voxels_.emplace_back();
+  return &voxels_.back();
+}
+
+uint64_t PointCloudEncoder::FindSlot(const uint64_t key) const {
+  uint64_t slot = ((key * 0x9E3779B97F4A7C15ULL) >> 32) & slot_mask_;
+  while (slots_[slot].index >= 0 && slots_[slot].key != key) {
+    slot = (slot + 1) & slot_mask_;
+  }
+  return slot;
+}
+
+void PointCloudEncoder::ResizeSlots(const size_t num_slots) {
+  std::vector<Slot> slots(num_slots, Slot{0, -1});
+  slots_.swap(slots);
+  slot_mask_ = num_slots - 1;
+  for (const Slot &slot : slots) {
+    if (slot.index >= 0) {
+      slots_[FindSlot(slot.key)] = slot;
+    }
+  }
+}
+
+size_t PointCloudEncoder::Encode(const uint8_t *data, const size_t num_points,
+                                 const size_t point_step,
+                                 const size_t x_offset, const size_t y_offset,
+                                 const size_t z_offset,
+                                 PointCloud *point_cloud) {
+  // Start with the hash table size of the last frame, which has about as
+  // many voxels.
+  std::fill(slots_.begin(), slots_.end(), Slot{0, -1});
+  if (slots_.empty()) {
+    ResizeSlots(1024);
+  }
+  voxels_.clear();
+
+  // Skip the points out of the range of the quantized coordinates, which
+  // skips NaN as well.
+  const double max_value = std::numeric_limits<int16_t>::max() * resolution_;
+  for (size_t i = 0; i < num_points; ++i) {
+    const uint8_t *point = data + i * point_step;
+    const float x = ReadFloat(point + x_offset);
+    const float y = ReadFloat(point + y_offset);
+    const float z = ReadFloat(point + z_offset);
+    if (!(std::fabs(x) <= max_value && std::fabs(y) <= max_value &&
+          std::fabs(z + height_offset_) <= max_value)) {
+      continue;
+    }
+    const int64_t ix = FloorToInt(x * inverse_leaf_size_) + kIndexBias;
+    const int64_t iy = FloorToInt(y * inverse_leaf_size_) + kIndexBias;
+    const int64_t iz = FloorToInt(z * inverse_leaf_height_) + kIndexBias;
+    if (((ix | iy | iz) & ~kIndexMask) != 0) {
+      continue;
+    }
+    Voxel *voxel = FindOrAddVoxel(static_cast<uint64_t>(ix) << 42 |
+                                  static_cast<uint64_t>(iy) << 21 |
+                                  static_cast<uint64_t>(iz));
+    voxel->x += x;
+    voxel->y += y;
+    voxel->z += z;
+    ++voxel->num_points;
+  }
+
+  std::string *bytes = point_cloud->mutable_quantized_points();
+  bytes->resize(voxels_.size() * 3 * sizeof(int16_t));
+  char *output = &(*bytes)[0];
+  for (const Voxel &voxel : voxels_) {
+    const double x = voxel.x / voxel.num_points;
+    const double y = voxel.y / voxel.num_points;
+    const double z = voxel.z / voxel.num_points + height_offset_;
+    WriteInt16(static_cast<int>(std::lround(x / resolution_)), output);
+    WriteInt16(static_cast<int>(std::lround(y / resolution_)), output + 2);
+    WriteInt16(static_cast<int>(std::lround(z / resolution_)), output + 4);
+    output += 3 * sizeof(int16_t);
+  }
+  point_cloud->set_resolution(resolution_);
+  return voxels_.size();
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_ENCODER_H_
+#define MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_ENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "modules/dreamview/proto/point_cloud.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class PointCloudEncoder
+ * @brief Downsamples a point cloud to the centroids of its voxels, as
+ * pcl::VoxelGrid, and encodes them for the frontend.
+ *
+ * The points are read straight from the raw buffer of the point cloud and
+ * put into the voxels of a hash grid in one pass. The centroids, which are
+ * relative to the sensor, are quantized to 16-bit integers. The buffers are
+ * reused between frames, so an instance should not be shared by threads.
+ */
+class PointCloudEncoder {
+ public:
+  /**
+   * @brief Constructor of PointCloudEncoder.
+   * @param leaf_size the size of the voxels along x and y in meters.
+   * @param leaf_height the size of the voxels along z in meters.
+   * @param resolution the resolution of the quantized points in meters.
+   * @param height_offset the offset added to z, the height of the sensor.
+   */
+  PointCloudEncoder(const double leaf_size, const double leaf_height,
+                    const double resolution, const double height_offset);
+
+  /**
+   * @brief Encodes the points of a raw point cloud buffer.
+   * @param data the buffer of the points.
+   * @param num_points the number of points in the buffer.
+   * @param point_step the number of bytes between two points.
+   * @param x_offset the offset of the float x in a point, likewise for y and
+   * z. The floats must lie within point_step bytes.
+   * @param point_cloud the encoded points, as little endian int16 x, y and z
+   * in units of the resolution.
+   * @return The number of encoded points.
+   */
+  size_t Encode(const uint8_t *data, const size_t num_points,
+                const size_t point_step, const size_t x_offset,
+                const size_t y_offset, const size_t z_offset,
+                PointCloud *point_cloud);
+
+ private:
+  struct Voxel {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    int num_points = 0;
+  };
+
+  Voxel *FindOrAddVoxel(const uint64_t key);
+  // Returns the slot of the key, or the empty slot to put it in.
+  uint64_t FindSlot(const uint64_t key) const;
+  void ResizeSlots(const size_t num_slots);
+
+  const double inverse_leaf_size_;
+  const double inverse_leaf_height_;
+  const double resolution_;
+  const double height_offset_;
+
+  // The open addressing hash table of the voxels, with the keys in the slots
+  // so that probing does not touch the voxels.
+  struct Slot {
+    uint64_t key;
+    // The index in voxels_, or -1 for an empty slot.
+    int index;
+  };
+  std::vector<Slot> slots_;
+  uint64_t slot_mask_ = 0;
+  std::vector<Voxel> voxels_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_ENCODER_H_
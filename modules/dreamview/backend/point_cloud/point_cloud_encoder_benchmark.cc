@@ -0,0 +1,311 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the CPU time and the bytes per frame of the point cloud
+ *        pushed to frontend, when converted to PCL, filtered by
+ *        pcl::VoxelGrid and sent as floats, versus encoded by
+ *        PointCloudEncoder. The frames are sweeps of a 64 beam lidar among
+ *        the ground, walls and cars.
+ *
+ *        A copy of the sort based filter of pcl::VoxelGrid is measured as
+ *        well, so that the comparison does not depend on the PCL build.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "pcl/filters/voxel_grid.h"
+#include "pcl_conversions/pcl_conversions.h"
+#include "sensor_msgs/PointCloud2.h"
+
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
+#include "modules/dreamview/backend/point_cloud/point_cloud_encoder.h"
+
+DEFINE_int32(benchmark_num_frames, 50, "Number of lidar sweeps.");
+DEFINE_int32(benchmark_num_columns, 1800, "Number of firings per sweep.");
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+// A point as in the point clouds of the velodyne driver.
+struct RawPoint {
+  float x;
+  float y;
+  float z;
+  float intensity;
+  double timestamp;
+};
+
+void AddField(const std::string &name, const uint32_t offset,
+              const uint8_t datatype, sensor_msgs::PointCloud2 *cloud) {
+  sensor_msgs::PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  cloud->fields.push_back(field);
+}
+
+// The range of a beam to the ground 1.9m below, to a wall along the road or
+// to a car, whichever is the nearest.
+double Range(const double azimuth, const double elevation, const int frame,
+             std::mt19937 *random) {
+  std::normal_distribution<double> noise(0.0, 0.02);
+  double range = 120.0;
+  if (elevation < 0.0) {
+    range = std::min(range, 1.9 / std::sin(-elevation));
+  }
+  const double y = std::sin(azimuth);
+  if (std::fabs(y) > 1e-3) {
+    range = std::min(range, 12.0 / std::fabs(y));
+  }
+  // Cars in front of and behind the ego car, moving away slowly.
+  const double x = std::cos(azimuth);
+  if (std::fabs(y / x) < 0.1 && elevation > -0.2) {
+    range = std::min(range, 15.0 + 0.1 * frame);
+  }
+  return range + noise(*random);
+}
+
+sensor_msgs::PointCloud2 CreateSweep(const int frame, std::mt19937 *random) {
+  sensor_msgs::PointCloud2 cloud;
+  AddField("x", offsetof(RawPoint, x), sensor_msgs::PointField::FLOAT32,
+           &cloud);
+  AddField("y", offsetof(RawPoint, y), sensor_msgs::PointField::FLOAT32,
+           &cloud);
+  AddField("z", offsetof(RawPoint, z), sensor_msgs::PointField::FLOAT32,
+           &cloud);
+  AddField("intensity", offsetof(RawPoint, intensity),
+           sensor_msgs::PointField::FLOAT32, &cloud);
+  AddField("timestamp", offsetof(RawPoint, timestamp),
+           sensor_msgs::PointField::FLOAT64, &cloud);
+  const int num_beams = 64;
+  cloud.height = 1;
+  cloud.width = num_beams * FLAGS_benchmark_num_columns;
+  cloud.point_step = sizeof(RawPoint);
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.is_dense = false;
+  cloud.data.resize(cloud.row_step);
+
+  RawPoint *points = reinterpret_cast<RawPoint *>(cloud.data.data());
+  for (int column = 0; column < FLAGS_benchmark_num_columns; ++column) {
+    const double azimuth = 2.0 * M_PI * column / FLAGS_benchmark_num_columns;
+    for (int beam = 0; beam < num_beams; ++beam) {
+      const double elevation = (2.0 - 26.8 * beam / (num_beams - 1)) / 180.0 *
+                               M_PI;
+      const double range = Range(azimuth, elevation, frame, random);
+      RawPoint &point = *points++;
+      point.x = range * std::cos(elevation) * std::cos(azimuth);
+      point.y = range * std::cos(elevation) * std::sin(azimuth);
+      point.z = range * std::sin(elevation);
+      point.intensity = 0.0f;
+      point.timestamp = frame * 0.1;
+    }
+  }
+  return cloud;
+}
+
+// The former way of PointCloudUpdater.
+void FilterWithPcl(const sensor_msgs::PointCloud2 &cloud, std::string *data) {
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr(
+      new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::fromROSMsg(cloud, *pcl_ptr);
+  pcl::VoxelGrid<pcl::PointXYZ> voxel_grid;
+  voxel_grid.setInputCloud(pcl_ptr);
+  voxel_grid.setLeafSize(FLAGS_voxel_filter_size, FLAGS_voxel_filter_size,
+                         FLAGS_voxel_filter_height);
+  voxel_grid.filter(*pcl_ptr);
+
+  PointCloud point_cloud_pb;
+  for (const pcl::PointXYZ &pt : pcl_ptr->points) {
+    if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
+      point_cloud_pb.add_num(pt.x);
+      point_cloud_pb.add_num(pt.y);
+      point_cloud_pb.add_num(pt.z + 1.91f);
+    }
+  }
+  point_cloud_pb.SerializeToString(data);
+}
+
+// The steps of pcl::VoxelGrid::applyFilter for the fields x, y and z: the
+// bounds of the points, the voxel index of each point, a sort by index and
+// the centroid of each run of equal indices.
+void FilterWithSort(const sensor_msgs::PointCloud2 &cloud, std::string *data) {
+  struct Point {
+    float x;
+    float y;
+    float z;
+  };
+  // The copy of pcl::fromROSMsg.
+  const size_t num_points = cloud.width * cloud.height;
+  std::vector<Point> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const RawPoint &raw =
+        *reinterpret_cast<const RawPoint *>(&cloud.data[i * cloud.point_step]);
+    points[i] = {raw.x, raw.y, raw.z};
+  }
+
+  const float inverse_leaf[3] = {1.0f / FLAGS_voxel_filter_size,
+                                 1.0f / FLAGS_voxel_filter_size,
+                                 1.0f / FLAGS_voxel_filter_height};
+  float min_p[3] = {std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::max()};
+  float max_p[3] = {std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::lowest()};
+  for (const Point &point : points) {
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) ||
+        !std::isfinite(point.z)) {
+      continue;
+    }
+    const float p[3] = {point.x, point.y, point.z};
+    for (int k = 0; k < 3; ++k) {
+      min_p[k] = std::min(min_p[k], p[k]);
+      max_p[k] = std::max(max_p[k], p[k]);
+    }
+  }
+  int min_b[3];
+  int div_b[3];
+  for (int k = 0; k < 3; ++k) {
+    min_b[k] = static_cast<int>(std::floor(min_p[k] * inverse_leaf[k]));
+    div_b[k] = static_cast<int>(std::floor(max_p[k] * inverse_leaf[k])) -
+               min_b[k] + 1;
+  }
+
+  // The voxel index and the index of each point.
+  std::vector<std::pair<uint32_t, uint32_t>> indices;
+  indices.reserve(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const Point &point = points[i];
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) ||
+        !std::isfinite(point.z)) {
+      continue;
+    }
+    const int i0 =
+        static_cast<int>(std::floor(point.x * inverse_leaf[0])) - min_b[0];
+    const int i1 =
+        static_cast<int>(std::floor(point.y * inverse_leaf[1])) - min_b[1];
+    const int i2 =
+        static_cast<int>(std::floor(point.z * inverse_leaf[2])) - min_b[2];
+    indices.emplace_back(i0 + i1 * div_b[0] + i2 * div_b[0] * div_b[1], i);
+  }
+  std::sort(indices.begin(), indices.end(),
+            [](const std::pair<uint32_t, uint32_t> &a,
+               const std::pair<uint32_t, uint32_t> &b) {
+              return a.first < b.first;
+            });
+
+  PointCloud point_cloud_pb;
+  for (size_t begin = 0; begin < indices.size();) {
+    size_t end = begin;
+    float sum[3] = {0.0f, 0.0f, 0.0f};
+    while (end < indices.size() && indices[end].first == indices[begin].first) {
+      const Point &point = points[indices[end].second];
+      sum[0] += point.x;
+      sum[1] += point.y;
+      sum[2] += point.z;
+      ++end;
+    }
+    const float count = static_cast<float>(end - begin);
+    point_cloud_pb.add_num(sum[0] / count);
+    point_cloud_pb.add_num(sum[1] / count);
+    point_cloud_pb.add_num(sum[2] / count + 1.91f);
+    begin = end;
+  }
+  point_cloud_pb.SerializeToString(data);
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+int Run() {
+  std::mt19937 random(2018);
+  std::vector<sensor_msgs::PointCloud2> sweeps;
+  for (int i = 0; i < FLAGS_benchmark_num_frames; ++i) {
+    sweeps.push_back(CreateSweep(i, &random));
+  }
+
+  size_t pcl_bytes = 0;
+  std::string data;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &cloud : sweeps) {
+    FilterWithPcl(cloud, &data);
+    pcl_bytes += data.size();
+  }
+  const double pcl_ms = ElapsedMs(start);
+
+  size_t sort_bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &cloud : sweeps) {
+    FilterWithSort(cloud, &data);
+    sort_bytes += data.size();
+  }
+  const double sort_ms = ElapsedMs(start);
+
+  PointCloudEncoder encoder(FLAGS_voxel_filter_size,
+                            FLAGS_voxel_filter_height, 0.01, 1.91);
+  size_t encoder_bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &cloud : sweeps) {
+    PointCloud point_cloud_pb;
+    encoder.Encode(cloud.data.data(), cloud.width * cloud.height,
+                   cloud.point_step, offsetof(RawPoint, x),
+                   offsetof(RawPoint, y), offsetof(RawPoint, z),
+                   &point_cloud_pb);
+    point_cloud_pb.SerializeToString(&data);
+    encoder_bytes += data.size();
+  }
+  const double encoder_ms = ElapsedMs(start);
+
+  const size_t num_frames = sweeps.size();
+  std::cout << "frames: " << num_frames << ", points per frame: "
+            << sweeps.front().width * sweeps.front().height << std::endl
+            << std::fixed << std::setprecision(2)
+            << "pcl::VoxelGrid:    " << pcl_ms / num_frames << " ms/frame, "
+            << pcl_bytes / 1024.0 / num_frames << " KB/frame" << std::endl
+            << "Sort voxel filter: " << sort_ms / num_frames << " ms/frame, "
+            << sort_bytes / 1024.0 / num_frames << " KB/frame" << std::endl
+            << "PointCloudEncoder: " << encoder_ms / num_frames
+            << " ms/frame, " << encoder_bytes / 1024.0 / num_frames
+            << " KB/frame" << std::endl;
+  return 0;
+}
+
+}  // namespace
+}  // namespace dreamview
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::dreamview::Run();
+}
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+// A point as in the point clouds of the velodyne driver.
+struct RawPoint {
+  float x;
+  float y;
+  float z;
+  float intensity;
+  double timestamp;
+};
+
+std::vector<std::array<double, 3>> Decode(const PointCloud &point_cloud) {
+  const std::string &bytes = point_cloud.quantized_points();
+  EXPECT_EQ(0, bytes.size() % 6);
+  std::vector<std::array<double, 3>> points;
+  for (size_t i = 0; i + 6 <= bytes.size(); i += 6) {
+    std::array<double, 3> point;
+    for (int k = 0; k < 3; ++k) {
+      const uint16_t bits =
+          static_cast<uint8_t>(bytes[i + 2 * k]) |
+          static_cast<uint8_t>(bytes[i + 2 * k + 1]) << 8;
+      point[k] = static_cast<int16_t>(bits) * point_cloud.resolution();
+    }
+    points.push_back(point);
+  }
+  std::sort(points.begin(), points.end());
+  return points;
+}
+
+size_t Encode(const std::vector<RawPoint> &points, PointCloudEncoder *encoder,
+              PointCloud *point_cloud) {
+  return encoder->Encode(reinterpret_cast<const uint8_t *>(points.data()),
+                         points.size(), sizeof(RawPoint),
+                         offsetof(RawPoint, x), offsetof(RawPoint, y),
+                         offsetof(RawPoint, z), point_cloud);
+}
+
+}  // namespace
+
+TEST(PointCloudEncoderTest, Voxelize) {
+  PointCloudEncoder encoder(0.5, 0.25, 0.01, 1.0);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<RawPoint> points = {
+      {0.1f, 0.1f, 0.1f, 0.0f, 0.0},   {0.3f, 0.2f, 0.2f, 0.0f, 0.0},
+      {-0.1f, 0.1f, 0.1f, 0.0f, 0.0},  {0.1f, 0.1f, 0.3f, 0.0f, 0.0},
+      {nan, 0.1f, 0.1f, 0.0f, 0.0},    {10.0f, -5.0f, 2.0f, 0.0f, 0.0},
+      {400.0f, 0.0f, 0.0f, 0.0f, 0.0}};
+  PointCloud point_cloud;
+  EXPECT_EQ(4, Encode(points, &encoder, &point_cloud));
+  EXPECT_DOUBLE_EQ(0.01, point_cloud.resolution());
+
+  const auto decoded = Decode(point_cloud);
+  ASSERT_EQ(4, decoded.size());
+  const std::vector<std::array<double, 3>> expected = {
+      {-0.1, 0.1, 1.1}, {0.1, 0.1, 1.3}, {0.2, 0.15, 1.15}, {10.0, -5.0, 3.0}};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    for (int k = 0; k < 3; ++k) {
+      EXPECT_NEAR(expected[i][k], decoded[i][k], 0.005 + 1e-6);
+    }
+  }
+
+  // The buffers are reused by the next frame.
+  EXPECT_EQ(0, Encode({}, &encoder, &point_cloud));
+  EXPECT_TRUE(point_cloud.quantized_points().empty());
+}
+
+TEST(PointCloudEncoderTest, RandomPoints) {
+  const double leaf_size = 0.3;
+  const double leaf_height = 0.2;
+  PointCloudEncoder encoder(leaf_size, leaf_height, 0.01, 0.0);
+  std::mt19937 random(2018);
+  std::uniform_real_distribution<float> xy(-60.0f, 60.0f);
+  std::uniform_real_distribution<float> z(-2.0f, 3.0f);
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<RawPoint> points(20000 + frame * 5000);
+    for (auto &point : points) {
+      point = {xy(random), xy(random), z(random), 0.0f, 0.0};
+    }
+
+    // Brute force voxelization.
+    std::map<std::tuple<int, int, int>, std::array<double, 4>> voxels;
+    for (const auto &point : points) {
+      auto &voxel = voxels[std::make_tuple(
+          static_cast<int>(std::floor(point.x * (1.0 / leaf_size))),
+          static_cast<int>(std::floor(point.y * (1.0 / leaf_size))),
+          static_cast<int>(std::floor(point.z * (1.0 / leaf_height))))];
+      voxel[0] += point.x;
+      voxel[1] += point.y;
+      voxel[2] += point.z;
+      voxel[3] += 1.0;
+    }
+    std::vector<std::array<double, 3>> expected;
+    for (const auto &kv : voxels) {
+      const auto &voxel = kv.second;
+      expected.push_back({std::round(voxel[0] / voxel[3] * 100.0) / 100.0,
+                          std::round(voxel[1] / voxel[3] * 100.0) / 100.0,
+                          std::round(voxel[2] / voxel[3] * 100.0) / 100.0});
+    }
+    std::sort(expected.begin(), expected.end());
+
+    PointCloud point_cloud;
+    EXPECT_EQ(expected.size(), Encode(points, &encoder, &point_cloud));
+    const auto decoded = Decode(point_cloud);
+    ASSERT_EQ(expected.size(), decoded.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      for (int k = 0; k < 3; ++k) {
+        EXPECT_NEAR(expected[i][k], decoded[i][k], 1e-6);
+      }
+    }
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
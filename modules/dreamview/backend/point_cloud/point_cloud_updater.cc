@@ -16,6 +16,7 @@
 
 #include "modules/dreamview/backend/point_cloud/point_cloud_updater.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "modules/common/adapters/adapter_manager.h"
@@ -23,8 +24,6 @@
 #include "modules/common/time/time.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/dreamview/proto/point_cloud.pb.h"
-#include "pcl/filters/voxel_grid.h"
-#include "pcl_conversions/pcl_conversions.h"
 #include "third_party/json/json.hpp"
 
 namespace apollo {
@@ -36,8 +35,22 @@ using apollo::localization::LocalizationEstimate;
 using sensor_msgs::PointCloud2;
 using Json = nlohmann::json;
 
+namespace {
+
+// The resolution of the points sent to frontend, in meters.
+constexpr double kPointResolution = 0.01;
+
+// TODO(unacao): velodyne height should be updated by hmi store
+// upon vehicle change.
+constexpr double kVelodyneHeight = 1.91;
+
+}  // namespace
+
 PointCloudUpdater::PointCloudUpdater(WebSocketHandler *websocket)
-    : websocket_(websocket), point_cloud_str_(""), future_ready_(true) {
+    : websocket_(websocket),
+      point_cloud_str_(std::make_shared<const std::string>()),
+      encoder_(FLAGS_voxel_filter_size, FLAGS_voxel_filter_height,
+               kPointResolution, kVelodyneHeight) {
   RegisterMessageHandlers();
 }
 
@@ -55,12 +68,14 @@ void PointCloudUpdater::RegisterMessageHandlers() {
   websocket_->RegisterMessageHandler(
       "RequestPointCloud",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
-        std::string to_send;
+        std::shared_ptr<const std::string> to_send;
         // If there is no point_cloud data for more than 2 seconds, reset.
-        if (point_cloud_str_ != "" &&
-            std::fabs(last_localization_time_ - last_point_cloud_time_) > 2.0) {
+        if (std::fabs(last_localization_time_ - last_point_cloud_time_) >
+            2.0) {
           boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-          point_cloud_str_ = "";
+          if (!point_cloud_str_->empty()) {
+            point_cloud_str_ = std::make_shared<const std::string>();
+          }
         }
         {
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
@@ -90,6 +105,7 @@ void PointCloudUpdater::RegisterMessageHandlers() {
 }
 
 void PointCloudUpdater::Start() {
+  worker_thread_ = std::thread(&PointCloudUpdater::EncodePointCloud, this);
   AdapterManager::AddPointCloudCallback(&PointCloudUpdater::UpdatePointCloud,
                                         this);
   AdapterManager::AddLocalizationCallback(
@@ -97,8 +113,13 @@ void PointCloudUpdater::Start() {
 }
 
 void PointCloudUpdater::Stop() {
-  if (enabled_) {
-    async_future_.wait();
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    stopped_ = true;
+  }
+  pending_cv_.notify_one();
+  if (worker_thread_.joinable()) {
+    worker_thread_.join();
   }
 }
 
@@ -108,44 +129,73 @@ void PointCloudUpdater::UpdatePointCloud(const PointCloud2 &point_cloud) {
   }
 
   last_point_cloud_time_ = point_cloud.header.stamp.toSec();
-  // Check if last filter process has finished before processing new data.
-  if (future_ready_) {
-    future_ready_ = false;
-    // transform from ros to pcl
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-    pcl::fromROSMsg(point_cloud, *pcl_ptr);
-    std::future<void> f =
-        std::async(std::launch::async, &PointCloudUpdater::FilterPointCloud,
-                   this, pcl_ptr);
-    async_future_ = std::move(f);
+  // Replace the point cloud which is not encoded yet, if any. The copy reuses
+  // the buffer of the last one.
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_point_cloud_ = point_cloud;
+    has_pending_point_cloud_ = true;
   }
+  pending_cv_.notify_one();
 }
 
-void PointCloudUpdater::FilterPointCloud(
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr) {
-  pcl::VoxelGrid<pcl::PointXYZ> voxel_grid;
-  voxel_grid.setInputCloud(pcl_ptr);
-  voxel_grid.setLeafSize(FLAGS_voxel_filter_size, FLAGS_voxel_filter_size,
-                         FLAGS_voxel_filter_height);
-  voxel_grid.filter(*pcl_ptr);
-  AINFO << "filtered point cloud data size: " << pcl_ptr->size();
+void PointCloudUpdater::EncodePointCloud() {
+  PointCloud2 point_cloud;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      pending_cv_.wait(
+          lock, [this] { return stopped_ || has_pending_point_cloud_; });
+      if (stopped_) {
+        return;
+      }
+      std::swap(point_cloud, pending_point_cloud_);
+      has_pending_point_cloud_ = false;
+    }
+    FilterPointCloud(point_cloud);
+  }
+}
 
-  PointCloud point_cloud_pb;
-  for (size_t idx = 0; idx < pcl_ptr->size(); ++idx) {
-    pcl::PointXYZ &pt = pcl_ptr->points[idx];
-    if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
-      point_cloud_pb.add_num(pt.x);
-      point_cloud_pb.add_num(pt.y);
-      // TODO(unacao): velodyne height should be updated by hmi store
-      // upon vehicle change.
-      point_cloud_pb.add_num(pt.z + 1.91f);
+void PointCloudUpdater::FilterPointCloud(const PointCloud2 &point_cloud) {
+  // Find the float x, y and z of the points.
+  int offsets[3] = {-1, -1, -1};
+  const char *names[3] = {"x", "y", "z"};
+  for (const auto &field : point_cloud.fields) {
+    for (int i = 0; i < 3; ++i) {
+      if (field.name == names[i] &&
+          field.datatype == sensor_msgs::PointField::FLOAT32) {
+        offsets[i] = field.offset;
+      }
     }
   }
+  if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0 ||
+      point_cloud.is_bigendian) {
+    AERROR << "Point cloud without little endian float x, y and z.";
+    return;
+  }
+  // The encoder reads the floats of each point within point_step bytes.
+  for (const int offset : offsets) {
+    if (offset + sizeof(float) > point_cloud.point_step) {
+      AERROR << "Point cloud field at offset " << offset
+             << " is out of the point step " << point_cloud.point_step;
+      return;
+    }
+  }
+  const size_t num_points =
+      std::min(static_cast<size_t>(point_cloud.width) * point_cloud.height,
+               point_cloud.data.size() / std::max(1u, point_cloud.point_step));
+
+  PointCloud point_cloud_pb;
+  const size_t num_filtered = encoder_.Encode(
+      point_cloud.data.data(), num_points, point_cloud.point_step, offsets[0],
+      offsets[1], offsets[2], &point_cloud_pb);
+  AINFO << "filtered point cloud data size: " << num_filtered;
+
+  auto point_cloud_str = std::make_shared<std::string>();
+  point_cloud_pb.SerializeToString(point_cloud_str.get());
   {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-    point_cloud_pb.SerializeToString(&point_cloud_str_);
-    future_ready_ = true;
+    point_cloud_str_ = point_cloud_str;
   }
 }
 
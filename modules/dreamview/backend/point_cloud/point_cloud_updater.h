@@ -22,8 +22,11 @@
 #define MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_UPDATER_H_
 
 #include <atomic>
-#include <future>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
@@ -31,9 +34,8 @@
 #include "modules/common/log.h"
 #include "modules/common/util/string_util.h"
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
+#include "modules/dreamview/backend/point_cloud/point_cloud_encoder.h"
 #include "modules/localization/proto/localization.pb.h"
-#include "pcl/point_cloud.h"
-#include "pcl/point_types.h"
 #include "sensor_msgs/PointCloud2.h"
 
 /**
@@ -69,7 +71,10 @@ class PointCloudUpdater {
 
   void UpdatePointCloud(const sensor_msgs::PointCloud2 &point_cloud);
 
-  void FilterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
+  // Encodes the latest point cloud received, on the worker thread.
+  void EncodePointCloud();
+
+  void FilterPointCloud(const sensor_msgs::PointCloud2 &point_cloud);
 
   void UpdateLocalizationTime(
       const apollo::localization::LocalizationEstimate &localization);
@@ -78,14 +83,24 @@ class PointCloudUpdater {
 
   bool enabled_ = false;
 
-  // The PointCloud to be pushed to frontend.
-  std::string point_cloud_str_;
+  // The PointCloud to be pushed to frontend, which is not modified once
+  // encoded.
+  std::shared_ptr<const std::string> point_cloud_str_;
 
   // Mutex to protect concurrent access to point_cloud_str_.
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
-  std::future<void> async_future_;
-  std::atomic<bool> future_ready_;
+
+  // The latest point cloud to be encoded by the worker thread. Its buffer is
+  // reused for the next one.
+  sensor_msgs::PointCloud2 pending_point_cloud_;
+  bool has_pending_point_cloud_ = false;
+  bool stopped_ = false;
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  std::thread worker_thread_;
+
+  PointCloudEncoder encoder_;
 
   double last_point_cloud_time_ = 0.0;
   double last_localization_time_ = 0.0;
@@ -0,0 +1,212 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the bytes pushed to the frontend and the CPU time spent on
+ *        encoding, when every client gets the full simulation world versus
+ *        a delta from SimulationWorldDeltaEncoder. The simulation worlds are
+ *        read from a file recorded with --sim_world_record_file, or a drive
+ *        with a moving car among static and moving obstacles is synthesized.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+DEFINE_string(benchmark_record_file, "",
+              "File of the simulation worlds recorded by dreamview with "
+              "--sim_world_record_file. A drive is synthesized if empty.");
+DEFINE_int32(benchmark_num_frames, 600, "Number of synthesized frames.");
+DEFINE_int32(benchmark_num_obstacles, 50, "Number of synthesized obstacles.");
+DEFINE_int32(benchmark_num_clients, 3, "Number of frontend clients.");
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+bool ReadRecord(const std::string &file_name,
+                std::vector<SimulationWorld> *worlds) {
+  std::ifstream file(file_name, std::ios::in | std::ios::binary);
+  if (!file) {
+    std::cerr << "Failed to open " << file_name << std::endl;
+    return false;
+  }
+  uint32_t size = 0;
+  std::string data;
+  while (file.read(reinterpret_cast<char *>(&size), sizeof(size))) {
+    data.resize(size);
+    if (!file.read(&data[0], size)) {
+      break;
+    }
+    worlds->emplace_back();
+    if (!worlds->back().ParseFromString(data)) {
+      std::cerr << "Failed to parse " << file_name << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Half of the obstacles are parked, the others move along the road.
+void SynthesizeDrive(std::vector<SimulationWorld> *worlds) {
+  for (int i = 0; i < FLAGS_benchmark_num_frames; ++i) {
+    const double t = i * 0.1;
+    SimulationWorld world;
+    world.set_sequence_num(i + 1);
+    world.set_timestamp(1.5e12 + t * 1000.0);
+    world.set_speed_limit(15.0);
+    world.set_engage_advice("READY_TO_ENGAGE");
+    world.set_routing_time(1.5e12);
+    world.set_map_hash(12345);
+    world.set_map_radius(200.0);
+
+    Object *car = world.mutable_auto_driving_car();
+    car->set_position_x(10.0 * t);
+    car->set_position_y(0.0);
+    car->set_heading(0.0);
+    car->set_speed(10.0);
+    car->set_throttle_percentage(20.0);
+
+    for (int k = 0; k < FLAGS_benchmark_num_obstacles; ++k) {
+      Object *object = world.add_object();
+      object->set_id(std::to_string(k));
+      object->set_type(Object::VEHICLE);
+      object->set_length(4.5);
+      object->set_width(2.0);
+      object->set_height(1.5);
+      const bool is_static = k % 2 == 0;
+      object->set_position_x(k * 10.0 + (is_static ? 0.0 : 8.0 * t));
+      object->set_position_y(k % 4 * 3.5);
+      object->set_speed(is_static ? 0.0 : 8.0);
+      for (int p = 0; p < 4; ++p) {
+        PolygonPoint *point = object->add_polygon_point();
+        point->set_x(object->position_x() + (p < 2 ? -2.25 : 2.25));
+        point->set_y(object->position_y() + (p % 2 == 0 ? -1.0 : 1.0));
+      }
+    }
+
+    for (int k = 0; k < 100; ++k) {
+      Object *point = world.add_planning_trajectory();
+      point->set_position_x(car->position_x() + k * 0.8);
+      point->set_position_y(0.1 * std::sin(t + k * 0.1));
+      point->set_heading(0.0);
+    }
+    auto *planning_data = world.mutable_planning_data();
+    for (int k = 0; k < 200; ++k) {
+      auto *point = planning_data->add_path()->add_path_point();
+      point->set_x(car->position_x() + k * 0.5);
+      point->set_y(0.1 * std::cos(t + k * 0.1));
+    }
+    worlds->push_back(world);
+  }
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+int Run() {
+  std::vector<SimulationWorld> worlds;
+  if (FLAGS_benchmark_record_file.empty()) {
+    SynthesizeDrive(&worlds);
+  } else if (!ReadRecord(FLAGS_benchmark_record_file, &worlds)) {
+    return 1;
+  }
+  if (worlds.empty()) {
+    std::cerr << "No simulation world to encode." << std::endl;
+    return 1;
+  }
+  const int num_clients = FLAGS_benchmark_num_clients;
+
+  // Every tick serializes the world with and without the planning data,
+  // and sends it to each client in full.
+  uint64_t full_bytes = 0;
+  std::string sim_world;
+  std::string sim_world_with_planning_data;
+  auto start = std::chrono::steady_clock::now();
+  for (SimulationWorld world : worlds) {
+    world.SerializeToString(&sim_world_with_planning_data);
+    world.clear_planning_data();
+    world.SerializeToString(&sim_world);
+    full_bytes += sim_world.size() * num_clients;
+  }
+  const double full_ms = ElapsedMs(start);
+
+  // Every client acknowledges the last frame it received.
+  SimulationWorldDeltaEncoder encoder;
+  std::vector<uint32_t> client_sequence_nums(num_clients, 0);
+  uint64_t delta_bytes = 0;
+  int num_mismatches = 0;
+  SimulationWorld client;
+  start = std::chrono::steady_clock::now();
+  for (const SimulationWorld &world : worlds) {
+    encoder.Update(world);
+    for (int i = 0; i < num_clients; ++i) {
+      const auto data = encoder.Encode(client_sequence_nums[i], false);
+      if (data == nullptr) {
+        continue;
+      }
+      delta_bytes += data->size();
+      client_sequence_nums[i] = world.sequence_num();
+    }
+  }
+  const double delta_ms = ElapsedMs(start);
+
+  // Checks that a client rebuilds the same worlds from the deltas.
+  SimulationWorldDeltaEncoder check_encoder;
+  for (SimulationWorld world : worlds) {
+    check_encoder.Update(world);
+    SimulationWorld frame;
+    frame.ParseFromString(*check_encoder.Encode(client.sequence_num(), false));
+    world.clear_planning_data();
+    if (!SimulationWorldDeltaEncoder::ApplyFrame(frame, &client) ||
+        client.SerializeAsString() != world.SerializeAsString()) {
+      ++num_mismatches;
+    }
+  }
+
+  std::cout << "frames: " << worlds.size() << ", clients: " << num_clients
+            << std::endl
+            << std::fixed << std::setprecision(2) << "full:  "
+            << full_bytes / 1024.0 / worlds.size() << " KB/frame, "
+            << full_ms / worlds.size() << " ms/frame" << std::endl
+            << "delta: " << delta_bytes / 1024.0 / worlds.size()
+            << " KB/frame, " << delta_ms / worlds.size() << " ms/frame"
+            << std::endl
+            << "mismatched frames: " << num_mismatches << std::endl;
+  return num_mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace dreamview
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::dreamview::Run();
+}
@@ -0,0 +1,228 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedInputStream;
+
+SimulationWorldDeltaEncoder::SimulationWorldDeltaEncoder(
+    const size_t history_size)
+    : history_size_(history_size) {}
+
+void SimulationWorldDeltaEncoder::Update(const SimulationWorld &world) {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->sequence_num = world.sequence_num();
+
+  // Split the wire format by field. The serialized fields are in the order
+  // of the field numbers, and the objects in the order of the list.
+  std::string data;
+  world.SerializeToString(&data);
+  CodedInputStream input(reinterpret_cast<const uint8_t *>(data.data()),
+                         static_cast<int>(data.size()));
+  int object_index = 0;
+  while (true) {
+    const int begin = input.CurrentPosition();
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      break;
+    }
+    if (!WireFormatLite::SkipField(&input, tag)) {
+      AERROR << "Failed to parse the serialized simulation world.";
+      break;
+    }
+    const int number = WireFormatLite::GetTagFieldNumber(tag);
+    const std::string bytes =
+        data.substr(begin, input.CurrentPosition() - begin);
+    if (number == SimulationWorld::kObjectFieldNumber) {
+      const std::string &id = world.object(object_index++).id();
+      if (snapshot->objects.count(id) > 0) {
+        snapshot->has_unique_object_ids = false;
+      }
+      snapshot->objects[id] = bytes;
+      snapshot->object_ids.push_back(id);
+    } else if (number == SimulationWorld::kPlanningDataFieldNumber) {
+      snapshot->planning_data.append(bytes);
+    } else {
+      snapshot->fields[number].append(bytes);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The sequence number starts over when the world is reset.
+  if (!history_.empty() &&
+      history_.back()->sequence_num >= snapshot->sequence_num) {
+    history_.clear();
+  }
+  history_.push_back(snapshot);
+  while (history_.size() > history_size_) {
+    history_.pop_front();
+  }
+  encoded_.clear();
+}
+
+std::shared_ptr<const std::string> SimulationWorldDeltaEncoder::Encode(
+    const uint32_t base_sequence_num, const bool with_planning_data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (history_.empty()) {
+    return nullptr;
+  }
+  const Snapshot &latest = *history_.back();
+  if (base_sequence_num != 0 && base_sequence_num == latest.sequence_num) {
+    return nullptr;
+  }
+
+  const auto key = std::make_pair(base_sequence_num, with_planning_data);
+  auto iter = encoded_.find(key);
+  if (iter != encoded_.end()) {
+    return iter->second;
+  }
+
+  const Snapshot *base = nullptr;
+  if (base_sequence_num != 0 && latest.has_unique_object_ids) {
+    for (size_t i = 0; i + 1 < history_.size(); ++i) {
+      if (history_[i]->sequence_num == base_sequence_num) {
+        base = history_[i].get();
+        break;
+      }
+    }
+  }
+
+  std::shared_ptr<const std::string> encoded;
+  if (base != nullptr) {
+    encoded = EncodeDelta(*base, with_planning_data);
+  } else {
+    const auto keyframe_key = std::make_pair(0u, with_planning_data);
+    iter = encoded_.find(keyframe_key);
+    encoded = iter != encoded_.end() ? iter->second
+                                     : EncodeKeyframe(with_planning_data);
+    encoded_[keyframe_key] = encoded;
+  }
+  encoded_[key] = encoded;
+  return encoded;
+}
+
+std::shared_ptr<const std::string> SimulationWorldDeltaEncoder::EncodeKeyframe(
+    const bool with_planning_data) const {
+  // The fields of a message can be parsed in any order.
+  const Snapshot &latest = *history_.back();
+  auto data = std::make_shared<std::string>();
+  for (const auto &field : latest.fields) {
+    data->append(field.second);
+  }
+  for (const auto &id : latest.object_ids) {
+    data->append(latest.objects.at(id));
+  }
+  if (with_planning_data) {
+    data->append(latest.planning_data);
+  }
+  return data;
+}
+
+std::shared_ptr<const std::string> SimulationWorldDeltaEncoder::EncodeDelta(
+    const Snapshot &base, const bool with_planning_data) const {
+  const Snapshot &latest = *history_.back();
+  auto data = std::make_shared<std::string>();
+  SimulationWorld delta_info;
+  delta_info.set_base_sequence_num(base.sequence_num);
+
+  for (const auto &field : latest.fields) {
+    auto iter = base.fields.find(field.first);
+    if (iter == base.fields.end() || iter->second != field.second) {
+      data->append(field.second);
+    }
+  }
+  for (const auto &field : base.fields) {
+    if (latest.fields.count(field.first) == 0) {
+      delta_info.add_cleared_field(field.first);
+    }
+  }
+  for (const auto &id : latest.object_ids) {
+    delta_info.add_object_id(id);
+    const std::string &object = latest.objects.at(id);
+    auto iter = base.objects.find(id);
+    if (iter == base.objects.end() || iter->second != object) {
+      data->append(object);
+    }
+  }
+  if (with_planning_data) {
+    data->append(latest.planning_data);
+  }
+  data->append(delta_info.SerializeAsString());
+  return data;
+}
+
+bool SimulationWorldDeltaEncoder::ApplyFrame(const SimulationWorld &frame,
+                                             SimulationWorld *world) {
+  if (!frame.has_base_sequence_num()) {
+    *world = frame;
+    return true;
+  }
+  if (frame.base_sequence_num() != world->sequence_num()) {
+    return false;
+  }
+
+  // As in the encoder, the last object wins if the base frame has several
+  // objects with the same id.
+  std::unordered_map<std::string, Object> objects;
+  for (auto &object : *world->mutable_object()) {
+    objects[object.id()].Swap(&object);
+  }
+  for (const auto &object : frame.object()) {
+    objects[object.id()] = object;
+  }
+  world->clear_object();
+  world->clear_planning_data();
+
+  const auto *descriptor = world->GetDescriptor();
+  const auto *reflection = world->GetReflection();
+  for (const uint32_t number : frame.cleared_field()) {
+    const FieldDescriptor *field = descriptor->FindFieldByNumber(number);
+    if (field != nullptr) {
+      reflection->ClearField(world, field);
+    }
+  }
+
+  // Replace the fields which are in the frame.
+  SimulationWorld fields = frame;
+  fields.clear_object();
+  fields.clear_base_sequence_num();
+  fields.clear_cleared_field();
+  fields.clear_object_id();
+  std::vector<const FieldDescriptor *> set_fields;
+  reflection->ListFields(fields, &set_fields);
+  for (const FieldDescriptor *field : set_fields) {
+    reflection->ClearField(world, field);
+  }
+  world->MergeFrom(fields);
+
+  for (const auto &id : frame.object_id()) {
+    *world->add_object() = objects[id];
+  }
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_DELTA_ENCODER_H_
+#define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_DELTA_ENCODER_H_
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldDeltaEncoder
+ * @brief Encodes the latest SimulationWorld in wire format for the frontend,
+ * either in full (a keyframe) or as a delta against a recent frame which the
+ * client already has.
+ *
+ * The world is serialized once per update and split into the wire format
+ * bytes of each field and of each object, so a delta is put together from
+ * the bytes which changed since the base frame without serializing again.
+ * The encoded strings are cached and shared by the clients which have the
+ * same base frame. The planning data is never delta encoded, it is sent in
+ * full to the clients which ask for it. This class is thread-safe.
+ */
+class SimulationWorldDeltaEncoder {
+ public:
+  /**
+   * @brief Constructor of SimulationWorldDeltaEncoder.
+   * @param history_size the number of recent frames which can be the base
+   * of a delta.
+   */
+  explicit SimulationWorldDeltaEncoder(const size_t history_size = 10);
+
+  /**
+   * @brief Sets the latest SimulationWorld to be encoded.
+   * @param world the latest SimulationWorld.
+   */
+  void Update(const SimulationWorld &world);
+
+  /**
+   * @brief Encodes the latest SimulationWorld for a client.
+   * @param base_sequence_num the sequence number of the latest frame the
+   * client has, or 0 if it has none.
+   * @param with_planning_data whether to include the planning data.
+   * @return The wire format string, a delta if the base frame is still in
+   * the history and a keyframe otherwise. nullptr if there is no frame yet,
+   * or if the client already has the latest one.
+   */
+  std::shared_ptr<const std::string> Encode(const uint32_t base_sequence_num,
+                                            const bool with_planning_data);
+
+  /**
+   * @brief Applies a frame received from the encoder, as the frontend does.
+   * @param frame a keyframe or a delta.
+   * @param world the latest frame of the client, updated to the new frame.
+   * @return False if the frame is a delta against another base frame.
+   */
+  static bool ApplyFrame(const SimulationWorld &frame, SimulationWorld *world);
+
+ private:
+  // The wire format bytes of a frame, split by field.
+  struct Snapshot {
+    uint32_t sequence_num = 0;
+    // The bytes of each field except the objects and the planning data,
+    // keyed by the field number.
+    std::map<int, std::string> fields;
+    // The bytes of each object keyed by its id, and the ids in order.
+    std::unordered_map<std::string, std::string> objects;
+    std::vector<std::string> object_ids;
+    bool has_unique_object_ids = true;
+    std::string planning_data;
+  };
+
+  std::shared_ptr<const std::string> EncodeKeyframe(
+      const bool with_planning_data) const;
+  std::shared_ptr<const std::string> EncodeDelta(
+      const Snapshot &base, const bool with_planning_data) const;
+
+  const size_t history_size_;
+  std::mutex mutex_;
+  // The recent frames, with the latest one at the back.
+  std::deque<std::shared_ptr<const Snapshot>> history_;
+  // The encoded strings of the latest frame, keyed by the base sequence
+  // number and whether the planning data is included.
+  std::map<std::pair<uint32_t, bool>, std::shared_ptr<const std::string>>
+      encoded_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_DELTA_ENCODER_H_
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+class SimulationWorldDeltaEncoderTest : public ::testing::Test {
+ protected:
+  // A world with a moving car, a moving and a static obstacle.
+  SimulationWorld CreateWorld(const uint32_t sequence_num) {
+    SimulationWorld world;
+    world.set_sequence_num(sequence_num);
+    world.set_timestamp(1000.0 + sequence_num * 100.0);
+    world.mutable_auto_driving_car()->set_position_x(sequence_num * 0.5);
+    world.set_speed_limit(10.0);
+    world.set_engage_advice("READY_TO_ENGAGE");
+    Object *moving = world.add_object();
+    moving->set_id("1");
+    moving->set_position_x(10.0 + sequence_num);
+    Object *parked = world.add_object();
+    parked->set_id("2");
+    parked->set_position_x(20.0);
+    world.mutable_planning_data()->mutable_init_point()->set_v(sequence_num);
+    return world;
+  }
+
+  SimulationWorld Decode(const std::shared_ptr<const std::string> &data) {
+    SimulationWorld frame;
+    EXPECT_TRUE(data != nullptr);
+    if (data != nullptr) {
+      EXPECT_TRUE(frame.ParseFromString(*data));
+    }
+    return frame;
+  }
+
+  void ExpectSameWorld(SimulationWorld expected, const SimulationWorld &world,
+                       const bool with_planning_data) {
+    if (!with_planning_data) {
+      expected.clear_planning_data();
+    }
+    EXPECT_EQ(expected.SerializeAsString(), world.SerializeAsString());
+  }
+
+  SimulationWorldDeltaEncoder encoder_{10};
+};
+
+TEST_F(SimulationWorldDeltaEncoderTest, Keyframe) {
+  EXPECT_EQ(nullptr, encoder_.Encode(0, false));
+
+  const SimulationWorld world = CreateWorld(1);
+  encoder_.Update(world);
+  SimulationWorld client;
+  const SimulationWorld frame = Decode(encoder_.Encode(0, true));
+  EXPECT_FALSE(frame.has_base_sequence_num());
+  EXPECT_TRUE(SimulationWorldDeltaEncoder::ApplyFrame(frame, &client));
+  ExpectSameWorld(world, client, true);
+
+  // The base frame is not in the history.
+  EXPECT_FALSE(Decode(encoder_.Encode(100, false)).has_base_sequence_num());
+  // The client has the latest frame.
+  EXPECT_EQ(nullptr, encoder_.Encode(1, false));
+}
+
+TEST_F(SimulationWorldDeltaEncoderTest, Delta) {
+  for (const bool with_planning_data : {false, true}) {
+    SimulationWorldDeltaEncoder encoder(10);
+    SimulationWorld world = CreateWorld(1);
+    encoder.Update(world);
+    SimulationWorld client;
+    SimulationWorldDeltaEncoder::ApplyFrame(
+        Decode(encoder.Encode(0, with_planning_data)), &client);
+
+    for (uint32_t sequence_num = 2; sequence_num < 20; ++sequence_num) {
+      const SimulationWorld last_world = world;
+      world = CreateWorld(sequence_num);
+      if (sequence_num % 3 == 0) {
+        // A new obstacle, removed in the next frame.
+        Object *object = world.add_object();
+        object->set_id("3");
+      }
+      if (sequence_num % 4 == 0) {
+        world.clear_engage_advice();
+      }
+      encoder.Update(world);
+      const auto data = encoder.Encode(client.sequence_num(),
+                                       with_planning_data);
+      const SimulationWorld frame = Decode(data);
+      ASSERT_TRUE(frame.has_base_sequence_num());
+      EXPECT_TRUE(SimulationWorldDeltaEncoder::ApplyFrame(frame, &client));
+      ExpectSameWorld(world, client, with_planning_data);
+
+      // The static obstacle and the speed limit are not sent again.
+      EXPECT_EQ(1, frame.object_size() - (sequence_num % 3 == 0 ? 1 : 0));
+      EXPECT_FALSE(frame.has_speed_limit());
+      EXPECT_LT(data->size(), world.ByteSize());
+      EXPECT_EQ(sequence_num % 4 == 0 && last_world.has_engage_advice() ? 1
+                                                                        : 0,
+                frame.cleared_field_size());
+    }
+  }
+}
+
+TEST_F(SimulationWorldDeltaEncoderTest, SharedEncoding) {
+  encoder_.Update(CreateWorld(1));
+  encoder_.Update(CreateWorld(2));
+  const auto data = encoder_.Encode(1, false);
+  EXPECT_EQ(data, encoder_.Encode(1, false));
+  EXPECT_NE(data, encoder_.Encode(1, true));
+  // The keyframe is shared by the clients without a known base frame.
+  EXPECT_EQ(encoder_.Encode(0, false), encoder_.Encode(100, false));
+}
+
+TEST_F(SimulationWorldDeltaEncoderTest, WrongBase) {
+  encoder_.Update(CreateWorld(1));
+  encoder_.Update(CreateWorld(2));
+  encoder_.Update(CreateWorld(3));
+  SimulationWorld client = CreateWorld(2);
+  EXPECT_FALSE(SimulationWorldDeltaEncoder::ApplyFrame(
+      Decode(encoder_.Encode(1, false)), &client));
+}
+
+TEST_F(SimulationWorldDeltaEncoderTest, DuplicatedObjectIds) {
+  encoder_.Update(CreateWorld(1));
+  SimulationWorld world = CreateWorld(2);
+  world.add_object()->set_id("1");
+  encoder_.Update(world);
+  EXPECT_FALSE(Decode(encoder_.Encode(1, false)).has_base_sequence_num());
+}
+
+TEST_F(SimulationWorldDeltaEncoderTest, Reset) {
+  encoder_.Update(CreateWorld(1));
+  encoder_.Update(CreateWorld(2));
+  // The sequence number starts over.
+  encoder_.Update(CreateWorld(1));
+  EXPECT_FALSE(Decode(encoder_.Encode(2, false)).has_base_sequence_num());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
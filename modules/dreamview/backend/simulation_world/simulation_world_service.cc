@@ -325,6 +325,15 @@ void SimulationWorldService::GetWireFormatString(
   world_.SerializeToString(sim_world);
 }
 
+void SimulationWorldService::UpdateDeltaEncoder(
+    double radius, SimulationWorldDeltaEncoder *encoder) {
+  PopulateMapInfo(radius);
+
+  encoder->Update(world_);
+
+  world_.clear_planning_data();
+}
+
 Json SimulationWorldService::GetUpdateAsJson(double radius) const {
   std::string sim_world_json_string;
   MessageToJsonString(world_, &sim_world_json_string);
@@ -337,19 +346,28 @@ Json SimulationWorldService::GetUpdateAsJson(double radius) const {
   return update;
 }
 
-void SimulationWorldService::GetMapElementIds(double radius,
-                                              MapElementIds *ids) const {
-  // Gather required map element ids based on current location.
+apollo::common::PointENU SimulationWorldService::GetMapQueryPoint() const {
   apollo::common::PointENU point;
   const auto &adc = world_.auto_driving_car();
   point.set_x(adc.position_x() + map_service_->GetXOffset());
   point.set_y(adc.position_y() + map_service_->GetYOffset());
-  map_service_->CollectMapElementIds(point, radius, ids);
+  return point;
+}
+
+void SimulationWorldService::GetMapElementIds(double radius,
+                                              MapElementIds *ids) const {
+  // Gather required map element ids based on current location.
+  map_service_->CollectMapElementIds(GetMapQueryPoint(), radius, ids);
 }
 
 void SimulationWorldService::PopulateMapInfo(double radius) {
+  // The map elements are those of the cached tiles around the car, which the
+  // frontend retrieves by tile.
   world_.clear_map_element_ids();
-  GetMapElementIds(radius, world_.mutable_map_element_ids());
+  world_.clear_map_tile();
+  map_service_->CollectMapTiles(GetMapQueryPoint(), radius,
+                                world_.mutable_map_tile(),
+                                world_.mutable_map_element_ids());
   world_.set_map_hash(map_service_->CalculateMapHash(world_.map_element_ids()));
   world_.set_map_radius(radius);
 }
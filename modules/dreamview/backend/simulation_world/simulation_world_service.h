@@ -32,6 +32,7 @@
 #include "third_party/json/json.hpp"
 
 #include "modules/dreamview/backend/map/map_service.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
 #include "modules/dreamview/proto/simulation_world.pb.h"
 
 #include "modules/common/adapters/adapter_manager.h"
@@ -92,6 +93,14 @@ class SimulationWorldService {
   void GetWireFormatString(double radius, std::string *sim_world,
                            std::string *sim_world_with_planning_data);
 
+  /**
+   * @brief Passes the SimulationWorld object to the delta encoder, which
+   * encodes it for the frontend on request.
+   * @param radius the search distance from the current car location.
+   * @param encoder the encoder of the SimulationWorld pushed to frontend.
+   */
+  void UpdateDeltaEncoder(double radius, SimulationWorldDeltaEncoder *encoder);
+
   /**
    * @brief Returns the json representation of the map element Ids and hash
    * within the given radius from the car.
@@ -193,6 +202,9 @@ class SimulationWorldService {
 
   void PopulateMapInfo(double radius);
 
+  // The position of the car in the coordinates of the map.
+  apollo::common::PointENU GetMapQueryPoint() const;
+
   /**
    * @brief Get the latest observed data from the adapter manager to update the
    * SimulationWorld object when triggered by refresh timer.
@@ -16,7 +16,13 @@
 
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
 
+#include <algorithm>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "google/protobuf/util/json_util.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "modules/common/time/time.h"
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/map_util.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
@@ -27,21 +33,28 @@ namespace dreamview {
 
 using apollo::common::adapter::AdapterManager;
 using apollo::common::monitor::MonitorMessageItem;
+using apollo::common::time::Clock;
 using apollo::common::util::ContainsKey;
 using apollo::common::util::GetProtoFromASCIIFile;
 using apollo::common::util::JsonUtil;
 using apollo::hdmap::EndWayPointFile;
 using apollo::routing::RoutingRequest;
 using Json = nlohmann::json;
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::StringOutputStream;
 using google::protobuf::util::JsonStringToMessage;
 using google::protobuf::util::MessageToJsonString;
 
+constexpr double SimulationWorldUpdater::kSimWorldTimeIntervalMs;
+
 SimulationWorldUpdater::SimulationWorldUpdater(WebSocketHandler *websocket,
                                                WebSocketHandler *map_ws,
                                                SimControl *sim_control,
                                                const MapService *map_service,
                                                bool routing_from_file)
     : sim_world_service_(map_service, routing_from_file),
+      delta_encoder_(FLAGS_sim_world_delta_history_size),
       map_service_(map_service),
       websocket_(websocket),
       map_ws_(map_ws),
@@ -59,6 +72,12 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         websocket_->SendData(conn, response.dump());
       });
 
+  websocket_->RegisterConnectionCloseHandler(
+      [this](const WebSocketHandler::Connection *conn) {
+        std::lock_guard<std::mutex> lock(push_states_mutex_);
+        push_states_.erase(conn);
+      });
+
   map_ws_->RegisterMessageHandler(
       "RetrieveMapData",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
@@ -78,6 +97,49 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         }
       });
 
+  map_ws_->RegisterMessageHandler(
+      "RetrieveMapTiles",
+      [this](const Json &json, WebSocketHandler::Connection *conn) {
+        auto iter = json.find("tiles");
+        if (iter == json.end() || !iter->is_array()) {
+          AERROR << "Cannot retrieve map tiles without the tile ids.";
+          return;
+        }
+
+        for (const auto &tile_id : *iter) {
+          if (!tile_id.is_string()) {
+            AERROR << "Expect tile id with type 'string', but was "
+                   << tile_id.type_name();
+            continue;
+          }
+          // Each tile is sent alone as a MapTile, so the frontend knows which
+          // tiles arrived. The map of a tile which cannot be retrieved is
+          // left unset, and the frontend requests the tile again.
+          const std::string id = tile_id.get<std::string>();
+          const auto tile = map_service_->RetrieveMapTile(id);
+          if (tile == nullptr) {
+            AERROR << "Failed to retrieve map tile " << id;
+          }
+
+          // The cached tile is already a serialized hdmap::Map, so the
+          // MapTile is written field by field instead of being parsed.
+          std::string tile_string;
+          {
+            StringOutputStream stream(&tile_string);
+            CodedOutputStream output(&stream);
+            WireFormatLite::WriteString(MapTile::kIdFieldNumber, id, &output);
+            if (tile != nullptr) {
+              WireFormatLite::WriteBytes(MapTile::kMapFieldNumber, *tile,
+                                         &output);
+            }
+          }
+
+          // Not skippable, as the frontend does not request a tile again
+          // until its reply arrives.
+          map_ws_->SendBinaryData(conn, tile_string, false);
+        }
+      });
+
   map_ws_->RegisterMessageHandler(
       "RetrieveRelativeMapData",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
@@ -168,19 +230,32 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
-        std::string to_send;
-        {
-          // Pay the price to copy the data instead of sending data over the
-          // wire while holding the lock.
-          boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = enable_pnc_monitor ? simulation_world_with_planning_data_
-                                       : simulation_world_;
+        // The latest simulation world the client has, if it supports delta
+        // updates.
+        uint32_t last_sequence_num = 0;
+        auto sequence_num = json.find("lastSequenceNum");
+        if (sequence_num != json.end() && sequence_num->is_number()) {
+          last_sequence_num = *sequence_num;
+        }
+        if (!IsTimeToPush(conn)) {
+          return;
+        }
+
+        // The encoded string is shared with the other clients, and is not
+        // modified once encoded.
+        const auto to_send =
+            delta_encoder_.Encode(last_sequence_num, enable_pnc_monitor);
+        if (to_send == nullptr) {
+          return;
         }
         if (FLAGS_enable_update_size_check && !enable_pnc_monitor &&
-            to_send.size() > FLAGS_max_update_size) {
-          AWARN << "update size is too big:" << to_send.size();
+            to_send->size() > FLAGS_max_update_size) {
+          AWARN << "update size is too big:" << to_send->size();
           return;
         }
+        // The client is slow to receive if the last simulation world pushed
+        // to it is still queued.
+        UpdatePushInterval(conn, websocket_->GetQueueSize(conn) > 0);
         websocket_->SendBinaryData(conn, to_send, true);
       });
 
@@ -336,7 +411,44 @@ bool SimulationWorldUpdater::ValidateCoordinate(const nlohmann::json &json) {
   return false;
 }
 
+bool SimulationWorldUpdater::IsTimeToPush(
+    const WebSocketHandler::Connection *conn) {
+  std::lock_guard<std::mutex> lock(push_states_mutex_);
+  const PushState &state = push_states_[conn];
+  // Allow for the jitter of the requests, which come every
+  // kSimWorldTimeIntervalMs.
+  return (Clock::NowInSeconds() - state.last_push_time) * 1000.0 >=
+         state.interval_ms - kSimWorldTimeIntervalMs / 2;
+}
+
+void SimulationWorldUpdater::UpdatePushInterval(
+    const WebSocketHandler::Connection *conn, const bool is_slow) {
+  std::lock_guard<std::mutex> lock(push_states_mutex_);
+  PushState &state = push_states_[conn];
+  if (is_slow) {
+    state.interval_ms =
+        std::min(state.interval_ms * 2, FLAGS_sim_world_max_push_interval_ms);
+  } else {
+    state.interval_ms = std::max(
+        state.interval_ms - kSimWorldTimeIntervalMs / 10,
+        kSimWorldTimeIntervalMs);
+  }
+  state.last_push_time = Clock::NowInSeconds();
+}
+
+void SimulationWorldUpdater::RecordSimulationWorld() {
+  // Each simulation world is written with its size in front.
+  const std::string data = sim_world_service_.world().SerializeAsString();
+  const uint32_t size = data.size();
+  record_file_.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  record_file_.write(data.data(), size);
+}
+
 void SimulationWorldUpdater::Start() {
+  if (!FLAGS_sim_world_record_file.empty()) {
+    record_file_.open(FLAGS_sim_world_record_file,
+                      std::ios::out | std::ios::binary | std::ios::app);
+  }
   // start ROS timer, one-shot = false, auto-start = true
   timer_ =
       AdapterManager::CreateTimer(ros::Duration(kSimWorldTimeIntervalMs / 1000),
@@ -345,12 +457,13 @@ void SimulationWorldUpdater::Start() {
 
 void SimulationWorldUpdater::OnTimer(const ros::TimerEvent &event) {
   sim_world_service_.Update();
+  if (record_file_.is_open()) {
+    RecordSimulationWorld();
+  }
+  sim_world_service_.UpdateDeltaEncoder(FLAGS_sim_map_radius, &delta_encoder_);
 
   {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-    sim_world_service_.GetWireFormatString(
-        FLAGS_sim_map_radius, &simulation_world_,
-        &simulation_world_with_planning_data_);
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
   }
@@ -21,7 +21,10 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_UPDATER_H_
 #define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_UPDATER_H_
 
+#include <fstream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
@@ -31,6 +34,7 @@
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/backend/sim_control/sim_control.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta_encoder.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
 #include "modules/routing/proto/poi.pb.h"
 
@@ -121,6 +125,24 @@ class SimulationWorldUpdater {
 
   void RegisterMessageHandlers();
 
+  /**
+   * @brief Checks whether the interval of the client has passed since the
+   * last simulation world pushed to it.
+   * @param conn the connection of the client.
+   */
+  bool IsTimeToPush(const WebSocketHandler::Connection *conn);
+
+  /**
+   * @brief Lengthens the push interval of a client which is slow to receive,
+   * and shortens it back once the client keeps up.
+   * @param conn the connection of the client.
+   * @param is_slow whether the client has not received the last push yet.
+   */
+  void UpdatePushInterval(const WebSocketHandler::Connection *conn,
+                          const bool is_slow);
+
+  void RecordSimulationWorld();
+
   ros::Timer timer_;
   SimulationWorldService sim_world_service_;
   const MapService *map_service_ = nullptr;
@@ -131,15 +153,25 @@ class SimulationWorldUpdater {
   // End point for requesting default route
   apollo::routing::POI poi_;
 
-  // The simulation_world in wire format to be pushed to frontend, which is
-  // updated by timer.
-  std::string simulation_world_;
-  std::string simulation_world_with_planning_data_;
+  // Encodes the simulation_world to be pushed to frontend, which is updated
+  // by timer.
+  SimulationWorldDeltaEncoder delta_encoder_;
+
+  // The interval between the simulation worlds pushed to a client.
+  struct PushState {
+    double interval_ms = kSimWorldTimeIntervalMs;
+    double last_push_time = 0.0;
+  };
+  std::unordered_map<const WebSocketHandler::Connection *, PushState>
+      push_states_;
+  std::mutex push_states_mutex_;
+
+  std::ofstream record_file_;
 
   // Received relative map data in wire format.
   std::string relative_map_string_;
 
-  // Mutex to protect concurrent access to simulation_world_json_.
+  // Mutex to protect concurrent access to relative_map_string_.
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
 };
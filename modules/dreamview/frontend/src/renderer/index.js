@@ -369,6 +369,13 @@ class Renderer {
         this.map.appendMapData(newData, this.coordinates, this.scene);
     }
 
+    updateMapTile(id, tileData, removeOldMap = false) {
+        if (removeOldMap) {
+            this.map.removeAllElements(this.scene);
+        }
+        this.map.appendMapTile(id, tileData, this.coordinates, this.scene);
+    }
+
     updatePointCloud(pointCloud) {
         if (!this.coordinates.isInitialized() || !this.adc.mesh) {
             return;
@@ -376,10 +383,10 @@ class Renderer {
         this.pointCloud.update(pointCloud, this.adc.mesh);
     }
 
-    updateMapIndex(hash, elementIds, radius) {
+    updateMapIndex(hash, elementIds, radius, tiles) {
         if (!this.routingEditor.isInEditingMode() ||
              this.routingEditor.EDITING_MAP_RADIUS === radius) {
-            this.map.updateIndex(hash, elementIds, this.scene);
+            this.map.updateIndex(hash, elementIds, this.scene, tiles);
         }
     }
 
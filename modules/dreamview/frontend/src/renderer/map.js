@@ -49,6 +49,10 @@ export default class Map {
         this.overlapMap = {};
         this.initialized = false;
         this.elementKindsDrawn = '';
+        // The ids of the map tiles whose data arrived.
+        this.tiles = new Set();
+        // The ids of the map tiles which were requested but did not arrive.
+        this.pendingTiles = new Set();
     }
 
     // The result will be the all the elements in current but not in data.
@@ -382,6 +386,7 @@ export default class Map {
 
     removeAllElements(scene) {
         this.removeExpiredElements([], scene);
+        this.tiles.clear();
     }
 
     removeExpiredElements(elementIds, scene) {
@@ -411,6 +416,17 @@ export default class Map {
         this.data = newData;
     }
 
+    // The tile is dropped if it left the view before it arrived. A tile
+    // without data could not be retrieved and is requested again with the
+    // next index.
+    appendMapTile(id, tileData, coordinates, scene) {
+        if (!this.pendingTiles.delete(id) || !tileData) {
+            return;
+        }
+        this.appendMapData(tileData, coordinates, scene);
+        this.tiles.add(id);
+    }
+
     // I do not want to do premature optimization either. Should the
     // performance become an issue, all the diff should be done at the server
     // side. This also means that the server should maintain a state of
@@ -420,7 +436,7 @@ export default class Map {
         const kinds = ["overlap", "lane", "junction", "road",
                        "clearArea", "signal", "stopSign", "crosswalk"];
         for (const kind of kinds) {
-            if (!newData[kind]) {
+            if (!newData[kind] || !this.shouldDrawThisElementKind(kind)) {
                 continue;
             }
 
@@ -428,6 +444,16 @@ export default class Map {
                 this.data[kind] = [];
             }
 
+            // The map tiles have the elements crossing them in common.
+            const existingIds = new Set(this.data[kind].map(element => element.id.id));
+            newData[kind] = newData[kind].filter(element => {
+                if (existingIds.has(element.id.id)) {
+                    return false;
+                }
+                existingIds.add(element.id.id);
+                return true;
+            });
+
             for (let i = 0; i < newData[kind].length; ++i) {
                 switch (kind) {
                     case "lane":
@@ -493,7 +519,7 @@ export default class Map {
         return STORE.options[optionName] !== false;
     }
 
-    updateIndex(hash, elementIds, scene) {
+    updateIndex(hash, elementIds, scene, tiles) {
         if (STORE.hmi.inNavigationMode) {
             MAP_WS.requestRelativeMapData();
         } else {
@@ -505,13 +531,33 @@ export default class Map {
             }
 
             if (hash !== this.hash || this.elementKindsDrawn !== newElementKindsDrawn) {
+                if (this.elementKindsDrawn !== newElementKindsDrawn) {
+                    // The elements of the kinds not drawn were not kept.
+                    this.tiles.clear();
+                }
                 this.hash = hash;
                 this.elementKindsDrawn = newElementKindsDrawn;
-                const diff = this.diffMapElements(elementIds, this.data);
                 this.removeExpiredElements(elementIds, scene);
-                if (!_.isEmpty(diff) || !this.initialized) {
-                    MAP_WS.requestMapData(diff);
-                    this.initialized = true;
+                if (tiles && tiles.length > 0) {
+                    // The elements are those of the tiles, so only the new
+                    // tiles are needed.
+                    const newTiles = tiles.filter(
+                        tile => !this.tiles.has(tile) && !this.pendingTiles.has(tile));
+                    this.tiles = new Set(tiles.filter(tile => this.tiles.has(tile)));
+                    this.pendingTiles = new Set(
+                        tiles.filter(tile => this.pendingTiles.has(tile)).concat(newTiles));
+                    if (newTiles.length > 0 || !this.initialized) {
+                        MAP_WS.requestMapTiles(newTiles);
+                        this.initialized = true;
+                    }
+                } else {
+                    this.tiles.clear();
+                    this.pendingTiles.clear();
+                    const diff = this.diffMapElements(elementIds, this.data);
+                    if (!_.isEmpty(diff) || !this.initialized) {
+                        MAP_WS.requestMapData(diff);
+                        this.initialized = true;
+                    }
                 }
             }
         }
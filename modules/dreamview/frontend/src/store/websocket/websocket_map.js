@@ -31,7 +31,11 @@ export default class MapDataWebSocketEndpoint {
             const removeOldMap =
                 STORE.hmi.inNavigationMode || this.currentMode !== STORE.hmi.currentMode;
             this.currentMode = STORE.hmi.currentMode;
-            RENDERER.updateMap(event.data, removeOldMap);
+            if (event.data.type === "MapTile") {
+                RENDERER.updateMapTile(event.data.id, event.data.map, removeOldMap);
+            } else {
+                RENDERER.updateMap(event.data, removeOldMap);
+            }
             STORE.setInitializationStatus(true);
         };
         this.websocket.onclose = event => {
@@ -47,6 +51,13 @@ export default class MapDataWebSocketEndpoint {
         }));
     }
 
+    requestMapTiles(tiles) {
+        this.websocket.send(JSON.stringify({
+            type: "RetrieveMapTiles",
+            tiles: tiles,
+        }));
+    }
+
     requestRelativeMapData(elements) {
         this.websocket.send(JSON.stringify({
             type: "RetrieveRelativeMapData",
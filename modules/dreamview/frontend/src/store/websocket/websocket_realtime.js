@@ -9,6 +9,7 @@ export default class RosWebSocketEndpoint {
         this.websocket = null;
         this.simWorldUpdatePeriodMs = 100;
         this.simWorldLastUpdateTimestamp = 0;
+        this.lastSimWorldSequenceNum = 0;
         this.mapUpdatePeriodMs = 1000;
         this.mapLastUpdateTimestamp = 0;
         this.updatePOI = true;
@@ -28,6 +29,8 @@ export default class RosWebSocketEndpoint {
             }, 1000);
             return;
         }
+        // A new connection starts with a full simulation world.
+        this.lastSimWorldSequenceNum = 0;
         this.websocket.onmessage = event => {
             this.worker.postMessage({
                 source: 'realtime',
@@ -52,6 +55,7 @@ export default class RosWebSocketEndpoint {
                     break;
                 case "SimWorldUpdate":
                     this.checkMessage(message);
+                    this.lastSimWorldSequenceNum = message.sequenceNum;
 
                     const updateCoordination = (this.currentMode !== STORE.hmi.currentMode);
                     this.currentMode = STORE.hmi.currentMode;
@@ -95,6 +99,10 @@ export default class RosWebSocketEndpoint {
                         this.routingTime = message.routingTime;
                     }
                     break;
+                case "SimWorldDeltaError":
+                    // Request a full simulation world instead.
+                    this.lastSimWorldSequenceNum = 0;
+                    break;
                 case "MapElementIds":
                     RENDERER.updateMapIndex(message.mapHash,
                             message.mapElementIds, message.mapRadius);
@@ -126,6 +134,7 @@ export default class RosWebSocketEndpoint {
                 this.websocket.send(JSON.stringify({
                     type : "RequestSimulationWorld",
                     planning : requestPlanningData,
+                    lastSequenceNum : this.lastSimWorldSequenceNum,
                 }));
             }
         }, this.simWorldUpdatePeriodMs);
@@ -135,7 +144,8 @@ export default class RosWebSocketEndpoint {
         const now = new Date();
         const duration = now - this.mapLastUpdateTimestamp;
         if (message.mapHash && duration >= this.mapUpdatePeriodMs) {
-            RENDERER.updateMapIndex(message.mapHash, message.mapElementIds, message.mapRadius);
+            RENDERER.updateMapIndex(message.mapHash, message.mapElementIds,
+                    message.mapRadius, message.mapTile);
             this.mapLastUpdateTimestamp = now;
         }
     }
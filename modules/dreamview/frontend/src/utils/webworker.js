@@ -4,11 +4,88 @@ const simWorldRoot = protobuf.Root.fromJSON(
 );
 const SimWorldMessage = simWorldRoot.lookupType("apollo.dreamview.SimulationWorld");
 const mapMessage = simWorldRoot.lookupType("apollo.hdmap.Map");
+const mapTileMessage = simWorldRoot.lookupType("apollo.dreamview.MapTile");
 const pointCloudRoot = protobuf.Root.fromJSON(
     require("proto_bundle/point_cloud_proto_bundle.json")
 );
 const pointCloudMessage = pointCloudRoot.lookupType("apollo.dreamview.PointCloud");
 
+// The recent simulation worlds, keyed by sequence number, which the backend
+// may send a delta against.
+const simWorldHistorySize = 10;
+let simWorldHistory = new Map();
+
+function applySimWorldDelta(delta) {
+    const base = simWorldHistory.get(delta.baseSequenceNum);
+    if (!base) {
+        return null;
+    }
+
+    const world = Object.assign({}, base);
+    delete world.planningData;
+    (delta.clearedField || []).forEach(id => {
+        delete world[SimWorldMessage.fieldsById[id].name];
+    });
+    const objects = new Map();
+    (base.object || []).forEach(object => objects.set(object.id, object));
+    (delta.object || []).forEach(object => objects.set(object.id, object));
+    for (const name in delta) {
+        world[name] = delta[name];
+    }
+    world.object = (delta.objectId || []).map(id => objects.get(id));
+    delete world.baseSequenceNum;
+    delete world.clearedField;
+    delete world.objectId;
+    return world;
+}
+
+function decodeSimWorld(data) {
+    let world = SimWorldMessage.toObject(
+        SimWorldMessage.decode(new Uint8Array(data)),
+        { enums: String });
+    if (world.baseSequenceNum === undefined) {
+        simWorldHistory.clear();
+    } else {
+        world = applySimWorldDelta(world);
+        if (!world) {
+            return { type: "SimWorldDeltaError" };
+        }
+    }
+
+    simWorldHistory.set(world.sequenceNum, world);
+    if (simWorldHistory.size > simWorldHistorySize) {
+        simWorldHistory.delete(simWorldHistory.keys().next().value);
+    }
+    return Object.assign({ type: "SimWorldUpdate" }, world);
+}
+
+// The map tiles share no field number with the other map replies, which are
+// apollo.hdmap.Map, so only a tile has an id when decoded as a MapTile.
+function decodeMapData(data) {
+    const bytes = new Uint8Array(data);
+    const tile = mapTileMessage.decode(bytes);
+    if (tile.hasOwnProperty("id")) {
+        const message = mapTileMessage.toObject(tile, {enums: String});
+        message.type = "MapTile";
+        return message;
+    }
+
+    const message = mapMessage.toObject(mapMessage.decode(bytes), {enums: String});
+    message.type = "MapData";
+    return message;
+}
+
+// Decodes the points encoded as little endian int16 x, y and z in units of
+// the resolution.
+function decodeQuantizedPoints(bytes, resolution) {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const points = new Float32Array(Math.floor(bytes.byteLength / 2));
+    for (let i = 0; i < points.length; i++) {
+        points[i] = view.getInt16(i * 2, true) * resolution;
+    }
+    return points;
+}
+
 self.addEventListener("message", event => {
     let message = null;
     const data = event.data.data;
@@ -17,17 +94,11 @@ self.addEventListener("message", event => {
             if (typeof data === "string") {
                 message = JSON.parse(data);
             } else {
-                message = SimWorldMessage.toObject(
-                    SimWorldMessage.decode(new Uint8Array(data)),
-                    { enums: String });
-                message.type = "SimWorldUpdate";
+                message = decodeSimWorld(data);
             }
             break;
         case "map":
-            message = mapMessage.toObject(
-                mapMessage.decode(new Uint8Array(data)),
-                {enums: String});
-            message.type = "MapData";
+            message = decodeMapData(data);
             break;
         case "point_cloud":
             if (typeof data === "string") {
@@ -35,6 +106,11 @@ self.addEventListener("message", event => {
             } else {
                 message = pointCloudMessage.toObject(
                     pointCloudMessage.decode(new Uint8Array(data)), {arrays: true});
+                if (message.quantizedPoints) {
+                    message.num = decodeQuantizedPoints(
+                        message.quantizedPoints, message.resolution);
+                    delete message.quantizedPoints;
+                }
             }
             break;
     }
@@ -51,6 +51,8 @@ DEFINE_double(gps_imu_timestamp_sec_diff_tolerance, 20e-3,
               "gps/imu timestamp diff tolerance (sec)");
 
 DEFINE_double(timestamp_sec_tolerance, 10e-7, "timestamp second tolerance");
+DEFINE_int32(imu_buffer_size, 400,
+             "number of imu messages kept for the gps/imu interpolation");
 // map offset
 DEFINE_double(map_offset_x, 0.0, "map_offsite: x");
 DEFINE_double(map_offset_y, 0.0, "map_offsite: y");
@@ -16,6 +16,11 @@
 
 #include "modules/localization/msf/common/util/compression.h"
 #include <gtest/gtest.h>
+#include <memory>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace apollo {
 namespace localization {
@@ -47,6 +52,96 @@ TEST_F(CompressionTestSuite, ZlibStrategyTest) {
   }
 }
 
+/**@brief Lz4StrategyTest. */
+TEST_F(CompressionTestSuite, Lz4StrategyTest) {
+  // Runs of bytes, short repeats and random bytes, split into several chunks.
+  std::vector<unsigned char> buf_uncompressed;
+  std::mt19937 random(0);
+  for (int i = 0; i < 3000; ++i) {
+    buf_uncompressed.insert(buf_uncompressed.end(), random() % 40,
+                            static_cast<unsigned char>(i));
+    for (int j = 0; j < 30; ++j) {
+      buf_uncompressed.push_back(static_cast<unsigned char>(random() % 4));
+    }
+  }
+
+  for (unsigned int thread_num : {1, 4}) {
+    Lz4Strategy lz4(10000, thread_num);
+    std::vector<unsigned char> buf_compressed;
+    std::vector<unsigned char> buf_uncompressed2;
+    ASSERT_EQ(0u, lz4.Encode(&buf_uncompressed, &buf_compressed));
+    ASSERT_LT(buf_compressed.size(), buf_uncompressed.size());
+    ASSERT_EQ(0u, lz4.Decode(&buf_compressed, &buf_uncompressed2));
+    ASSERT_EQ(buf_uncompressed, buf_uncompressed2);
+
+    // Several decodes at once share the decode threads.
+    std::vector<std::vector<unsigned char>> decoded(4);
+    std::vector<unsigned int> results(decoded.size(), 1);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        results[i] = lz4.Decode(&buf_compressed, &decoded[i]);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      ASSERT_EQ(0u, results[i]);
+      ASSERT_EQ(buf_uncompressed, decoded[i]);
+    }
+
+    // A corrupted buffer is rejected.
+    buf_compressed.resize(buf_compressed.size() - 1);
+    ASSERT_NE(0u, lz4.Decode(&buf_compressed, &buf_uncompressed2));
+  }
+
+  // A raw size in the header which the encoded chunk can't hold is rejected
+  // before the output is allocated.
+  {
+    const uint32_t header[] = {0xfffffff0u, 0xfffffff0u, 1, 4};
+    std::vector<unsigned char> buf_compressed(sizeof(header) + 4, 0);
+    memcpy(buf_compressed.data(), header, sizeof(header));
+    std::vector<unsigned char> buf_uncompressed2;
+    Lz4Strategy lz4;
+    ASSERT_NE(0u, lz4.Decode(&buf_compressed, &buf_uncompressed2));
+    ASSERT_TRUE(buf_uncompressed2.empty());
+  }
+
+  // Short and empty buffers.
+  Lz4Strategy lz4;
+  for (size_t size : {0, 1, 12, 13, 100}) {
+    std::vector<unsigned char> buf(size, 7);
+    std::vector<unsigned char> buf_compressed;
+    std::vector<unsigned char> buf2;
+    ASSERT_EQ(0u, lz4.Encode(&buf, &buf_compressed));
+    ASSERT_EQ(0u, lz4.Decode(&buf_compressed, &buf2));
+    ASSERT_EQ(buf, buf2);
+  }
+}
+
+/**@brief CodecTypeTest. */
+TEST_F(CompressionTestSuite, CodecTypeTest) {
+  const CompressionStrategy::CodecType types[] = {
+      CompressionStrategy::CODEC_NONE, CompressionStrategy::CODEC_ZLIB,
+      CompressionStrategy::CODEC_LZ4};
+  for (const CompressionStrategy::CodecType type : types) {
+    CompressionStrategy::CodecType parsed_type;
+    ASSERT_TRUE(CompressionStrategy::GetCodecType(
+        CompressionStrategy::GetCodecName(type), &parsed_type));
+    ASSERT_EQ(type, parsed_type);
+    std::unique_ptr<CompressionStrategy> strategy(
+        CompressionStrategy::Create(type));
+    if (type == CompressionStrategy::CODEC_NONE) {
+      ASSERT_TRUE(strategy == nullptr);
+    } else {
+      ASSERT_EQ(type, strategy->GetCodecType());
+    }
+  }
+  CompressionStrategy::CodecType type;
+  ASSERT_FALSE(CompressionStrategy::GetCodecType("lzma", &type));
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/common/util/voxel_grid_covariance_hdmap.h"
+#include <gtest/gtest.h>
+#include <pcl/point_types.h>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class VoxelGridCovarianceTestSuite : public ::testing::Test {
+ protected:
+  VoxelGridCovarianceTestSuite() {}
+  virtual ~VoxelGridCovarianceTestSuite() {}
+  virtual void SetUp() {
+    cloud_.reset(new pcl::PointCloud<pcl::PointXYZI>);
+    unsigned int seed = 17;
+    for (int i = 0; i < 20000; ++i) {
+      pcl::PointXYZI point;
+      seed = seed * 1103515245 + 12345;
+      point.x = static_cast<float>((seed >> 8) % 40000) / 1000.0f - 20.0f;
+      seed = seed * 1103515245 + 12345;
+      point.y = static_cast<float>((seed >> 8) % 40000) / 1000.0f - 20.0f;
+      seed = seed * 1103515245 + 12345;
+      point.z = static_cast<float>((seed >> 8) % 4000) / 1000.0f;
+      point.intensity = 0.0f;
+      cloud_->push_back(point);
+    }
+  }
+  virtual void TearDown() {}
+
+  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud_;
+};
+
+/**@brief Check the leaves against a brute force voxelization. */
+TEST_F(VoxelGridCovarianceTestSuite, SameAsBruteForce) {
+  const float leaf_size = 2.0f;
+  VoxelGridCovariance<pcl::PointXYZI> voxel_grid;
+  voxel_grid.setLeafSize(leaf_size, leaf_size, leaf_size);
+  voxel_grid.SetMinPointPerVoxel(6);
+  voxel_grid.setInputCloud(cloud_);
+  pcl::PointCloud<pcl::PointXYZI>::Ptr centroids(
+      new pcl::PointCloud<pcl::PointXYZI>);
+  voxel_grid.Filter(centroids, false);
+
+  typedef std::tuple<int, int, int> Voxel;
+  std::map<Voxel, std::pair<Eigen::Vector3d, int>> voxels;
+  for (const auto& point : cloud_->points) {
+    Voxel voxel(static_cast<int>(std::floor(point.x / leaf_size)),
+                static_cast<int>(std::floor(point.y / leaf_size)),
+                static_cast<int>(std::floor(point.z / leaf_size)));
+    auto& sum = voxels[voxel];
+    if (sum.second == 0) {
+      sum.first.setZero();
+    }
+    sum.first += Eigen::Vector3d(point.x, point.y, point.z);
+    ++sum.second;
+  }
+
+  auto& leaves = voxel_grid.GetLeaves();
+  ASSERT_EQ(leaves.size(), voxels.size());
+  for (size_t i = 1; i < leaves.size(); ++i) {
+    ASSERT_LT(leaves[i - 1].first, leaves[i].first);
+  }
+  ASSERT_EQ(centroids->size(), voxels.size());
+  for (const auto& point : cloud_->points) {
+    auto leaf = voxel_grid.GetLeaf(point);
+    ASSERT_TRUE(leaf != NULL);
+    Voxel voxel(static_cast<int>(std::floor(point.x / leaf_size)),
+                static_cast<int>(std::floor(point.y / leaf_size)),
+                static_cast<int>(std::floor(point.z / leaf_size)));
+    const auto& sum = voxels[voxel];
+    ASSERT_EQ(leaf->cloud_.size(), sum.second);
+    Eigen::Vector3d mean = sum.first / sum.second;
+    ASSERT_LT((leaf->GetMean() - mean).norm(), 1e-6);
+  }
+}
+
+/**@brief The leaves don't depend on the number of threads. */
+TEST_F(VoxelGridCovarianceTestSuite, SameWithThreads) {
+  VoxelGridCovariance<pcl::PointXYZI> serial_grid;
+  serial_grid.setLeafSize(0.5f, 0.5f, 0.5f);
+  serial_grid.SetThreadNum(1);
+  serial_grid.setInputCloud(cloud_);
+  serial_grid.Filter(false);
+
+  VoxelGridCovariance<pcl::PointXYZI> parallel_grid;
+  parallel_grid.setLeafSize(0.5f, 0.5f, 0.5f);
+  parallel_grid.SetThreadNum(4);
+  parallel_grid.setInputCloud(cloud_);
+  parallel_grid.Filter(false);
+
+  auto& serial_leaves = serial_grid.GetLeaves();
+  auto& parallel_leaves = parallel_grid.GetLeaves();
+  ASSERT_EQ(serial_leaves.size(), parallel_leaves.size());
+  for (size_t i = 0; i < serial_leaves.size(); ++i) {
+    const auto& serial_leaf = serial_leaves[i].second;
+    const auto& parallel_leaf = parallel_leaves[i].second;
+    ASSERT_EQ(serial_leaves[i].first, parallel_leaves[i].first);
+    ASSERT_EQ(serial_leaf.GetPointCount(), parallel_leaf.GetPointCount());
+    ASSERT_TRUE(serial_leaf.GetMean() == parallel_leaf.GetMean());
+    ASSERT_TRUE(serial_leaf.GetCov() == parallel_leaf.GetCov());
+    ASSERT_TRUE(serial_leaf.GetInverseCov() == parallel_leaf.GetInverseCov());
+  }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
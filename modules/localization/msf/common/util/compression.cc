@@ -17,14 +17,129 @@
 #include "modules/localization/msf/common/util/compression.h"
 
 #include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include "modules/common/log.h"
+#include "modules/localization/msf/common/util/threadpool.h"
 
 namespace apollo {
 namespace localization {
 namespace msf {
 
+namespace {
+
+// The constants of the LZ4 block format.
+const unsigned int kLz4MinMatch = 4;
+const unsigned int kLz4LastLiterals = 5;
+const unsigned int kLz4MatchFindLimit = 12;
+const unsigned int kLz4MaxOffset = 65535;
+const unsigned int kLz4HashLog = 16;
+// A byte of an encoded block decodes to at most 255 bytes, so a larger raw
+// size in the header is corrupted.
+const uint64_t kLz4MaxRatio = 255;
+
+inline uint32_t Read32(const unsigned char* p) {
+  uint32_t value = 0;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline void Write32(uint32_t value, unsigned char* p) {
+  memcpy(p, &value, sizeof(value));
+}
+
+inline uint32_t Lz4Hash(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kLz4HashLog);
+}
+
+inline unsigned char* WriteLz4Length(unsigned int length, unsigned char* op) {
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = static_cast<unsigned char>(length);
+  return op;
+}
+
+inline bool ReadLz4Length(const unsigned char** ip, const unsigned char* iend,
+                          size_t* length) {
+  unsigned char byte = 255;
+  while (byte == 255) {
+    if (*ip >= iend) {
+      return false;
+    }
+    byte = *(*ip)++;
+    *length += byte;
+  }
+  return true;
+}
+
+// The decode threads shared by all the LZ4 codecs, so that loading the map
+// nodes from several threads doesn't multiply the threads. It is never
+// destroyed, as codecs may decode until the exit.
+ThreadPool* Lz4DecodePool() {
+  static ThreadPool* pool =
+      new ThreadPool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+  return pool;
+}
+
+// The chunks of a decode which are not taken yet or not done yet. The pool
+// tasks keep it alive, since they may start after the decode returned.
+struct Lz4DecodeJob {
+  std::atomic<unsigned int> next_chunk;
+  unsigned int done_num = 0;
+  std::mutex mutex;
+  std::condition_variable done;
+};
+
+}  // namespace
+
+CompressionStrategy* CompressionStrategy::Create(CodecType type) {
+  switch (type) {
+    case CODEC_ZLIB:
+      return new ZlibStrategy();
+    case CODEC_LZ4:
+      return new Lz4Strategy();
+    default:
+      return nullptr;
+  }
+}
+
+bool CompressionStrategy::GetCodecType(const std::string& name,
+                                       CodecType* type) {
+  if (name == "none") {
+    *type = CODEC_NONE;
+  } else if (name == "zlib") {
+    *type = CODEC_ZLIB;
+  } else if (name == "lz4") {
+    *type = CODEC_LZ4;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::string CompressionStrategy::GetCodecName(CodecType type) {
+  switch (type) {
+    case CODEC_NONE:
+      return "none";
+    case CODEC_ZLIB:
+      return "zlib";
+    case CODEC_LZ4:
+      return "lz4";
+    default:
+      return "unknown";
+  }
+}
+
 const unsigned int ZlibStrategy::zlib_chunk = 16384;
 
 unsigned int ZlibStrategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
@@ -153,6 +268,234 @@ unsigned int ZlibStrategy::ZlibUncompress(BufferStr* src, BufferStr* dst) {
   return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
 }
 
+Lz4Strategy::Lz4Strategy(unsigned int chunk_size, unsigned int thread_num)
+    : chunk_size_(std::max(chunk_size, 1u)), thread_num_(thread_num) {
+  if (thread_num_ == 0) {
+    thread_num_ = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+}
+
+unsigned int Lz4Strategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
+  const unsigned int raw_size = buf->size();
+  const unsigned int chunk_num = (raw_size + chunk_size_ - 1) / chunk_size_;
+  const unsigned int header_size = (3 + chunk_num) * sizeof(uint32_t);
+  buf_compressed->resize(header_size + GetMaxBlockSize(raw_size) +
+                         chunk_num * GetMaxBlockSize(0));
+  unsigned char* dst = buf_compressed->data();
+  Write32(raw_size, dst);
+  Write32(chunk_size_, dst + sizeof(uint32_t));
+  Write32(chunk_num, dst + 2 * sizeof(uint32_t));
+
+  unsigned int dst_idx = header_size;
+  for (unsigned int i = 0; i < chunk_num; ++i) {
+    const unsigned int src_idx = i * chunk_size_;
+    const unsigned int size = std::min(chunk_size_, raw_size - src_idx);
+    const unsigned int encoded_size =
+        CompressBlock(buf->data() + src_idx, size, dst + dst_idx);
+    Write32(encoded_size, dst + (3 + i) * sizeof(uint32_t));
+    dst_idx += encoded_size;
+  }
+  buf_compressed->resize(dst_idx);
+  return 0;
+}
+
+unsigned int Lz4Strategy::Decode(BufferStr* buf, BufferStr* buf_uncompressed) {
+  const unsigned char* src = buf->data();
+  const size_t src_size = buf->size();
+  if (src_size < 3 * sizeof(uint32_t)) {
+    return 1;
+  }
+  const unsigned int raw_size = Read32(src);
+  const unsigned int chunk_size = Read32(src + sizeof(uint32_t));
+  const unsigned int chunk_num = Read32(src + 2 * sizeof(uint32_t));
+  const size_t header_size =
+      (3 + static_cast<size_t>(chunk_num)) * sizeof(uint32_t);
+  if (chunk_size == 0 || src_size < header_size ||
+      chunk_num != (raw_size + static_cast<size_t>(chunk_size) - 1) /
+                       chunk_size) {
+    return 1;
+  }
+
+  // The offset of each encoded chunk.
+  std::vector<size_t> offsets(chunk_num + 1, header_size);
+  for (unsigned int i = 0; i < chunk_num; ++i) {
+    const uint32_t encoded_size = Read32(src + (3 + i) * sizeof(uint32_t));
+    if (std::min(chunk_size, raw_size - i * chunk_size) >
+        encoded_size * kLz4MaxRatio) {
+      return 1;
+    }
+    offsets[i + 1] = offsets[i] + encoded_size;
+  }
+  if (offsets[chunk_num] != src_size) {
+    return 1;
+  }
+
+  buf_uncompressed->resize(raw_size);
+  unsigned char* dst = buf_uncompressed->data();
+  std::vector<char> is_chunk_valid(chunk_num, 0);
+  std::shared_ptr<Lz4DecodeJob> job(new Lz4DecodeJob());
+  job->next_chunk = 0;
+  // The buffers are only touched for a taken chunk, and the decode waits
+  // until all the taken chunks are done.
+  auto decode_chunks = [=, &offsets, &is_chunk_valid]() {
+    for (unsigned int i = job->next_chunk++; i < chunk_num;
+         i = job->next_chunk++) {
+      const unsigned int dst_idx = i * chunk_size;
+      is_chunk_valid[i] = DecompressBlock(
+          src + offsets[i], offsets[i + 1] - offsets[i], dst + dst_idx,
+          std::min(chunk_size, raw_size - dst_idx));
+      std::lock_guard<std::mutex> lock(job->mutex);
+      if (++job->done_num == chunk_num) {
+        job->done.notify_all();
+      }
+    }
+  };
+
+  const unsigned int thread_num = std::min(thread_num_, chunk_num);
+  for (unsigned int i = 1; i < thread_num; ++i) {
+    Lz4DecodePool()->schedule(decode_chunks);
+  }
+  decode_chunks();
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->done.wait(lock, [&job, chunk_num]() {
+      return job->done_num == chunk_num;
+    });
+  }
+  for (const char is_valid : is_chunk_valid) {
+    if (!is_valid) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+unsigned int Lz4Strategy::CompressBlock(const unsigned char* src,
+                                        unsigned int src_size,
+                                        unsigned char* dst) {
+  unsigned char* op = dst;
+  unsigned int anchor = 0;
+  if (src_size > kLz4MatchFindLimit) {
+    // The last match starts before the find limit and ends before the last
+    // literals, as required by the format.
+    const unsigned int find_limit = src_size - kLz4MatchFindLimit;
+    const unsigned int match_limit = src_size - kLz4LastLiterals;
+    std::vector<uint32_t> hash_table(1 << kLz4HashLog, 0);
+    unsigned int ip = 0;
+    while (ip < find_limit) {
+      const uint32_t sequence = Read32(src + ip);
+      uint32_t& entry = hash_table[Lz4Hash(sequence)];
+      const unsigned int ref = entry;
+      entry = ip;
+      if (ref >= ip || ip - ref > kLz4MaxOffset ||
+          Read32(src + ref) != sequence) {
+        // Skip faster in the data which doesn't compress.
+        ip += 1 + ((ip - anchor) >> 6);
+        continue;
+      }
+      unsigned int match_length = kLz4MinMatch;
+      while (ip + match_length < match_limit &&
+             src[ref + match_length] == src[ip + match_length]) {
+        ++match_length;
+      }
+
+      const unsigned int literal_length = ip - anchor;
+      unsigned char* token = op++;
+      *token = static_cast<unsigned char>(std::min(literal_length, 15u) << 4);
+      if (literal_length >= 15) {
+        op = WriteLz4Length(literal_length - 15, op);
+      }
+      memcpy(op, src + anchor, literal_length);
+      op += literal_length;
+      const unsigned int offset = ip - ref;
+      *op++ = static_cast<unsigned char>(offset & 0xff);
+      *op++ = static_cast<unsigned char>(offset >> 8);
+      const unsigned int length_code = match_length - kLz4MinMatch;
+      *token |= static_cast<unsigned char>(std::min(length_code, 15u));
+      if (length_code >= 15) {
+        op = WriteLz4Length(length_code - 15, op);
+      }
+      ip += match_length;
+      anchor = ip;
+    }
+  }
+
+  // The last sequence only has literals.
+  const unsigned int literal_length = src_size - anchor;
+  *op++ = static_cast<unsigned char>(std::min(literal_length, 15u) << 4);
+  if (literal_length >= 15) {
+    op = WriteLz4Length(literal_length - 15, op);
+  }
+  if (literal_length > 0) {
+    memcpy(op, src + anchor, literal_length);
+    op += literal_length;
+  }
+  return op - dst;
+}
+
+bool Lz4Strategy::DecompressBlock(const unsigned char* src,
+                                  unsigned int src_size, unsigned char* dst,
+                                  unsigned int dst_size) {
+  const unsigned char* ip = src;
+  const unsigned char* iend = src + src_size;
+  unsigned char* op = dst;
+  unsigned char* oend = dst + dst_size;
+  while (ip < iend) {
+    const unsigned int token = *ip++;
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !ReadLz4Length(&ip, iend, &literal_length)) {
+      return false;
+    }
+    if (literal_length > static_cast<size_t>(iend - ip) ||
+        literal_length > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+    memcpy(op, ip, literal_length);
+    op += literal_length;
+    ip += literal_length;
+    if (ip == iend) {
+      break;
+    }
+
+    if (iend - ip < 2) {
+      return false;
+    }
+    const size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+      return false;
+    }
+    size_t match_length = token & 15;
+    if (match_length == 15 && !ReadLz4Length(&ip, iend, &match_length)) {
+      return false;
+    }
+    match_length += kLz4MinMatch;
+    if (match_length > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+    const unsigned char* match = op - offset;
+    if (offset >= match_length) {
+      memcpy(op, match, match_length);
+    } else {
+      // The match overlaps the output, it repeats the last offset bytes.
+      // Copy one period, then double the copied periods.
+      memcpy(op, match, offset);
+      size_t copied = offset;
+      while (copied < match_length) {
+        const size_t size = std::min(copied, match_length - copied);
+        memcpy(op + copied, op, size);
+        copied += size;
+      }
+    }
+    op += match_length;
+  }
+  return op == oend;
+}
+
+unsigned int Lz4Strategy::GetMaxBlockSize(unsigned int src_size) {
+  return src_size + src_size / 255 + 16;
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
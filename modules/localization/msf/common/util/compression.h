@@ -17,6 +17,7 @@
 #ifndef MODULES_LOCALIZATION_MSF_COMMON_COMPRESSION_H_
 #define MODULES_LOCALIZATION_MSF_COMMON_COMPRESSION_H_
 
+#include <string>
 #include <vector>
 
 namespace apollo {
@@ -26,9 +27,23 @@ namespace msf {
 class CompressionStrategy {
  public:
   typedef std::vector<unsigned char> BufferStr;
+  /**@brief The codec ids, they are stored in the map node files. */
+  enum CodecType { CODEC_NONE = 0, CODEC_ZLIB = 1, CODEC_LZ4 = 2 };
+
   virtual ~CompressionStrategy() {}
+  /**@brief Encode or decode the buffer.
+   * @param <return> Zero on success.
+   */
   virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed) = 0;
   virtual unsigned int Decode(BufferStr* buf, BufferStr* buf_uncompressed) = 0;
+  virtual CodecType GetCodecType() const = 0;
+
+  /**@brief Create the strategy of a codec, nullptr for CODEC_NONE or an
+   * unknown codec. The caller owns the strategy. */
+  static CompressionStrategy* Create(CodecType type);
+  /**@brief Get the codec from its name: "none", "zlib" or "lz4". */
+  static bool GetCodecType(const std::string& name, CodecType* type);
+  static std::string GetCodecName(CodecType type);
 
  protected:
 };
@@ -37,6 +52,7 @@ class ZlibStrategy : public CompressionStrategy {
  public:
   virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
   virtual unsigned int Decode(BufferStr* buf, BufferStr* buf_uncompressed);
+  virtual CodecType GetCodecType() const { return CODEC_ZLIB; }
 
  protected:
   static const unsigned int zlib_chunk;
@@ -44,6 +60,39 @@ class ZlibStrategy : public CompressionStrategy {
   unsigned int ZlibUncompress(BufferStr* src, BufferStr* dst);
 };
 
+/**@brief A fast codec in the LZ4 block format. The buffer is split into
+ * chunks which are compressed independently, so the chunks of a large buffer
+ * are decoded in parallel, on a thread pool shared by all the codecs.
+ * The encoded buffer is: the raw size, the chunk size, the number of chunks,
+ * the encoded size of each chunk, and then the encoded chunks. All the sizes
+ * are 32 bits unsigned integers.
+ */
+class Lz4Strategy : public CompressionStrategy {
+ public:
+  /**@param <thread_num> The max number of decode threads, 0 for the number
+   * of cores. */
+  explicit Lz4Strategy(unsigned int chunk_size = 1 << 20,
+                       unsigned int thread_num = 0);
+  virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
+  virtual unsigned int Decode(BufferStr* buf, BufferStr* buf_uncompressed);
+  virtual CodecType GetCodecType() const { return CODEC_LZ4; }
+
+  /**@brief Compress a block, return the encoded size. The dst must hold
+   * GetMaxBlockSize(src_size) bytes. */
+  static unsigned int CompressBlock(const unsigned char* src,
+                                    unsigned int src_size, unsigned char* dst);
+  /**@brief Decompress a block into exactly dst_size bytes.
+   * @param <return> False if the block is corrupted.
+   */
+  static bool DecompressBlock(const unsigned char* src, unsigned int src_size,
+                              unsigned char* dst, unsigned int dst_size);
+  static unsigned int GetMaxBlockSize(unsigned int src_size);
+
+ protected:
+  unsigned int chunk_size_;
+  unsigned int thread_num_;
+};
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
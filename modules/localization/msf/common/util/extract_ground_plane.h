@@ -95,7 +95,7 @@ class FeatureXYPlane {
 
       PointCloudT cloud_tmp;
       int plane_num = 0;
-      typename std::map<size_t, VoxelGridCovariance<PointT>::Leaf>::iterator it;
+      VoxelGridCovariance<PointT>::LeafList::iterator it;
       for (it = vgc.GetLeaves().begin(); it != vgc.GetLeaves().end(); it++) {
         if (it->second.GetPointCount() < min_planepoints_number_) {
           cloud_tmp += it->second.cloud_;
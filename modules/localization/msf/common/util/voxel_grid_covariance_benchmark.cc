@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the voxelization of a lidar frame by VoxelGridCovariance
+ *        with different leaf sizes and thread numbers.
+ */
+
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/localization/msf/common/util/voxel_grid_covariance_hdmap.h"
+
+DEFINE_string(pcd_path,
+              "modules/perception/data/cnnseg_test/"
+              "uscar_12_1470770225_1470770492_1349.pcd",
+              "The lidar frame to voxelize.");
+DEFINE_int32(benchmark_num_runs, 50, "Number of runs per configuration.");
+DEFINE_int32(benchmark_max_thread_num, 4,
+             "The largest number of threads to measure.");
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace {
+
+typedef pcl::PointXYZI PointT;
+
+double Run(const pcl::PointCloud<PointT>::Ptr& cloud, const float leaf_size,
+           const int thread_num, size_t* leaf_num) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FLAGS_benchmark_num_runs; ++i) {
+    VoxelGridCovariance<PointT> voxel_grid;
+    voxel_grid.setLeafSize(leaf_size, leaf_size, leaf_size);
+    voxel_grid.SetThreadNum(thread_num);
+    voxel_grid.setInputCloud(cloud);
+    voxel_grid.Filter(false);
+    *leaf_num = voxel_grid.GetLeaves().size();
+  }
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count() / FLAGS_benchmark_num_runs;
+}
+
+}  // namespace
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  using apollo::localization::msf::PointT;
+  using apollo::localization::msf::Run;
+
+  pcl::PointCloud<PointT>::Ptr cloud(new pcl::PointCloud<PointT>);
+  if (pcl::io::loadPCDFile(FLAGS_pcd_path, *cloud) < 0) {
+    std::cerr << "Failed to load " << FLAGS_pcd_path << std::endl;
+    return 1;
+  }
+  std::cout << "points: " << cloud->size() << std::endl;
+  std::cout << std::setw(10) << "leaf_size" << std::setw(10) << "threads"
+            << std::setw(10) << "leaves" << std::setw(12) << "ms/frame"
+            << std::endl;
+  const std::vector<float> leaf_sizes = {4.0f, 2.0f, 1.0f, 0.5f};
+  for (const float leaf_size : leaf_sizes) {
+    for (int thread_num = 1; thread_num <= FLAGS_benchmark_max_thread_num;
+         thread_num *= 2) {
+      size_t leaf_num = 0;
+      const double ms = Run(cloud, leaf_size, thread_num, &leaf_num);
+      std::cout << std::setw(10) << leaf_size << std::setw(10) << thread_num
+                << std::setw(10) << leaf_num << std::setw(12) << std::fixed
+                << std::setprecision(3) << ms << std::endl;
+      std::cout.unsetf(std::ios::fixed);
+    }
+  }
+  return 0;
+}
@@ -23,8 +23,10 @@
 #include <pcl/kdtree/kdtree_flann.h>
 #include <Eigen/Cholesky>
 #include <Eigen/Dense>
+#include <algorithm>
 #include <limits>
-#include <map>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace apollo {
@@ -121,12 +123,15 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
   typedef Leaf* LeafPtr;
   // Const pointer to VoxelGridCovariance leaf structure.
   typedef const Leaf* LeafConstPtr;
+  // Leaves with their leaf indices.
+  typedef std::vector<std::pair<size_t, Leaf>> LeafList;
 
  public:
   VoxelGridCovariance()
       : searchable_(true),
         min_points_per_voxel_(6),
         min_covar_eigvalue_mult_(0.01),
+        thread_num_(1),
         leaves_(),
         voxel_centroids_(),
         voxel_centroidsleaf_indices_(),
@@ -184,13 +189,7 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
 
   // Get the voxel containing point p.
   inline LeafConstPtr GetLeaf(int index) {
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(index);
-    if (leaf_iter != leaves_.end()) {
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
-      return NULL;
-    }
+    return FindLeaf(static_cast<size_t>(index));
   }
 
   // Get the voxel containing point p.
@@ -204,14 +203,7 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
 
     // Find leaf associated with index
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(idx);
-    if (leaf_iter != leaves_.end()) {
-      // If such a leaf exists return the pointer to the leaf structure
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
-      return NULL;
-    }
+    return FindLeaf(static_cast<size_t>(idx));
   }
 
   // Get the voxel containing point p.
@@ -228,20 +220,35 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
 
     // Find leaf associated with index
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(idx);
-    if (leaf_iter != leaves_.end()) {
+    return FindLeaf(static_cast<size_t>(idx));
+  }
+
+  // Get the leaves sorted by the leaf index.
+  inline LeafList& GetLeaves() { return leaves_; }
+
+  // Set the number of threads to compute the voxel covariances. It is 1 by
+  // default, since the filter is mostly run from worker threads, e.g. by
+  // FeatureXYPlane inside the LosslessMapBuilder tasks.
+  inline void SetThreadNum(int thread_num) {
+    thread_num_ = std::max(thread_num, 1);
+  }
+
+ private:
+  // Find the leaf by binary search in the sorted leaves.
+  inline LeafConstPtr FindLeaf(size_t index) const {
+    typename LeafList::const_iterator leaf_iter = std::lower_bound(
+        leaves_.begin(), leaves_.end(), index,
+        [](const std::pair<size_t, Leaf>& leaf, size_t idx) {
+          return leaf.first < idx;
+        });
+    if (leaf_iter != leaves_.end() && leaf_iter->first == index) {
       // If such a leaf exists return the pointer to the leaf structure
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
+      return &(leaf_iter->second);
     } else {
       return NULL;
     }
   }
 
-  // Get the leaf structure map.
-  inline std::map<size_t, Leaf>& GetLeaves() { return leaves_; }
-
- private:
   // Filter cloud and initializes voxel structure.
   void ApplyFilter(PointCloudPtr output) {
     voxel_centroidsleaf_indices_.clear();
@@ -317,32 +324,45 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     }
     // If we don't want to process the entire cloud,
     // but rather filter points far away from the viewpoint first.
+    std::vector<pcl::PCLPointField> distance_fields;
+    int distance_idx = -1;
     if (!filter_field_name_.empty()) {
       // Get the distance field index
-      std::vector<pcl::PCLPointField> fields;
-      int distance_idx =
-          pcl::getFieldIndex(*input_, filter_field_name_, fields);
+      distance_idx =
+          pcl::getFieldIndex(*input_, filter_field_name_, distance_fields);
       if (distance_idx == -1) {
         PCL_WARN(
             "[pcl::%s::ApplyFilter] Invalid filter field name. Index is %d.\n",
             getClassName().c_str(), distance_idx);
         return;
       }
-      // First pass: go over all points and insert them into the right leaf
-      for (size_t cp = 0; cp < input_->points.size(); ++cp) {
-        if (!input_->is_dense) {
-          // Check if the point is invalid
-          if (!pcl_isfinite(input_->points[cp].x) ||
-              !pcl_isfinite(input_->points[cp].y) ||
-              !pcl_isfinite(input_->points[cp].z)) {
-            continue;
-          }
+    }
+
+    // First pass: compute the leaf index of every point, and number the
+    // distinct leaf indices in an open addressing hash table.
+    size_t table_size = 16;
+    while (table_size < input_->points.size() * 2) {
+      table_size <<= 1;
+    }
+    std::vector<int> table(table_size, -1);
+    std::vector<size_t> leaf_indices;
+    std::vector<size_t> leaf_point_nums;
+    std::vector<std::pair<size_t, int>> point_slots;
+    point_slots.reserve(input_->points.size());
+    for (size_t cp = 0; cp < input_->points.size(); ++cp) {
+      const PointT& point = input_->points[cp];
+      if (!input_->is_dense) {
+        // Check if the point is invalid
+        if (!pcl_isfinite(point.x) || !pcl_isfinite(point.y) ||
+            !pcl_isfinite(point.z)) {
+          continue;
         }
+      }
+      if (distance_idx >= 0) {
         // Get the distance value
-        const uint8_t* pt_data =
-            reinterpret_cast<const uint8_t*>(&input_->points[cp]);
+        const uint8_t* pt_data = reinterpret_cast<const uint8_t*>(&point);
         float distance_value = 0;
-        memcpy(&distance_value, pt_data + fields[distance_idx].offset,
+        memcpy(&distance_value, pt_data + distance_fields[distance_idx].offset,
                sizeof(float));
 
         if (filter_limit_negative_) {
@@ -358,134 +378,91 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
             continue;
           }
         }
+      }
 
-        int ijk0 = static_cast<int>(
-            floor(input_->points[cp].x * inverse_leaf_size_[0]) -
-            static_cast<float>(min_b_[0]));
-        int ijk1 = static_cast<int>(
-            floor(input_->points[cp].y * inverse_leaf_size_[1]) -
-            static_cast<float>(min_b_[1]));
-        int ijk2 = static_cast<int>(
-            floor(input_->points[cp].z * inverse_leaf_size_[2]) -
-            static_cast<float>(min_b_[2]));
-        // Compute the centroid leaf index
-        int idx =
-            ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-        Leaf& leaf = leaves_[idx];
-        if (leaf.nr_points_ == 0) {
-          leaf.centroid.resize(centroid_size);
-          leaf.centroid.setZero();
-        }
+      int ijk0 = static_cast<int>(floor(point.x * inverse_leaf_size_[0]) -
+                                  static_cast<float>(min_b_[0]));
+      int ijk1 = static_cast<int>(floor(point.y * inverse_leaf_size_[1]) -
+                                  static_cast<float>(min_b_[1]));
+      int ijk2 = static_cast<int>(floor(point.z * inverse_leaf_size_[2]) -
+                                  static_cast<float>(min_b_[2]));
+
+      // Compute the centroid leaf index
+      int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
+      const size_t leaf_index = static_cast<size_t>(idx);
+
+      // Linear probing from the hashed position
+      size_t pos = (leaf_index * 0x9E3779B97F4A7C15ULL) & (table_size - 1);
+      while (table[pos] >= 0 && leaf_indices[table[pos]] != leaf_index) {
+        pos = (pos + 1) & (table_size - 1);
+      }
+      if (table[pos] < 0) {
+        table[pos] = static_cast<int>(leaf_indices.size());
+        leaf_indices.push_back(leaf_index);
+        leaf_point_nums.push_back(0);
+      }
+      ++leaf_point_nums[table[pos]];
+      point_slots.emplace_back(cp, table[pos]);
+    }
 
-        //! added by wangcheng
-        leaf.cloud_.points.push_back(input_->points[cp]);
-
-        Eigen::Vector3d pt3d(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z);
-        // Accumulate point sum for centroid calculation
-        leaf.mean_ += pt3d;
-        // Accumulate x*xT for single pass covariance calculation
-        leaf.cov_ += pt3d * pt3d.transpose();
-
-        // Do we need to process all the fields?
-        if (!downsample_all_data_) {
-          Eigen::Vector4f pt(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z, 0);
-          leaf.centroid.template head<4>() += pt;
-        } else {
-          // Copy all the fields
-          Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
-          pcl::for_each_type<FieldList>(pcl::NdCopyPointEigenFunctor<PointT>(
-              input_->points[cp], centroid));
-          // ---[ RGB special case
-          if (rgba_index >= 0) {
-            // Fill r/g/b data, assuming that the order is BGRA
-            const pcl::RGB& rgb = *reinterpret_cast<const pcl::RGB*>(
-                reinterpret_cast<const char*>(&input_->points[cp]) +
-                rgba_index);
-            centroid[centroid_size - 4] = rgb.a;
-            centroid[centroid_size - 3] = rgb.r;
-            centroid[centroid_size - 2] = rgb.g;
-            centroid[centroid_size - 1] = rgb.b;
-          }
-          leaf.centroid += centroid;
-        }
-        ++leaf.nr_points_;
+    // Sort the leaves by the leaf index, and bucket the points by leaf in the
+    // input order.
+    std::vector<int> sorted_slots(leaf_indices.size());
+    for (size_t i = 0; i < sorted_slots.size(); ++i) {
+      sorted_slots[i] = static_cast<int>(i);
+    }
+    std::sort(sorted_slots.begin(), sorted_slots.end(),
+              [&leaf_indices](int lhs, int rhs) {
+                return leaf_indices[lhs] < leaf_indices[rhs];
+              });
+    std::vector<size_t> slot_offsets(leaf_indices.size());
+    std::vector<size_t> leaf_begins(sorted_slots.size() + 1, 0);
+    for (size_t i = 0; i < sorted_slots.size(); ++i) {
+      leaf_begins[i + 1] = leaf_begins[i] + leaf_point_nums[sorted_slots[i]];
+      slot_offsets[sorted_slots[i]] = leaf_begins[i];
+    }
+    std::vector<size_t> sorted_points(point_slots.size());
+    for (const auto& point_slot : point_slots) {
+      sorted_points[slot_offsets[point_slot.second]++] = point_slot.first;
+    }
+
+    // Second pass: accumulate the points of every leaf.
+    leaves_.resize(sorted_slots.size());
+    for (size_t i = 0; i < sorted_slots.size(); ++i) {
+      leaves_[i].first = leaf_indices[sorted_slots[i]];
+      Leaf& leaf = leaves_[i].second;
+      leaf.centroid.resize(centroid_size);
+      leaf.centroid.setZero();
+      leaf.cloud_.points.reserve(leaf_begins[i + 1] - leaf_begins[i]);
+      for (size_t j = leaf_begins[i]; j < leaf_begins[i + 1]; ++j) {
+        AddPoint(input_->points[sorted_points[j]], centroid_size, rgba_index,
+                 &leaf);
       }
-    } else {  // No distance filtering, process all data
-      // First pass: go over all points and insert them into the right leaf
-      for (size_t cp = 0; cp < input_->points.size(); ++cp) {
-        if (!input_->is_dense) {
-          // Check if the point is invalid
-          if (!pcl_isfinite(input_->points[cp].x) ||
-              !pcl_isfinite(input_->points[cp].y) ||
-              !pcl_isfinite(input_->points[cp].z)) {
-            continue;
-          }
-        }
-        int ijk0 = static_cast<int>(
-            floor(input_->points[cp].x * inverse_leaf_size_[0]) -
-            static_cast<float>(min_b_[0]));
-        int ijk1 = static_cast<int>(
-            floor(input_->points[cp].y * inverse_leaf_size_[1]) -
-            static_cast<float>(min_b_[1]));
-        int ijk2 = static_cast<int>(
-            floor(input_->points[cp].z * inverse_leaf_size_[2]) -
-            static_cast<float>(min_b_[2]));
-
-        // Compute the centroid leaf index
-        int idx =
-            ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-        // int idx = (((input_->points[cp].getArray4fmap () *
-        // inverse_leaf_size_).template cast<int> ()).matrix ()
-        //    - min_b_).dot (divb_mul_);
-
-        Leaf& leaf = leaves_[idx];
-        if (leaf.nr_points_ == 0) {
-          leaf.centroid.resize(centroid_size);
-          leaf.centroid.setZero();
-        }
+    }
 
-        //! added by wangcheng
-        leaf.cloud_.points.push_back(input_->points[cp]);
-
-        Eigen::Vector3d pt3d(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z);
-        // Accumulate point sum for centroid calculation
-        leaf.mean_ += pt3d;
-        // Accumulate x*xT for single pass covariance calculation
-        leaf.cov_ += pt3d * pt3d.transpose();
-
-        // Do we need to process all the fields?
-        if (!downsample_all_data_) {
-          Eigen::Vector4f pt(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z, 0);
-          leaf.centroid.template head<4>() += pt;
-        } else {
-          // Copy all the fields
-          Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
-          pcl::for_each_type<FieldList>(pcl::NdCopyPointEigenFunctor<PointT>(
-              input_->points[cp], centroid));
-          // ---[ RGB special case
-          if (rgba_index >= 0) {
-            // Fill r/g/b data, assuming that the order is BGRA
-            const pcl::RGB& rgb = *reinterpret_cast<const pcl::RGB*>(
-                reinterpret_cast<const char*>(&input_->points[cp]) +
-                rgba_index);
-            centroid[centroid_size - 4] = rgb.a;
-            centroid[centroid_size - 3] = rgb.r;
-            centroid[centroid_size - 2] = rgb.g;
-            centroid[centroid_size - 1] = rgb.b;
-          }
-          leaf.centroid += centroid;
-        }
-        ++leaf.nr_points_;
+    // Third pass: compute centroids and covariance of the leaves in parallel.
+    std::vector<char> has_enough_points(leaves_.size(), 0);
+    auto compute_leaves = [this, &has_enough_points](size_t begin,
+                                                     size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        has_enough_points[i] = ComputeLeaf(&leaves_[i].second);
       }
+    };
+    const size_t thread_num = std::max<size_t>(
+        std::min<size_t>(thread_num_, leaves_.size() / kMinLeavesPerThread),
+        1);
+    const size_t chunk_size = (leaves_.size() + thread_num - 1) / thread_num;
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_num; ++i) {
+      threads.emplace_back(compute_leaves, i * chunk_size,
+                           std::min(leaves_.size(), (i + 1) * chunk_size));
+    }
+    compute_leaves(0, std::min(leaves_.size(), chunk_size));
+    for (auto& thread : threads) {
+      thread.join();
     }
 
-    // Second pass: go over all leaves and compute centroids and covariance
+    // Collect the centroids of the leaves in the order of the leaf index.
     output->points.reserve(leaves_.size());
     if (searchable_) {
       voxel_centroidsleaf_indices_.reserve(leaves_.size());
@@ -494,94 +471,134 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     if (save_leaf_layout_) {
       leaf_layout_.resize(div_b_[0] * div_b_[1] * div_b_[2], -1);
     }
-    // Eigen values and vectors calculated to prevent near singluar matrices
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver;
-    Eigen::Matrix3d eigen_val;
-    Eigen::Vector3d pt_sum;
-
-    // Eigen values less than a threshold of max eigen value are
-    // inflated to a set fraction of the max eigen value.
-    double min_covar_eigvalue;
-
-    for (typename std::map<size_t, Leaf>::iterator it = leaves_.begin();
-         it != leaves_.end(); ++it) {
-      // Normalize the centroid
-      Leaf& leaf = it->second;
-
-      // Normalize the centroid
-      leaf.centroid /= static_cast<float>(leaf.nr_points_);
-      // Point sum used for single pass covariance calculation
-      pt_sum = leaf.mean_;
-      // Normalize mean
-      leaf.mean_ /= leaf.nr_points_;
-
-      if (leaf.nr_points_ >= min_points_per_voxel_) {
-        if (save_leaf_layout_) {
-          leaf_layout_[it->first] = cp++;
-        }
-        output->push_back(PointT());
-        // Do we need to process all the fields?
-        if (!downsample_all_data_) {
-          output->points.back().x = leaf.centroid[0];
-          output->points.back().y = leaf.centroid[1];
-          output->points.back().z = leaf.centroid[2];
-        } else {
-          pcl::for_each_type<FieldList>(pcl::NdCopyEigenPointFunctor<PointT>(
-              leaf.centroid, output->back()));
-          // ---[ RGB special case
-          if (rgba_index >= 0) {
-            pcl::RGB& rgb = *reinterpret_cast<pcl::RGB*>(
-                reinterpret_cast<char*>(&output->points.back()) + rgba_index);
-            rgb.a = leaf.centroid[centroid_size - 4];
-            rgb.r = leaf.centroid[centroid_size - 3];
-            rgb.g = leaf.centroid[centroid_size - 2];
-            rgb.b = leaf.centroid[centroid_size - 1];
-          }
+    for (size_t i = 0; i < leaves_.size(); ++i) {
+      if (!has_enough_points[i]) {
+        continue;
+      }
+      const Leaf& leaf = leaves_[i].second;
+      if (save_leaf_layout_) {
+        leaf_layout_[leaves_[i].first] = cp++;
+      }
+      output->push_back(PointT());
+      // Do we need to process all the fields?
+      if (!downsample_all_data_) {
+        output->points.back().x = leaf.centroid[0];
+        output->points.back().y = leaf.centroid[1];
+        output->points.back().z = leaf.centroid[2];
+      } else {
+        pcl::for_each_type<FieldList>(pcl::NdCopyEigenPointFunctor<PointT>(
+            leaf.centroid, output->back()));
+        // ---[ RGB special case
+        if (rgba_index >= 0) {
+          pcl::RGB& rgb = *reinterpret_cast<pcl::RGB*>(
+              reinterpret_cast<char*>(&output->points.back()) + rgba_index);
+          rgb.a = leaf.centroid[centroid_size - 4];
+          rgb.r = leaf.centroid[centroid_size - 3];
+          rgb.g = leaf.centroid[centroid_size - 2];
+          rgb.b = leaf.centroid[centroid_size - 1];
         }
+      }
 
-        // Stores the voxel indice for fast access searching
-        if (searchable_) {
-          voxel_centroidsleaf_indices_.push_back(static_cast<int>(it->first));
-        }
+      // Stores the voxel indice for fast access searching
+      if (searchable_) {
+        voxel_centroidsleaf_indices_.push_back(
+            static_cast<int>(leaves_[i].first));
+      }
+    }
+    output->width = static_cast<uint32_t>(output->points.size());
+  }
 
-        // Single pass covariance calculation
-        leaf.cov_ = (leaf.cov_ - 2 * (pt_sum * leaf.mean_.transpose())) /
-                        leaf.nr_points_ +
-                    leaf.mean_ * leaf.mean_.transpose();
-        leaf.cov_ *= (leaf.nr_points_ - 1.0) / leaf.nr_points_;
+  // Accumulate a point into the leaf.
+  void AddPoint(const PointT& point, int centroid_size, int rgba_index,
+                Leaf* leaf) const {
+    //! added by wangcheng
+    leaf->cloud_.points.push_back(point);
+
+    Eigen::Vector3d pt3d(point.x, point.y, point.z);
+    // Accumulate point sum for centroid calculation
+    leaf->mean_ += pt3d;
+    // Accumulate x*xT for single pass covariance calculation
+    leaf->cov_ += pt3d * pt3d.transpose();
+
+    // Do we need to process all the fields?
+    if (!downsample_all_data_) {
+      Eigen::Vector4f pt(point.x, point.y, point.z, 0);
+      leaf->centroid.template head<4>() += pt;
+    } else {
+      // Copy all the fields
+      Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
+      pcl::for_each_type<FieldList>(
+          pcl::NdCopyPointEigenFunctor<PointT>(point, centroid));
+      // ---[ RGB special case
+      if (rgba_index >= 0) {
+        // Fill r/g/b data, assuming that the order is BGRA
+        const pcl::RGB& rgb = *reinterpret_cast<const pcl::RGB*>(
+            reinterpret_cast<const char*>(&point) + rgba_index);
+        centroid[centroid_size - 4] = rgb.a;
+        centroid[centroid_size - 3] = rgb.r;
+        centroid[centroid_size - 2] = rgb.g;
+        centroid[centroid_size - 1] = rgb.b;
+      }
+      leaf->centroid += centroid;
+    }
+    ++leaf->nr_points_;
+  }
 
-        // Normalize Eigen Val such that max no more than 100x min.
-        eigensolver.compute(leaf.cov_);
-        eigen_val = eigensolver.eigenvalues().asDiagonal();
-        leaf.evecs_ = eigensolver.eigenvectors();
+  // Normalize the centroid and compute the covariance of the leaf.
+  // Return false if the leaf has too few points to be used.
+  bool ComputeLeaf(Leaf* leaf) const {
+    // Normalize the centroid
+    leaf->centroid /= static_cast<float>(leaf->nr_points_);
+    // Point sum used for single pass covariance calculation
+    Eigen::Vector3d pt_sum = leaf->mean_;
+    // Normalize mean
+    leaf->mean_ /= leaf->nr_points_;
+
+    if (leaf->nr_points_ < min_points_per_voxel_) {
+      return false;
+    }
 
-        if (eigen_val(0, 0) < 0 || eigen_val(1, 1) < 0 ||
-            eigen_val(2, 2) <= 0) {
-          leaf.nr_points_ = -1;
-          continue;
-        }
+    // Single pass covariance calculation
+    leaf->cov_ = (leaf->cov_ - 2 * (pt_sum * leaf->mean_.transpose())) /
+                     leaf->nr_points_ +
+                 leaf->mean_ * leaf->mean_.transpose();
+    leaf->cov_ *= (leaf->nr_points_ - 1.0) / leaf->nr_points_;
 
-        // Avoids matrices near singularities (eq 6.11)[Magnusson 2009]
-        min_covar_eigvalue = min_covar_eigvalue_mult_ * eigen_val(2, 2);
-        if (eigen_val(0, 0) < min_covar_eigvalue) {
-          eigen_val(0, 0) = min_covar_eigvalue;
-          if (eigen_val(1, 1) < min_covar_eigvalue) {
-            eigen_val(1, 1) = min_covar_eigvalue;
-          }
-          leaf.cov_ = leaf.evecs_ * eigen_val * leaf.evecs_.inverse();
-        }
-        leaf.evals_ = eigen_val.diagonal();
+    // Normalize Eigen Val such that max no more than 100x min.
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver;
+    eigensolver.compute(leaf->cov_);
+    Eigen::Matrix3d eigen_val = eigensolver.eigenvalues().asDiagonal();
+    leaf->evecs_ = eigensolver.eigenvectors();
 
-        leaf.icov_ = leaf.cov_.inverse();
-        if (leaf.icov_.maxCoeff() == std::numeric_limits<float>::infinity() ||
-            leaf.icov_.minCoeff() == -std::numeric_limits<float>::infinity()) {
-          leaf.nr_points_ = -1;
-        }
+    if (eigen_val(0, 0) < 0 || eigen_val(1, 1) < 0 || eigen_val(2, 2) <= 0) {
+      leaf->nr_points_ = -1;
+      return true;
+    }
+
+    // Avoids matrices near singularities (eq 6.11)[Magnusson 2009]
+    // Eigen values less than a threshold of max eigen value are
+    // inflated to a set fraction of the max eigen value.
+    double min_covar_eigvalue = min_covar_eigvalue_mult_ * eigen_val(2, 2);
+    if (eigen_val(0, 0) < min_covar_eigvalue) {
+      eigen_val(0, 0) = min_covar_eigvalue;
+      if (eigen_val(1, 1) < min_covar_eigvalue) {
+        eigen_val(1, 1) = min_covar_eigvalue;
       }
+      leaf->cov_ = leaf->evecs_ * eigen_val * leaf->evecs_.inverse();
     }
-    output->width = static_cast<uint32_t>(output->points.size());
+    leaf->evals_ = eigen_val.diagonal();
+
+    leaf->icov_ = leaf->cov_.inverse();
+    if (leaf->icov_.maxCoeff() == std::numeric_limits<float>::infinity() ||
+        leaf->icov_.minCoeff() == -std::numeric_limits<float>::infinity()) {
+      leaf->nr_points_ = -1;
+    }
+    return true;
   }
 
+  // Minimum number of leaves computed by a thread.
+  static const size_t kMinLeavesPerThread = 256;
+
   // Flag to determine if voxel structure is searchable. */
   bool searchable_;
 
@@ -591,8 +608,11 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
   // Minimum allowable ratio between eigenvalues.
   double min_covar_eigvalue_mult_;
 
-  // Voxel structure containing all leaf nodes.
-  std::map<size_t, Leaf> leaves_;
+  // Number of threads to compute the voxel covariances.
+  int thread_num_;
+
+  // Voxel structure containing all leaf nodes, sorted by the leaf index.
+  LeafList leaves_;
 
   /* Point cloud containing centroids of voxels
    * containing atleast minimum number of points. */
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 
+#include <cstring>
+
 namespace apollo {
 namespace localization {
 namespace msf {
@@ -239,8 +241,8 @@ void LocalizationLidar::RefineAltitudeFromMap(Eigen::Affine3d *pose) {
       map_.GetConfig(), lidar_trans, resolution_id_, zone_id_);
   LossyMapNode* node =
       static_cast<LossyMapNode*>(map_.GetMapNodeSafe(index));
-  LossyMapMatrix& matrix =
-      static_cast<LossyMapMatrix&>(node->GetMapCellMatrix());
+  const LossyMapMatrix& matrix =
+      static_cast<const LossyMapMatrix&>(node->GetMapCellMatrix());
 
   const double height_diff = vehicle_lidar_height_;
 
@@ -353,18 +355,20 @@ void LocalizationLidar::ComposeMapNode(const Eigen::Vector3d& trans) {
       int src_y = src_ys[i][j];
       int dst_x = dst_xs[i][j];
       int dst_y = dst_ys[i][j];
-      LossyMapMatrix& map_cells =
-          static_cast<LossyMapMatrix&>(map_node[i][j]->GetMapCellMatrix());
+      const LossyMapPlanes2D& planes =
+          static_cast<const LossyMapMatrix&>(
+              map_node[i][j]->GetMapCellMatrix()).GetPlanes();
       for (int y = 0; y < range_y; ++y) {
-        int dst_base_x = (dst_y + y) * node_size_x_ + dst_x;
-        for (int x = 0; x < range_x; ++x) {
-          auto &cell = map_cells[src_y + y][src_x + x];
-          int dst_idx = dst_base_x + x;
-          lidar_map_node_->intensities[dst_idx] = cell.intensity;
-          lidar_map_node_->intensities_var[dst_idx] = cell.intensity_var;
-          lidar_map_node_->altitudes[dst_idx] = cell.altitude;
-          lidar_map_node_->count[dst_idx] = cell.count;
-        }
+        int src_idx = (src_y + y) * node_size_x_ + src_x;
+        int dst_idx = (dst_y + y) * node_size_x_ + dst_x;
+        memcpy(&lidar_map_node_->intensities[dst_idx],
+               &planes.intensities[src_idx], range_x * sizeof(float));
+        memcpy(&lidar_map_node_->intensities_var[dst_idx],
+               &planes.intensity_vars[src_idx], range_x * sizeof(float));
+        memcpy(&lidar_map_node_->altitudes[dst_idx],
+               &planes.altitudes[src_idx], range_x * sizeof(float));
+        memcpy(&lidar_map_node_->count[dst_idx], &planes.counts[src_idx],
+               range_x * sizeof(unsigned int));
       }
     }
   }
@@ -26,6 +26,7 @@ BaseMapConfig::BaseMapConfig(std::string map_version) {
   map_node_size_x_ = 1024;            // in pixels
   map_node_size_y_ = 1024;            // in pixels
   map_range_ = Rect2D<double>(0, 0, 1000448.0, 10000384.0);  // in meters
+  map_compression_codec_ = CompressionStrategy::CODEC_ZLIB;
 
   map_version_ = map_version;
   map_folder_path_ = ".";
@@ -66,6 +67,8 @@ void BaseMapConfig::CreateXml(boost::property_tree::ptree* config) const {
   config->put("map.map_config.range.max_x", map_range_.GetMaxX());
   config->put("map.map_config.range.max_y", map_range_.GetMaxY());
   config->put("map.map_config.compression", map_is_compression_);
+  config->put("map.map_config.compression_codec",
+              CompressionStrategy::GetCodecName(map_compression_codec_));
   config->put("map.map_runtime.map_ground_height_offset",
              map_ground_height_offset_);
   for (size_t i = 0; i < map_resolutions_.size(); ++i) {
@@ -89,6 +92,14 @@ void BaseMapConfig::LoadXml(const boost::property_tree::ptree& config) {
   double max_y = config.get<double>("map.map_config.range.max_y");
   map_range_ = Rect2D<double>(min_x, min_y, max_x, max_y);
   map_is_compression_ = config.get<bool>("map.map_config.compression");
+  const std::string codec_name =
+      config.get<std::string>("map.map_config.compression_codec", "zlib");
+  if (!CompressionStrategy::GetCodecType(codec_name,
+                                         &map_compression_codec_)) {
+    std::cerr << "Unknown map compression codec: " << codec_name
+              << ", use zlib." << std::endl;
+    map_compression_codec_ = CompressionStrategy::CODEC_ZLIB;
+  }
   map_ground_height_offset_ =
       config.get<float>("map.map_runtime.map_ground_height_offset");
   BOOST_FOREACH(const boost::property_tree::ptree::value_type& v,
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include "modules/localization/msf/common/util/compression.h"
 #include "modules/localization/msf/common/util/rect2d.h"
 #include "modules/localization/msf/local_map/base_map/base_map_fwd.h"
 
@@ -65,6 +66,8 @@ class BaseMapConfig {
   float map_ground_height_offset_;
   /**@brief Enable the compression. */
   bool map_is_compression_;
+  /**@brief The codec of the map node files, zlib if not in the XML file. */
+  CompressionStrategy::CodecType map_compression_codec_;
 
   /**@brief The map folder path. */
   std::string map_folder_path_;
@@ -17,6 +17,7 @@
 #include "modules/localization/msf/local_map/base_map/base_map_node.h"
 
 #include <cstdio>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,15 @@ namespace msf {
 using apollo::common::util::DirectoryExists;
 using apollo::common::util::EnsureDirectory;
 
+namespace {
+
+// The versioned header starts with a magic number, which is never a valid
+// resolution id at the beginning of a legacy header.
+const unsigned int kHeaderMagic = 0x4e46534d;  // "MSFN"
+const unsigned int kHeaderVersion = 1;
+
+}  // namespace
+
 BaseMapNode::BaseMapNode(BaseMapMatrix* matrix, CompressionStrategy* strategy)
     : map_matrix_(matrix), compression_strategy_(strategy) {}
 
@@ -51,6 +61,7 @@ void BaseMapNode::Init(const BaseMapConfig* map_config,
   is_reserved_ = false;
   data_is_ready_ = false;
   is_changed_ = false;
+  UpdateCompressionStrategy();
   if (create_map_cells) {
     InitMapMatrix(map_config_);
   }
@@ -59,9 +70,24 @@ void BaseMapNode::Init(const BaseMapConfig* map_config,
 
 void BaseMapNode::InitMapMatrix(const BaseMapConfig* map_config) {
   map_config_ = map_config;
+  UpdateCompressionStrategy();
   map_matrix_->Init(map_config);
 }
 
+void BaseMapNode::UpdateCompressionStrategy() {
+  const CompressionStrategy::CodecType codec_type =
+      compression_strategy_ == nullptr ? CompressionStrategy::CODEC_NONE
+                                       : compression_strategy_->GetCodecType();
+  if (codec_type == map_config_->map_compression_codec_) {
+    return;
+  }
+  if (compression_strategy_ != nullptr) {
+    delete compression_strategy_;
+  }
+  compression_strategy_ =
+      CompressionStrategy::Create(map_config_->map_compression_codec_);
+}
+
 void BaseMapNode::Finalize() {
   if (is_changed_) {
     Save();
@@ -123,8 +149,14 @@ bool BaseMapNode::Save() {
 
   FILE* file = fopen(path.c_str(), "wb");
   if (file) {
-    CreateBinary(file);
+    const unsigned int binary_size = CreateBinary(file);
     fclose(file);
+    if (binary_size == 0) {
+      AERROR << "Can't create the map node: " << index_ << ".";
+      // Don't leave a truncated node behind.
+      remove(path.c_str());
+      return false;
+    }
     is_changed_ = false;
     return true;
   } else {
@@ -178,8 +210,12 @@ bool BaseMapNode::Load(const char* filename) {
 
   FILE* file = fopen(filename, "rb");
   if (file) {
-    LoadBinary(file);
+    const unsigned int processed_size = LoadBinary(file);
     fclose(file);
+    if (processed_size == 0) {
+      AERROR << "Can't load the map node: " << filename << ".";
+      return false;
+    }
     is_changed_ = false;
     data_is_ready_ = true;
     return true;
@@ -190,20 +226,39 @@ bool BaseMapNode::Load(const char* filename) {
 }
 
 unsigned int BaseMapNode::LoadBinary(FILE* file) {
-  // Load the header
-  unsigned int header_size = GetHeaderBinarySize();
-  std::vector<unsigned char> buf(header_size);
+  // Load the header, it is a legacy header without the magic number.
+  unsigned int header_size = GetLegacyHeaderBinarySize();
+  std::vector<unsigned char> buf(GetHeaderBinarySize());
   size_t read_size = fread(&buf[0], 1, header_size, file);
-  CHECK_EQ(read_size, header_size);
+  if (read_size != header_size) {
+    AERROR << "Truncated map node header.";
+    return 0;
+  }
+  if (*reinterpret_cast<unsigned int*>(&buf[0]) == kHeaderMagic) {
+    read_size = fread(&buf[header_size], 1, buf.size() - header_size, file);
+    if (read_size != buf.size() - header_size) {
+      AERROR << "Truncated map node header.";
+      return 0;
+    }
+    header_size = buf.size();
+  }
   unsigned int processed_size = LoadHeaderBinary(&buf[0]);
-  CHECK_EQ(processed_size, header_size);
+  if (processed_size != header_size) {
+    return 0;
+  }
 
   // Load the body
   buf.resize(file_body_binary_size_);
   read_size = fread(&buf[0], 1, file_body_binary_size_, file);
-  CHECK_EQ(read_size, file_body_binary_size_);
-  processed_size += LoadBodyBinary(&buf);
-  return processed_size;
+  if (read_size != file_body_binary_size_) {
+    AERROR << "Truncated map node body: " << index_ << ".";
+    return 0;
+  }
+  const unsigned int body_size = LoadBodyBinary(&buf);
+  if (body_size == 0) {
+    return 0;
+  }
+  return processed_size + body_size;
 }
 
 unsigned int BaseMapNode::CreateBinary(FILE* file) const {
@@ -213,8 +268,9 @@ unsigned int BaseMapNode::CreateBinary(FILE* file) const {
 
   unsigned int binary_size = 0;
   std::vector<unsigned char> body_buffer;
-  CreateBodyBinary(&body_buffer);
-  // CHECK_EQ(processed_size, buf_size);
+  if (CreateBodyBinary(&body_buffer) == 0) {
+    return 0;
+  }
 
   // Create header
   unsigned int header_size = GetHeaderBinarySize();
@@ -224,11 +280,18 @@ unsigned int BaseMapNode::CreateBinary(FILE* file) const {
   unsigned int buffer_bias = processed_size;
   buf_size -= processed_size;
   binary_size += processed_size;
-  // Create body
-  CHECK_GE(buf_size, body_buffer.size());
+  // Create body, the codec may expand an incompressible body.
+  if (body_buffer.size() > buf_size) {
+    AERROR << "The encoded map node body is larger than the raw body: "
+           << body_buffer.size() << " > " << buf_size << ".";
+    return 0;
+  }
   memcpy(&buffer[buffer_bias], &body_buffer[0], body_buffer.size());
   binary_size += body_buffer.size();
-  fwrite(&buffer[0], 1, binary_size, file);
+  if (fwrite(&buffer[0], 1, binary_size, file) != binary_size) {
+    AERROR << "Can't write the map node: " << index_ << ".";
+    return 0;
+  }
   return binary_size;
 }
 
@@ -238,8 +301,22 @@ unsigned int BaseMapNode::GetBinarySize() const {
 }
 
 unsigned int BaseMapNode::LoadHeaderBinary(unsigned char* buf) {
-  unsigned int target_size = GetHeaderBinarySize();
+  unsigned int target_size = GetLegacyHeaderBinarySize();
   unsigned int* p = reinterpret_cast<unsigned int*>(buf);
+  if (*p == kHeaderMagic) {
+    target_size = GetHeaderBinarySize();
+    ++p;
+    if (*p != kHeaderVersion) {
+      AERROR << "Unsupported map node version: " << *p << ".";
+      return 0;
+    }
+    ++p;
+    file_codec_type_ = static_cast<CompressionStrategy::CodecType>(*p);
+    ++p;
+  } else {
+    // The legacy map nodes are always compressed by zlib.
+    file_codec_type_ = CompressionStrategy::CODEC_ZLIB;
+  }
   index_.resolution_id_ = *p;
   ++p;
   int* pp = reinterpret_cast<int*>(p);
@@ -261,6 +338,14 @@ unsigned int BaseMapNode::CreateHeaderBinary(unsigned char* buf,
   unsigned int target_size = GetHeaderBinarySize();
   if (buf_size >= target_size) {
     unsigned int* p = reinterpret_cast<unsigned int*>(buf);
+    *p = kHeaderMagic;
+    ++p;
+    *p = kHeaderVersion;
+    ++p;
+    *p = compression_strategy_ == nullptr
+             ? CompressionStrategy::CODEC_NONE
+             : compression_strategy_->GetCodecType();
+    ++p;
     *p = index_.resolution_id_;
     ++p;
     int* pp = reinterpret_cast<int*>(p);
@@ -277,6 +362,13 @@ unsigned int BaseMapNode::CreateHeaderBinary(unsigned char* buf,
 }
 
 unsigned int BaseMapNode::GetHeaderBinarySize() const {
+  return sizeof(unsigned int)     // the magic number
+         + sizeof(unsigned int)   // the version
+         + sizeof(unsigned int)   // the codec of the body
+         + GetLegacyHeaderBinarySize();
+}
+
+unsigned int BaseMapNode::GetLegacyHeaderBinarySize() const {
   return sizeof(unsigned int)     // index_.resolution_id_
          + sizeof(int)            // index_.zone_id_
          + sizeof(unsigned int)   // index_.m_
@@ -297,11 +389,22 @@ unsigned int BaseMapNode::GetHeaderBinarySize() const {
 // }
 
 unsigned int BaseMapNode::LoadBodyBinary(std::vector<unsigned char>* buf) {
-  if (compression_strategy_ == nullptr) {
+  if (file_codec_type_ == CompressionStrategy::CODEC_NONE) {
     return map_matrix_->LoadBinary(&((*buf)[0]));
   }
+  // The file may be written with another codec than the one of the map.
+  CompressionStrategy* strategy = compression_strategy_;
+  std::unique_ptr<CompressionStrategy> file_strategy;
+  if (strategy == nullptr || strategy->GetCodecType() != file_codec_type_) {
+    file_strategy.reset(CompressionStrategy::Create(file_codec_type_));
+    strategy = file_strategy.get();
+  }
   std::vector<unsigned char> buf_uncompressed;
-  compression_strategy_->Decode(buf, &buf_uncompressed);
+  if (strategy == nullptr || strategy->Decode(buf, &buf_uncompressed) != 0) {
+    AERROR << "Can't decode the map node: " << index_ << ", codec: "
+           << CompressionStrategy::GetCodecName(file_codec_type_) << ".";
+    return 0;
+  }
   AERROR << "map node compress ratio: "
          << static_cast<float>(buf->size()) / buf_uncompressed.size();
   return map_matrix_->LoadBinary(&buf_uncompressed[0]);
@@ -321,7 +424,13 @@ unsigned int BaseMapNode::CreateBodyBinary(
   unsigned int body_size = GetBodyBinarySize();
   buf_uncompressed.resize(body_size);
   map_matrix_->CreateBinary(&buf_uncompressed[0], body_size);
-  compression_strategy_->Encode(&buf_uncompressed, buf);
+  if (compression_strategy_->Encode(&buf_uncompressed, buf) != 0) {
+    AERROR << "Can't encode the map node: " << index_ << ", codec: "
+           << CompressionStrategy::GetCodecName(
+                  compression_strategy_->GetCodecType())
+           << ".";
+    return 0;
+  }
   file_body_binary_size_ = buf->size();
   return buf->size();
 }
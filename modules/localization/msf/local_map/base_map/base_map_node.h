@@ -130,17 +130,20 @@ class BaseMapNode {
 
  protected:
   /**@brief Load the map cell from a binary chunk.
-   * @param <return> The size read (the real size of object).
+   * @param <return> The size read (the real size of object), or 0 if the
+   * node can't be read or decoded.
    */
   virtual unsigned int LoadBinary(FILE* file);
   /**@brief Create the binary. Serialization of the object.
-   * @param <return> The the used size of binary is returned.
+   * @param <return> The the used size of binary is returned, or 0 if the node
+   * can't be encoded or written.
    */
   virtual unsigned int CreateBinary(FILE* file) const;
   /**@brief Get the binary size of the object. */
   virtual unsigned int GetBinarySize() const;
   /**@brief Load the map node header from a binary chunk.
-   * @param <return> The size read (the real size of header).
+   * @param <return> The size read (the real size of header), or 0 for an
+   * unsupported version.
    */
   virtual unsigned int LoadHeaderBinary(unsigned char* buf);
   /**@brief Create the binary header.
@@ -151,6 +154,12 @@ class BaseMapNode {
                                           unsigned int buf_size) const;
   /**@brief Get the size of the header in bytes. */
   virtual unsigned int GetHeaderBinarySize() const;
+  /**@brief Get the size of the header without magic number, version and
+   * codec, which is written by the old versions. */
+  unsigned int GetLegacyHeaderBinarySize() const;
+  /**@brief Replace the compression strategy if the codec of the map config is
+   * different. */
+  void UpdateCompressionStrategy();
   /**@brief Load the map node body from a binary chunk.
    * @param <return> The size read (the real size of body).
    */
@@ -186,6 +195,9 @@ class BaseMapNode {
   mutable unsigned int file_body_binary_size_ = 0;
   /**@bried The compression strategy. */
   CompressionStrategy* compression_strategy_ = nullptr;
+  /**@brief The codec of the body in the loaded file. */
+  CompressionStrategy::CodecType file_codec_type_ =
+      CompressionStrategy::CODEC_ZLIB;
   /**@brief The min altitude of point cloud in the node. */
   float min_altitude_ = 1e6;
 };
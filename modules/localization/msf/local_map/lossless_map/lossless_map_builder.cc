@@ -0,0 +1,332 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_builder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+LosslessMapBuilder::LosslessMapBuilder(const LosslessMapConfig* map_config,
+                                       BaseMapNodePool* map_node_pool,
+                                       int zone_id, unsigned int thread_size)
+    : map_config_(map_config),
+      map_node_pool_(map_node_pool),
+      zone_id_(zone_id),
+      batch_size_(std::max(thread_size, 1u) * 2),
+      checkpoint_interval_(1000),
+      workers_(std::max(thread_size, 1u)) {}
+
+LosslessMapBuilder::~LosslessMapBuilder() { ReleaseNodes(); }
+
+bool LosslessMapBuilder::Build(unsigned int frame_num,
+                               const FrameLoader& frame_loader, bool resume) {
+  saved_frame_num_ = 0;
+  if (resume && !LoadProgress(frame_num, &saved_frame_num_)) {
+    return false;
+  }
+  if (saved_frame_num_ > 0) {
+    AINFO << "Resume the map building from frame " << saved_frame_num_ << ".";
+  }
+
+  unsigned int frame_id = saved_frame_num_;
+  while (frame_id < frame_num) {
+    const unsigned int batch_size =
+        std::min(std::max(batch_size_, 1u), frame_num - frame_id);
+    std::vector<Frame> frames(batch_size);
+    std::vector<FrameBins> bins(batch_size);
+    std::vector<char> is_loaded(batch_size, 0);
+    for (unsigned int i = 0; i < batch_size; ++i) {
+      workers_.schedule([this, &frame_loader, &frames, &bins, &is_loaded,
+                         frame_id, i]() {
+        is_loaded[i] =
+            LoadFrame(frame_id + i, frame_loader, &frames[i], &bins[i]);
+      });
+    }
+    workers_.wait();
+    for (unsigned int i = 0; i < batch_size; ++i) {
+      if (!is_loaded[i]) {
+        AERROR << "Failed to load frame " << frame_id + i << ".";
+        ReleaseNodes();
+        return false;
+      }
+    }
+
+    // Split the batch into runs of frames whose nodes fit into the pool.
+    unsigned int begin = 0;
+    while (begin < batch_size) {
+      std::set<MapNodeIndex> run_nodes;
+      unsigned int end = begin;
+      while (end < batch_size) {
+        std::set<MapNodeIndex> nodes = run_nodes;
+        for (const auto& bin : bins[end]) {
+          nodes.insert(bin.first);
+        }
+        if (nodes.size() > map_node_pool_->GetPoolSize() && end > begin) {
+          break;
+        }
+        run_nodes.swap(nodes);
+        ++end;
+      }
+      if (!AcquireNodes(bins, begin, end, frame_id + begin)) {
+        ReleaseNodes();
+        return false;
+      }
+      ApplyFrames(frames, bins, begin, end);
+      for (const auto& index : run_nodes) {
+        resident_nodes_[index].last_frame_id = frame_id + end - 1;
+      }
+      begin = end;
+    }
+
+    frame_id += batch_size;
+    AINFO << "Added " << frame_id << " / " << frame_num << " frames.";
+    if (frame_id - saved_frame_num_ >= checkpoint_interval_ &&
+        !SaveCheckpoint(frame_id)) {
+      ReleaseNodes();
+      return false;
+    }
+  }
+
+  bool is_success = SaveCheckpoint(frame_num);
+  ReleaseNodes();
+  return is_success;
+}
+
+bool LosslessMapBuilder::LoadFrame(unsigned int frame_id,
+                                   const FrameLoader& frame_loader,
+                                   Frame* frame, FrameBins* bins) const {
+  if (!frame_loader(frame_id, frame)) {
+    return false;
+  }
+  if (frame->pt3ds.size() != frame->intensities.size() ||
+      frame->layer_pt3ds.size() != frame->layer_intensities.size()) {
+    AERROR << "The intensities don't match the points in frame " << frame_id
+           << ".";
+    return false;
+  }
+  const unsigned int resolution_num = map_config_->map_resolutions_.size();
+  for (unsigned int i = 0; i < frame->pt3ds.size(); ++i) {
+    for (unsigned int r = 0; r < resolution_num; ++r) {
+      MapNodeIndex index = MapNodeIndex::GetMapNodeIndex(
+          *map_config_, frame->pt3ds[i], r, zone_id_);
+      (*bins)[index].point_ids.push_back(i);
+    }
+  }
+  for (unsigned int i = 0; i < frame->layer_pt3ds.size(); ++i) {
+    for (unsigned int r = 0; r < resolution_num; ++r) {
+      MapNodeIndex index = MapNodeIndex::GetMapNodeIndex(
+          *map_config_, frame->layer_pt3ds[i], r, zone_id_);
+      (*bins)[index].layer_point_ids.push_back(i);
+    }
+  }
+  return true;
+}
+
+bool LosslessMapBuilder::AcquireNodes(const std::vector<FrameBins>& bins,
+                                      unsigned int begin, unsigned int end,
+                                      unsigned int first_frame_id) {
+  std::set<MapNodeIndex> missing_nodes;
+  std::set<MapNodeIndex> used_nodes;
+  for (unsigned int i = begin; i < end; ++i) {
+    for (const auto& bin : bins[i]) {
+      used_nodes.insert(bin.first);
+      if (resident_nodes_.find(bin.first) == resident_nodes_.end()) {
+        missing_nodes.insert(bin.first);
+      }
+    }
+  }
+  const size_t pool_size = map_node_pool_->GetPoolSize();
+  if (used_nodes.size() > pool_size) {
+    AERROR << "Frame " << first_frame_id << " needs " << used_nodes.size()
+           << " map nodes, but the node pool size is " << pool_size << ".";
+    return false;
+  }
+
+  if (resident_nodes_.size() + missing_nodes.size() > pool_size) {
+    // The nodes on the disk must be consistent with the recorded progress
+    // before any of them can be released.
+    if (!SaveCheckpoint(first_frame_id)) {
+      return false;
+    }
+    std::vector<std::pair<unsigned int, MapNodeIndex>> candidates;
+    for (const auto& resident_node : resident_nodes_) {
+      if (used_nodes.find(resident_node.first) == used_nodes.end()) {
+        candidates.emplace_back(resident_node.second.last_frame_id,
+                                resident_node.first);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& candidate : candidates) {
+      if (resident_nodes_.size() + missing_nodes.size() <= pool_size) {
+        break;
+      }
+      auto itr = resident_nodes_.find(candidate.second);
+      map_node_pool_->FreeMapNode(itr->second.node);
+      resident_nodes_.erase(itr);
+    }
+  }
+
+  for (const auto& index : missing_nodes) {
+    LosslessMapNode* node =
+        static_cast<LosslessMapNode*>(map_node_pool_->AllocMapNode());
+    if (node == nullptr) {
+      AERROR << "Failed to allocate the map node: " << index;
+      return false;
+    }
+    resident_nodes_[index].node = node;
+    workers_.schedule([this, node, index]() {
+      node->Init(map_config_, index, false);
+      if (!node->Load()) {
+        ADEBUG << "Created map node: " << index;
+      }
+    });
+  }
+  workers_.wait();
+  return true;
+}
+
+void LosslessMapBuilder::ApplyFrames(const std::vector<Frame>& frames,
+                                     const std::vector<FrameBins>& bins,
+                                     unsigned int begin, unsigned int end) {
+  std::set<MapNodeIndex> used_nodes;
+  for (unsigned int i = begin; i < end; ++i) {
+    for (const auto& bin : bins[i]) {
+      used_nodes.insert(bin.first);
+    }
+  }
+  // Every node is updated by one task only, in the frame order.
+  for (const auto& index : used_nodes) {
+    LosslessMapNode* node = resident_nodes_[index].node;
+    workers_.schedule([&frames, &bins, begin, end, node, index]() {
+      for (unsigned int i = begin; i < end; ++i) {
+        auto itr = bins[i].find(index);
+        if (itr == bins[i].end()) {
+          continue;
+        }
+        const Frame& frame = frames[i];
+        for (unsigned int id : itr->second.point_ids) {
+          node->SetValue(frame.pt3ds[id], frame.intensities[id]);
+        }
+        for (unsigned int id : itr->second.layer_point_ids) {
+          node->SetValueLayer(frame.layer_pt3ds[id],
+                              frame.layer_intensities[id]);
+        }
+      }
+    });
+  }
+  workers_.wait();
+}
+
+bool LosslessMapBuilder::SaveCheckpoint(unsigned int frame_num) {
+  // Mark the checkpoint as incomplete until all the nodes are saved.
+  if (!SaveProgress(saved_frame_num_, false)) {
+    return false;
+  }
+  std::vector<std::pair<LosslessMapNode*, char>> nodes;
+  for (const auto& resident_node : resident_nodes_) {
+    if (resident_node.second.node->GetIsChanged()) {
+      nodes.emplace_back(resident_node.second.node, 0);
+    }
+  }
+  for (auto& node : nodes) {
+    workers_.schedule([&node]() { node.second = node.first->Save(); });
+  }
+  workers_.wait();
+  for (const auto& node : nodes) {
+    if (!node.second) {
+      AERROR << "Failed to save the map node: "
+             << node.first->GetMapNodeIndex();
+      return false;
+    }
+  }
+  if (!SaveProgress(frame_num, true)) {
+    return false;
+  }
+  saved_frame_num_ = frame_num;
+  return true;
+}
+
+void LosslessMapBuilder::ReleaseNodes() {
+  for (auto& resident_node : resident_nodes_) {
+    resident_node.second.node->SetIsChanged(false);
+    map_node_pool_->FreeMapNode(resident_node.second.node);
+  }
+  resident_nodes_.clear();
+}
+
+bool LosslessMapBuilder::LoadProgress(unsigned int frame_num,
+                                      unsigned int* saved_frame_num) {
+  *saved_frame_num = 0;
+  FILE* file = fopen(GetProgressPath().c_str(), "r");
+  if (file == nullptr) {
+    return true;
+  }
+  unsigned int is_complete = 0;
+  int count = fscanf(file, "frame_num: %u\ncomplete: %u", saved_frame_num,
+                     &is_complete);
+  fclose(file);
+  if (count != 2) {
+    AERROR << "Can't parse the build progress: " << GetProgressPath();
+    return false;
+  }
+  if (!is_complete) {
+    AERROR << "The map was left in the middle of a checkpoint, "
+           << "it can't be resumed.";
+    return false;
+  }
+  if (*saved_frame_num > frame_num) {
+    AERROR << "The map has " << *saved_frame_num << " frames, but only "
+           << frame_num << " frames are given.";
+    return false;
+  }
+  return true;
+}
+
+bool LosslessMapBuilder::SaveProgress(unsigned int frame_num,
+                                      bool is_complete) const {
+  if (!common::util::EnsureDirectory(map_config_->map_folder_path_)) {
+    AERROR << "Can't create the map folder: " << map_config_->map_folder_path_;
+    return false;
+  }
+  const std::string path = GetProgressPath();
+  const std::string temp_path = path + ".tmp";
+  FILE* file = fopen(temp_path.c_str(), "w");
+  if (file == nullptr) {
+    AERROR << "Can't write to file: " << temp_path << ".";
+    return false;
+  }
+  fprintf(file, "frame_num: %u\ncomplete: %u\n", frame_num,
+          is_complete ? 1u : 0u);
+  bool is_success = fflush(file) == 0;
+  fclose(file);
+  return is_success && rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+std::string LosslessMapBuilder::GetProgressPath() const {
+  return map_config_->map_folder_path_ + "/build_progress.txt";
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULE_LOCALIZAION_MSF_LOCAL_MAP_LOSSLESS_MAP_LOSSLESS_MAP_BUILDER_H_
+#define MODULE_LOCALIZAION_MSF_LOCAL_MAP_LOSSLESS_MAP_LOSSLESS_MAP_BUILDER_H_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/localization/msf/common/util/threadpool.h"
+#include "modules/localization/msf/local_map/base_map/base_map_node_index.h"
+#include "modules/localization/msf/local_map/base_map/base_map_pool.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**@brief Build a lossless map from a sequence of frames on a thread pool.
+ * The frames are loaded and binned by map node in parallel, then every map
+ * node is updated by a single task in the frame order, so the map is identical
+ * to the one built by calling LosslessMap::SetValue frame by frame.
+ * The map nodes are held in the node pool only, when the pool is used up the
+ * least recently used nodes are saved to the disk and released. Every save
+ * is a checkpoint of the whole map, which allows an interrupted build to be
+ * resumed. */
+class LosslessMapBuilder {
+ public:
+  /**@brief The points of a frame in the global coordinate. */
+  struct Frame {
+    /**@brief The points which are added to the layer 0. */
+    std::vector<Eigen::Vector3d> pt3ds;
+    std::vector<unsigned char> intensities;
+    /**@brief The points which are added to the matched layer. */
+    std::vector<Eigen::Vector3d> layer_pt3ds;
+    std::vector<unsigned char> layer_intensities;
+  };
+  /**@brief Load the frame with the given id. It is called from the worker
+   * threads concurrently. */
+  typedef std::function<bool(unsigned int, Frame*)> FrameLoader;
+
+  /**@brief The constructor.
+   * @param <map_config> The map config, the map folder path must be set.
+   * @param <map_node_pool> The node pool, its size bounds the memory.
+   * @param <zone_id> The zone id of the frames.
+   * @param <thread_size> The number of worker threads.
+   */
+  LosslessMapBuilder(const LosslessMapConfig* map_config,
+                     BaseMapNodePool* map_node_pool, int zone_id,
+                     unsigned int thread_size);
+  ~LosslessMapBuilder();
+
+  /**@brief Set the number of frames loaded together. */
+  void SetBatchSize(unsigned int batch_size) { batch_size_ = batch_size; }
+  /**@brief Set the number of frames between two checkpoints. */
+  void SetCheckpointInterval(unsigned int frame_num) {
+    checkpoint_interval_ = frame_num;
+  }
+  /**@brief Add the frames [0, frame_num) to the map. If resume is true, the
+   * frames before the last checkpoint in the map folder are skipped.
+   * @param <return> False if a frame fails to load or the map can't be
+   * saved. The map on the disk is left at the last checkpoint. */
+  bool Build(unsigned int frame_num, const FrameLoader& frame_loader,
+             bool resume);
+  /**@brief Get the number of frames saved to the disk. */
+  unsigned int GetSavedFrameNum() const { return saved_frame_num_; }
+
+ private:
+  /**@brief The points of a frame in a map node. */
+  struct NodeBin {
+    std::vector<unsigned int> point_ids;
+    std::vector<unsigned int> layer_point_ids;
+  };
+  typedef std::map<MapNodeIndex, NodeBin> FrameBins;
+
+  struct ResidentNode {
+    LosslessMapNode* node = nullptr;
+    /**@brief The last frame which updates this node. */
+    unsigned int last_frame_id = 0;
+  };
+
+  /**@brief Load a frame and bin its points by map node. */
+  bool LoadFrame(unsigned int frame_id, const FrameLoader& frame_loader,
+                 Frame* frame, FrameBins* bins) const;
+  /**@brief Apply the frames [begin, end) of the batch, their nodes must be
+   * resident. */
+  void ApplyFrames(const std::vector<Frame>& frames,
+                   const std::vector<FrameBins>& bins, unsigned int begin,
+                   unsigned int end);
+  /**@brief Make the nodes used by the frames resident. */
+  bool AcquireNodes(const std::vector<FrameBins>& bins, unsigned int begin,
+                    unsigned int end, unsigned int first_frame_id);
+  /**@brief Save the changed nodes and record the frame number. */
+  bool SaveCheckpoint(unsigned int frame_num);
+  /**@brief Release all nodes, unsaved changes are dropped. */
+  void ReleaseNodes();
+
+  bool LoadProgress(unsigned int frame_num, unsigned int* saved_frame_num);
+  bool SaveProgress(unsigned int frame_num, bool is_complete) const;
+  std::string GetProgressPath() const;
+
+ private:
+  const LosslessMapConfig* map_config_;
+  BaseMapNodePool* map_node_pool_;
+  int zone_id_;
+  unsigned int batch_size_;
+  unsigned int checkpoint_interval_;
+  unsigned int saved_frame_num_ = 0;
+  std::map<MapNodeIndex, ResidentNode> resident_nodes_;
+  ThreadPool workers_;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+#endif  // MODULE_LOCALIZAION_MSF_LOCAL_MAP_LOSSLESS_MAP_LOSSLESS_MAP_BUILDER_H_
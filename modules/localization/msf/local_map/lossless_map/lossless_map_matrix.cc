@@ -32,6 +32,7 @@ void LosslessMapSingleCell::Reset() {
   intensity = 0.0;
   intensity_var = 0.0;
   altitude = 0.0;
+  altitude_var = 0.0;
   count = 0;
 }
 
@@ -40,6 +41,7 @@ LosslessMapSingleCell& LosslessMapSingleCell::operator=(
   intensity = ref.intensity;
   intensity_var = ref.intensity_var;
   altitude = ref.altitude;
+  altitude_var = ref.altitude_var;
   count = ref.count;
   return *this;
 }
@@ -51,6 +51,7 @@ LossyMapMatrix2D::LossyMapMatrix2D() {
   rows_ = 0;
   cols_ = 0;
   map_cells_ = NULL;
+  is_planes_valid_ = false;
 }
 
 LossyMapMatrix2D::~LossyMapMatrix2D() {
@@ -62,7 +63,7 @@ LossyMapMatrix2D::~LossyMapMatrix2D() {
 }
 
 LossyMapMatrix2D::LossyMapMatrix2D(const LossyMapMatrix2D& matrix)
-    : BaseMapMatrix(matrix), map_cells_(NULL) {
+    : BaseMapMatrix(matrix), map_cells_(NULL), is_planes_valid_(false) {
   Init(matrix.rows_, matrix.cols_);
   for (unsigned int y = 0; y < rows_; ++y) {
     for (unsigned int x = 0; x < cols_; ++x) {
@@ -99,6 +100,7 @@ void LossyMapMatrix2D::Init(unsigned int rows, unsigned int cols) {
   map_cells_ = new LossyMapCell2D[rows * cols];
   rows_ = rows;
   cols_ = cols;
+  is_planes_valid_ = false;
 }
 
 void LossyMapMatrix2D::Reset(const BaseMapConfig* config) {
@@ -111,6 +113,29 @@ void LossyMapMatrix2D::Reset(unsigned int rows, unsigned int cols) {
   for (unsigned int i = 0; i < length; ++i) {
     map_cells_[i].Reset();
   }
+  // Release the planes, the node may not be used for matching any more.
+  planes_ = LossyMapPlanes2D();
+  is_planes_valid_ = false;
+}
+
+const LossyMapPlanes2D& LossyMapMatrix2D::GetPlanes() const {
+  if (is_planes_valid_) {
+    return planes_;
+  }
+  const unsigned int length = rows_ * cols_;
+  planes_.counts.resize(length);
+  planes_.intensities.resize(length);
+  planes_.intensity_vars.resize(length);
+  planes_.altitudes.resize(length);
+  for (unsigned int i = 0; i < length; ++i) {
+    const LossyMapCell2D& cell = map_cells_[i];
+    planes_.counts[i] = cell.count;
+    planes_.intensities[i] = cell.intensity;
+    planes_.intensity_vars[i] = cell.intensity_var;
+    planes_.altitudes[i] = cell.altitude;
+  }
+  is_planes_valid_ = true;
+  return planes_;
 }
 
 unsigned char LossyMapMatrix2D::EncodeIntensity(
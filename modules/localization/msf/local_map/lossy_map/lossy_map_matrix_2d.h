@@ -58,6 +58,15 @@ struct LossyMapCell2D {
   bool is_ground_useful;
 };
 
+/**@brief The fields of the map cells in separate row-major planes, so a
+ * window of the map can be copied row by row. */
+struct LossyMapPlanes2D {
+  std::vector<unsigned int> counts;
+  std::vector<float> intensities;
+  std::vector<float> intensity_vars;
+  std::vector<float> altitudes;
+};
+
 class LossyMapMatrix2D : public BaseMapMatrix {
  public:
   LossyMapMatrix2D();
@@ -87,6 +96,7 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   virtual void GetIntensityImg(cv::Mat* intensity_img) const;
 
   inline LossyMapCell2D* operator[](int row) {
+    is_planes_valid_ = false;
     return map_cells_ + row * cols_;
   }
   inline const LossyMapCell2D* operator[](int row) const {
@@ -95,6 +105,10 @@ class LossyMapMatrix2D : public BaseMapMatrix {
 
   LossyMapMatrix2D& operator=(const LossyMapMatrix2D& matrix);
 
+  /**@brief Get the planes of the map cells. They are rebuilt when the cells
+   * have been accessed for writing since the last call. */
+  const LossyMapPlanes2D& GetPlanes() const;
+
  protected:
   /**@brief The number of rows. */
   unsigned int rows_;
@@ -102,6 +116,9 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   unsigned int cols_;
   /**@brief The matrix data structure. */
   LossyMapCell2D* map_cells_;
+  /**@brief The planes of the map cells, built on demand. */
+  mutable LossyMapPlanes2D planes_;
+  mutable bool is_planes_valid_;
 
  protected:
   inline unsigned char EncodeIntensity(const LossyMapCell2D& cell) const;
@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_builder.h"
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "modules/localization/msf/local_map/lossless_map/lossless_map.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_pool.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class LosslessMapBuilderTestSuite : public ::testing::Test {
+ protected:
+  LosslessMapBuilderTestSuite() {}
+  virtual ~LosslessMapBuilderTestSuite() {}
+  virtual void SetUp() {
+    boost::filesystem::remove_all(temp_folder_);
+    boost::filesystem::create_directories(temp_folder_);
+  }
+  virtual void TearDown() { boost::filesystem::remove_all(temp_folder_); }
+
+  void InitConfig(const std::string& map_folder, LosslessMapConfig* config) {
+    config->map_resolutions_.clear();
+    config->map_resolutions_.push_back(0.125);
+    config->map_resolutions_.push_back(0.25);
+    config->map_node_size_x_ = 64;
+    config->map_node_size_y_ = 64;
+    config->map_folder_path_ = temp_folder_ + "/" + map_folder;
+  }
+
+  /**@brief Generate a frame moving along the x axis. */
+  static bool LoadFrame(unsigned int frame_id,
+                        LosslessMapBuilder::Frame* frame) {
+    const unsigned int point_num = 2000;
+    unsigned int seed = frame_id * 7919 + 17;
+    for (unsigned int i = 0; i < point_num; ++i) {
+      seed = seed * 1103515245 + 12345;
+      double x = static_cast<double>((seed >> 8) % 12000) / 1000.0 - 6.0;
+      seed = seed * 1103515245 + 12345;
+      double y = static_cast<double>((seed >> 8) % 12000) / 1000.0 - 6.0;
+      double z = 47.0 + 0.01 * static_cast<double>(seed % 300);
+      Eigen::Vector3d pt3d(439700.0 + 6.0 * frame_id + x, 4433980.0 + y, z);
+      unsigned char intensity = static_cast<unsigned char>(seed % 256);
+      frame->pt3ds.push_back(pt3d);
+      frame->intensities.push_back(intensity);
+      if (i % 3 == 0) {
+        frame->layer_pt3ds.push_back(pt3d);
+        frame->layer_intensities.push_back(intensity);
+      }
+    }
+    return true;
+  }
+
+  void BuildSerialMap(unsigned int frame_num) {
+    LosslessMapConfig config;
+    InitConfig("serial_map", &config);
+    LosslessMap map(&config);
+    LosslessMapNodePool lossless_map_node_pool(25, 8);
+    lossless_map_node_pool.Initial(&config);
+    map.InitThreadPool(1, 6);
+    map.InitMapNodeCaches(12, 24);
+    map.AttachMapNodePool(&lossless_map_node_pool);
+    for (unsigned int frame_id = 0; frame_id < frame_num; ++frame_id) {
+      LosslessMapBuilder::Frame frame;
+      LoadFrame(frame_id, &frame);
+      for (size_t i = 0; i < frame.pt3ds.size(); ++i) {
+        map.SetValue(frame.pt3ds[i], zone_id_, frame.intensities[i]);
+      }
+      for (size_t i = 0; i < frame.layer_pt3ds.size(); ++i) {
+        map.SetValueLayer(frame.layer_pt3ds[i], zone_id_,
+                          frame.layer_intensities[i]);
+      }
+    }
+  }
+
+  /**@brief Check the map node files are identical in the two maps. */
+  void ExpectSameNodes(const std::string& map_folder0,
+                       const std::string& map_folder1) {
+    const std::string root0 = temp_folder_ + "/" + map_folder0 + "/map";
+    const std::string root1 = temp_folder_ + "/" + map_folder1 + "/map";
+    unsigned int file_num0 = 0;
+    for (boost::filesystem::recursive_directory_iterator itr(root0), end;
+         itr != end; ++itr) {
+      if (!boost::filesystem::is_regular_file(itr->path())) {
+        continue;
+      }
+      ++file_num0;
+      std::string path1 = root1 + itr->path().string().substr(root0.size());
+      ASSERT_TRUE(boost::filesystem::exists(path1)) << path1;
+      std::ifstream file0(itr->path().string(), std::ios::binary);
+      std::ifstream file1(path1, std::ios::binary);
+      std::string data0((std::istreambuf_iterator<char>(file0)),
+                        std::istreambuf_iterator<char>());
+      std::string data1((std::istreambuf_iterator<char>(file1)),
+                        std::istreambuf_iterator<char>());
+      EXPECT_TRUE(data0 == data1) << path1;
+    }
+    unsigned int file_num1 = 0;
+    for (boost::filesystem::recursive_directory_iterator itr(root1), end;
+         itr != end; ++itr) {
+      if (boost::filesystem::is_regular_file(itr->path())) {
+        ++file_num1;
+      }
+    }
+    EXPECT_GT(file_num0, 10);
+    EXPECT_EQ(file_num0, file_num1);
+  }
+
+  const std::string temp_folder_ =
+      "modules/localization/msf/local_map/test/test_data/temp_builder_map";
+  const int zone_id_ = 50;
+};
+
+TEST_F(LosslessMapBuilderTestSuite, SameAsSerialMap) {
+  const unsigned int frame_num = 20;
+  BuildSerialMap(frame_num);
+
+  LosslessMapConfig config;
+  InitConfig("parallel_map", &config);
+  // The pool is smaller than the map, the nodes are saved and loaded again.
+  LosslessMapNodePool lossless_map_node_pool(16, 2);
+  lossless_map_node_pool.Initial(&config);
+  LosslessMapBuilder builder(&config, &lossless_map_node_pool, zone_id_, 4);
+  builder.SetBatchSize(3);
+  EXPECT_TRUE(builder.Build(frame_num, LoadFrame, false));
+  EXPECT_EQ(builder.GetSavedFrameNum(), frame_num);
+
+  ExpectSameNodes("serial_map", "parallel_map");
+}
+
+TEST_F(LosslessMapBuilderTestSuite, ResumeBuild) {
+  const unsigned int frame_num = 20;
+  BuildSerialMap(frame_num);
+
+  LosslessMapConfig config;
+  InitConfig("parallel_map", &config);
+  LosslessMapNodePool lossless_map_node_pool(16, 2);
+  lossless_map_node_pool.Initial(&config);
+  {
+    LosslessMapBuilder builder(&config, &lossless_map_node_pool, zone_id_, 3);
+    builder.SetBatchSize(2);
+    builder.SetCheckpointInterval(4);
+    auto failed_loader = [](unsigned int frame_id,
+                            LosslessMapBuilder::Frame* frame) {
+      return frame_id < 13 && LoadFrame(frame_id, frame);
+    };
+    EXPECT_FALSE(builder.Build(frame_num, failed_loader, false));
+    EXPECT_GT(builder.GetSavedFrameNum(), 0);
+    EXPECT_LE(builder.GetSavedFrameNum(), 13);
+  }
+  {
+    LosslessMapBuilder builder(&config, &lossless_map_node_pool, zone_id_, 3);
+    EXPECT_TRUE(builder.Build(frame_num, LoadFrame, true));
+    EXPECT_EQ(builder.GetSavedFrameNum(), frame_num);
+  }
+
+  ExpectSameNodes("serial_map", "parallel_map");
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <fstream>
+#include <iterator>
+#include <vector>
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_pool_2d.h"
@@ -216,6 +219,108 @@ TEST_F(LossyMap2DTestSuite, MapScheduleTest) {
   }
 }
 
+/**@brief A legacy node is saved with the zlib and the lz4 codecs, and both
+ * are loaded by a node whose map uses zlib. */
+TEST_F(LossyMap2DTestSuite, MapNodeCodecTest) {
+  const std::string src_node_file =
+      "modules/localization/msf/local_map/test/test_data/lossy_single_map/"
+      "map/000/north/50/00034636/00003436";
+  const std::string dst_map_folder =
+      "modules/localization/msf/local_map/test/test_data/temp_codec_lossy_map";
+
+  LossyMapConfig2D config("lossy_map");
+  LossyMapNode2D legacy_node;
+  legacy_node.InitMapMatrix(&config);
+  ASSERT_TRUE(legacy_node.Load(src_node_file.c_str()));
+  const MapNodeIndex& index = legacy_node.GetMapNodeIndex();
+
+  const CompressionStrategy::CodecType codecs[] = {
+      CompressionStrategy::CODEC_ZLIB, CompressionStrategy::CODEC_LZ4};
+  LossyMapConfig2D load_config("lossy_map");
+  LossyMapNode2D nodes[2];
+  for (int i = 0; i < 2; ++i) {
+    LossyMapConfig2D save_config("lossy_map");
+    save_config.map_folder_path_ =
+        dst_map_folder + CompressionStrategy::GetCodecName(codecs[i]);
+    save_config.map_compression_codec_ = codecs[i];
+    LossyMapNode2D save_node;
+    save_node.Init(&save_config, index);
+    static_cast<LossyMapMatrix2D&>(save_node.GetMapCellMatrix()) =
+        static_cast<const LossyMapMatrix2D&>(legacy_node.GetMapCellMatrix());
+    ASSERT_TRUE(save_node.Save());
+
+    load_config.map_folder_path_ = save_config.map_folder_path_;
+    nodes[i].Init(&load_config, index);
+    ASSERT_TRUE(nodes[i].Load());
+    boost::filesystem::remove_all(save_config.map_folder_path_);
+  }
+
+  const LossyMapMatrix2D& zlib_matrix =
+      static_cast<const LossyMapMatrix2D&>(nodes[0].GetMapCellMatrix());
+  const LossyMapMatrix2D& lz4_matrix =
+      static_cast<const LossyMapMatrix2D&>(nodes[1].GetMapCellMatrix());
+  for (unsigned int row = 0; row < config.map_node_size_y_; ++row) {
+    for (unsigned int col = 0; col < config.map_node_size_x_; ++col) {
+      ASSERT_EQ(zlib_matrix[row][col].count, lz4_matrix[row][col].count);
+      ASSERT_EQ(zlib_matrix[row][col].intensity,
+                lz4_matrix[row][col].intensity);
+      ASSERT_EQ(zlib_matrix[row][col].intensity_var,
+                lz4_matrix[row][col].intensity_var);
+      ASSERT_EQ(zlib_matrix[row][col].altitude, lz4_matrix[row][col].altitude);
+    }
+  }
+}
+
+/**@brief A node with an unsupported version, an unknown codec or a truncated
+ * body fails to load, instead of loading stale data. */
+TEST_F(LossyMap2DTestSuite, MapNodeCorruptedTest) {
+  const std::string src_node_file =
+      "modules/localization/msf/local_map/test/test_data/lossy_single_map/"
+      "map/000/north/50/00034636/00003436";
+  const std::string dst_map_folder =
+      "modules/localization/msf/local_map/test/test_data/temp_corrupted_map";
+  const std::string dst_node_file =
+      dst_map_folder + "/map/000/north/50/00034636/00003436";
+
+  LossyMapConfig2D config("lossy_map");
+  config.map_folder_path_ = dst_map_folder;
+  config.map_compression_codec_ = CompressionStrategy::CODEC_LZ4;
+  LossyMapNode2D node;
+  node.InitMapMatrix(&config);
+  ASSERT_TRUE(node.Load(src_node_file.c_str()));
+  ASSERT_TRUE(node.Save());
+
+  std::vector<char> data;
+  {
+    std::ifstream file(dst_node_file, std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+  }
+  ASSERT_GT(data.size(), 3 * sizeof(unsigned int));
+  const auto write_node = [&dst_node_file](const std::vector<char>& bytes) {
+    std::ofstream file(dst_node_file, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+  };
+  write_node(data);
+  EXPECT_TRUE(node.Load(dst_node_file.c_str()));
+
+  // The version follows the magic number, and the codec follows the version.
+  std::vector<char> future_version = data;
+  ++reinterpret_cast<unsigned int*>(&future_version[0])[1];
+  write_node(future_version);
+  EXPECT_FALSE(node.Load(dst_node_file.c_str()));
+
+  std::vector<char> unknown_codec = data;
+  reinterpret_cast<unsigned int*>(&unknown_codec[0])[2] = 100;
+  write_node(unknown_codec);
+  EXPECT_FALSE(node.Load(dst_node_file.c_str()));
+
+  write_node(std::vector<char>(data.begin(), data.end() - 10));
+  EXPECT_FALSE(node.Load(dst_node_file.c_str()));
+
+  boost::filesystem::remove_all(dst_map_folder);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class LossyMapMatrix2DTestSuite : public ::testing::Test {
+ protected:
+  LossyMapMatrix2DTestSuite() {}
+  virtual ~LossyMapMatrix2DTestSuite() {}
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+
+  void ExpectSamePlanes(const LossyMapMatrix2D& matrix) {
+    const LossyMapPlanes2D& planes = matrix.GetPlanes();
+    ASSERT_EQ(planes.counts.size(), rows_ * cols_);
+    for (unsigned int row = 0; row < rows_; ++row) {
+      for (unsigned int col = 0; col < cols_; ++col) {
+        const LossyMapCell2D& cell = matrix[row][col];
+        const unsigned int idx = row * cols_ + col;
+        EXPECT_EQ(cell.count, planes.counts[idx]);
+        EXPECT_EQ(cell.intensity, planes.intensities[idx]);
+        EXPECT_EQ(cell.intensity_var, planes.intensity_vars[idx]);
+        EXPECT_EQ(cell.altitude, planes.altitudes[idx]);
+      }
+    }
+  }
+
+  const unsigned int rows_ = 6;
+  const unsigned int cols_ = 9;
+};
+
+/**@brief The planes follow the changes of the cells. */
+TEST_F(LossyMapMatrix2DTestSuite, Planes) {
+  LossyMapMatrix2D matrix;
+  matrix.Init(rows_, cols_);
+  for (unsigned int row = 0; row < rows_; ++row) {
+    for (unsigned int col = 0; col < cols_; ++col) {
+      LossyMapCell2D& cell = matrix[row][col];
+      cell.count = row + col;
+      cell.intensity = static_cast<float>(row * cols_ + col);
+      cell.intensity_var = 0.5f * col;
+      cell.altitude = 10.0f + row;
+    }
+  }
+  ExpectSamePlanes(matrix);
+
+  matrix[2][3].intensity = 200.0f;
+  EXPECT_EQ(200.0f, matrix.GetPlanes().intensities[2 * cols_ + 3]);
+  ExpectSamePlanes(matrix);
+
+  // The planes of a loaded matrix hold the decoded cells.
+  std::vector<unsigned char> buf(matrix.GetBinarySize());
+  ASSERT_EQ(buf.size(), matrix.CreateBinary(buf.data(), buf.size()));
+  LossyMapMatrix2D loaded_matrix;
+  loaded_matrix.GetPlanes();
+  loaded_matrix.LoadBinary(buf.data());
+  ExpectSamePlanes(loaded_matrix);
+
+  matrix.Reset(rows_, cols_);
+  ExpectSamePlanes(matrix);
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures assembling the lidar matching window from 2x2 lossy map
+ *        nodes cell by cell, versus copying the rows of the cell planes.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_pool_2d.h"
+
+DEFINE_string(map_folder,
+              "modules/localization/msf/local_map/test/test_data/"
+              "lossy_single_map",
+              "The lossy map folder.");
+DEFINE_int32(benchmark_num_runs, 50, "Number of windows to assemble.");
+DEFINE_int32(offset_x, 300, "The window offset in the top left node.");
+DEFINE_int32(offset_y, 700, "The window offset in the top left node.");
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace {
+
+struct Window {
+  explicit Window(const int size)
+      : intensities(size), intensity_vars(size), altitudes(size),
+        counts(size) {}
+  std::vector<float> intensities;
+  std::vector<float> intensity_vars;
+  std::vector<float> altitudes;
+  std::vector<unsigned int> counts;
+};
+
+// Copy the window with the top left corner at (offset_x, offset_y) of the
+// first node, in the same way as LocalizationLidar::ComposeMapNode.
+template <typename CopyRow>
+void AssembleWindow(const int cols, const int rows, const int offset_x,
+                    const int offset_y, const CopyRow& copy_row) {
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      const int range_x = j == 0 ? cols - offset_x : offset_x;
+      const int range_y = i == 0 ? rows - offset_y : offset_y;
+      const int src_x = j == 0 ? offset_x : 0;
+      const int src_y = i == 0 ? offset_y : 0;
+      const int dst_x = j == 0 ? 0 : cols - offset_x;
+      const int dst_y = i == 0 ? 0 : rows - offset_y;
+      for (int y = 0; y < range_y; ++y) {
+        copy_row(i, j, src_y + y, src_x, (dst_y + y) * cols + dst_x, range_x);
+      }
+    }
+  }
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count() / FLAGS_benchmark_num_runs;
+}
+
+int Run() {
+  LossyMapConfig2D config("lossy_map");
+  LossyMapNodePool2D node_pool(25, 8);
+  node_pool.Initial(&config);
+  LossyMap2D map(&config);
+  map.InitThreadPool(1, 6);
+  map.InitMapNodeCaches(12, 24);
+  map.AttachMapNodePool(&node_pool);
+  if (!map.SetMapFolderPath(FLAGS_map_folder)) {
+    std::cerr << "Invalid map folder: " << FLAGS_map_folder << std::endl;
+    return 1;
+  }
+
+  MapNodeIndex index;
+  index.resolution_id_ = 0;
+  index.zone_id_ = 50;
+  index.m_ = 34636;
+  index.n_ = 3436;
+  const LossyMapMatrix2D* matrices[2][2] = {{nullptr}};
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      MapNodeIndex node_index = index;
+      node_index.m_ += i;
+      node_index.n_ += j;
+      BaseMapNode* node = map.GetMapNodeSafe(node_index);
+      matrices[i][j] =
+          &static_cast<const LossyMapMatrix2D&>(node->GetMapCellMatrix());
+    }
+  }
+
+  const int cols = config.map_node_size_x_;
+  const int rows = config.map_node_size_y_;
+  Window cell_window(cols * rows);
+  Window plane_window(cols * rows);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < FLAGS_benchmark_num_runs; ++run) {
+    AssembleWindow(cols, rows, FLAGS_offset_x, FLAGS_offset_y,
+                   [&](int i, int j, int src_row, int src_col, int dst_idx,
+                       int length) {
+                     const LossyMapCell2D* cells =
+                         (*matrices[i][j])[src_row] + src_col;
+                     for (int x = 0; x < length; ++x) {
+                       cell_window.intensities[dst_idx + x] =
+                           cells[x].intensity;
+                       cell_window.intensity_vars[dst_idx + x] =
+                           cells[x].intensity_var;
+                       cell_window.altitudes[dst_idx + x] = cells[x].altitude;
+                       cell_window.counts[dst_idx + x] = cells[x].count;
+                     }
+                   });
+  }
+  const double cell_ms = ElapsedMs(start);
+
+  // The planes are built once when a node is first used.
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      matrices[i][j]->GetPlanes();
+    }
+  }
+  const std::chrono::duration<double, std::milli> build_duration =
+      std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int run = 0; run < FLAGS_benchmark_num_runs; ++run) {
+    AssembleWindow(cols, rows, FLAGS_offset_x, FLAGS_offset_y,
+                   [&](int i, int j, int src_row, int src_col, int dst_idx,
+                       int length) {
+                     const LossyMapPlanes2D& planes =
+                         matrices[i][j]->GetPlanes();
+                     const int src_idx = src_row * cols + src_col;
+                     memcpy(&plane_window.intensities[dst_idx],
+                            &planes.intensities[src_idx],
+                            length * sizeof(float));
+                     memcpy(&plane_window.intensity_vars[dst_idx],
+                            &planes.intensity_vars[src_idx],
+                            length * sizeof(float));
+                     memcpy(&plane_window.altitudes[dst_idx],
+                            &planes.altitudes[src_idx],
+                            length * sizeof(float));
+                     memcpy(&plane_window.counts[dst_idx],
+                            &planes.counts[src_idx],
+                            length * sizeof(unsigned int));
+                   });
+  }
+  const double plane_ms = ElapsedMs(start);
+
+  const bool is_same =
+      cell_window.intensities == plane_window.intensities &&
+      cell_window.intensity_vars == plane_window.intensity_vars &&
+      cell_window.altitudes == plane_window.altitudes &&
+      cell_window.counts == plane_window.counts;
+  std::cout << "window: " << cols << "x" << rows << std::endl
+            << "cells:  " << cell_ms << " ms/window" << std::endl
+            << "planes: " << plane_ms << " ms/window, "
+            << build_duration.count() << " ms to build the planes of 4 nodes"
+            << std::endl
+            << "same result: " << (is_same ? "yes" : "no") << std::endl;
+  return is_same ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::localization::msf::Run();
+}
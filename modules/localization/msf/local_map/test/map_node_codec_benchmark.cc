@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the disk size and the load latency of the lossy map nodes
+ *        written with each codec. The files are read from the page cache
+ *        after the first run, so the latency is mostly the decode time.
+ */
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/localization/msf/common/util/compression.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
+
+DEFINE_string(map_folder,
+              "modules/localization/msf/local_map/test/test_data/"
+              "lossy_single_map",
+              "The lossy map folder.");
+DEFINE_string(output_folder, "/tmp/map_node_codec_benchmark",
+              "The folder of the converted maps, removed at the end.");
+DEFINE_int32(benchmark_num_runs, 10, "Number of loads of each node.");
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace {
+
+std::vector<std::string> GetNodeFiles(const std::string& map_folder) {
+  std::vector<std::string> files;
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_folder + "/map");
+  for (; iter != end_iter; ++iter) {
+    if (!boost::filesystem::is_directory(*iter)) {
+      files.push_back(iter->path().string());
+    }
+  }
+  return files;
+}
+
+int Run() {
+  LossyMapConfig2D src_config("lossy_map");
+  const std::vector<std::string> src_files = GetNodeFiles(FLAGS_map_folder);
+  std::vector<LossyMapNode2D> src_nodes(src_files.size());
+  for (size_t i = 0; i < src_files.size(); ++i) {
+    src_nodes[i].InitMapMatrix(&src_config);
+    if (!src_nodes[i].Load(src_files[i].c_str())) {
+      return 1;
+    }
+  }
+
+  std::cout << std::setw(8) << "codec" << std::setw(14) << "size (KB)"
+            << std::setw(16) << "load (ms/node)" << std::endl;
+  const CompressionStrategy::CodecType codecs[] = {
+      CompressionStrategy::CODEC_NONE, CompressionStrategy::CODEC_ZLIB,
+      CompressionStrategy::CODEC_LZ4};
+  for (const CompressionStrategy::CodecType codec : codecs) {
+    LossyMapConfig2D config("lossy_map");
+    config.map_folder_path_ =
+        FLAGS_output_folder + "/" + CompressionStrategy::GetCodecName(codec);
+    config.map_compression_codec_ = codec;
+    for (const LossyMapNode2D& src_node : src_nodes) {
+      LossyMapNode2D node;
+      node.Init(&config, src_node.GetMapNodeIndex());
+      static_cast<LossyMapMatrix2D&>(node.GetMapCellMatrix()) =
+          static_cast<const LossyMapMatrix2D&>(src_node.GetMapCellMatrix());
+      node.Save();
+    }
+
+    uintmax_t size = 0;
+    const std::vector<std::string> files =
+        GetNodeFiles(config.map_folder_path_);
+    for (const std::string& file : files) {
+      size += boost::filesystem::file_size(file);
+    }
+
+    LossyMapNode2D node;
+    node.InitMapMatrix(&config);
+    const auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < FLAGS_benchmark_num_runs; ++run) {
+      for (const std::string& file : files) {
+        node.Load(file.c_str());
+      }
+    }
+    const std::chrono::duration<double, std::milli> duration =
+        std::chrono::steady_clock::now() - start;
+    std::cout << std::setw(8) << CompressionStrategy::GetCodecName(codec)
+              << std::setw(14) << size / 1024 << std::setw(16)
+              << duration.count() / FLAGS_benchmark_num_runs / files.size()
+              << std::endl;
+  }
+  boost::filesystem::remove_all(FLAGS_output_folder);
+  return 0;
+}
+
+}  // namespace
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::localization::msf::Run();
+}
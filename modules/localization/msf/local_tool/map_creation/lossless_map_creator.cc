@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 #include "boost/filesystem.hpp"
@@ -23,12 +25,14 @@
 #include "modules/localization/msf/common/util/extract_ground_plane.h"
 #include "modules/localization/msf/common/util/system_utility.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_builder.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_pool.h"
 
 const unsigned int CAR_SENSOR_LASER_NUMBER = 64;
 
 using apollo::localization::msf::FeatureXYPlane;
 using apollo::localization::msf::LosslessMap;
+using apollo::localization::msf::LosslessMapBuilder;
 using apollo::localization::msf::LosslessMapConfig;
 using apollo::localization::msf::LosslessMapMatrix;
 using apollo::localization::msf::LosslessMapNode;
@@ -73,7 +77,21 @@ bool ParseCommandLine(int argc, char* argv[],
           "resolution",
           boost::program_options::value<float>()->default_value(0.125),
           "optional: resolution for single resolution generation, default: "
-          "0.125");
+          "0.125")(
+          "thread_num",
+          boost::program_options::value<unsigned int>()->default_value(
+              std::max(std::thread::hardware_concurrency(), 1u)),
+          "optional: number of threads to load and add the frames, default: "
+          "the number of cores")(
+          "map_node_pool_size",
+          boost::program_options::value<unsigned int>()->default_value(25),
+          "optional: number of map nodes kept in memory, default: 25")(
+          "checkpoint_interval",
+          boost::program_options::value<unsigned int>()->default_value(1000),
+          "optional: number of frames between two checkpoints, default: 1000")(
+          "resume", boost::program_options::value<bool>()->default_value(false),
+          "optional: resume from the last checkpoint in the map folder, "
+          "default: false");
   try {
     boost::program_options::store(
         boost::program_options::parse_command_line(argc, argv, desc), *vm);
@@ -103,8 +121,6 @@ void VarianceOnline(double* mean, double* var, unsigned int* N, double x) {
 }
 
 int main(int argc, char** argv) {
-  FeatureXYPlane plane_extractor;
-
   boost::program_options::variables_map boost_args;
   if (!ParseCommandLine(argc, argv, &boost_args)) {
     std::cerr << "Parse input command line failed." << std::endl;
@@ -182,8 +198,11 @@ int main(int argc, char** argv) {
     apollo::localization::msf::system::CreateDirectory(map_folder_path);
   }
   map.SetMapFolderPath(map_folder_path);
-  for (size_t i = 0; i < pcd_folder_pathes.size(); ++i) {
-    map.AddDataset(pcd_folder_pathes[i]);
+  const bool resume = boost_args["resume"].as<bool>();
+  if (!resume) {
+    for (size_t i = 0; i < pcd_folder_pathes.size(); ++i) {
+      map.AddDataset(pcd_folder_pathes[i]);
+    }
   }
   if (strcasecmp(map_resolution_type.c_str(), "single") == 0) {
     loss_less_config.SetSingleResolutions(single_resolution_map);
@@ -251,63 +270,87 @@ int main(int argc, char** argv) {
               << "./lossless_map/config.txt" << std::endl;
   }
 
-  LosslessMapNodePool lossless_map_node_pool(25, 8);
+  LosslessMapNodePool lossless_map_node_pool(
+      boost_args["map_node_pool_size"].as<unsigned int>(), 8);
   lossless_map_node_pool.Initial(&loss_less_config);
   map.InitThreadPool(1, 6);
   map.InitMapNodeCaches(12, 24);
   map.AttachMapNodePool(&lossless_map_node_pool);
 
+  std::vector<std::pair<unsigned int, unsigned int>> trial_frames;
   for (unsigned int trial = 0; trial < num_trials; ++trial) {
     for (unsigned int frame_idx = 0; frame_idx < ieout_poses[trial].size();
          ++frame_idx) {
-      unsigned int trial_frame_idx = frame_idx;
-      const std::vector<Eigen::Affine3d>& poses = ieout_poses[trial];
-      apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
-      std::string pcd_file_path;
-      std::ostringstream ss;
-      ss << pcd_indices[trial][frame_idx];
-      pcd_file_path = pcd_folder_pathes[trial] + "/" + ss.str() + ".pcd";
-      const Eigen::Affine3d& pcd_pose = poses[trial_frame_idx];
-      apollo::localization::msf::velodyne::LoadPcds(
-          pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
-      AERROR << "Loaded " << velodyne_frame.pt3ds.size()
-             << "3D Points at Trial: " << trial << " Frame: " << trial_frame_idx
-             << ".";
+      trial_frames.emplace_back(trial, frame_idx);
+    }
+  }
+
+  // Called from the worker threads of the builder.
+  auto load_frame = [&](unsigned int frame_id,
+                        LosslessMapBuilder::Frame* frame) {
+    const unsigned int trial = trial_frames[frame_id].first;
+    const unsigned int trial_frame_idx = trial_frames[frame_id].second;
+    const std::vector<Eigen::Affine3d>& poses = ieout_poses[trial];
+    apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
+    std::string pcd_file_path;
+    std::ostringstream ss;
+    ss << pcd_indices[trial][trial_frame_idx];
+    pcd_file_path = pcd_folder_pathes[trial] + "/" + ss.str() + ".pcd";
+    const Eigen::Affine3d& pcd_pose = poses[trial_frame_idx];
+    apollo::localization::msf::velodyne::LoadPcds(
+        pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
+    AERROR << "Loaded " << velodyne_frame.pt3ds.size()
+           << "3D Points at Trial: " << trial << " Frame: " << trial_frame_idx
+           << ".";
+
+    frame->pt3ds.resize(velodyne_frame.pt3ds.size());
+    for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+      frame->pt3ds[i] = velodyne_frame.pose * velodyne_frame.pt3ds[i];
+    }
+    frame->intensities.swap(velodyne_frame.intensities);
 
+    if (use_plane_inliers_only) {
+      PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
+      pcl_pc->resize(velodyne_frame.pt3ds.size());
       for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-        Eigen::Vector3d& pt3d_local = velodyne_frame.pt3ds[i];
-        unsigned char intensity = velodyne_frame.intensities[i];
-        Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local;
-        map.SetValue(pt3d_global, zone_id, intensity);
+        PclPointT& pt = pcl_pc->at(i);
+        pt.x = velodyne_frame.pt3ds[i][0];
+        pt.y = velodyne_frame.pt3ds[i][1];
+        pt.z = velodyne_frame.pt3ds[i][2];
+        pt.intensity = static_cast<float>(frame->intensities[i]);
       }
 
-      if (use_plane_inliers_only) {
-        PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
-        pcl_pc->resize(velodyne_frame.pt3ds.size());
-        for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-          PclPointT& pt = pcl_pc->at(i);
-          pt.x = velodyne_frame.pt3ds[i][0];
-          pt.y = velodyne_frame.pt3ds[i][1];
-          pt.z = velodyne_frame.pt3ds[i][2];
-          pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
-        }
-
-        plane_extractor.ExtractXYPlane(pcl_pc);
-        PclPointCloudPtrT& plane_pc = plane_extractor.GetXYPlaneCloud();
+      FeatureXYPlane plane_extractor;
+      plane_extractor.ExtractXYPlane(pcl_pc);
+      PclPointCloudPtrT& plane_pc = plane_extractor.GetXYPlaneCloud();
 
-        for (unsigned int k = 0; k < plane_pc->size(); ++k) {
-          const PclPointT& plane_pt = plane_pc->at(k);
-          Eigen::Vector3d pt3d_local_double;
-          pt3d_local_double[0] = plane_pt.x;
-          pt3d_local_double[1] = plane_pt.y;
-          pt3d_local_double[2] = plane_pt.z;
-          unsigned char intensity =
-              static_cast<unsigned char>(plane_pt.intensity);
-          Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local_double;
-          map.SetValueLayer(pt3d_global, zone_id, intensity);
-        }
+      frame->layer_pt3ds.resize(plane_pc->size());
+      frame->layer_intensities.resize(plane_pc->size());
+      for (unsigned int k = 0; k < plane_pc->size(); ++k) {
+        const PclPointT& plane_pt = plane_pc->at(k);
+        Eigen::Vector3d pt3d_local_double;
+        pt3d_local_double[0] = plane_pt.x;
+        pt3d_local_double[1] = plane_pt.y;
+        pt3d_local_double[2] = plane_pt.z;
+        frame->layer_pt3ds[k] = velodyne_frame.pose * pt3d_local_double;
+        frame->layer_intensities[k] =
+            static_cast<unsigned char>(plane_pt.intensity);
       }
     }
+    return true;
+  };
+
+  {
+    LosslessMapBuilder builder(&loss_less_config, &lossless_map_node_pool,
+                               zone_id,
+                               boost_args["thread_num"].as<unsigned int>());
+    builder.SetCheckpointInterval(
+        boost_args["checkpoint_interval"].as<unsigned int>());
+    if (!builder.Build(trial_frames.size(), load_frame, resume)) {
+      std::cerr << "Failed to build the map, it can be resumed from frame "
+                << builder.GetSavedFrameNum() << "." << std::endl;
+      return -1;
+    }
   }
 
   // Compute the ground height offset
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Rewrite the nodes of a lossless or a lossy map with another codec.
+ *        The nodes of the old versions, which have no codec in the header,
+ *        are converted as well.
+ */
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "modules/localization/msf/common/util/compression.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+void GetAllMapNodeFiles(const std::string& map_folder,
+                        std::vector<std::string>* files) {
+  files->clear();
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_folder + "/map");
+  for (; iter != end_iter; ++iter) {
+    if (!boost::filesystem::is_directory(*iter) &&
+        iter->path().extension() == "") {
+      files->push_back(iter->path().string());
+    }
+  }
+}
+
+template <typename MapConfig, typename MapNode>
+int ConvertMap(const std::string& map_version, const std::string& src_folder,
+               const std::string& dst_folder,
+               CompressionStrategy::CodecType codec_type) {
+  MapConfig config(map_version);
+  if (!config.Load(src_folder + "/config.xml")) {
+    return -1;
+  }
+  config.map_folder_path_ = dst_folder;
+  config.map_compression_codec_ = codec_type;
+  if (!boost::filesystem::exists(dst_folder)) {
+    boost::filesystem::create_directories(dst_folder);
+  }
+  config.Save(dst_folder + "/config.xml");
+
+  std::vector<std::string> files;
+  GetAllMapNodeFiles(src_folder, &files);
+  std::cout << "node size: " << files.size() << std::endl;
+
+  uintmax_t src_size = 0;
+  uintmax_t dst_size = 0;
+  MapNode node;
+  node.InitMapMatrix(&config);
+  for (const std::string& file : files) {
+    // The node index is read from the header of the file.
+    if (!node.Load(file.c_str()) || !node.Save()) {
+      std::cerr << "Can't convert the map node: " << file << std::endl;
+      return -1;
+    }
+    src_size += boost::filesystem::file_size(file);
+    dst_size += boost::filesystem::file_size(
+        dst_folder + file.substr(src_folder.length()));
+  }
+  std::cout << "converted to " << CompressionStrategy::GetCodecName(codec_type)
+            << ", size: " << src_size << " -> " << dst_size << " bytes"
+            << std::endl;
+  return 0;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+using apollo::localization::msf::CompressionStrategy;
+using apollo::localization::msf::ConvertMap;
+using apollo::localization::msf::LosslessMapConfig;
+using apollo::localization::msf::LosslessMapNode;
+using apollo::localization::msf::LossyMapConfig2D;
+using apollo::localization::msf::LossyMapNode2D;
+
+int main(int argc, char** argv) {
+  boost::program_options::options_description boost_desc("Allowed options");
+  boost_desc.add_options()("help", "produce help message")(
+      "srcdir", boost::program_options::value<std::string>(),
+      "provide the source map folder")(
+      "dstdir", boost::program_options::value<std::string>(),
+      "provide the destination map folder")(
+      "codec", boost::program_options::value<std::string>()->default_value(
+                   "lz4"),
+      "provide the codec of the map nodes: none, zlib or lz4");
+
+  boost::program_options::variables_map boost_args;
+  boost::program_options::store(
+      boost::program_options::parse_command_line(argc, argv, boost_desc),
+      boost_args);
+  boost::program_options::notify(boost_args);
+
+  if (boost_args.count("help") || !boost_args.count("srcdir") ||
+      !boost_args.count("dstdir")) {
+    std::cout << boost_desc << std::endl;
+    return 0;
+  }
+
+  const std::string src_folder = boost_args["srcdir"].as<std::string>();
+  const std::string dst_folder = boost_args["dstdir"].as<std::string>();
+  const std::string codec_name = boost_args["codec"].as<std::string>();
+  CompressionStrategy::CodecType codec_type;
+  if (!CompressionStrategy::GetCodecType(codec_name, &codec_type)) {
+    std::cerr << "Unknown codec: " << codec_name << std::endl;
+    return -1;
+  }
+  if (boost::filesystem::exists(dst_folder) &&
+      boost::filesystem::equivalent(src_folder, dst_folder)) {
+    std::cerr << "The destination folder must differ from the source."
+              << std::endl;
+    return -1;
+  }
+
+  boost::property_tree::ptree config;
+  boost::property_tree::read_xml(src_folder + "/config.xml", config);
+  const std::string map_version =
+      config.get<std::string>("map.map_config.version");
+  if (map_version == "lossless_map") {
+    return ConvertMap<LosslessMapConfig, LosslessMapNode>(
+        map_version, src_folder, dst_folder, codec_type);
+  }
+  if (map_version == "lossy_map") {
+    return ConvertMap<LossyMapConfig2D, LossyMapNode2D>(
+        map_version, src_folder, dst_folder, codec_type);
+  }
+  std::cerr << "Unknown map version: " << map_version << std::endl;
+  return -1;
+}
@@ -16,6 +16,9 @@
 
 #include "modules/localization/rtk/rtk_localization.h"
 
+#include <cmath>
+#include <limits>
+
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
@@ -33,7 +36,10 @@ using ::Eigen::Vector3d;
 
 RTKLocalization::RTKLocalization()
     : monitor_logger_(MonitorMessageItem::LOCALIZATION),
-      map_offset_{FLAGS_map_offset_x, FLAGS_map_offset_y, FLAGS_map_offset_z} {}
+      map_offset_{FLAGS_map_offset_x, FLAGS_map_offset_y, FLAGS_map_offset_z},
+      imu_buffer_(FLAGS_imu_buffer_size) {
+  CHECK_GT(FLAGS_imu_buffer_size, 0);
+}
 
 RTKLocalization::~RTKLocalization() {}
 
@@ -95,6 +101,8 @@ void RTKLocalization::OnTimer(const ros::TimerEvent &event) {
     return;
   }
 
+  UpdateImuBuffer();
+
   // publish localization messages
   PublishLocalization();
   service_started_ = true;
@@ -105,21 +113,107 @@ void RTKLocalization::OnTimer(const ros::TimerEvent &event) {
   last_received_timestamp_sec_ = common::time::ToSecond(Clock::Now());
 }
 
-template <class T>
-T RTKLocalization::InterpolateXYZ(const T &p1, const T &p2,
-                                  const double frac1) {
-  T p;
-  double frac2 = 1.0 - frac1;
-  if (p1.has_x() && !std::isnan(p1.x()) && p2.has_x() && !std::isnan(p2.x())) {
-    p.set_x(p1.x() * frac2 + p2.x() * frac1);
+void RTKLocalization::UpdateImuBuffer() {
+  auto *imu_adapter = AdapterManager::GetImu();
+  if (imu_adapter->Empty()) {
+    return;
   }
-  if (p1.has_y() && !std::isnan(p1.y()) && p2.has_y() && !std::isnan(p2.y())) {
-    p.set_y(p1.y() * frac2 + p2.y() * frac1);
+  if (!imu_buffer_.empty() &&
+      imu_adapter->GetLatestObserved().header().timestamp_sec() <
+          imu_buffer_.timestamp_sec_at(imu_buffer_.size() - 1)) {
+    AERROR << "IMU timestamp goes back, reset the IMU buffer.";
+    imu_buffer_.Clear();
+    imu_msgs_.clear();
   }
-  if (p1.has_z() && !std::isnan(p1.z()) && p2.has_z() && !std::isnan(p2.z())) {
-    p.set_z(p1.z() * frac2 + p2.z() * frac1);
+
+  // The observed queue starts from the newest message, collect the messages
+  // newer than the buffer and push them in the time order.
+  std::vector<const CorrectedImu *> imu_msgs;
+  for (ImuAdapter::Iterator imu_it = imu_adapter->begin();
+       imu_it != imu_adapter->end(); ++imu_it) {
+    const double timestamp_sec = (*imu_it)->header().timestamp_sec();
+    if (!imu_buffer_.empty() &&
+        timestamp_sec <= imu_buffer_.timestamp_sec_at(imu_buffer_.size() - 1)) {
+      break;
+    }
+    if (!imu_msgs.empty() &&
+        timestamp_sec >= imu_msgs.back()->header().timestamp_sec()) {
+      break;
+    }
+    imu_msgs.push_back(imu_it->get());
   }
-  return p;
+  for (auto imu_it = imu_msgs.rbegin(); imu_it != imu_msgs.rend(); ++imu_it) {
+    if (!(*imu_it)->has_header()) {
+      AERROR << "imu_msg must have header.";
+      continue;
+    }
+    if (!imu_buffer_.Push((*imu_it)->header().timestamp_sec(),
+                          ToImuSample(**imu_it))) {
+      continue;
+    }
+    imu_msgs_.push_back(**imu_it);
+    if (imu_msgs_.size() > imu_buffer_.size()) {
+      imu_msgs_.pop_front();
+    }
+  }
+}
+
+RTKLocalization::ImuBuffer::Sample RTKLocalization::ToImuSample(
+    const CorrectedImu &imu_msg) {
+  ImuBuffer::Sample sample;
+  sample.fill(std::numeric_limits<double>::quiet_NaN());
+  auto copy_xyz = [&sample](const common::Point3D &point, const int offset) {
+    if (point.has_x()) {
+      sample[offset] = point.x();
+    }
+    if (point.has_y()) {
+      sample[offset + 1] = point.y();
+    }
+    if (point.has_z()) {
+      sample[offset + 2] = point.z();
+    }
+  };
+  const auto &imu = imu_msg.imu();
+  if (imu.has_linear_acceleration()) {
+    copy_xyz(imu.linear_acceleration(), 0);
+  }
+  if (imu.has_angular_velocity()) {
+    copy_xyz(imu.angular_velocity(), 3);
+  }
+  if (imu.has_euler_angles()) {
+    copy_xyz(imu.euler_angles(), 6);
+  }
+  return sample;
+}
+
+void RTKLocalization::SetImuVectors(const ImuBuffer::Sample &sample1,
+                                    const ImuBuffer::Sample &sample2,
+                                    const ImuBuffer::Sample &interpolated,
+                                    CorrectedImu *imu_msg) {
+  auto has_xyz = [](const ImuBuffer::Sample &sample, const int offset) {
+    return !(std::isnan(sample[offset]) && std::isnan(sample[offset + 1]) &&
+             std::isnan(sample[offset + 2]));
+  };
+  auto set_xyz = [&](const int offset,
+                     common::Point3D *(Pose::*mutable_xyz)()) {
+    if (!has_xyz(sample1, offset) || !has_xyz(sample2, offset)) {
+      return;
+    }
+    common::Point3D *point = (imu_msg->mutable_imu()->*mutable_xyz)();
+    point->Clear();
+    if (!std::isnan(interpolated[offset])) {
+      point->set_x(interpolated[offset]);
+    }
+    if (!std::isnan(interpolated[offset + 1])) {
+      point->set_y(interpolated[offset + 1]);
+    }
+    if (!std::isnan(interpolated[offset + 2])) {
+      point->set_z(interpolated[offset + 2]);
+    }
+  };
+  set_xyz(0, &Pose::mutable_linear_acceleration);
+  set_xyz(3, &Pose::mutable_angular_velocity);
+  set_xyz(6, &Pose::mutable_euler_angles);
 }
 
 bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
@@ -128,66 +222,39 @@ bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
     AERROR << "imu_msg should NOT be nullptr.";
     return false;
   }
-  auto *imu_adapter = AdapterManager::GetImu();
-  if (imu_adapter->Empty()) {
+  if (imu_buffer_.empty()) {
     AERROR << "Cannot find Matching IMU. "
            << "IMU message Queue is empty! GPS timestamp[" << gps_timestamp_sec
            << "]";
     return false;
   }
 
-  // scan imu buffer, find first imu message that is newer than the given
-  // timestamp
-  ImuAdapter::Iterator imu_it = imu_adapter->begin();
-  for (; imu_it != imu_adapter->end(); ++imu_it) {
-    if ((*imu_it)->header().timestamp_sec() - gps_timestamp_sec >
-        FLAGS_timestamp_sec_tolerance) {
-      break;
-    }
-  }
-
-  if (imu_it != imu_adapter->end()) {  // found one
-    if (imu_it == imu_adapter->begin()) {
-      AERROR << "IMU queue too short or request too old. "
-             << "Oldest timestamp["
-             << imu_adapter->GetOldestObserved().header().timestamp_sec()
-             << "], Newest timestamp["
-             << imu_adapter->GetLatestObserved().header().timestamp_sec()
-             << "], GPS timestamp[" << gps_timestamp_sec << "]";
-      *imu_msg = imu_adapter->GetOldestObserved();  // the oldest imu
-    } else {
-      // here is the normal case
-      auto imu_it_1 = imu_it;
-      imu_it_1--;
-      if (!(*imu_it)->has_header() || !(*imu_it_1)->has_header()) {
-        AERROR << "imu1 and imu_it_1 must both have header.";
-        return false;
-      }
-      if (!InterpolateIMU(**imu_it_1, **imu_it, gps_timestamp_sec, imu_msg)) {
-        AERROR << "failed to interpolate IMU";
-        return false;
-      }
-    }
+  // find the first imu message that is newer than the given timestamp
+  const size_t index =
+      imu_buffer_.UpperBound(gps_timestamp_sec + FLAGS_timestamp_sec_tolerance);
+  const size_t newest = imu_buffer_.size() - 1;
+
+  if (index == 0) {
+    AERROR << "IMU queue too short or request too old. "
+           << "Oldest timestamp[" << imu_buffer_.timestamp_sec_at(0)
+           << "], Newest timestamp[" << imu_buffer_.timestamp_sec_at(newest)
+           << "], GPS timestamp[" << gps_timestamp_sec << "]";
+    *imu_msg = imu_msgs_.front();  // the oldest imu
+  } else if (index <= newest) {
+    // here is the normal case
+    InterpolateImuSample(imu_msgs_[index - 1], imu_buffer_.sample_at(index - 1),
+                         imu_buffer_.timestamp_sec_at(index),
+                         imu_buffer_.sample_at(index), gps_timestamp_sec,
+                         imu_msg);
   } else {
     // give the newest imu, without extrapolation
-    *imu_msg = imu_adapter->GetLatestObserved();
-    if (imu_msg == nullptr) {
-      AERROR << "Fail to get latest observed imu_msg.";
-      return false;
-    }
-
-    if (!imu_msg->has_header()) {
-      AERROR << "imu_msg must have header.";
-      return false;
-    }
-
+    *imu_msg = imu_msgs_.back();
     if (fabs(imu_msg->header().timestamp_sec() - gps_timestamp_sec) >
         FLAGS_report_gps_imu_time_diff_threshold) {
       // 20ms threshold to report error
       AERROR << "Cannot find Matching IMU. "
              << "IMU messages too old"
-             << "Newest timestamp["
-             << imu_adapter->GetLatestObserved().header().timestamp_sec()
+             << "Newest timestamp[" << imu_buffer_.timestamp_sec_at(newest)
              << "], GPS timestamp[" << gps_timestamp_sec << "]";
     }
   }
@@ -202,51 +269,39 @@ bool RTKLocalization::InterpolateIMU(const CorrectedImu &imu1,
     AERROR << "imu1 and imu2 has no header or no timestamp_sec in header";
     return false;
   }
-  if (timestamp_sec - imu1.header().timestamp_sec() <
-      FLAGS_timestamp_sec_tolerance) {
+  InterpolateImuSample(imu1, ToImuSample(imu1),
+                       imu2.header().timestamp_sec(), ToImuSample(imu2),
+                       timestamp_sec, imu_msg);
+  return true;
+}
+
+void RTKLocalization::InterpolateImuSample(const CorrectedImu &imu1,
+                                           const ImuBuffer::Sample &sample1,
+                                           const double timestamp_sec2,
+                                           const ImuBuffer::Sample &sample2,
+                                           const double timestamp_sec,
+                                           CorrectedImu *imu_msg) const {
+  const double timestamp_sec1 = imu1.header().timestamp_sec();
+  if (timestamp_sec - timestamp_sec1 < FLAGS_timestamp_sec_tolerance) {
     AERROR << "[InterpolateIMU]: the given time stamp[" << timestamp_sec
-           << "] is older than the 1st message["
-           << imu1.header().timestamp_sec() << "]";
+           << "] is older than the 1st message[" << timestamp_sec1 << "]";
     *imu_msg = imu1;
-  } else if (timestamp_sec - imu2.header().timestamp_sec() >
-             FLAGS_timestamp_sec_tolerance) {
+  } else if (timestamp_sec - timestamp_sec2 > FLAGS_timestamp_sec_tolerance) {
     AERROR << "[InterpolateIMU]: the given time stamp[" << timestamp_sec
-           << "] is newer than the 2nd message["
-           << imu2.header().timestamp_sec() << "]";
+           << "] is newer than the 2nd message[" << timestamp_sec2 << "]";
     *imu_msg = imu1;
   } else {
     *imu_msg = imu1;
     imu_msg->mutable_header()->set_timestamp_sec(timestamp_sec);
 
-    double time_diff =
-        imu2.header().timestamp_sec() - imu1.header().timestamp_sec();
+    double time_diff = timestamp_sec2 - timestamp_sec1;
     if (fabs(time_diff) >= 0.001) {
-      double frac1 =
-          (timestamp_sec - imu1.header().timestamp_sec()) / time_diff;
-
-      if (imu1.has_imu() && imu1.imu().has_angular_velocity() &&
-          imu2.has_imu() && imu2.imu().has_angular_velocity()) {
-        auto val = InterpolateXYZ(imu1.imu().angular_velocity(),
-                                  imu2.imu().angular_velocity(), frac1);
-        imu_msg->mutable_imu()->mutable_angular_velocity()->CopyFrom(val);
-      }
-
-      if (imu1.has_imu() && imu1.imu().has_linear_acceleration() &&
-          imu2.has_imu() && imu2.imu().has_linear_acceleration()) {
-        auto val = InterpolateXYZ(imu1.imu().linear_acceleration(),
-                                  imu2.imu().linear_acceleration(), frac1);
-        imu_msg->mutable_imu()->mutable_linear_acceleration()->CopyFrom(val);
-      }
-
-      if (imu1.has_imu() && imu1.imu().has_euler_angles() && imu2.has_imu() &&
-          imu2.imu().has_euler_angles()) {
-        auto val = InterpolateXYZ(imu1.imu().euler_angles(),
-                                  imu2.imu().euler_angles(), frac1);
-        imu_msg->mutable_imu()->mutable_euler_angles()->CopyFrom(val);
-      }
+      double frac1 = (timestamp_sec - timestamp_sec1) / time_diff;
+      SetImuVectors(sample1, sample2,
+                    ImuBuffer::InterpolateSamples(sample1, sample2, frac1),
+                    imu_msg);
     }
   }
-  return true;
 }
 
 void RTKLocalization::PrepareLocalizationMsg(
@@ -22,6 +22,7 @@
 #ifndef MODULES_LOCALIZATION_RTK_RTK_LOCALIZATION_H_
 #define MODULES_LOCALIZATION_RTK_RTK_LOCALIZATION_H_
 
+#include <deque>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -38,6 +39,7 @@
 
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
+#include "modules/common/util/time_series_buffer.h"
 #include "modules/localization/localization_base.h"
 
 /**
@@ -81,8 +83,23 @@ class RTKLocalization : public LocalizationBase {
   bool FindMatchingIMU(const double gps_timestamp_sec, CorrectedImu *imu_msg);
   bool InterpolateIMU(const CorrectedImu &imu1, const CorrectedImu &imu2,
                       const double timestamp_sec, CorrectedImu *msgbuf);
-  template <class T>
-  T InterpolateXYZ(const T &p1, const T &p2, const double frac1);
+
+  // The linear acceleration, angular velocity and euler angles of an imu
+  // message, a missing value is NaN.
+  typedef common::util::TimeSeriesBuffer<9> ImuBuffer;
+  void UpdateImuBuffer();
+  void InterpolateImuSample(const CorrectedImu &imu1,
+                            const ImuBuffer::Sample &sample1,
+                            const double timestamp_sec2,
+                            const ImuBuffer::Sample &sample2,
+                            const double timestamp_sec,
+                            CorrectedImu *imu_msg) const;
+  static ImuBuffer::Sample ToImuSample(const CorrectedImu &imu_msg);
+  // Overwrite the vectors that both samples have with the interpolated ones.
+  static void SetImuVectors(const ImuBuffer::Sample &sample1,
+                            const ImuBuffer::Sample &sample2,
+                            const ImuBuffer::Sample &interpolated,
+                            CorrectedImu *imu_msg);
 
  private:
   ros::Timer timer_;
@@ -91,8 +108,12 @@ class RTKLocalization : public LocalizationBase {
   double last_received_timestamp_sec_ = 0.0;
   double last_reported_timestamp_sec_ = 0.0;
   bool service_started_ = false;
+  ImuBuffer imu_buffer_;
+  // The messages of the samples in imu_buffer_, in the same order.
+  std::deque<CorrectedImu> imu_msgs_;
 
   FRIEND_TEST(RTKLocalizationTest, InterpolateIMU);
+  FRIEND_TEST(RTKLocalizationTest, FindMatchingIMU);
   FRIEND_TEST(RTKLocalizationTest, ComposeLocalizationMsg);
 };
 
@@ -46,6 +46,12 @@ class RTKLocalizationTest : public ::testing::Test {
       sub_config->set_mode(AdapterConfig::PUBLISH_ONLY);
       sub_config->set_type(AdapterConfig::LOCALIZATION);
     }
+    {
+      auto *sub_config = config.add_config();
+      sub_config->set_mode(AdapterConfig::RECEIVE_ONLY);
+      sub_config->set_type(AdapterConfig::IMU);
+      sub_config->set_message_history_limit(20);
+    }
     AdapterManager::Init(config);
   }
 
@@ -135,6 +141,44 @@ TEST_F(RTKLocalizationTest, InterpolateIMU) {
   }
 }
 
+TEST_F(RTKLocalizationTest, FindMatchingIMU) {
+  apollo::localization::CorrectedImu imu;
+  EXPECT_FALSE(rtk_localizatoin_->FindMatchingIMU(100.0, &imu));
+
+  // Feed 30 messages at 100Hz in 3 cycles, the adapter keeps 20 of them.
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    for (int i = 0; i < 10; ++i) {
+      const double timestamp = 100.0 + (cycle * 10 + i) * 0.01;
+      apollo::localization::CorrectedImu msg;
+      msg.mutable_header()->set_timestamp_sec(timestamp);
+      msg.mutable_header()->set_sequence_num(cycle * 10 + i);
+      msg.mutable_imu()->mutable_linear_acceleration()->set_x(timestamp);
+      msg.mutable_imu()->mutable_angular_velocity()->set_z(-timestamp);
+      AdapterManager::FeedImuData(msg);
+    }
+    AdapterManager::Observe();
+    rtk_localizatoin_->UpdateImuBuffer();
+  }
+
+  // interpolate between the messages at 100.12 and 100.13
+  EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(100.125, &imu));
+  EXPECT_DOUBLE_EQ(100.125, imu.header().timestamp_sec());
+  // the rest of the message is copied from the message at 100.12
+  EXPECT_EQ(12, imu.header().sequence_num());
+  EXPECT_NEAR(100.125, imu.imu().linear_acceleration().x(), 1e-9);
+  EXPECT_FALSE(imu.imu().linear_acceleration().has_y());
+  EXPECT_NEAR(-100.125, imu.imu().angular_velocity().z(), 1e-9);
+  EXPECT_FALSE(imu.imu().has_euler_angles());
+
+  // older than the buffer, give the oldest imu
+  EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(99.0, &imu));
+  EXPECT_DOUBLE_EQ(100.0, imu.header().timestamp_sec());
+
+  // newer than the buffer, give the newest imu
+  EXPECT_TRUE(rtk_localizatoin_->FindMatchingIMU(101.0, &imu));
+  EXPECT_DOUBLE_EQ(100.29, imu.header().timestamp_sec());
+}
+
 TEST_F(RTKLocalizationTest, ComposeLocalizationMsg) {
   // FLAGS_enable_map_reference_unify: false
   {
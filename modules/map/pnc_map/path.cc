@@ -39,12 +39,74 @@ using common::math::LineSegment2d;
 using common::math::Polygon2d;
 using common::math::Sqr;
 using common::math::Vec2d;
-using std::placeholders::_1;
 
 namespace {
 
 const double kSampleDistance = 0.25;
 
+using GetOverlapsFromLaneFunc =
+    const std::vector<OverlapInfoConstPtr>& (LaneInfo::*)() const;
+
+// TODO(all): add support for parking.
+const GetOverlapsFromLaneFunc kGetOverlapsFromLane[] = {
+    &LaneInfo::cross_lanes, &LaneInfo::signals,    &LaneInfo::yield_signs,
+    &LaneInfo::stop_signs,  &LaneInfo::crosswalks, &LaneInfo::junctions,
+    &LaneInfo::clear_areas, &LaneInfo::speed_bumps,
+};
+
+bool IsSamePoint(const MapPathPoint& p1, const MapPathPoint& p2) {
+  if (p1.x() != p2.x() || p1.y() != p2.y() || p1.heading() != p2.heading() ||
+      p1.lane_waypoints().size() != p2.lane_waypoints().size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < p1.lane_waypoints().size(); ++i) {
+    const auto& wp1 = p1.lane_waypoints()[i];
+    const auto& wp2 = p2.lane_waypoints()[i];
+    if (wp1.lane != wp2.lane || wp1.s != wp2.s || wp1.l != wp2.l) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same as LaneInfo::GetWidthFromSample(), but remembers the last sample
+// interval, since the path is sampled with increasing s along each lane.
+class WidthSampler {
+ public:
+  double Get(const std::vector<LaneInfo::SampledWidth>& samples,
+             const double s) {
+    if (samples.empty()) {
+      return 0.0;
+    }
+    if (s <= samples[0].first) {
+      return samples[0].second;
+    }
+    if (s >= samples.back().first) {
+      return samples.back().second;
+    }
+    if (&samples != samples_ || samples[low_].first > s) {
+      samples_ = &samples;
+      low_ = 0;
+    }
+    while (samples[low_ + 1].first <= s) {
+      ++low_;
+    }
+    const LaneInfo::SampledWidth& sample1 = samples[low_];
+    const LaneInfo::SampledWidth& sample2 = samples[low_ + 1];
+    const double ratio = (sample2.first - s) / (sample2.first - sample1.first);
+    return sample1.second * ratio + sample2.second * (1.0 - ratio);
+  }
+
+ private:
+  const std::vector<LaneInfo::SampledWidth>* samples_ = nullptr;
+  std::size_t low_ = 0;
+};
+
+bool IsSameLaneSegment(const LaneSegment& s1, const LaneSegment& s2) {
+  return s1.lane == s2.lane && s1.start_s == s2.start_s &&
+         s1.end_s == s2.end_s;
+}
+
 bool FindLaneSegment(const MapPathPoint& p1, const MapPathPoint& p2,
                      LaneSegment* const lane_segment) {
   for (const auto& wp1 : p1.lane_waypoints()) {
@@ -268,17 +330,87 @@ Path::Path(std::vector<MapPathPoint>&& path_points,
   }
 }
 
-void Path::Init() {
-  InitPoints();
-  InitLaneSegments();
-  InitPointIndex();
-  InitWidth();
-  InitOverlaps();
+Path::Path(const Path& prev_path, std::vector<MapPathPoint>&& path_points)
+    : path_points_(std::move(path_points)) {
+  Init(&prev_path);
 }
 
-void Path::InitPoints() {
+Path::Path(const Path& prev_path, std::vector<MapPathPoint>&& path_points,
+           std::vector<LaneSegment>&& lane_segments,
+           const double max_approximation_error)
+    : path_points_(std::move(path_points)),
+      lane_segments_(std::move(lane_segments)) {
+  Init(&prev_path);
+  if (max_approximation_error > 0.0) {
+    use_path_approximation_ = true;
+    approximation_ = PathApproximation(*this, max_approximation_error);
+  }
+}
+
+void Path::Init(const Path* prev_path) {
   num_points_ = static_cast<int>(path_points_.size());
   CHECK_GE(num_points_, 2);
+  const SharedPoints shared =
+      prev_path == nullptr ? SharedPoints() : FindSharedPoints(*prev_path);
+  InitPoints(shared);
+  InitLaneSegments(shared);
+  InitPointIndex();
+  InitWidth();
+  InitOverlaps(prev_path);
+}
+
+Path::SharedPoints Path::FindSharedPoints(const Path& prev_path) const {
+  SharedPoints shared;
+  const auto& prev_points = prev_path.path_points_;
+  if (prev_points.empty() ||
+      prev_path.num_points_ != static_cast<int>(prev_points.size())) {
+    return shared;
+  }
+  // The shared points are either a prefix of this path (e.g., the passed part
+  // of prev_path is dropped), or a suffix of it (e.g., points are prepended).
+  // Probe the first two points of each path to tolerate a changed endpoint.
+  auto match = [](const std::vector<MapPathPoint>& points,
+                  const MapPathPoint& point) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      if (IsSamePoint(points[i], point)) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  };
+  for (int i = 0; i < 2 && i < num_points_ && shared.size == 0; ++i) {
+    const int prev_index = match(prev_points, path_points_[i]);
+    if (prev_index >= 0) {
+      shared.begin = i;
+      shared.prev_begin = prev_index;
+      shared.size = 1;
+    }
+  }
+  for (int i = 0; i < 2 && i < prev_path.num_points_ && shared.size == 0;
+       ++i) {
+    const int index = match(path_points_, prev_points[i]);
+    if (index >= 0) {
+      shared.begin = index;
+      shared.prev_begin = i;
+      shared.size = 1;
+    }
+  }
+  if (shared.size == 0) {
+    return shared;
+  }
+  while (shared.begin + shared.size < num_points_ &&
+         shared.prev_begin + shared.size < prev_path.num_points_ &&
+         IsSamePoint(path_points_[shared.begin + shared.size],
+                     prev_points[shared.prev_begin + shared.size])) {
+    ++shared.size;
+  }
+  if (shared.size >= 2) {
+    shared.prev_path = &prev_path;
+  }
+  return shared;
+}
+
+void Path::InitPoints(const SharedPoints& shared) {
 
   accumulated_s_.clear();
   accumulated_s_.reserve(num_points_);
@@ -289,6 +421,17 @@ void Path::InitPoints() {
   double s = 0.0;
   for (int i = 0; i < num_points_; ++i) {
     accumulated_s_.push_back(s);
+    const int segment_id = std::min(i, num_points_ - 2);
+    if (shared.prev_path != nullptr && shared.HasSegment(segment_id)) {
+      const int prev_segment_id = shared.PrevIndex(segment_id);
+      if (i == segment_id) {
+        segments_.push_back(shared.prev_path->segments_[prev_segment_id]);
+        s += segments_.back().length();
+      }
+      unit_directions_.push_back(
+          shared.prev_path->unit_directions_[prev_segment_id]);
+      continue;
+    }
     Vec2d heading;
     if (i + 1 >= num_points_) {
       heading = path_points_[i] - path_points_[i - 1];
@@ -312,18 +455,38 @@ void Path::InitPoints() {
   CHECK_EQ(segments_.size(), num_segments_);
 }
 
-void Path::InitLaneSegments() {
+void Path::InitLaneSegments(const SharedPoints& shared) {
+  const bool reuse =
+      shared.prev_path != nullptr &&
+      static_cast<int>(shared.prev_path->lane_segments_to_next_point_.size()) ==
+          shared.prev_path->num_segments_;
+  lane_segments_to_next_point_.clear();
+  lane_segments_to_next_point_.reserve(num_points_);
+  for (int i = 0; i + 1 < num_points_; ++i) {
+    if (reuse && shared.HasSegment(i)) {
+      lane_segments_to_next_point_.push_back(
+          shared.prev_path->lane_segments_to_next_point_[shared.PrevIndex(i)]);
+      continue;
+    }
+    LaneSegment lane_segment;
+    if (FindLaneSegment(path_points_[i], path_points_[i + 1], &lane_segment)) {
+      lane_segments_to_next_point_.push_back(lane_segment);
+    } else {
+      lane_segments_to_next_point_.push_back(LaneSegment());
+    }
+  }
+  CHECK_EQ(lane_segments_to_next_point_.size(), num_segments_);
+
   if (lane_segments_.empty()) {
-    for (int i = 0; i + 1 < num_points_; ++i) {
-      LaneSegment lane_segment;
-      if (FindLaneSegment(path_points_[i], path_points_[i + 1],
-                          &lane_segment)) {
+    for (const auto& lane_segment : lane_segments_to_next_point_) {
+      if (lane_segment.lane != nullptr) {
         lane_segments_.push_back(lane_segment);
       }
     }
   }
   LaneSegment::Join(&lane_segments_);
   if (lane_segments_.empty()) {
+    lane_segments_to_next_point_.clear();
     return;
   }
   lane_accumulated_s_.resize(lane_segments_.size());
@@ -332,18 +495,6 @@ void Path::InitLaneSegments() {
     lane_accumulated_s_[i] =
         lane_accumulated_s_[i - 1] + lane_segments_[i].Length();
   }
-
-  lane_segments_to_next_point_.clear();
-  lane_segments_to_next_point_.reserve(num_points_);
-  for (int i = 0; i + 1 < num_points_; ++i) {
-    LaneSegment lane_segment;
-    if (FindLaneSegment(path_points_[i], path_points_[i + 1], &lane_segment)) {
-      lane_segments_to_next_point_.push_back(lane_segment);
-    } else {
-      lane_segments_to_next_point_.push_back(LaneSegment());
-    }
-  }
-  CHECK_EQ(lane_segments_to_next_point_.size(), num_segments_);
 }
 
 void Path::InitWidth() {
@@ -357,32 +508,38 @@ void Path::InitWidth() {
   road_right_width_.clear();
   road_right_width_.reserve(num_sample_points_);
 
+  WidthSampler lane_left_sampler;
+  WidthSampler lane_right_sampler;
+  WidthSampler road_left_sampler;
+  WidthSampler road_right_sampler;
   double s = 0;
   for (int i = 0; i < num_sample_points_; ++i) {
-    const MapPathPoint point = GetSmoothPoint(s);
-    if (point.lane_waypoints().empty()) {
+    const LaneInfo* lane = nullptr;
+    double lane_s = 0.0;
+    double lane_l = 0.0;
+    if (!GetSmoothLaneWaypoint(GetIndexFromS(s), &lane, &lane_s, &lane_l)) {
       lane_left_width_.push_back(FLAGS_default_lane_width / 2.0);
       lane_right_width_.push_back(FLAGS_default_lane_width / 2.0);
 
       road_left_width_.push_back(FLAGS_default_lane_width / 2.0);
       road_right_width_.push_back(FLAGS_default_lane_width / 2.0);
-      AWARN << "path point:" << point.DebugString() << " has invalid width.";
+      AWARN << "path point:" << GetSmoothPoint(s).DebugString()
+            << " has invalid width.";
     } else {
-      const LaneWaypoint waypoint = point.lane_waypoints()[0];
-      CHECK_NOTNULL(waypoint.lane);
-
-      double lane_left_width = 0.0;
-      double lane_right_width = 0.0;
-      waypoint.lane->GetWidth(waypoint.s, &lane_left_width, &lane_right_width);
-      lane_left_width_.push_back(lane_left_width - waypoint.l);
-      lane_right_width_.push_back(lane_right_width + waypoint.l);
-
-      double road_left_width = 0.0;
-      double road_right_width = 0.0;
-      waypoint.lane->GetRoadWidth(waypoint.s, &road_left_width,
-                                  &road_right_width);
-      road_left_width_.push_back(road_left_width - waypoint.l);
-      road_right_width_.push_back(road_right_width + waypoint.l);
+      CHECK_NOTNULL(lane);
+
+      lane_left_width_.push_back(
+          lane_left_sampler.Get(lane->sampled_left_width(), lane_s) - lane_l);
+      lane_right_width_.push_back(
+          lane_right_sampler.Get(lane->sampled_right_width(), lane_s) +
+          lane_l);
+
+      road_left_width_.push_back(
+          road_left_sampler.Get(lane->sampled_left_road_width(), lane_s) -
+          lane_l);
+      road_right_width_.push_back(
+          road_right_sampler.Get(lane->sampled_right_road_width(), lane_s) +
+          lane_l);
     }
     s += kSampleDistance;
   }
@@ -409,20 +566,13 @@ void Path::InitPointIndex() {
   CHECK_EQ(last_point_index_.size(), num_sample_points_);
 }
 
-void Path::GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
-                          std::vector<PathOverlap>* const overlaps) const {
-  if (overlaps == nullptr) {
-    return;
-  }
-  overlaps->clear();
-  std::unordered_map<std::string, std::vector<std::pair<double, double>>>
-      overlaps_by_id;
-  double s = 0.0;
-  for (const auto& lane_segment : lane_segments_) {
-    if (lane_segment.lane == nullptr) {
-      continue;
-    }
-    for (const auto& overlap : GetOverlaps_from_lane(*(lane_segment.lane))) {
+std::shared_ptr<const Path::LaneSegmentOverlaps> Path::GetLaneSegmentOverlaps(
+    const LaneSegment& lane_segment) const {
+  auto lane_segment_overlaps = std::make_shared<LaneSegmentOverlaps>();
+  for (int type = 0; type < kNumOverlapTypes; ++type) {
+    const auto& lane_overlaps =
+        ((*lane_segment.lane).*kGetOverlapsFromLane[type])();
+    for (const auto& overlap : lane_overlaps) {
       const auto& overlap_info =
           overlap->GetObjectOverlapInfo(lane_segment.lane->id());
       if (overlap_info == nullptr) {
@@ -432,19 +582,41 @@ void Path::GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
       const auto& lane_overlap_info = overlap_info->lane_overlap_info();
       if (lane_overlap_info.start_s() < lane_segment.end_s &&
           lane_overlap_info.end_s() > lane_segment.start_s) {
-        const double ref_s = s - lane_segment.start_s;
-        const double adjusted_start_s =
-            std::max(lane_overlap_info.start_s(), lane_segment.start_s) + ref_s;
-        const double adjusted_end_s =
-            std::min(lane_overlap_info.end_s(), lane_segment.end_s) + ref_s;
+        LaneSegmentOverlap clipped;
+        clipped.start_s =
+            std::max(lane_overlap_info.start_s(), lane_segment.start_s);
+        clipped.end_s = std::min(lane_overlap_info.end_s(), lane_segment.end_s);
         for (const auto& object : overlap->overlap().object()) {
           if (object.id().id() != lane_segment.lane->id().id()) {
-            overlaps_by_id[object.id().id()].emplace_back(adjusted_start_s,
-                                                          adjusted_end_s);
+            clipped.object_id = object.id().id();
+            (*lane_segment_overlaps)[type].push_back(clipped);
           }
         }
       }
     }
+  }
+  return lane_segment_overlaps;
+}
+
+void Path::MergeOverlaps(const int type,
+                         std::vector<PathOverlap>* const overlaps) const {
+  if (overlaps == nullptr) {
+    return;
+  }
+  overlaps->clear();
+  std::unordered_map<std::string, std::vector<std::pair<double, double>>>
+      overlaps_by_id;
+  double s = 0.0;
+  for (std::size_t i = 0; i < lane_segments_.size(); ++i) {
+    const auto& lane_segment = lane_segments_[i];
+    if (lane_segment.lane == nullptr) {
+      continue;
+    }
+    const double ref_s = s - lane_segment.start_s;
+    for (const auto& overlap : (*lane_segment_overlaps_[i])[type]) {
+      overlaps_by_id[overlap.object_id].emplace_back(overlap.start_s + ref_s,
+                                                     overlap.end_s + ref_s);
+    }
     s += lane_segment.end_s - lane_segment.start_s;
   }
   for (auto& overlaps_one_object : overlaps_by_id) {
@@ -480,21 +652,77 @@ const PathOverlap* Path::NextLaneOverlap(double s) const {
   }
 }
 
-void Path::InitOverlaps() {
-  GetAllOverlaps(std::bind(&LaneInfo::cross_lanes, _1), &lane_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::signals, _1), &signal_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::yield_signs, _1), &yield_sign_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::stop_signs, _1), &stop_sign_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::crosswalks, _1), &crosswalk_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::junctions, _1), &junction_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::clear_areas, _1), &clear_area_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::speed_bumps, _1), &speed_bump_overlaps_);
-
-  // TODO(all): add support for parking.
-  /*
-  GetAllOverlaps(std::bind(&LaneInfo::parking_spaces, _1),
-                   &parking_space_overlaps_);
-  */
+void Path::InitOverlaps(const Path* prev_path) {
+  // Lane overlaps only depend on the lane segment, so the ones of the lane
+  // segments kept from prev_path are reused.
+  const bool reuse = prev_path != nullptr &&
+                     prev_path->lane_segment_overlaps_.size() ==
+                         prev_path->lane_segments_.size();
+  std::size_t prev_index = 0;
+  lane_segment_overlaps_.clear();
+  lane_segment_overlaps_.reserve(lane_segments_.size());
+  for (const auto& lane_segment : lane_segments_) {
+    std::shared_ptr<const LaneSegmentOverlaps> lane_segment_overlaps;
+    if (lane_segment.lane == nullptr) {
+      lane_segment_overlaps = std::make_shared<LaneSegmentOverlaps>();
+    } else if (reuse) {
+      for (std::size_t i = prev_index; i < prev_path->lane_segments_.size();
+           ++i) {
+        if (IsSameLaneSegment(prev_path->lane_segments_[i], lane_segment)) {
+          lane_segment_overlaps = prev_path->lane_segment_overlaps_[i];
+          prev_index = i + 1;
+          break;
+        }
+      }
+    }
+    if (lane_segment_overlaps == nullptr) {
+      lane_segment_overlaps = GetLaneSegmentOverlaps(lane_segment);
+    }
+    lane_segment_overlaps_.push_back(std::move(lane_segment_overlaps));
+  }
+
+  std::vector<PathOverlap>* const overlaps[kNumOverlapTypes] = {
+      &lane_overlaps_,       &signal_overlaps_,   &yield_sign_overlaps_,
+      &stop_sign_overlaps_,  &crosswalk_overlaps_, &junction_overlaps_,
+      &clear_area_overlaps_, &speed_bump_overlaps_,
+  };
+  for (int type = 0; type < kNumOverlapTypes; ++type) {
+    MergeOverlaps(type, overlaps[type]);
+  }
+}
+
+bool Path::GetSmoothLaneWaypoint(const InterpolatedIndex& index,
+                                 const LaneInfo** lane, double* lane_s,
+                                 double* lane_l) const {
+  CHECK_GE(index.id, 0);
+  CHECK_LT(index.id, num_points_);
+
+  const MapPathPoint& ref_point = path_points_[index.id];
+  if (ref_point.lane_waypoints().empty()) {
+    return false;
+  }
+  const LaneWaypoint* ref_lane_waypoint = &ref_point.lane_waypoints()[0];
+  if (std::abs(index.offset) > kMathEpsilon && index.id < num_segments_ &&
+      index.id < static_cast<int>(lane_segments_to_next_point_.size())) {
+    const LaneSegment& lane_segment = lane_segments_to_next_point_[index.id];
+    if (lane_segment.lane != nullptr) {
+      for (const auto& lane_waypoint : ref_point.lane_waypoints()) {
+        if (lane_waypoint.lane == lane_segment.lane ||
+            lane_waypoint.lane->id().id() == lane_segment.lane->id().id()) {
+          ref_lane_waypoint = &lane_waypoint;
+          break;
+        }
+      }
+      *lane = lane_segment.lane.get();
+      *lane_s = lane_segment.start_s + index.offset;
+      *lane_l = ref_lane_waypoint->l;
+      return true;
+    }
+  }
+  *lane = ref_lane_waypoint->lane.get();
+  *lane_s = ref_lane_waypoint->s;
+  *lane_l = ref_lane_waypoint->l;
+  return true;
 }
 
 MapPathPoint Path::GetSmoothPoint(const InterpolatedIndex& index) const {
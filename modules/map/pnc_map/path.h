@@ -17,6 +17,7 @@
 #ifndef MODULES_MAP_PNC_MAP_PATH_H_
 #define MODULES_MAP_PNC_MAP_PATH_H_
 
+#include <array>
 #include <cmath>
 #include <functional>
 #include <memory>
@@ -226,6 +227,16 @@ class Path {
        std::vector<LaneSegment>&& lane_segments,
        const double max_approximation_error);
 
+  // Build the same path as the constructors above, but reuse the per-point
+  // and per-lane-segment data of prev_path wherever the two paths share
+  // points, e.g., when the new path is prev_path with the passed prefix
+  // dropped and a new suffix appended. Falls back to a full construction if
+  // they share nothing.
+  Path(const Path& prev_path, std::vector<MapPathPoint>&& path_points);
+  Path(const Path& prev_path, std::vector<MapPathPoint>&& path_points,
+       std::vector<LaneSegment>&& lane_segments,
+       const double max_approximation_error);
+
   // Return smooth coordinate by interpolated index or accumulate_s.
   MapPathPoint GetSmoothPoint(const InterpolatedIndex& index) const;
   MapPathPoint GetSmoothPoint(double s) const;
@@ -323,19 +334,52 @@ class Path {
   std::string DebugString() const;
 
  protected:
-  void Init();
-  void InitPoints();
-  void InitLaneSegments();
+  // Points [begin, begin + size) of this path are the same as points
+  // [prev_begin, prev_begin + size) of the previous path.
+  struct SharedPoints {
+    const Path* prev_path = nullptr;
+    int begin = 0;
+    int prev_begin = 0;
+    int size = 0;
+
+    // Whether the segment from point i to point i + 1 is shared.
+    bool HasSegment(const int i) const {
+      return i >= begin && i + 1 < begin + size;
+    }
+    int PrevIndex(const int i) const { return i - begin + prev_begin; }
+  };
+
+  // Overlaps of one lane segment, clipped to the lane segment, in lane s.
+  struct LaneSegmentOverlap {
+    std::string object_id;
+    double start_s = 0.0;
+    double end_s = 0.0;
+  };
+  static constexpr int kNumOverlapTypes = 8;
+  using LaneSegmentOverlaps =
+      std::array<std::vector<LaneSegmentOverlap>, kNumOverlapTypes>;
+
+  void Init(const Path* prev_path = nullptr);
+  void InitPoints(const SharedPoints& shared);
+  void InitLaneSegments(const SharedPoints& shared);
   void InitWidth();
   void InitPointIndex();
-  void InitOverlaps();
+  void InitOverlaps(const Path* prev_path);
+
+  SharedPoints FindSharedPoints(const Path& prev_path) const;
+
+  // Get the first lane waypoint of GetSmoothPoint(index) without building
+  // the point. Returns false if the point has no lane waypoint.
+  bool GetSmoothLaneWaypoint(const InterpolatedIndex& index,
+                             const LaneInfo** lane, double* lane_s,
+                             double* lane_l) const;
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
-  using GetOverlapFromLaneFunc =
-      std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
-  void GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
-                      std::vector<PathOverlap>* const overlaps) const;
+  std::shared_ptr<const LaneSegmentOverlaps> GetLaneSegmentOverlaps(
+      const LaneSegment& lane_segment) const;
+  void MergeOverlaps(const int type,
+                     std::vector<PathOverlap>* const overlaps) const;
 
  protected:
   int num_points_ = 0;
@@ -359,6 +403,10 @@ class Path {
   std::vector<double> road_right_width_;
   std::vector<int> last_point_index_;
 
+  // Indexed by lane segment. Shared with the paths built from this one.
+  std::vector<std::shared_ptr<const LaneSegmentOverlaps>>
+      lane_segment_overlaps_;
+
   std::vector<PathOverlap> lane_overlaps_;
   std::vector<PathOverlap> signal_overlaps_;
   std::vector<PathOverlap> yield_sign_overlaps_;
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures building a sliding-window path from scratch versus
+ *        incrementally from the path of the previous cycle, the way a
+ *        stitched reference line moves forward.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/pnc_map/path.h"
+
+DEFINE_int32(benchmark_num_cycles, 1000, "Number of planning cycles.");
+DEFINE_double(benchmark_backward_length, 30.0,
+              "Length of the window behind the vehicle, in meters.");
+DEFINE_double(benchmark_forward_length, 300.0,
+              "Length of the window ahead of the vehicle, in meters.");
+DEFINE_double(benchmark_step, 1.0,
+              "Distance the window moves each cycle, in meters.");
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+constexpr int kLaneLength = 50;
+
+common::PointENU MakePoint(const double x, const double y) {
+  common::PointENU point;
+  point.set_x(x);
+  point.set_y(y);
+  point.set_z(0.0);
+  return point;
+}
+
+double CurveY(const double x) { return 30.0 * std::sin(x / 150.0); }
+
+// A chain of curvy lanes with one meter between lane points, and a crosswalk
+// on every third lane.
+Map MakeMap(const int num_lanes) {
+  Map map;
+  for (int i = 0; i < num_lanes; ++i) {
+    Lane* lane = map.add_lane();
+    lane->mutable_id()->set_id("lane_" + std::to_string(i));
+    auto* segment =
+        lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+    for (int k = 0; k <= kLaneLength; ++k) {
+      const double x = i * kLaneLength + k;
+      *segment->add_point() = MakePoint(x, CurveY(x));
+    }
+    for (int k = 0; k <= kLaneLength; k += 2) {
+      auto* left = lane->add_left_sample();
+      left->set_s(k);
+      left->set_width(1.75 + 0.1 * std::sin(k));
+      auto* right = lane->add_right_sample();
+      right->set_s(k);
+      right->set_width(1.75 + 0.1 * std::cos(k));
+    }
+    if (i % 3 != 0) {
+      continue;
+    }
+    const std::string crosswalk_id = "crosswalk_" + std::to_string(i);
+    Crosswalk* crosswalk = map.add_crosswalk();
+    crosswalk->mutable_id()->set_id(crosswalk_id);
+    const double x = i * kLaneLength + 22.0;
+    auto* polygon = crosswalk->mutable_polygon();
+    *polygon->add_point() = MakePoint(x - 2.0, CurveY(x) - 5.0);
+    *polygon->add_point() = MakePoint(x + 2.0, CurveY(x) - 5.0);
+    *polygon->add_point() = MakePoint(x + 2.0, CurveY(x) + 5.0);
+    *polygon->add_point() = MakePoint(x - 2.0, CurveY(x) + 5.0);
+    Overlap* overlap = map.add_overlap();
+    overlap->mutable_id()->set_id("overlap_" + std::to_string(i));
+    auto* lane_object = overlap->add_object();
+    lane_object->mutable_id()->set_id(lane->id().id());
+    lane_object->mutable_lane_overlap_info()->set_start_s(20.0);
+    lane_object->mutable_lane_overlap_info()->set_end_s(24.0);
+    auto* crosswalk_object = overlap->add_object();
+    crosswalk_object->mutable_id()->set_id(crosswalk_id);
+    crosswalk_object->mutable_crosswalk_overlap_info();
+    lane->add_overlap_id()->set_id(overlap->id().id());
+    crosswalk->add_overlap_id()->set_id(overlap->id().id());
+  }
+  return map;
+}
+
+std::vector<MapPathPoint> MakePoints(const HDMap& hdmap, const int num_lanes) {
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i < num_lanes; ++i) {
+    Id id;
+    id.set_id("lane_" + std::to_string(i));
+    const LaneInfoConstPtr lane = hdmap.GetLaneById(id);
+    for (std::size_t k = 0; k < lane->points().size(); ++k) {
+      const LaneWaypoint waypoint(lane, lane->accumulate_s()[k]);
+      if (k == 0 && !points.empty()) {
+        points.back().add_lane_waypoint(waypoint);
+        continue;
+      }
+      points.emplace_back(lane->points()[k], lane->headings()[k], waypoint);
+    }
+  }
+  return points;
+}
+
+// Returns the mean time of building one window in ms, and the last path.
+double Run(const std::vector<MapPathPoint>& points, const bool incremental,
+           Path* const path) {
+  const int backward = static_cast<int>(FLAGS_benchmark_backward_length);
+  const int forward = static_cast<int>(FLAGS_benchmark_forward_length);
+  const int step = std::max(1, static_cast<int>(FLAGS_benchmark_step));
+  *path = Path(std::vector<MapPathPoint>(points.begin(),
+                                         points.begin() + backward + forward));
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 1; i <= FLAGS_benchmark_num_cycles; ++i) {
+    const auto begin = points.begin() + i * step;
+    std::vector<MapPathPoint> window(begin, begin + backward + forward);
+    if (incremental) {
+      *path = Path(*path, std::move(window));
+    } else {
+      *path = Path(std::move(window));
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         FLAGS_benchmark_num_cycles;
+}
+
+}  // namespace
+}  // namespace hdmap
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_benchmark_num_cycles = std::max(FLAGS_benchmark_num_cycles, 1);
+  const double window_length =
+      FLAGS_benchmark_backward_length + FLAGS_benchmark_forward_length +
+      FLAGS_benchmark_num_cycles * std::max(1.0, FLAGS_benchmark_step);
+  const int num_lanes =
+      static_cast<int>(window_length / apollo::hdmap::kLaneLength) + 2;
+
+  apollo::hdmap::HDMap hdmap;
+  if (hdmap.LoadMapFromProto(apollo::hdmap::MakeMap(num_lanes)) != 0) {
+    std::cerr << "Failed to load the synthetic map." << std::endl;
+    return 1;
+  }
+  const auto points = apollo::hdmap::MakePoints(hdmap, num_lanes);
+
+  apollo::hdmap::Path full_path;
+  apollo::hdmap::Path incremental_path;
+  const double full_ms = apollo::hdmap::Run(points, false, &full_path);
+  const double incremental_ms =
+      apollo::hdmap::Run(points, true, &incremental_path);
+  const bool same =
+      full_path.accumulated_s() == incremental_path.accumulated_s() &&
+      full_path.lane_segments().size() ==
+          incremental_path.lane_segments().size() &&
+      full_path.crosswalk_overlaps().size() ==
+          incremental_path.crosswalk_overlaps().size();
+  std::cout << std::fixed << std::setprecision(4) << "full " << full_ms
+            << " ms/cycle, incremental " << incremental_ms
+            << " ms/cycle, speedup " << std::setprecision(2)
+            << full_ms / incremental_ms << "x, "
+            << (same ? "same" : "DIFFERENT") << " paths" << std::endl;
+  return same ? 0 : 1;
+}
@@ -17,6 +17,8 @@
 #include "modules/map/pnc_map/path.h"
 
 #include <algorithm>
+#include <cmath>
+#include <string>
 #include <vector>
 
 #include "gflags/gflags.h"
@@ -79,6 +81,122 @@ std::string ToString(const T& val) {
   return apollo::common::util::StrCat(val);
 }
 
+// A chain of curvy lanes, with a crosswalk overlapping every other lane.
+Map MakeLaneChainMap(const int num_lanes, const int lane_length) {
+  Map map;
+  auto curve_y = [](const double x) { return 20.0 * std::sin(x / 50.0); };
+  for (int i = 0; i < num_lanes; ++i) {
+    Lane* lane = map.add_lane();
+    lane->mutable_id()->set_id("lane_" + ToString(i));
+    auto* segment =
+        lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+    for (int k = 0; k <= lane_length; ++k) {
+      const double x = i * lane_length + k;
+      *segment->add_point() = MakePoint(x, curve_y(x), 0);
+    }
+    for (int k = 0; k <= lane_length; k += 2) {
+      *lane->add_left_sample() = MakeSample(k, 1.75 + 0.1 * std::sin(k));
+      *lane->add_right_sample() = MakeSample(k, 1.75 + 0.1 * std::cos(k));
+      *lane->add_left_road_sample() = MakeSample(k, 5.0);
+      *lane->add_right_road_sample() = MakeSample(k, 5.0);
+    }
+    if (i % 2 == 0) {
+      const std::string crosswalk_id = "crosswalk_" + ToString(i);
+      Crosswalk* crosswalk = map.add_crosswalk();
+      crosswalk->mutable_id()->set_id(crosswalk_id);
+      const double x = i * lane_length + 5.5;
+      auto* polygon = crosswalk->mutable_polygon();
+      *polygon->add_point() = MakePoint(x - 1.5, curve_y(x) - 3.0, 0);
+      *polygon->add_point() = MakePoint(x + 1.5, curve_y(x) - 3.0, 0);
+      *polygon->add_point() = MakePoint(x + 1.5, curve_y(x) + 3.0, 0);
+      *polygon->add_point() = MakePoint(x - 1.5, curve_y(x) + 3.0, 0);
+      Overlap* overlap = map.add_overlap();
+      overlap->mutable_id()->set_id("overlap_" + ToString(i));
+      auto* lane_object = overlap->add_object();
+      lane_object->mutable_id()->set_id(lane->id().id());
+      lane_object->mutable_lane_overlap_info()->set_start_s(4.0);
+      lane_object->mutable_lane_overlap_info()->set_end_s(7.0);
+      auto* crosswalk_object = overlap->add_object();
+      crosswalk_object->mutable_id()->set_id(crosswalk_id);
+      crosswalk_object->mutable_crosswalk_overlap_info();
+      lane->add_overlap_id()->set_id(overlap->id().id());
+      crosswalk->add_overlap_id()->set_id(overlap->id().id());
+    }
+  }
+  return map;
+}
+
+// Path points of lanes [first_lane, first_lane + num_lanes) from
+// MakeLaneChainMap, one per lane point.
+std::vector<MapPathPoint> MakeLaneChainPoints(const HDMap& hdmap,
+                                              const int first_lane,
+                                              const int num_lanes) {
+  std::vector<MapPathPoint> points;
+  for (int i = first_lane; i < first_lane + num_lanes; ++i) {
+    Id id;
+    id.set_id("lane_" + ToString(i));
+    const LaneInfoConstPtr lane = hdmap.GetLaneById(id);
+    for (std::size_t k = 0; k < lane->points().size(); ++k) {
+      const LaneWaypoint waypoint(lane, lane->accumulate_s()[k]);
+      if (k == 0 && !points.empty()) {
+        points.back().add_lane_waypoint(waypoint);
+        continue;
+      }
+      points.emplace_back(lane->points()[k], lane->headings()[k], waypoint);
+    }
+  }
+  return points;
+}
+
+void ExpectSameOverlaps(const std::vector<PathOverlap>& expected,
+                        const std::vector<PathOverlap>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].object_id, actual[i].object_id);
+    EXPECT_EQ(expected[i].start_s, actual[i].start_s);
+    EXPECT_EQ(expected[i].end_s, actual[i].end_s);
+  }
+}
+
+void ExpectSamePath(const Path& expected, const Path& actual) {
+  ASSERT_EQ(expected.num_points(), actual.num_points());
+  EXPECT_EQ(expected.length(), actual.length());
+  for (int i = 0; i < expected.num_points(); ++i) {
+    EXPECT_EQ(expected.accumulated_s()[i], actual.accumulated_s()[i]);
+    EXPECT_EQ(expected.unit_directions()[i].x(),
+              actual.unit_directions()[i].x());
+    EXPECT_EQ(expected.unit_directions()[i].y(),
+              actual.unit_directions()[i].y());
+  }
+  ASSERT_EQ(expected.lane_segments_to_next_point().size(),
+            actual.lane_segments_to_next_point().size());
+  for (std::size_t i = 0; i < expected.lane_segments_to_next_point().size();
+       ++i) {
+    const auto& expected_segment = expected.lane_segments_to_next_point()[i];
+    const auto& actual_segment = actual.lane_segments_to_next_point()[i];
+    EXPECT_EQ(expected_segment.lane, actual_segment.lane);
+    EXPECT_EQ(expected_segment.start_s, actual_segment.start_s);
+    EXPECT_EQ(expected_segment.end_s, actual_segment.end_s);
+  }
+  ASSERT_EQ(expected.lane_segments().size(), actual.lane_segments().size());
+  for (std::size_t i = 0; i < expected.lane_segments().size(); ++i) {
+    EXPECT_EQ(expected.lane_segments()[i].lane, actual.lane_segments()[i].lane);
+    EXPECT_EQ(expected.lane_segments()[i].start_s,
+              actual.lane_segments()[i].start_s);
+    EXPECT_EQ(expected.lane_segments()[i].end_s,
+              actual.lane_segments()[i].end_s);
+  }
+  for (double s = 0.0; s < expected.length(); s += 0.25) {
+    EXPECT_EQ(expected.GetLaneLeftWidth(s), actual.GetLaneLeftWidth(s));
+    EXPECT_EQ(expected.GetLaneRightWidth(s), actual.GetLaneRightWidth(s));
+    EXPECT_EQ(expected.GetRoadLeftWidth(s), actual.GetRoadLeftWidth(s));
+    EXPECT_EQ(expected.GetRoadRightWidth(s), actual.GetRoadRightWidth(s));
+  }
+  ExpectSameOverlaps(expected.crosswalk_overlaps(),
+                     actual.crosswalk_overlaps());
+  ExpectSameOverlaps(expected.junction_overlaps(), actual.junction_overlaps());
+}
+
 }  // namespace
 
 TEST(TestSuite, LaneSegment) {
@@ -880,5 +998,60 @@ TEST(TestSuite, lane_info) {
   EXPECT_NEAR(effective_width, 0.0, 1e-6);
 }
 
+TEST(TestSuite, incremental_path) {
+  HDMap hdmap;
+  ASSERT_EQ(0, hdmap.LoadMapFromProto(MakeLaneChainMap(12, 10)));
+  const std::vector<MapPathPoint> all_points =
+      MakeLaneChainPoints(hdmap, 0, 12);
+
+  std::vector<MapPathPoint> window(all_points.begin(),
+                                   all_points.begin() + 40);
+  Path prev_path(window);
+  EXPECT_FALSE(prev_path.crosswalk_overlaps().empty());
+  // Slide the window forward, as a stitched reference line does.
+  for (int start = 3; start + 45 <= static_cast<int>(all_points.size());
+       start += 3) {
+    window.assign(all_points.begin() + start, all_points.begin() + start + 45);
+    const Path path(window);
+    Path incremental_path(prev_path, std::vector<MapPathPoint>(window));
+    ExpectSamePath(path, incremental_path);
+    prev_path = std::move(incremental_path);
+  }
+
+  // Prepend points to the previous path.
+  const Path suffix_path(std::vector<MapPathPoint>(all_points.begin() + 20,
+                                                   all_points.begin() + 60));
+  window.assign(all_points.begin(), all_points.begin() + 60);
+  ExpectSamePath(Path(window),
+                 Path(suffix_path, std::vector<MapPathPoint>(window)));
+
+  // Paths without shared points are built from scratch.
+  const Path disjoint_path(
+      std::vector<MapPathPoint>(all_points.begin(), all_points.begin() + 20));
+  window.assign(all_points.begin() + 50, all_points.begin() + 100);
+  ExpectSamePath(Path(window),
+                 Path(disjoint_path, std::vector<MapPathPoint>(window)));
+
+  // With given lane segments and path approximation.
+  window.assign(all_points.begin(), all_points.begin() + 60);
+  const Path approximated_prev_path(
+      std::vector<MapPathPoint>(window),
+      std::vector<LaneSegment>(Path(window).lane_segments()), 2.0);
+  window.assign(all_points.begin() + 10, all_points.begin() + 70);
+  const std::vector<LaneSegment> lane_segments = Path(window).lane_segments();
+  const Path approximated_path(std::vector<MapPathPoint>(window),
+                               std::vector<LaneSegment>(lane_segments), 2.0);
+  const Path incremental_approximated_path(
+      approximated_prev_path, std::vector<MapPathPoint>(window),
+      std::vector<LaneSegment>(lane_segments), 2.0);
+  ExpectSamePath(approximated_path, incremental_approximated_path);
+  double s = 0.0;
+  double l = 0.0;
+  ASSERT_TRUE(incremental_approximated_path.GetNearestPoint(
+      all_points[30], &s, &l));
+  EXPECT_NEAR(approximated_path.accumulated_s()[20], s, 1e-6);
+  EXPECT_NEAR(0.0, l, 1e-6);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -16,31 +16,34 @@
 
 #include "modules/monitor/common/recurrent_runner.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
 #include <utility>
 
 #include "modules/common/log.h"
 #include "modules/common/time/time.h"
 #include "modules/monitor/common/monitor_manager.h"
+#include "modules/monitor/common/timer_wheel.h"
 
 namespace apollo {
 namespace monitor {
 
 using apollo::common::time::Clock;
 
+namespace {
+
+constexpr int kNumTimerWheelSlots = 64;
+
+}  // namespace
+
 RecurrentRunner::RecurrentRunner(const std::string &name,
                                  const double interval)
     : name_(name)
     , interval_(interval) {
 }
 
-void RecurrentRunner::Tick(const double current_time) {
-  if (next_round_ <= current_time) {
-    ADEBUG << "RecurrentRunner " << name_ << " runs at " << current_time;
-    next_round_ = current_time + interval_;
-    RunOnce(current_time);
-  }
-}
-
 RecurrentRunnerThread::RecurrentRunnerThread(const double interval)
     : interval_ms_(interval * 1000) {
 }
@@ -52,26 +55,46 @@ void RecurrentRunnerThread::RegisterRunner(
 
 void RecurrentRunnerThread::Start() {
   CHECK(!thread_) << "Thread has already started.";
-  thread_.reset(new std::thread([this]() {
-    while (true) {
-      {
-        // Check stop sign.
-        std::lock_guard<std::mutex> guard(stop_mutex_);
-        if (stop_) {
-          return;
-        }
-      }
+  thread_.reset(new std::thread(&RecurrentRunnerThread::Run, this));
+}
 
-      // Tick runners.
-      const double current_time = Clock::NowInSeconds();
-      MonitorManager::InitFrame(current_time);
-      for (auto &runner : runners_) {
-        runner->Tick(current_time);
-      }
+void RecurrentRunnerThread::Run() {
+  const std::chrono::milliseconds tick_interval(interval_ms_);
+  // Runner intervals in ticks. Zero-interval runners run on every tick.
+  std::vector<int64_t> interval_ticks;
+  for (const auto &runner : runners_) {
+    interval_ticks.push_back(std::max<int64_t>(
+        1, std::ceil(runner->interval() * 1000 / interval_ms_ - 1e-6)));
+  }
 
-      std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms_));
+  TimerWheel wheel(kNumTimerWheelSlots);
+  // All runners are due at the first tick.
+  std::vector<int> due_runners(runners_.size());
+  std::iota(due_runners.begin(), due_runners.end(), 0);
+  auto next_tick_time = std::chrono::steady_clock::now();
+  while (true) {
+    const double current_time = Clock::NowInSeconds();
+    MonitorManager::InitFrame(current_time);
+    // The wheel already decided which runners are due, so run them directly.
+    for (const int i : due_runners) {
+      ADEBUG << "Runner " << i << " runs at " << current_time;
+      runners_[i]->RunOnce(current_time);
+      wheel.Schedule(i, interval_ticks[i]);
     }
-  }));
+
+    // Don't burst to catch up if we fell behind.
+    next_tick_time = std::max(next_tick_time + tick_interval,
+                              std::chrono::steady_clock::now());
+    {
+      // Sleep until the next tick, or return as soon as we are stopped.
+      std::unique_lock<std::mutex> lock(stop_mutex_);
+      if (stop_cv_.wait_until(lock, next_tick_time,
+                              [this]() { return stop_; })) {
+        return;
+      }
+    }
+    wheel.Advance(&due_runners);
+  }
 }
 
 void RecurrentRunnerThread::Stop() {
@@ -80,6 +103,7 @@ void RecurrentRunnerThread::Stop() {
     std::lock_guard<std::mutex> guard(stop_mutex_);
     stop_ = true;
   }
+  stop_cv_.notify_all();
   thread_->join();
   thread_.reset(nullptr);
 }
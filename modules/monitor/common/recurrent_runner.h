@@ -17,6 +17,7 @@
 #ifndef MODULES_MONITOR_COMMON_RECURRENT_RUNNER_H_
 #define MODULES_MONITOR_COMMON_RECURRENT_RUNNER_H_
 
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -35,19 +36,16 @@ class RecurrentRunner {
   RecurrentRunner(const std::string &name, const double interval);
   virtual ~RecurrentRunner() = default;
 
-  // Tick once, which may or may not execute the RunOnce() function, based on
-  // the interval setting.
-  void Tick(const double current_time);
-
   // Do the actual work.
   virtual void RunOnce(const double current_time) = 0;
 
+  double interval() const { return interval_; }
+
  protected:
   std::string name_;
 
  private:
   double interval_;
-  double next_round_ = 0;
 };
 
 class RecurrentRunnerThread {
@@ -56,18 +54,22 @@ class RecurrentRunnerThread {
 
   void RegisterRunner(std::unique_ptr<RecurrentRunner> runner);
 
-  // Start the thread of ticking all registered runners.
+  // Start the thread of ticking registered runners. Each tick only runs the
+  // runners which are due, in the order they were registered.
   void Start();
   // Stop the ticking thread.
   void Stop();
 
  private:
+  void Run();
+
   int64_t interval_ms_;
   std::vector<std::unique_ptr<RecurrentRunner>> runners_;
   std::unique_ptr<std::thread> thread_ = nullptr;
 
   bool stop_ = false;
   std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
 };
 
 }  // namespace monitor
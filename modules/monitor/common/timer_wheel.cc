@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/timer_wheel.h"
+
+#include <algorithm>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace monitor {
+
+TimerWheel::TimerWheel(const int num_slots) : slots_(num_slots) {
+  CHECK_GT(num_slots, 0);
+}
+
+void TimerWheel::Schedule(const int id, const int64_t delay_ticks) {
+  const int64_t due_tick = current_tick_ + std::max<int64_t>(delay_ticks, 1);
+  slots_[due_tick % slots_.size()].push_back({id, due_tick});
+}
+
+void TimerWheel::Advance(std::vector<int> *due_ids) {
+  due_ids->clear();
+  ++current_tick_;
+  auto &slot = slots_[current_tick_ % slots_.size()];
+  // Timers more than one round ahead stay in the slot.
+  size_t kept = 0;
+  for (const auto &timer : slot) {
+    if (timer.due_tick == current_tick_) {
+      due_ids->push_back(timer.id);
+    } else {
+      slot[kept++] = timer;
+    }
+  }
+  slot.resize(kept);
+  std::sort(due_ids->begin(), due_ids->end());
+}
+
+}  // namespace monitor
+}  // namespace apollo
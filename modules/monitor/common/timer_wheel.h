@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_MONITOR_COMMON_TIMER_WHEEL_H_
+#define MODULES_MONITOR_COMMON_TIMER_WHEEL_H_
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace apollo::monitor
+ * @brief apollo::monitor
+ */
+namespace apollo {
+namespace monitor {
+
+// A hashed timer wheel. Scheduling and firing a timer are O(1) amortized, so
+// the ticking thread only touches the timers that are due instead of polling
+// every registered runner on each tick.
+class TimerWheel {
+ public:
+  explicit TimerWheel(const int num_slots);
+
+  // Schedule a timer to fire after delay_ticks (at least 1) ticks.
+  void Schedule(const int id, const int64_t delay_ticks);
+
+  // Advance the wheel by one tick, and output the due timers in ascending
+  // order of id.
+  void Advance(std::vector<int> *due_ids);
+
+  int64_t current_tick() const { return current_tick_; }
+
+ private:
+  struct Timer {
+    int id;
+    int64_t due_tick;
+  };
+  std::vector<std::vector<Timer>> slots_;
+  int64_t current_tick_ = 0;
+};
+
+}  // namespace monitor
+}  // namespace apollo
+
+#endif  // MODULES_MONITOR_COMMON_TIMER_WHEEL_H_
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/timer_wheel.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+
+TEST(TimerWheelTest, Advance) {
+  TimerWheel wheel(4);
+  wheel.Schedule(2, 1);
+  wheel.Schedule(0, 1);
+  wheel.Schedule(1, 6);
+  wheel.Schedule(3, 0);
+
+  std::vector<int> due_ids;
+  wheel.Advance(&due_ids);
+  EXPECT_EQ(1, wheel.current_tick());
+  EXPECT_EQ(std::vector<int>({0, 2, 3}), due_ids);
+
+  // Timer 1 shares slot 2 with tick 2, but is one round ahead.
+  for (int tick = 2; tick < 6; ++tick) {
+    wheel.Advance(&due_ids);
+    EXPECT_TRUE(due_ids.empty()) << "tick " << tick;
+  }
+  wheel.Advance(&due_ids);
+  EXPECT_EQ(std::vector<int>({1}), due_ids);
+
+  wheel.Schedule(0, 2);
+  wheel.Advance(&due_ids);
+  EXPECT_TRUE(due_ids.empty());
+  wheel.Advance(&due_ids);
+  EXPECT_EQ(std::vector<int>({0}), due_ids);
+}
+
+}  // namespace monitor
+}  // namespace apollo
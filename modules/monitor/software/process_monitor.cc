@@ -16,9 +16,10 @@
 
 #include "modules/monitor/software/process_monitor.h"
 
+#include <unistd.h>
+
 #include "gflags/gflags.h"
 #include "modules/common/log.h"
-#include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
 #include "modules/monitor/common/monitor_manager.h"
 
@@ -28,58 +29,78 @@ DEFINE_string(process_monitor_name, "ProcessMonitor",
 DEFINE_double(process_monitor_interval, 1.5,
               "Process status checking interval (s).");
 
+DEFINE_string(process_monitor_proc_root, "/proc",
+              "Root of the proc filesystem to monitor processes in.");
+
+DEFINE_double(process_monitor_full_scan_interval, 60,
+              "Interval (s) of forced full rescans of all processes.");
+
 namespace apollo {
 namespace monitor {
 namespace {
 
-template <class Iterable>
-bool ContainsAll(const std::string &full, const Iterable &parts) {
-  for (const auto &part : parts) {
-    if (full.find(part) == std::string::npos) {
-      return false;
-    }
+void SetProcessStatus(const ProcessTable::Binding &binding,
+                      ProcessStatus *status) {
+  static const int64_t kPageSize = sysconf(_SC_PAGESIZE);
+  status->set_pid(binding.pid);
+  if (binding.cpu_usage >= 0) {
+    status->set_cpu_usage(binding.cpu_usage);
+  } else {
+    status->clear_cpu_usage();
   }
-  return true;
+  status->set_rss_bytes(binding.stat.rss_pages * kPageSize);
+  status->set_voluntary_context_switches(
+      binding.stat.voluntary_context_switches);
+  status->set_nonvoluntary_context_switches(
+      binding.stat.nonvoluntary_context_switches);
 }
 
 }  // namespace
 
 ProcessMonitor::ProcessMonitor()
     : RecurrentRunner(FLAGS_process_monitor_name,
-                      FLAGS_process_monitor_interval) {
+                      FLAGS_process_monitor_interval)
+    , process_table_(FLAGS_process_monitor_proc_root,
+                     FLAGS_process_monitor_full_scan_interval) {
+  for (const auto &module : MonitorManager::GetConfig().modules()) {
+    if (module.has_process_conf()) {
+      const auto &keywords = module.process_conf().process_cmd_keywords();
+      process_table_.AddModule(
+          module.name(), {keywords.begin(), keywords.end()});
+    }
+  }
+  self_.pid = getpid();
 }
 
 void ProcessMonitor::RunOnce(const double current_time) {
-  // Get running processes.
-  std::map<std::string, std::string> running_processes;
-  const auto procs = common::util::ListSubPaths("/proc");
-  for (const auto &proc : procs) {
-    // Get process command string.
-    std::string cmd_string;
-    const auto cmd_file = common::util::StrCat("/proc/", proc, "/cmdline");
-    if (common::util::GetContent(cmd_file, &cmd_string)) {
-      running_processes.emplace(proc, cmd_string);
-    }
-  }
+  // Only rescans processes if some module lost or may have found its process.
+  process_table_.Update(current_time);
 
   for (const auto &module : MonitorManager::GetConfig().modules()) {
     if (module.has_process_conf()) {
-      UpdateModule(module.name(), module.process_conf(), running_processes);
+      UpdateModule(module.name(), *process_table_.GetBinding(module.name()));
     }
   }
+
+  // Report the overhead of the monitor itself.
+  if (process_table_.UpdateBinding(current_time, &self_)) {
+    SetProcessStatus(self_, MonitorManager::GetStatus()
+                                ->mutable_monitor_process_status());
+  }
+  ADEBUG << "ProcessMonitor has done " << process_table_.num_scans()
+         << " scans and " << process_table_.num_cmdline_reads()
+         << " cmdline reads.";
 }
 
-void ProcessMonitor::UpdateModule(
-    const std::string &module_name, const ProcessConf &config,
-    const std::map<std::string, std::string> &running_processes) {
+void ProcessMonitor::UpdateModule(const std::string &module_name,
+                                  const ProcessTable::Binding &binding) {
   auto *status = MonitorManager::GetModuleStatus(module_name);
-  for (const auto &proc : running_processes) {
-    if (ContainsAll(proc.second, config.process_cmd_keywords())) {
-      status->mutable_process_status()->set_running(true);
-      ADEBUG << "Module " << module_name
-             << " is running on process " << proc.first;
-      return;
-    }
+  if (binding.pid >= 0) {
+    status->mutable_process_status()->set_running(true);
+    SetProcessStatus(binding, status->mutable_process_status());
+    ADEBUG << "Module " << module_name
+           << " is running on process " << binding.pid;
+    return;
   }
 
   if (status->process_status().running()) {
@@ -94,6 +115,7 @@ void ProcessMonitor::UpdateModule(
     }
   }
 
+  status->mutable_process_status()->Clear();
   status->mutable_process_status()->set_running(false);
 }
 
@@ -0,0 +1,268 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/process_table.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+using apollo::common::util::GetContent;
+using apollo::common::util::StrCat;
+
+template <class Iterable>
+bool ContainsAll(const std::string &full, const Iterable &parts) {
+  for (const auto &part : parts) {
+    if (full.find(part) == std::string::npos) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParsePid(const std::string &name, int *pid) {
+  if (name.empty() ||
+      !std::all_of(name.begin(), name.end(), ::isdigit)) {
+    return false;
+  }
+  *pid = std::atoi(name.c_str());
+  return true;
+}
+
+}  // namespace
+
+ProcessTable::ProcessTable(const std::string &proc_root,
+                           const double full_scan_interval)
+    : proc_root_(proc_root)
+    , full_scan_interval_(full_scan_interval)
+    , clock_ticks_per_second_(sysconf(_SC_CLK_TCK)) {
+}
+
+void ProcessTable::AddModule(const std::string &module_name,
+                             const std::vector<std::string> &keywords) {
+  Module module;
+  module.name = module_name;
+  module.keywords = keywords;
+  modules_.emplace_back(std::move(module));
+}
+
+void ProcessTable::Update(const double current_time) {
+  bool lost_process = false;
+  for (auto &module : modules_) {
+    Binding *binding = &module.binding;
+    if (binding->pid >= 0 && !UpdateBinding(current_time, binding)) {
+      ADEBUG << "Module " << module.name << " lost process " << binding->pid;
+      *binding = Binding();
+      lost_process = true;
+    }
+  }
+  if (NeedsScan(lost_process, current_time)) {
+    Scan(current_time);
+  }
+}
+
+const ProcessTable::Binding *ProcessTable::GetBinding(
+    const std::string &module_name) const {
+  for (const auto &module : modules_) {
+    if (module.name == module_name) {
+      return &module.binding;
+    }
+  }
+  return nullptr;
+}
+
+bool ProcessTable::ReadProcessStat(const std::string &pid,
+                                   ProcessStat *stat) const {
+  const std::string dir = StrCat(proc_root_, "/", pid);
+  std::string content;
+  if (!GetContent(StrCat(dir, "/stat"), &content) ||
+      !ParseStat(content, stat)) {
+    return false;
+  }
+  // Context switches are optional, the process may just have exited.
+  if (GetContent(StrCat(dir, "/status"), &content)) {
+    ParseStatus(content, stat);
+  }
+  return true;
+}
+
+bool ProcessTable::ParseStat(const std::string &content, ProcessStat *stat) {
+  // The command name in parentheses may contain spaces and parentheses, so
+  // fields are counted from the last ')'.
+  const auto comm_end = content.rfind(')');
+  if (comm_end == std::string::npos) {
+    return false;
+  }
+  std::istringstream fields(content.substr(comm_end + 1));
+  // Fields after the command name, starting from field 3 (state).
+  std::vector<std::string> values;
+  std::string value;
+  while (values.size() < 22 && fields >> value) {
+    values.push_back(value);
+  }
+  if (values.size() < 22) {
+    return false;
+  }
+  // utime(14), stime(15), starttime(22) and rss(24), 1-based.
+  stat->cpu_ticks = std::strtoull(values[11].c_str(), nullptr, 10) +
+                    std::strtoull(values[12].c_str(), nullptr, 10);
+  stat->start_ticks = std::strtoull(values[19].c_str(), nullptr, 10);
+  stat->rss_pages = std::strtoll(values[21].c_str(), nullptr, 10);
+  return true;
+}
+
+void ProcessTable::ParseStatus(const std::string &content,
+                               ProcessStat *stat) {
+  static const std::string kVoluntary = "voluntary_ctxt_switches:";
+  static const std::string kNonvoluntary = "nonvoluntary_ctxt_switches:";
+  std::istringstream lines(content);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.compare(0, kVoluntary.size(), kVoluntary) == 0) {
+      stat->voluntary_context_switches =
+          std::strtoull(line.c_str() + kVoluntary.size(), nullptr, 10);
+    } else if (line.compare(0, kNonvoluntary.size(), kNonvoluntary) == 0) {
+      stat->nonvoluntary_context_switches =
+          std::strtoull(line.c_str() + kNonvoluntary.size(), nullptr, 10);
+    }
+  }
+}
+
+bool ProcessTable::NeedsScan(const bool lost_process,
+                             const double current_time) {
+  if (lost_process || last_full_scan_time_ < 0 ||
+      current_time - last_full_scan_time_ >= full_scan_interval_) {
+    return true;
+  }
+  const bool all_bound = std::all_of(
+      modules_.begin(), modules_.end(),
+      [](const Module &module) { return module.binding.pid >= 0; });
+  if (all_bound) {
+    return false;
+  }
+  const std::string last_pid = ReadLastPid();
+  return last_pid.empty() || last_pid != last_pid_;
+}
+
+std::string ProcessTable::ReadLastPid() const {
+  // The last field of loadavg is the most recently created PID.
+  std::string loadavg;
+  std::string last_pid;
+  if (GetContent(StrCat(proc_root_, "/loadavg"), &loadavg)) {
+    std::istringstream fields(loadavg);
+    std::string field;
+    while (fields >> field) {
+      last_pid = field;
+    }
+  }
+  return last_pid;
+}
+
+void ProcessTable::Scan(const double current_time) {
+  ++num_scans_;
+  const bool full_scan = last_full_scan_time_ < 0 ||
+                         current_time - last_full_scan_time_ >=
+                             full_scan_interval_;
+  if (full_scan) {
+    // Also catches processes which exec'ed into a module.
+    cmdlines_.clear();
+    last_full_scan_time_ = current_time;
+  }
+
+  // Record the last PID before listing, so nothing spawned during the scan
+  // is missed by the next one.
+  last_pid_ = ReadLastPid();
+
+  std::vector<int> pids;
+  std::unordered_map<int, std::string> cmdlines;
+  for (const auto &name : common::util::ListSubPaths(proc_root_)) {
+    int pid = 0;
+    if (!ParsePid(name, &pid)) {
+      continue;
+    }
+    auto it = cmdlines_.find(pid);
+    if (it != cmdlines_.end()) {
+      cmdlines.emplace(pid, std::move(it->second));
+    } else {
+      std::string cmdline;
+      ++num_cmdline_reads_;
+      if (!GetContent(StrCat(proc_root_, "/", name, "/cmdline"), &cmdline)) {
+        continue;
+      }
+      cmdlines.emplace(pid, std::move(cmdline));
+    }
+    pids.push_back(pid);
+  }
+  // Dead processes are dropped from the cache.
+  cmdlines_.swap(cmdlines);
+  std::sort(pids.begin(), pids.end());
+
+  for (auto &module : modules_) {
+    if (module.binding.pid >= 0) {
+      continue;
+    }
+    for (const int pid : pids) {
+      if (!ContainsAll(cmdlines_[pid], module.keywords)) {
+        continue;
+      }
+      Binding binding;
+      binding.pid = pid;
+      if (UpdateBinding(current_time, &binding)) {
+        ADEBUG << "Module " << module.name << " is running on process "
+               << pid;
+        module.binding = binding;
+        break;
+      }
+    }
+  }
+}
+
+bool ProcessTable::UpdateBinding(const double current_time,
+                                 Binding *binding) const {
+  ProcessStat stat;
+  if (!ReadProcessStat(std::to_string(binding->pid), &stat)) {
+    return false;
+  }
+  if (binding->stat_time >= 0) {
+    if (stat.start_ticks != binding->stat.start_ticks) {
+      // The PID was reused by another process.
+      return false;
+    }
+    const double duration = current_time - binding->stat_time;
+    if (duration > 0 && stat.cpu_ticks >= binding->stat.cpu_ticks) {
+      binding->cpu_usage = 100.0 * (stat.cpu_ticks - binding->stat.cpu_ticks) /
+                           clock_ticks_per_second_ / duration;
+    }
+  }
+  binding->stat = stat;
+  binding->stat_time = current_time;
+  return true;
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_MONITOR_SOFTWARE_PROCESS_TABLE_H_
+#define MODULES_MONITOR_SOFTWARE_PROCESS_TABLE_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace apollo {
+namespace monitor {
+
+// Counters of a process, as read from /proc/<pid>/stat and
+// /proc/<pid>/status.
+struct ProcessStat {
+  // utime + stime, in clock ticks.
+  uint64_t cpu_ticks = 0;
+  // Process start time after boot, in clock ticks. Detects PID reuse.
+  uint64_t start_ticks = 0;
+  int64_t rss_pages = 0;
+  uint64_t voluntary_context_switches = 0;
+  uint64_t nonvoluntary_context_switches = 0;
+};
+
+// Binds modules to the processes running them, and keeps track of their
+// resource usage.
+//
+// Instead of reading the cmdline of every process on each update, bindings
+// are cached, and the process tree is only rescanned when a bound process
+// disappears, or when a module is unbound and a new process was spawned since
+// the last scan. A scan only reads the cmdline of PIDs it has not seen yet.
+class ProcessTable {
+ public:
+  struct Binding {
+    int pid = -1;
+    ProcessStat stat;
+    // CPU usage since the previous update, in percent of one core. Negative
+    // if unknown.
+    double cpu_usage = -1;
+    // When stat was read.
+    double stat_time = -1;
+  };
+
+  // proc_root is "/proc" except for testing. A full rescan is forced every
+  // full_scan_interval seconds, to catch anything the heuristics missed.
+  ProcessTable(const std::string &proc_root, const double full_scan_interval);
+
+  // Add a module running on the process whose cmdline contains all keywords.
+  void AddModule(const std::string &module_name,
+                 const std::vector<std::string> &keywords);
+
+  // Refresh bindings and counters.
+  void Update(const double current_time);
+
+  // Get the binding of a module, nullptr if the module was not added.
+  const Binding *GetBinding(const std::string &module_name) const;
+
+  // Read the counters of a process, "self" for the current one.
+  bool ReadProcessStat(const std::string &pid, ProcessStat *stat) const;
+
+  // Refresh the counters and CPU usage of a bound process. Returns false if
+  // the process is gone.
+  bool UpdateBinding(const double current_time, Binding *binding) const;
+
+  // Number of rescans and cmdline reads so far, for overhead reporting.
+  int num_scans() const { return num_scans_; }
+  int num_cmdline_reads() const { return num_cmdline_reads_; }
+
+  static bool ParseStat(const std::string &content, ProcessStat *stat);
+  static void ParseStatus(const std::string &content, ProcessStat *stat);
+
+ private:
+  struct Module {
+    std::string name;
+    std::vector<std::string> keywords;
+    Binding binding;
+  };
+
+  bool NeedsScan(const bool lost_process, const double current_time);
+  // The most recently created PID, empty if unknown.
+  std::string ReadLastPid() const;
+  void Scan(const double current_time);
+
+  std::string proc_root_;
+  double full_scan_interval_;
+  double clock_ticks_per_second_;
+
+  std::vector<Module> modules_;
+  std::unordered_map<int, std::string> cmdlines_;
+  std::string last_pid_;
+  double last_full_scan_time_ = -1;
+
+  int num_scans_ = 0;
+  int num_cmdline_reads_ = 0;
+};
+
+}  // namespace monitor
+}  // namespace apollo
+
+#endif  // MODULES_MONITOR_SOFTWARE_PROCESS_TABLE_H_
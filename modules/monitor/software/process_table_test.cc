@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/process_table.h"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+
+namespace apollo {
+namespace monitor {
+
+using apollo::common::util::StrCat;
+
+class ProcessTableTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    proc_root_ = StrCat("/tmp/process_table_test_", getpid());
+    ASSERT_TRUE(common::util::EnsureDirectory(proc_root_));
+    SetLastPid(100);
+  }
+
+  void TearDown() override {
+    ASSERT_EQ(0, system(StrCat("rm -rf ", proc_root_).c_str()));
+  }
+
+ protected:
+  void WriteFile(const std::string &path, const std::string &content) {
+    std::ofstream fout(StrCat(proc_root_, "/", path));
+    fout << content;
+  }
+
+  void SetLastPid(const int pid) {
+    WriteFile("loadavg", StrCat("0.50 0.40 0.30 2/1000 ", pid, "\n"));
+  }
+
+  void AddProcess(const int pid, const std::string &cmdline,
+                  const int cpu_ticks, const int start_ticks = 1000) {
+    const std::string dir = StrCat(proc_root_, "/", pid);
+    ASSERT_TRUE(common::util::EnsureDirectory(dir));
+    WriteFile(StrCat(pid, "/cmdline"), cmdline);
+    WriteFile(StrCat(pid, "/stat"),
+              StrCat(pid, " (my (odd) name) S 1 1 1 0 -1 4194560 100 0 0 0 ",
+                     cpu_ticks, " 0 0 0 20 0 4 0 ", start_ticks,
+                     " 123456 2048 18446744073709551615\n"));
+    WriteFile(StrCat(pid, "/status"),
+              "Name:\tmainboard\nvoluntary_ctxt_switches:\t42\n"
+              "nonvoluntary_ctxt_switches:\t7\n");
+  }
+
+  void RemoveProcess(const int pid) {
+    ASSERT_EQ(0,
+              system(StrCat("rm -rf ", proc_root_, "/", pid).c_str()));
+  }
+
+  std::string proc_root_;
+};
+
+TEST_F(ProcessTableTest, ParseStat) {
+  ProcessStat stat;
+  EXPECT_TRUE(ProcessTable::ParseStat(
+      "12 (a) b) R 1 1 1 0 -1 0 0 0 0 0 30 12 0 0 20 0 1 0 555 1000 77",
+      &stat));
+  EXPECT_EQ(42, stat.cpu_ticks);
+  EXPECT_EQ(555, stat.start_ticks);
+  EXPECT_EQ(77, stat.rss_pages);
+  EXPECT_FALSE(ProcessTable::ParseStat("12 (truncated) R 1 1", &stat));
+  EXPECT_FALSE(ProcessTable::ParseStat("", &stat));
+}
+
+TEST_F(ProcessTableTest, BindAndTrack) {
+  AddProcess(1, "/sbin/init", 0);
+  AddProcess(20, std::string("planning\0--flagfile=planning.conf", 33), 100);
+  ProcessTable table(proc_root_, 60.0);
+  table.AddModule("planning", {"planning", "--flagfile"});
+  table.AddModule("control", {"control"});
+
+  table.Update(0.0);
+  EXPECT_EQ(1, table.num_scans());
+  EXPECT_EQ(2, table.num_cmdline_reads());
+  const auto *planning = table.GetBinding("planning");
+  ASSERT_TRUE(planning != nullptr);
+  EXPECT_EQ(20, planning->pid);
+  EXPECT_EQ(2048, planning->stat.rss_pages);
+  EXPECT_EQ(42, planning->stat.voluntary_context_switches);
+  EXPECT_EQ(7, planning->stat.nonvoluntary_context_switches);
+  EXPECT_LT(planning->cpu_usage, 0.0);
+  EXPECT_EQ(-1, table.GetBinding("control")->pid);
+  EXPECT_TRUE(table.GetBinding("perception") == nullptr);
+
+  // Nothing was spawned, so the unbound module does not trigger a scan.
+  AddProcess(20, std::string("planning\0--flagfile=planning.conf", 33),
+             100 + sysconf(_SC_CLK_TCK));
+  table.Update(2.0);
+  EXPECT_EQ(1, table.num_scans());
+  EXPECT_DOUBLE_EQ(50.0, planning->cpu_usage);
+
+  // A spawned process is found, reading only its own cmdline.
+  AddProcess(30, "control", 0);
+  SetLastPid(30);
+  table.Update(3.0);
+  EXPECT_EQ(2, table.num_scans());
+  EXPECT_EQ(3, table.num_cmdline_reads());
+  EXPECT_EQ(30, table.GetBinding("control")->pid);
+
+  // All modules are bound, new processes are ignored.
+  AddProcess(31, "other", 0);
+  SetLastPid(31);
+  table.Update(4.0);
+  EXPECT_EQ(2, table.num_scans());
+
+  // A lost process triggers a scan.
+  RemoveProcess(30);
+  table.Update(5.0);
+  EXPECT_EQ(3, table.num_scans());
+  EXPECT_EQ(4, table.num_cmdline_reads());
+  EXPECT_EQ(-1, table.GetBinding("control")->pid);
+
+  // A reused PID is detected by its start time.
+  AddProcess(20, "planning --flagfile", 0, 2000);
+  table.Update(6.0);
+  EXPECT_EQ(4, table.num_scans());
+  EXPECT_EQ(20, table.GetBinding("planning")->pid);
+  EXPECT_EQ(2000, table.GetBinding("planning")->stat.start_ticks);
+}
+
+TEST_F(ProcessTableTest, FullScan) {
+  AddProcess(10, "bash run.sh", 0);
+  ProcessTable table(proc_root_, 10.0);
+  table.AddModule("control", {"control"});
+  table.Update(0.0);
+  EXPECT_EQ(-1, table.GetBinding("control")->pid);
+
+  // The process exec'ed into the module without a new PID.
+  AddProcess(10, "control", 0);
+  table.Update(5.0);
+  EXPECT_EQ(-1, table.GetBinding("control")->pid);
+  table.Update(10.0);
+  EXPECT_EQ(10, table.GetBinding("control")->pid);
+}
+
+}  // namespace monitor
+}  // namespace apollo
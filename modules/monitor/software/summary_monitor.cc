@@ -16,6 +16,9 @@
 
 #include "modules/monitor/software/summary_monitor.h"
 
+#include <functional>
+#include <string>
+
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
 #include "modules/common/util/string_util.h"
@@ -70,6 +73,33 @@ void SummarizeOnTopicStatus(const TopicStatus &topic_status, Status *status) {
   }
 }
 
+// Resource usage changes on every process monitor round. Leave it out of the
+// fingerprint, so that it rides along with the status changes and the
+// periodic broadcasts.
+void ClearResourceUsage(ProcessStatus *status) {
+  status->clear_cpu_usage();
+  status->clear_rss_bytes();
+  status->clear_voluntary_context_switches();
+  status->clear_nonvoluntary_context_switches();
+}
+
+size_t StatusFingerprint(const SystemStatus &system_status) {
+  static std::hash<std::string> hash_fn;
+  SystemStatus status = system_status;
+  status.clear_header();
+  status.clear_monitor_process_status();
+  for (auto &module : *status.mutable_modules()) {
+    if (module.second.has_process_status()) {
+      ClearResourceUsage(module.second.mutable_process_status());
+    }
+  }
+  // Don't use DebugString() which has known bug on Map field. The string
+  // doesn't change though the value has changed.
+  std::string proto_bytes;
+  status.SerializeToString(&proto_bytes);
+  return hash_fn(proto_bytes);
+}
+
 }  // namespace
 
 // Set interval to 0, so it runs every time when ticking.
@@ -89,14 +119,8 @@ void SummaryMonitor::RunOnce(const double current_time) {
     safety_manager_->CheckSafety(current_time);
   }
   // Get fingerprint of current status.
-  // Don't use DebugString() which has known bug on Map field. The string
-  // doesn't change though the value has changed.
-  static std::hash<std::string> hash_fn;
-  std::string proto_bytes;
   auto *system_status = MonitorManager::GetStatus();
-  system_status->clear_header();
-  system_status->SerializeToString(&proto_bytes);
-  const size_t new_fp = hash_fn(proto_bytes);
+  const size_t new_fp = StatusFingerprint(*system_status);
 
   if (system_status_fp_ != new_fp ||
       current_time - last_broadcast_ > FLAGS_broadcast_max_interval) {
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file arena_allocator.h
+ **/
+
+#ifndef MODULES_PLANNING_COMMON_ARENA_ALLOCATOR_H_
+#define MODULES_PLANNING_COMMON_ARENA_ALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "google/protobuf/arena.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ArenaAllocator
+ * @brief An allocator of the standard containers which takes the memory from
+ * a protobuf arena, such as the arena of a planning frame. The memory is
+ * freed at once with the arena, and deallocate does nothing. Without an
+ * arena, it allocates on the heap like std::allocator.
+ *
+ * A copy of a container is allocated on the heap, as it may outlive the
+ * arena of the original.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  ArenaAllocator() = default;
+
+  explicit ArenaAllocator(google::protobuf::Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(const std::size_t n) {
+    // The blocks of an arena are aligned to 8 bytes.
+    static_assert(alignof(T) <= 8, "over-aligned type");
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return reinterpret_cast<T*>(
+        google::protobuf::Arena::CreateArray<char>(arena_, n * sizeof(T)));
+  }
+
+  void deallocate(T* p, const std::size_t n) {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  void destroy(U* p) {
+    p->~U();
+  }
+
+  std::size_t max_size() const { return std::allocator<T>().max_size(); }
+
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  google::protobuf::Arena* arena() const { return arena_; }
+
+ private:
+  google::protobuf::Arena* arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() != b.arena();
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_COMMON_ARENA_ALLOCATOR_H_
@@ -24,6 +24,7 @@
 #include <functional>
 #include <limits>
 #include <list>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -52,6 +53,18 @@ using apollo::prediction::PredictionObstacles;
 
 constexpr double kMathEpsilon = 1e-8;
 
+namespace {
+
+std::unique_ptr<google::protobuf::Arena> CreateFrameArena() {
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = FLAGS_frame_arena_block_size;
+  options.max_block_size = FLAGS_frame_arena_block_size;
+  return std::unique_ptr<google::protobuf::Arena>(
+      new google::protobuf::Arena(options));
+}
+
+}  // namespace
+
 FrameHistory::FrameHistory()
     : IndexedQueue<uint32_t, Frame>(FLAGS_max_history_frame_num) {}
 
@@ -63,6 +76,10 @@ Frame::Frame(uint32_t sequence_num,
       planning_start_point_(planning_start_point),
       start_time_(start_time),
       vehicle_state_(vehicle_state),
+      arena_(CreateFrameArena()),
+      obstacles_(arena_.get()),
+      trajectory_(
+          google::protobuf::Arena::CreateMessage<ADCTrajectory>(arena_.get())),
       reference_line_provider_(reference_line_provider),
       monitor_logger_(common::monitor::MonitorMessageItem::PLANNING) {
   if (FLAGS_enable_lag_prediction) {
@@ -166,7 +183,8 @@ bool Frame::CreateReferenceLineInfo() {
       is_near_destination_ = true;
     }
     reference_line_info_.emplace_back(vehicle_state_, planning_start_point_,
-                                      *ref_line_iter, *segments_iter);
+                                      *ref_line_iter, *segments_iter,
+                                      arena_.get());
     ++ref_line_iter;
     ++segments_iter;
   }
@@ -314,8 +332,7 @@ const Obstacle *Frame::CreateStaticVirtualObstacle(const std::string &id,
     AWARN << "obstacle " << id << " already exist.";
     return object;
   }
-  auto *ptr =
-      obstacles_.Add(id, *Obstacle::CreateStaticVirtualObstacles(id, box));
+  auto *ptr = AddObstacle(*Obstacle::CreateStaticVirtualObstacles(id, box));
   if (!ptr) {
     AERROR << "Failed to create virtual obstacle " << id;
   }
@@ -502,8 +519,13 @@ void Frame::AlignPredictionTime(const double planning_start_time,
 
 Obstacle *Frame::Find(const std::string &id) { return obstacles_.Find(id); }
 
-void Frame::AddObstacle(const Obstacle &obstacle) {
-  obstacles_.Add(obstacle.Id(), obstacle);
+Obstacle *Frame::AddObstacle(const Obstacle &obstacle) {
+  std::lock_guard<std::mutex> lock(obstacle_handle_mutex_);
+  const auto *existing = obstacles_.Find(obstacle.Id());
+  const int handle = existing ? existing->Handle() : num_obstacle_handles_++;
+  auto *ptr = obstacles_.Add(obstacle.Id(), obstacle);
+  ptr->SetHandle(handle);
+  return ptr;
 }
 
 const ReferenceLineInfo *Frame::FindDriveReferenceLineInfo() {
@@ -24,9 +24,12 @@
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/localization/proto/pose.pb.h"
@@ -105,9 +108,15 @@ class Frame {
       const double planning_start_time,
       prediction::PredictionObstacles *prediction_obstacles);
 
-  ADCTrajectory *mutable_trajectory() { return &trajectory_; }
+  ADCTrajectory *mutable_trajectory() { return trajectory_; }
+
+  const ADCTrajectory &trajectory() const { return *trajectory_; }
 
-  const ADCTrajectory &trajectory() const { return trajectory_; }
+  /**
+   * @brief the arena of the protobuf messages and the obstacles built in this
+   * planning cycle, it is freed at once with the frame.
+   */
+  google::protobuf::Arena *arena() const { return arena_.get(); }
 
   const bool is_near_destination() const { return is_near_destination_; }
 
@@ -129,7 +138,11 @@ class Frame {
   const Obstacle *CreateStaticVirtualObstacle(const std::string &id,
                                               const common::math::Box2d &box);
 
-  void AddObstacle(const Obstacle &obstacle);
+  /**
+   * @brief add the obstacle to the frame and assign it the next handle, or
+   * the handle of the obstacle with the same id.
+   */
+  Obstacle *AddObstacle(const Obstacle &obstacle);
 
  private:
   uint32_t sequence_num_ = 0;
@@ -137,6 +150,8 @@ class Frame {
   common::TrajectoryPoint planning_start_point_;
   const double start_time_;
   common::VehicleState vehicle_state_;
+  // Declared before the members which allocate on it.
+  std::unique_ptr<google::protobuf::Arena> arena_;
   std::list<ReferenceLineInfo> reference_line_info_;
   bool is_near_destination_ = false;
 
@@ -147,8 +162,10 @@ class Frame {
 
   prediction::PredictionObstacles prediction_;
   ThreadSafeIndexedObstacles obstacles_;
+  std::mutex obstacle_handle_mutex_;
+  int num_obstacle_handles_ = 0;
   ChangeLaneDecider change_lane_decider_;
-  ADCTrajectory trajectory_;  // last published trajectory
+  ADCTrajectory *trajectory_ = nullptr;  // last published trajectory
   std::unique_ptr<LagPrediction> lag_predictor_;
   ReferenceLineProvider *reference_line_provider_ = nullptr;
   apollo::common::monitor::MonitorLogger monitor_logger_;
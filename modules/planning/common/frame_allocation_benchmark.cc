@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Counts the heap allocations of the per-cycle storage of a planning
+ *        frame, on the heap as before versus on the arena of the frame: the
+ *        obstacles of the frame, the path obstacles of each reference line,
+ *        and the published trajectory with its debug message.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "google/protobuf/arena.h"
+
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+
+#include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path_decision.h"
+#include "modules/planning/common/path_obstacle.h"
+#include "modules/planning/common/planning_gflags.h"
+
+DEFINE_int32(benchmark_num_obstacles, 100, "Number of obstacles in a frame.");
+DEFINE_int32(benchmark_num_reference_lines, 2, "Number of reference lines.");
+DEFINE_int32(benchmark_num_trajectory_points, 200,
+             "Number of points of the trajectory and of each debug path.");
+DEFINE_int32(benchmark_num_debug_plans, 4,
+             "Number of path and speed debug plans.");
+DEFINE_int32(benchmark_num_cycles, 100, "Number of planning cycles.");
+
+namespace {
+
+std::atomic<int64_t> g_num_allocations(0);
+
+}  // namespace
+
+// Count the allocations of the whole binary. The array and the sized forms
+// call these ones.
+void* operator new(std::size_t size) {
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+namespace {
+
+struct Allocations {
+  int64_t obstacles = 0;
+  int64_t path_obstacles = 0;
+  int64_t trajectory = 0;
+};
+
+std::vector<Obstacle> CreateObstacles() {
+  std::vector<Obstacle> obstacles;
+  for (int i = 0; i < FLAGS_benchmark_num_obstacles; ++i) {
+    perception::PerceptionObstacle perception_obstacle;
+    perception_obstacle.set_id(2000 + i);
+    perception_obstacle.mutable_position()->set_x(10.0 * i);
+    perception_obstacle.mutable_position()->set_y(2.0);
+    perception_obstacle.set_length(4.0);
+    perception_obstacle.set_width(2.0);
+    obstacles.emplace_back(std::to_string(2000 + i) + "_0",
+                           perception_obstacle);
+    obstacles.back().SetHandle(i);
+  }
+  return obstacles;
+}
+
+// Fills the trajectory and the debug plans as the planner does in a cycle.
+void FillTrajectory(ADCTrajectory* trajectory) {
+  for (int i = 0; i < FLAGS_benchmark_num_trajectory_points; ++i) {
+    auto* point = trajectory->add_trajectory_point();
+    point->mutable_path_point()->set_x(i);
+    point->set_v(1.0);
+  }
+  auto* planning_data = trajectory->mutable_debug()->mutable_planning_data();
+  for (int k = 0; k < FLAGS_benchmark_num_debug_plans; ++k) {
+    auto* path = planning_data->add_path();
+    path->set_name("DpPolyPathOptimizer");
+    for (int i = 0; i < FLAGS_benchmark_num_trajectory_points; ++i) {
+      path->add_path_point()->set_x(i);
+    }
+    auto* speed_plan = planning_data->add_speed_plan();
+    speed_plan->set_name("QpSplineStSpeedOptimizer");
+    for (int i = 0; i < FLAGS_benchmark_num_trajectory_points / 2; ++i) {
+      speed_plan->add_speed_point()->set_s(i);
+    }
+  }
+}
+
+// Runs the cycles, with the storage on an arena like in Frame, or on the
+// heap, and returns the allocations of each part.
+Allocations RunCycles(const std::vector<Obstacle>& obstacles,
+                      const bool use_arena) {
+  Allocations allocations;
+  for (int cycle = 0; cycle < FLAGS_benchmark_num_cycles; ++cycle) {
+    std::unique_ptr<google::protobuf::Arena> arena;
+    if (use_arena) {
+      google::protobuf::ArenaOptions options;
+      options.start_block_size = FLAGS_frame_arena_block_size;
+      options.max_block_size = FLAGS_frame_arena_block_size;
+      arena.reset(new google::protobuf::Arena(options));
+    }
+
+    int64_t start = g_num_allocations.load();
+    ThreadSafeIndexedObstacles frame_obstacles(arena.get());
+    std::vector<const Obstacle*> added_obstacles;
+    for (const Obstacle& obstacle : obstacles) {
+      added_obstacles.push_back(frame_obstacles.Add(obstacle.Id(), obstacle));
+    }
+    allocations.obstacles += g_num_allocations.load() - start;
+
+    start = g_num_allocations.load();
+    std::vector<std::unique_ptr<PathDecision>> path_decisions;
+    for (int i = 0; i < FLAGS_benchmark_num_reference_lines; ++i) {
+      path_decisions.emplace_back(new PathDecision(arena.get()));
+      for (const Obstacle* obstacle : added_obstacles) {
+        path_decisions.back()->AddPathObstacle(PathObstacle(obstacle));
+      }
+    }
+    allocations.path_obstacles += g_num_allocations.load() - start;
+
+    start = g_num_allocations.load();
+    {
+      std::unique_ptr<ADCTrajectory> heap_trajectory;
+      ADCTrajectory* trajectory =
+          google::protobuf::Arena::CreateMessage<ADCTrajectory>(arena.get());
+      if (arena == nullptr) {
+        heap_trajectory.reset(trajectory);
+      }
+      FillTrajectory(trajectory);
+    }
+    allocations.trajectory += g_num_allocations.load() - start;
+  }
+  return allocations;
+}
+
+void Run() {
+  const std::vector<Obstacle> obstacles = CreateObstacles();
+  const Allocations heap = RunCycles(obstacles, false);
+  const Allocations arena = RunCycles(obstacles, true);
+  const double num_cycles = FLAGS_benchmark_num_cycles;
+  std::cout << "obstacles: " << obstacles.size()
+            << ", reference lines: " << FLAGS_benchmark_num_reference_lines
+            << ", trajectory points: " << FLAGS_benchmark_num_trajectory_points
+            << std::endl
+            << "allocations per cycle    heap     arena" << std::endl
+            << std::fixed << std::setprecision(0) << std::setw(20)
+            << "obstacles" << std::setw(9) << heap.obstacles / num_cycles
+            << std::setw(10) << arena.obstacles / num_cycles << std::endl
+            << std::setw(20) << "path obstacles" << std::setw(9)
+            << heap.path_obstacles / num_cycles << std::setw(10)
+            << arena.path_obstacles / num_cycles << std::endl
+            << std::setw(20) << "trajectory" << std::setw(9)
+            << heap.trajectory / num_cycles << std::setw(10)
+            << arena.trajectory / num_cycles << std::endl;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::planning::Run();
+  return 0;
+}
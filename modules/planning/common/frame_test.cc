@@ -70,5 +70,18 @@ TEST_F(FrameTest, AlignPredictionTime) {
                    .trajectory_point_size());
 }
 
+TEST_F(FrameTest, Arena) {
+  Frame frame(1, common::TrajectoryPoint(), 0.0, common::VehicleState(),
+              nullptr);
+  ASSERT_NE(nullptr, frame.arena());
+  auto* trajectory = frame.mutable_trajectory();
+  EXPECT_EQ(frame.arena(), trajectory->GetArena());
+
+  trajectory->add_trajectory_point()->mutable_path_point()->set_x(1.0);
+  auto* planning_data = trajectory->mutable_debug()->mutable_planning_data();
+  EXPECT_EQ(frame.arena(), planning_data->GetArena());
+  EXPECT_EQ(1.0, frame.trajectory().trajectory_point(0).path_point().x());
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -21,6 +21,8 @@
 #ifndef MODULES_PLANNING_COMMON_INDEXED_LIST_H_
 #define MODULES_PLANNING_COMMON_INDEXED_LIST_H_
 
+#include <deque>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -28,9 +30,11 @@
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
+#include "google/protobuf/arena.h"
 
 #include "modules/common/log.h"
 #include "modules/common/util/map_util.h"
+#include "modules/planning/common/arena_allocator.h"
 
 namespace apollo {
 namespace planning {
@@ -38,6 +42,17 @@ namespace planning {
 template <typename I, typename T>
 class IndexedList {
  public:
+  IndexedList() = default;
+
+  /**
+   * @brief Constructor
+   * @param arena the arena of the objects, e.g. the arena of the frame, which
+   * must outlive the container. The objects are on the heap if it is nullptr.
+   */
+  explicit IndexedList(google::protobuf::Arena* arena)
+      : object_dict_(0, std::hash<I>(), std::equal_to<I>(),
+                     ArenaAllocator<std::pair<const I, T>>(arena)) {}
+
   /**
    * @brief copy object into the container. If the id is already exist,
    * overwrite the object in the container.
@@ -88,12 +103,129 @@ class IndexedList {
 
  private:
   std::vector<const T*> object_list_;
-  std::unordered_map<I, T> object_dict_;
+  std::unordered_map<I, T, std::hash<I>, std::equal_to<I>,
+                     ArenaAllocator<std::pair<const I, T>>>
+      object_dict_;
+};
+
+/**
+ * @class HandleIndexedList
+ * @brief A list of objects indexed by dense integer handles, such as the
+ * obstacle handles of a frame. A lookup is an array access instead of a
+ * hash. The objects are stored in blocks in the order they are added, and
+ * their addresses stay valid when more objects are added.
+ */
+template <typename T>
+class HandleIndexedList {
+ public:
+  HandleIndexedList() = default;
+
+  /**
+   * @brief Constructor
+   * @param arena the arena of the objects, e.g. the arena of the frame, which
+   * must outlive the container. The objects are on the heap if it is nullptr.
+   */
+  explicit HandleIndexedList(google::protobuf::Arena* arena)
+      : objects_(ArenaAllocator<T>(arena)),
+        index_(ArenaAllocator<int>(arena)) {}
+
+  HandleIndexedList(const HandleIndexedList& other)
+      : objects_(other.objects_), index_(other.index_) {
+    UpdateItems();
+  }
+
+  HandleIndexedList& operator=(const HandleIndexedList& other) {
+    objects_ = other.objects_;
+    index_ = other.index_;
+    UpdateItems();
+    return *this;
+  }
+
+  /**
+   * @brief copy object into the container. If the handle is already exist,
+   * overwrite the object in the container.
+   * @param handle the non-negative handle of the object
+   * @param object the const reference of the objected to be copied to the
+   * container.
+   * @return The pointer to the object in the container.
+   * @return nullptr if the handle is negative.
+   */
+  T* Add(const int handle, const T& object) {
+    if (handle < 0) {
+      AERROR << "invalid handle " << handle;
+      return nullptr;
+    }
+    if (static_cast<size_t>(handle) >= index_.size()) {
+      index_.resize(handle + 1, -1);
+    }
+    if (index_[handle] >= 0) {
+      AWARN << "object " << handle << " is already in container";
+      T* obs = &objects_[index_[handle]];
+      *obs = object;
+      return obs;
+    }
+    index_[handle] = static_cast<int>(objects_.size());
+    objects_.push_back(object);
+    object_list_.push_back(&objects_.back());
+    return &objects_.back();
+  }
+
+  /**
+   * @brief Find object by handle in the container
+   * @param handle the handle of the object
+   * @return the raw pointer to the object if found.
+   * @return nullptr if the object is not found.
+   */
+  T* Find(const int handle) {
+    const int index = Index(handle);
+    return index < 0 ? nullptr : &objects_[index];
+  }
+
+  /**
+   * @brief Find object by handle in the container
+   * @param handle the handle of the object
+   * @return the raw pointer to the object if found.
+   * @return nullptr if the object is not found.
+   */
+  const T* Find(const int handle) const {
+    const int index = Index(handle);
+    return index < 0 ? nullptr : &objects_[index];
+  }
+
+  /**
+   * @brief List all the items in the container, in the order they are added.
+   * @return the list of const raw pointers of the objects in the container.
+   */
+  const std::vector<const T*>& Items() const { return object_list_; }
+
+ private:
+  int Index(const int handle) const {
+    if (handle < 0 || static_cast<size_t>(handle) >= index_.size()) {
+      return -1;
+    }
+    return index_[handle];
+  }
+
+  void UpdateItems() {
+    object_list_.clear();
+    for (const T& object : objects_) {
+      object_list_.push_back(&object);
+    }
+  }
+
+  std::deque<T, ArenaAllocator<T>> objects_;
+  std::vector<int, ArenaAllocator<int>> index_;
+  std::vector<const T*> object_list_;
 };
 
 template <typename I, typename T>
 class ThreadSafeIndexedList : public IndexedList<I, T> {
  public:
+  ThreadSafeIndexedList() = default;
+
+  explicit ThreadSafeIndexedList(google::protobuf::Arena* arena)
+      : IndexedList<I, T>(arena) {}
+
   T* Add(const I id, const T& object) {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     return IndexedList<I, T>::Add(id, object);
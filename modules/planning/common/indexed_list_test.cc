@@ -19,6 +19,7 @@
  **/
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -67,5 +68,70 @@ TEST(IndexedList, Find) {
   ASSERT_EQ(nullptr, object.Find(2));
 }
 
+TEST(HandleIndexedList, Add) {
+  HandleIndexedList<std::string> object;
+  ASSERT_EQ(nullptr, object.Add(-1, "invalid"));
+  auto* three = object.Add(3, "three");
+  ASSERT_NE(nullptr, three);
+  ASSERT_NE(nullptr, object.Add(0, "zero"));
+  ASSERT_EQ(three, object.Add(3, "three_again"));
+  ASSERT_EQ(nullptr, object.Find(1));
+  ASSERT_EQ(nullptr, object.Find(4));
+  ASSERT_EQ(nullptr, object.Find(-1));
+  const auto& items = object.Items();
+  ASSERT_EQ(2, items.size());
+  ASSERT_EQ("three_again", *items[0]);
+  ASSERT_EQ("zero", *items[1]);
+
+  // The added objects do not move.
+  for (int i = 4; i < 1000; ++i) {
+    object.Add(i, std::to_string(i));
+  }
+  ASSERT_EQ(three, object.Find(3));
+  ASSERT_EQ(998, object.Items().size());
+  ASSERT_EQ("999", *object.Find(999));
+}
+
+TEST(HandleIndexedList, Copy) {
+  HandleIndexedList<std::string> object;
+  object.Add(2, "two");
+  object.Add(1, "one");
+  HandleIndexedList<std::string> copy(object);
+  *copy.Find(2) = "two_copy";
+  ASSERT_EQ("two", *object.Find(2));
+  const auto& items = copy.Items();
+  ASSERT_EQ(2, items.size());
+  ASSERT_EQ(copy.Find(2), items[0]);
+  ASSERT_EQ(copy.Find(1), items[1]);
+  ASSERT_EQ("two_copy", *items[0]);
+}
+
+TEST(IndexedList, Arena) {
+  google::protobuf::Arena arena;
+  ThreadSafeIndexedList<int, std::string> object(&arena);
+  ASSERT_NE(nullptr, object.Add(1, "one"));
+  ASSERT_NE(nullptr, object.Add(2, "two"));
+  ASSERT_LT(0, arena.SpaceUsed());
+  ASSERT_EQ("two", *object.Find(2));
+  ASSERT_EQ(2, object.Items().size());
+}
+
+TEST(HandleIndexedList, Arena) {
+  std::unique_ptr<HandleIndexedList<std::string>> copy;
+  {
+    google::protobuf::Arena arena;
+    HandleIndexedList<std::string> object(&arena);
+    for (int i = 0; i < 100; ++i) {
+      object.Add(i, std::to_string(i));
+    }
+    ASSERT_LT(100 * sizeof(std::string), arena.SpaceUsed());
+    ASSERT_EQ("42", *object.Find(42));
+    // A copy is on the heap, it outlives the arena.
+    copy.reset(new HandleIndexedList<std::string>(object));
+  }
+  ASSERT_EQ(100, copy->Items().size());
+  ASSERT_EQ("42", *copy->Find(42));
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -56,6 +56,14 @@ class Obstacle {
   const std::string &Id() const;
   void SetId(const std::string &id) { id_ = id; }
 
+  /**
+   * @brief the dense integer handle which the frame assigns to the obstacle,
+   * -1 if the obstacle is not in a frame. The decisions of the obstacle are
+   * looked up by the handle, the id is kept for output.
+   */
+  int Handle() const { return handle_; }
+  void SetHandle(const int handle) { handle_ = handle; }
+
   std::int32_t PerceptionId() const;
 
   double Speed() const;
@@ -107,6 +115,7 @@ class Obstacle {
 
  private:
   std::string id_;
+  int handle_ = -1;
   std::int32_t perception_id_ = 0;
   bool is_static_ = false;
   bool is_virtual_ = false;
@@ -28,41 +28,50 @@
 namespace apollo {
 namespace planning {
 
-using IndexedPathObstacles = IndexedList<std::string, PathObstacle>;
+PathDecision::PathDecision(google::protobuf::Arena *arena)
+    : path_obstacles_(arena) {}
 
 PathObstacle *PathDecision::AddPathObstacle(const PathObstacle &path_obstacle) {
   std::lock_guard<std::mutex> lock(obstacle_mutex_);
-  return path_obstacles_.Add(path_obstacle.Id(), path_obstacle);
+  return path_obstacles_.Add(path_obstacle.Handle(), path_obstacle);
 }
 
-const IndexedPathObstacles &PathDecision::path_obstacles() const {
+const HandleIndexedList<PathObstacle> &PathDecision::path_obstacles() const {
   return path_obstacles_;
 }
 
-PathObstacle *PathDecision::Find(const std::string &object_id) {
-  return path_obstacles_.Find(object_id);
+PathObstacle *PathDecision::Find(const int handle) {
+  return path_obstacles_.Find(handle);
+}
+
+const PathObstacle *PathDecision::Find(const int handle) const {
+  return path_obstacles_.Find(handle);
 }
 
 const PathObstacle *PathDecision::Find(const std::string &object_id) const {
-  return path_obstacles_.Find(object_id);
+  for (const auto *path_obstacle : path_obstacles_.Items()) {
+    if (path_obstacle->Id() == object_id) {
+      return path_obstacle;
+    }
+  }
+  return nullptr;
 }
 
-void PathDecision::SetStBoundary(const std::string &id,
+void PathDecision::SetStBoundary(const int handle,
                                  const StBoundary &boundary) {
-  auto *obstacle = path_obstacles_.Find(id);
+  auto *obstacle = path_obstacles_.Find(handle);
 
   if (!obstacle) {
-    AERROR << "Failed to find obstacle : " << id;
+    AERROR << "Failed to find obstacle : " << handle;
     return;
   } else {
     obstacle->SetStBoundary(boundary);
   }
 }
 
-bool PathDecision::AddLateralDecision(const std::string &tag,
-                                      const std::string &object_id,
+bool PathDecision::AddLateralDecision(const std::string &tag, const int handle,
                                       const ObjectDecisionType &decision) {
-  auto *path_obstacle = path_obstacles_.Find(object_id);
+  auto *path_obstacle = path_obstacles_.Find(handle);
   if (!path_obstacle) {
     AERROR << "failed to find obstacle";
     return false;
@@ -73,15 +82,15 @@ bool PathDecision::AddLateralDecision(const std::string &tag,
 
 void PathDecision::EraseStBoundaries() {
   for (const auto *path_obstacle : path_obstacles_.Items()) {
-    auto *obstacle_ptr = path_obstacles_.Find(path_obstacle->Id());
+    auto *obstacle_ptr = path_obstacles_.Find(path_obstacle->Handle());
     obstacle_ptr->EraseStBoundary();
   }
 }
 
 bool PathDecision::AddLongitudinalDecision(const std::string &tag,
-                                           const std::string &object_id,
+                                           const int handle,
                                            const ObjectDecisionType &decision) {
-  auto *path_obstacle = path_obstacles_.Find(object_id);
+  auto *path_obstacle = path_obstacles_.Find(handle);
   if (!path_obstacle) {
     AERROR << "failed to find obstacle";
     return false;
@@ -28,6 +28,8 @@
 #include <string>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+
 #include "modules/planning/proto/decision.pb.h"
 
 #include "modules/planning/common/indexed_list.h"
@@ -40,27 +42,39 @@ namespace planning {
 /**
  * @class PathDecision
  *
- * @brief PathDecision represents all obstacle decisions on one path.
+ * @brief PathDecision represents all obstacle decisions on one path. The path
+ * obstacles are indexed by the obstacle handles of the frame.
  */
 class PathDecision {
  public:
   PathDecision() = default;
 
+  /**
+   * @param arena the arena of the path obstacles, e.g. the arena of the frame,
+   * which must outlive this object.
+   */
+  explicit PathDecision(google::protobuf::Arena *arena);
+
   PathObstacle *AddPathObstacle(const PathObstacle &path_obstacle);
 
-  const IndexedList<std::string, PathObstacle> &path_obstacles() const;
+  const HandleIndexedList<PathObstacle> &path_obstacles() const;
 
-  bool AddLateralDecision(const std::string &tag, const std::string &object_id,
+  bool AddLateralDecision(const std::string &tag, const int handle,
                           const ObjectDecisionType &decision);
-  bool AddLongitudinalDecision(const std::string &tag,
-                               const std::string &object_id,
+  bool AddLongitudinalDecision(const std::string &tag, const int handle,
                                const ObjectDecisionType &decision);
 
-  const PathObstacle *Find(const std::string &object_id) const;
+  const PathObstacle *Find(const int handle) const;
 
-  PathObstacle *Find(const std::string &object_id);
+  PathObstacle *Find(const int handle);
+
+  /**
+   * @brief find the path obstacle by its id with a linear search, for the
+   * few lookups of an obstacle whose handle is unknown.
+   */
+  const PathObstacle *Find(const std::string &object_id) const;
 
-  void SetStBoundary(const std::string &id, const StBoundary &boundary);
+  void SetStBoundary(const int handle, const StBoundary &boundary);
   void EraseStBoundaries();
   MainStop main_stop() const { return main_stop_; }
   double stop_reference_line_s() const { return stop_reference_line_s_; }
@@ -70,7 +84,7 @@ class PathDecision {
 
  private:
   std::mutex obstacle_mutex_;
-  IndexedList<std::string, PathObstacle> path_obstacles_;
+  HandleIndexedList<PathObstacle> path_obstacles_;
   MainStop main_stop_;
   double stop_reference_line_s_ = std::numeric_limits<double>::max();
 };
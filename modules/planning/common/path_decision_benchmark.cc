@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the path obstacles of a frame indexed by the obstacle ids
+ *        versus by the obstacle handles. A cycle adds the path obstacles of
+ *        one reference line, runs the decider passes, each of which looks up
+ *        every obstacle once, and copies the container.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/perception/proto/perception_obstacle.pb.h"
+
+#include "modules/planning/common/indexed_list.h"
+#include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path_obstacle.h"
+
+DEFINE_int32(benchmark_num_obstacles, 200, "Number of obstacles in a frame.");
+DEFINE_int32(benchmark_num_cycles, 1000, "Number of planning cycles.");
+DEFINE_int32(benchmark_num_passes, 10,
+             "Number of decider passes over the obstacles in a cycle.");
+
+namespace apollo {
+namespace planning {
+namespace {
+
+double ElapsedUs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::micro> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count() / FLAGS_benchmark_num_cycles;
+}
+
+std::vector<Obstacle> CreateObstacles() {
+  std::vector<Obstacle> obstacles;
+  for (int i = 0; i < FLAGS_benchmark_num_obstacles; ++i) {
+    perception::PerceptionObstacle perception_obstacle;
+    perception_obstacle.set_id(2000 + i);
+    perception_obstacle.mutable_position()->set_x(10.0 * i);
+    perception_obstacle.mutable_position()->set_y(2.0);
+    perception_obstacle.set_length(4.0);
+    perception_obstacle.set_width(2.0);
+    // The ids of the obstacles with a predicted trajectory.
+    obstacles.emplace_back(std::to_string(2000 + i) + "_0",
+                           perception_obstacle);
+    obstacles.back().SetHandle(i);
+  }
+  return obstacles;
+}
+
+// The decider passes look up every obstacle of the list, like
+// path_decision->Find(path_obstacle->Id()) in the speed deciders.
+template <typename List, typename GetKey>
+double RunCycles(const std::vector<Obstacle>& obstacles,
+                 const GetKey& get_key) {
+  ObjectDecisionType ignore;
+  ignore.mutable_ignore();
+  size_t num_copied = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int cycle = 0; cycle < FLAGS_benchmark_num_cycles; ++cycle) {
+    List list;
+    for (const Obstacle& obstacle : obstacles) {
+      list.Add(get_key(obstacle), PathObstacle(&obstacle));
+    }
+    for (int pass = 0; pass < FLAGS_benchmark_num_passes; ++pass) {
+      for (const auto* const_path_obstacle : list.Items()) {
+        auto* path_obstacle =
+            list.Find(get_key(*const_path_obstacle->obstacle()));
+        path_obstacle->SetBlockingObstacle(pass % 2 == 0);
+      }
+    }
+    list.Find(get_key(obstacles.front()))
+        ->AddLongitudinalDecision("benchmark", ignore);
+    const List copy = list;
+    num_copied += copy.Items().size();
+  }
+  const double elapsed_us = ElapsedUs(start);
+  if (num_copied != obstacles.size() * FLAGS_benchmark_num_cycles) {
+    std::cerr << "Wrong number of copied obstacles: " << num_copied
+              << std::endl;
+  }
+  return elapsed_us;
+}
+
+void Run() {
+  const std::vector<Obstacle> obstacles = CreateObstacles();
+  const double id_us = RunCycles<IndexedList<std::string, PathObstacle>>(
+      obstacles, [](const Obstacle& obstacle) { return obstacle.Id(); });
+  const double handle_us = RunCycles<HandleIndexedList<PathObstacle>>(
+      obstacles, [](const Obstacle& obstacle) { return obstacle.Handle(); });
+  std::cout << "obstacles: " << obstacles.size()
+            << ", passes: " << FLAGS_benchmark_num_passes << std::endl
+            << std::fixed << std::setprecision(1)
+            << "by id:     " << id_us << " us/cycle" << std::endl
+            << "by handle: " << handle_us << " us/cycle" << std::endl;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::planning::Run();
+  return 0;
+}
@@ -64,6 +64,7 @@ const std::string& PathObstacle::Id() const { return id_; }
 PathObstacle::PathObstacle(const Obstacle* obstacle) : obstacle_(obstacle) {
   CHECK_NOTNULL(obstacle);
   id_ = obstacle_->Id();
+  handle_ = obstacle_->Handle();
 }
 
 void PathObstacle::SetPerceptionSlBoundary(const SLBoundary& sl_boundary) {
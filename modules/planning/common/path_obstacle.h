@@ -66,6 +66,11 @@ class PathObstacle {
 
   const std::string& Id() const;
 
+  /**
+   * @brief the frame handle of the obstacle, see Obstacle::Handle().
+   */
+  int Handle() const { return handle_; }
+
   const Obstacle* obstacle() const;
 
   /**
@@ -163,6 +168,7 @@ class PathObstacle {
   bool IsValidObstacle(
       const perception::PerceptionObstacle& perception_obstacle);
   std::string id_;
+  int handle_ = -1;
   const Obstacle* obstacle_ = nullptr;
   std::vector<ObjectDecisionType> decisions_;
   std::vector<std::string> decider_tags_;
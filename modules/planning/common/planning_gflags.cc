@@ -100,6 +100,9 @@ DEFINE_bool(enable_side_vehicle_st_boundary, false,
             "Add st boundary of side vehicle in st graph.");
 
 DEFINE_int32(max_history_frame_num, 1, "The maximum history frame number");
+DEFINE_int32(frame_arena_block_size, 256 * 1024,
+             "The block size in bytes of the arena which holds the protobuf "
+             "messages of a frame, one block is enough for a typical cycle");
 
 DEFINE_double(max_collision_distance, 0.1,
               "considered as collision if distance (meters) is smaller than or "
@@ -281,6 +284,8 @@ DEFINE_bool(
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_em_planner, false,
+            "Enable multiple thread to plan reference lines in em planner.");
 
 /// Lattice Planner
 DEFINE_double(lattice_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -56,6 +56,7 @@ DECLARE_bool(publish_estop);
 DECLARE_bool(enable_trajectory_stitcher);
 
 DECLARE_int32(max_history_frame_num);
+DECLARE_int32(frame_arena_block_size);
 
 // parameters for trajectory stitching and reinit planning starting point.
 DECLARE_double(replan_lateral_distance_threshold);
@@ -145,6 +146,7 @@ DECLARE_int32(num_thread_planning_thread_pool);
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_em_planner);
 
 // lattice planner
 DECLARE_double(lattice_epsilon);
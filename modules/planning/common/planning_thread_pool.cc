@@ -36,11 +36,25 @@ void PlanningThreadPool::Init() {
   is_initialized = true;
 }
 
+void PlanningThreadPool::AddFuture(std::future<void> future) {
+  std::lock_guard<std::mutex> lock(futures_mutex_);
+  futures_[std::this_thread::get_id()].push_back(std::move(future));
+}
+
 void PlanningThreadPool::Synchronize() {
-  for (auto& future : futures_) {
+  std::vector<std::future<void>> futures;
+  {
+    std::lock_guard<std::mutex> lock(futures_mutex_);
+    auto iter = futures_.find(std::this_thread::get_id());
+    if (iter == futures_.end()) {
+      return;
+    }
+    futures = std::move(iter->second);
+    futures_.erase(iter);
+  }
+  for (auto& future : futures) {
     future.wait();
   }
-  futures_.clear();
 }
 
 }  // namespace planning
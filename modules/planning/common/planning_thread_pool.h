@@ -21,7 +21,11 @@
 #ifndef MODULES_PLANNING_COMMON_PLANNING_THREAD_POOL_H_
 #define MODULES_PLANNING_COMMON_PLANNING_THREAD_POOL_H_
 
+#include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -47,21 +51,29 @@ class PlanningThreadPool {
   }
   template <typename F, typename... Rest>
   void Push(F &&f, Rest &&... rest) {
-    futures_.push_back(std::move(thread_pool_->Push(f, rest...)));
+    AddFuture(thread_pool_->Push(f, rest...));
   }
 
   template <typename F>
   void Push(F &&f) {
-    futures_.push_back(std::move(thread_pool_->Push(f)));
+    AddFuture(thread_pool_->Push(f));
   }
 
+  /**
+   * @brief Waits for the tasks pushed by the calling thread, so that the
+   * reference lines planned on different threads do not wait for each other.
+   */
   void Synchronize();
 
  private:
+  void AddFuture(std::future<void> future);
+
   std::unique_ptr<common::util::ThreadPool> thread_pool_;
   bool is_initialized = false;
 
-  std::vector<std::future<void>> futures_;
+  std::mutex futures_mutex_;
+  std::unordered_map<std::thread::id, std::vector<std::future<void>>>
+      futures_;
 
   DECLARE_SINGLETON(PlanningThreadPool);
 };
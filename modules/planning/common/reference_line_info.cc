@@ -53,11 +53,19 @@ using apollo::planning::util::GetPlanningStatus;
 ReferenceLineInfo::ReferenceLineInfo(const common::VehicleState& vehicle_state,
                                      const TrajectoryPoint& adc_planning_point,
                                      const ReferenceLine& reference_line,
-                                     const hdmap::RouteSegments& segments)
+                                     const hdmap::RouteSegments& segments,
+                                     google::protobuf::Arena* arena)
     : vehicle_state_(vehicle_state),
       adc_planning_point_(adc_planning_point),
       reference_line_(reference_line),
-      lanes_(segments) {}
+      path_decision_(arena),
+      lanes_(segments) {
+  debug_ = google::protobuf::Arena::CreateMessage<planning_internal::Debug>(
+      arena);
+  if (arena == nullptr) {
+    owned_debug_.reset(debug_);
+  }
+}
 
 bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
   const auto& param = VehicleConfigHelper::GetConfig().vehicle_param();
@@ -245,10 +253,10 @@ PathObstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
   if (IsUnrelaventObstacle(path_obstacle)) {
     ObjectDecisionType ignore;
     ignore.mutable_ignore();
-    path_decision_.AddLateralDecision("reference_line_filter", obstacle->Id(),
-                                      ignore);
-    path_decision_.AddLongitudinalDecision("reference_line_filter",
-                                           obstacle->Id(), ignore);
+    // Decide on the added path obstacle directly, the lookup is not
+    // synchronized with the obstacles added by the other threads.
+    path_obstacle->AddLateralDecision("reference_line_filter", ignore);
+    path_obstacle->AddLongitudinalDecision("reference_line_filter", ignore);
     ADEBUG << "NO build reference line st boundary. id:" << obstacle->Id();
   } else {
     ADEBUG << "build reference line st boundary. id:" << obstacle->Id();
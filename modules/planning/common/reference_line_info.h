@@ -29,6 +29,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+
 #include "modules/common/proto/drive_state.pb.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
@@ -50,10 +52,16 @@ namespace planning {
  */
 class ReferenceLineInfo {
  public:
+  /**
+   * @param arena the arena of the debug message and the path obstacles, which
+   * must outlive this object. They are allocated on the heap if it is
+   * nullptr.
+   */
   explicit ReferenceLineInfo(const common::VehicleState& vehicle_state,
                              const common::TrajectoryPoint& adc_planning_point,
                              const ReferenceLine& reference_line,
-                             const hdmap::RouteSegments& segments);
+                             const hdmap::RouteSegments& segments,
+                             google::protobuf::Arena* arena = nullptr);
 
   bool Init(const std::vector<const Obstacle*>& obstacles);
 
@@ -94,8 +102,8 @@ class ReferenceLineInfo {
    **/
   bool IsStartFrom(const ReferenceLineInfo& previous_reference_line_info) const;
 
-  planning_internal::Debug* mutable_debug() { return &debug_; }
-  const planning_internal::Debug& debug() const { return debug_; }
+  planning_internal::Debug* mutable_debug() { return debug_; }
+  const planning_internal::Debug& debug() const { return *debug_; }
   LatencyStats* mutable_latency_stats() { return &latency_stats_; }
   const LatencyStats& latency_stats() const { return latency_stats_; }
 
@@ -189,7 +197,9 @@ class ReferenceLineInfo {
 
   SLBoundary adc_sl_boundary_;
 
-  planning_internal::Debug debug_;
+  // Owns the debug message only when it is not allocated on an arena.
+  std::unique_ptr<planning_internal::Debug> owned_debug_;
+  planning_internal::Debug* debug_ = nullptr;
   LatencyStats latency_stats_;
 
   hdmap::RouteSegments lanes_;
@@ -64,12 +64,21 @@ TrajectoryEvaluator::TrajectoryEvaluator(
 
   reference_s_dot_ = ComputeLongitudinalGuideVelocity(planning_target);
 
+  for (double s = 0.0; s < FLAGS_decision_horizon;
+       s += FLAGS_trajectory_space_resolution) {
+    s_values_.emplace_back(s);
+  }
+
   // if we have a stop point along the reference line,
   // filter out the lon. trajectories that pass the stop point.
   double stop_point = std::numeric_limits<double>::max();
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
+
+  // Each 1d trajectory is evaluated once, and the cost of a pair is combined
+  // from the costs of its trajectories.
+  std::vector<LatTrajectoryCosts> lat_costs;
   for (const auto& lon_trajectory : lon_trajectories) {
     double lon_end_s = lon_trajectory->Evaluate(0, end_time);
     if (init_s[0] < stop_point &&
@@ -80,7 +89,18 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
-    for (const auto& lat_trajectory : lat_trajectories) {
+    if (lat_trajectories.empty()) {
+      break;
+    }
+    if (lat_costs.empty()) {
+      for (const auto& lat_trajectory : lat_trajectories) {
+        lat_costs.emplace_back(EvaluateLat(lat_trajectory));
+      }
+    }
+    const LonTrajectoryCosts lon_costs =
+        EvaluateLon(planning_target, lon_trajectory);
+    for (std::size_t i = 0; i < lat_trajectories.size(); ++i) {
+      const auto& lat_trajectory = lat_trajectories[i];
       /**
        * The validity of the code needs to be verified.
       if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
@@ -89,12 +109,12 @@ TrajectoryEvaluator::TrajectoryEvaluator(
       }
       */
       if (!FLAGS_enable_auto_tuning) {
-        double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
+        double cost = Evaluate(lon_costs, lat_trajectory, lat_costs[i]);
         cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
                             cost);
       } else {
         std::vector<double> cost_components;
-        double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory,
+        double cost = Evaluate(lon_costs, lat_trajectory, lat_costs[i],
                                &cost_components);
         cost_queue_with_components_.emplace(
             Trajectory1dPair(lon_trajectory, lat_trajectory),
@@ -154,55 +174,100 @@ std::vector<double> TrajectoryEvaluator::top_trajectory_pair_component_cost()
   return cost_queue_with_components_.top().second.first;
 }
 
-double TrajectoryEvaluator::Evaluate(
+TrajectoryEvaluator::LonTrajectoryCosts TrajectoryEvaluator::EvaluateLon(
     const PlanningTarget& planning_target,
-    const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory,
-    std::vector<double>* cost_components) const {
+    const PtrTrajectory1d& lon_trajectory) const {
+  LonTrajectoryCosts costs;
+  for (double t = 0.0; t < FLAGS_trajectory_time_length;
+       t += FLAGS_trajectory_time_resolution) {
+    costs.s.emplace_back(lon_trajectory->Evaluate(0, t));
+    costs.s_dot.emplace_back(lon_trajectory->Evaluate(1, t));
+    costs.s_ddot.emplace_back(lon_trajectory->Evaluate(2, t));
+    costs.jerk.emplace_back(lon_trajectory->Evaluate(3, t));
+  }
+
   // Costs:
   // 1. Cost of missing the objective, e.g., cruise, stop, etc.
   // 2. Cost of logitudinal jerk
   // 3. Cost of logitudinal collision
-  // 4. Cost of lateral offsets
-  // 5. Cost of lateral comfort
-
-  // Longitudinal costs
-  double lon_objective_cost =
+  // 4. Cost of centripetal acceleration
+  costs.objective_cost =
       LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
 
-  double lon_jerk_cost = LonComfortCost(lon_trajectory);
+  costs.comfort_cost = LonComfortCost(costs.jerk);
 
-  double lon_collision_cost = LonCollisionCost(lon_trajectory);
+  costs.collision_cost = LonCollisionCost(lon_trajectory);
 
-  double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
+  costs.centripetal_acc_cost =
+      CentripetalAccelerationCost(costs.s, costs.s_dot);
+
+  costs.cost = costs.objective_cost * FLAGS_weight_lon_objective +
+               costs.comfort_cost * FLAGS_weight_lon_jerk +
+               costs.collision_cost * FLAGS_weight_lon_collision +
+               costs.centripetal_acc_cost *
+                   FLAGS_weight_centripetal_acceleration;
 
   // decides the longitudinal evaluation horizon for lateral trajectories.
   double evaluation_horizon =
       std::min(FLAGS_decision_horizon,
                lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
-  std::vector<double> s_values;
   for (double s = 0.0; s < evaluation_horizon;
        s += FLAGS_trajectory_space_resolution) {
-    s_values.emplace_back(s);
+    ++costs.num_s_values;
+  }
+  return costs;
+}
+
+TrajectoryEvaluator::LatTrajectoryCosts TrajectoryEvaluator::EvaluateLat(
+    const PtrTrajectory1d& lat_trajectory) const {
+  LatTrajectoryCosts costs;
+  double lat_offset_start = lat_trajectory->Evaluate(0, 0.0);
+  double cost_sqr_sum = 0.0;
+  double cost_abs_sum = 0.0;
+  costs.offset_cost_sqr_sums.emplace_back(cost_sqr_sum);
+  costs.offset_cost_abs_sums.emplace_back(cost_abs_sum);
+  for (const auto& s : s_values_) {
+    double lat_offset = lat_trajectory->Evaluate(0, s);
+    double cost = lat_offset / FLAGS_lat_offset_bound;
+    if (lat_offset * lat_offset_start < 0.0) {
+      cost_sqr_sum += cost * cost * FLAGS_weight_opposite_side_offset;
+      cost_abs_sum += std::fabs(cost) * FLAGS_weight_opposite_side_offset;
+    } else {
+      cost_sqr_sum += cost * cost * FLAGS_weight_same_side_offset;
+      cost_abs_sum += std::fabs(cost) * FLAGS_weight_same_side_offset;
+    }
+    costs.offset_cost_sqr_sums.emplace_back(cost_sqr_sum);
+    costs.offset_cost_abs_sums.emplace_back(cost_abs_sum);
   }
+  return costs;
+}
 
-  // Lateral costs
-  double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+double TrajectoryEvaluator::Evaluate(
+    const LonTrajectoryCosts& lon_costs,
+    const PtrTrajectory1d& lat_trajectory,
+    const LatTrajectoryCosts& lat_costs,
+    std::vector<double>* cost_components) const {
+  // Lateral costs:
+  // 1. Cost of lateral offsets
+  // 2. Cost of lateral comfort
 
-  double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
+  // The s values within the evaluation horizon are the first ones of
+  // s_values_, as the horizon is not beyond the decision horizon.
+  const std::size_t num_s_values = lon_costs.num_s_values;
+  double lat_offset_cost =
+      lat_costs.offset_cost_sqr_sums[num_s_values] /
+      (lat_costs.offset_cost_abs_sums[num_s_values] + FLAGS_lattice_epsilon);
+
+  double lat_comfort_cost = LatComfortCost(lon_costs, lat_trajectory);
 
   if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
+    cost_components->emplace_back(lon_costs.objective_cost);
+    cost_components->emplace_back(lon_costs.comfort_cost);
+    cost_components->emplace_back(lon_costs.collision_cost);
     cost_components->emplace_back(lat_offset_cost);
   }
 
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
-         lat_offset_cost * FLAGS_weight_lat_offset +
+  return lon_costs.cost + lat_offset_cost * FLAGS_weight_lat_offset +
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
@@ -236,26 +301,6 @@ double TrajectoryEvaluator::EvaluateDiscreteTrajectory(
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
-double TrajectoryEvaluator::LatOffsetCost(
-    const PtrTrajectory1d& lat_trajectory,
-    const std::vector<double>& s_values) const {
-  double lat_offset_start = lat_trajectory->Evaluate(0, 0.0);
-  double cost_sqr_sum = 0.0;
-  double cost_abs_sum = 0.0;
-  for (const auto& s : s_values) {
-    double lat_offset = lat_trajectory->Evaluate(0, s);
-    double cost = lat_offset / FLAGS_lat_offset_bound;
-    if (lat_offset * lat_offset_start < 0.0) {
-      cost_sqr_sum += cost * cost * FLAGS_weight_opposite_side_offset;
-      cost_abs_sum += std::fabs(cost) * FLAGS_weight_opposite_side_offset;
-    } else {
-      cost_sqr_sum += cost * cost * FLAGS_weight_same_side_offset;
-      cost_abs_sum += std::fabs(cost) * FLAGS_weight_same_side_offset;
-    }
-  }
-  return cost_sqr_sum / (cost_abs_sum + FLAGS_lattice_epsilon);
-}
-
 double TrajectoryEvaluator::LatOffsetCost(
     const std::vector<FrenetFramePoint> sl_points) const {
   if (sl_points.size() == 0) {
@@ -279,14 +324,13 @@ double TrajectoryEvaluator::LatOffsetCost(
 }
 
 double TrajectoryEvaluator::LatComfortCost(
-    const PtrTrajectory1d& lon_trajectory,
+    const LonTrajectoryCosts& lon_costs,
     const PtrTrajectory1d& lat_trajectory) const {
   double max_cost = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
+  for (std::size_t i = 0; i < lon_costs.s.size(); ++i) {
+    double s = lon_costs.s[i];
+    double s_dot = lon_costs.s_dot[i];
+    double s_dotdot = lon_costs.s_ddot[i];
     double l_prime = lat_trajectory->Evaluate(1, s);
     double l_primeprime = lat_trajectory->Evaluate(2, s);
     double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
@@ -316,12 +360,10 @@ double TrajectoryEvaluator::LatComfortCost(
 }
 
 double TrajectoryEvaluator::LonComfortCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const std::vector<double>& jerks) const {
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double jerk = lon_trajectory->Evaluate(3, t);
+  for (const double jerk : jerks) {
     double cost = jerk / FLAGS_longitudinal_jerk_upper_bound;
     cost_sqr_sum += cost * cost;
     cost_abs_sum += std::fabs(cost);
@@ -476,15 +518,14 @@ double TrajectoryEvaluator::LonCollisionCost(
 }
 
 double TrajectoryEvaluator::CentripetalAccelerationCost(
-    const PtrTrajectory1d& lon_trajectory) const {
-
+    const std::vector<double>& s_values,
+    const std::vector<double>& s_dots) const {
   // Assumes the vehicle is not obviously deviate from the reference line.
   double centripetal_acc_sum = 0.0;
   double centripetal_acc_sqr_sum = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double v = lon_trajectory->Evaluate(1, t);
+  for (std::size_t i = 0; i < s_values.size(); ++i) {
+    double s = s_values[i];
+    double v = s_dots[i];
     PathPoint ref_point = PathMatcher::MatchToPath(*reference_line_, s);
     CHECK(ref_point.has_kappa());
     double centripetal_acc = v * v * ref_point.kappa();
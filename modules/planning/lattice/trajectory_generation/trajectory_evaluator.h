@@ -77,24 +77,53 @@ class TrajectoryEvaluator {
       std::vector<double>* cost_components);
 
  private:
-  double Evaluate(const PlanningTarget& planning_target,
-                  const std::shared_ptr<Curve1d>& lon_trajectory,
+  // The costs of a longitudinal trajectory, which are shared by all its
+  // lateral partners, and its samples at the times of the comfort costs.
+  struct LonTrajectoryCosts {
+    std::vector<double> s;
+    std::vector<double> s_dot;
+    std::vector<double> s_ddot;
+    std::vector<double> jerk;
+    double objective_cost = 0.0;
+    double comfort_cost = 0.0;
+    double collision_cost = 0.0;
+    double centripetal_acc_cost = 0.0;
+    // The weighted sum of the costs above.
+    double cost = 0.0;
+    // The number of s values within the evaluation horizon of the lateral
+    // trajectories.
+    std::size_t num_s_values = 0;
+  };
+
+  // The sums of the lateral offset costs of a lateral trajectory over the
+  // first s values, for every number of s values.
+  struct LatTrajectoryCosts {
+    std::vector<double> offset_cost_sqr_sums;
+    std::vector<double> offset_cost_abs_sums;
+  };
+
+  LonTrajectoryCosts EvaluateLon(
+      const PlanningTarget& planning_target,
+      const std::shared_ptr<Curve1d>& lon_trajectory) const;
+
+  LatTrajectoryCosts EvaluateLat(
+      const std::shared_ptr<Curve1d>& lat_trajectory) const;
+
+  double Evaluate(const LonTrajectoryCosts& lon_costs,
                   const std::shared_ptr<Curve1d>& lat_trajectory,
+                  const LatTrajectoryCosts& lat_costs,
                   std::vector<double>* cost_components = nullptr) const;
 
-  double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
-                       const std::vector<double>& s_values) const;
-
   double LatOffsetCost(
       const std::vector<apollo::common::FrenetFramePoint> sl_points) const;
 
-  double LatComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory,
+  double LatComfortCost(const LonTrajectoryCosts& lon_costs,
                         const std::shared_ptr<Curve1d>& lat_trajectory) const;
 
   double LatComfortCost(
       const std::vector<apollo::common::FrenetFramePoint>& sl_points) const;
 
-  double LonComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double LonComfortCost(const std::vector<double>& jerks) const;
 
   double LonComfortCost(
       const std::vector<apollo::common::SpeedPoint>& st_points) const;
@@ -113,8 +142,8 @@ class TrajectoryEvaluator {
       const PlanningTarget& planning_target,
       const std::vector<double>& ref_s_dots) const;
 
-  double CentripetalAccelerationCost(
-      const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double CentripetalAccelerationCost(const std::vector<double>& s_values,
+                                     const std::vector<double>& s_dots) const;
 
   double CentripetalAccelerationCost(
       const std::vector<apollo::common::SpeedPoint>& st_points) const;
@@ -159,6 +188,9 @@ class TrajectoryEvaluator {
   std::array<double, 3> init_s_;
 
   std::vector<double> reference_s_dot_;
+
+  // The s values of the lateral offset cost, up to the decision horizon.
+  std::vector<double> s_values_;
 };
 
 }  // namespace planning
@@ -0,0 +1,376 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the CPU time of TrajectoryEvaluator, which evaluates each 1d
+ *        trajectory once, against the former evaluation of every pair of
+ *        trajectories, and checks that the pairs are ranked the same with the
+ *        same costs. The trajectories are sampled as Trajectory1dGenerator
+ *        does for cruising on a curvy reference line, without obstacles and
+ *        without a stop point.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/path_matcher.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/constraint_checker/constraint_checker1d.h"
+#include "modules/planning/lattice/behavior/path_time_graph.h"
+#include "modules/planning/lattice/trajectory1d/lattice_trajectory1d.h"
+#include "modules/planning/lattice/trajectory1d/piecewise_acceleration_trajectory1d.h"
+#include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+DEFINE_int32(benchmark_num_runs, 20, "Number of evaluations of the pairs.");
+DEFINE_int32(benchmark_num_lon_speeds, 10,
+             "Number of end speeds of the longitudinal trajectories.");
+DEFINE_int32(benchmark_num_lon_times, 9,
+             "Number of end times of the longitudinal trajectories.");
+
+namespace apollo {
+namespace planning {
+namespace {
+
+using apollo::common::PathPoint;
+using apollo::common::math::PathMatcher;
+using PtrTrajectory1d = std::shared_ptr<Curve1d>;
+using PairCost = std::pair<std::pair<PtrTrajectory1d, PtrTrajectory1d>, double>;
+// The ranked pairs, as indices of the trajectories, with their costs.
+using Ranking = std::vector<std::tuple<std::size_t, std::size_t, double>>;
+
+// The former evaluation of a pair of trajectories, which evaluates both
+// trajectories again for every pair.
+class FormerEvaluator {
+ public:
+  FormerEvaluator(
+      const std::vector<std::vector<std::pair<double, double>>>&
+          path_time_intervals,
+      const std::vector<double>& reference_s_dot,
+      const std::vector<PathPoint>& reference_line)
+      : path_time_intervals_(path_time_intervals),
+        reference_s_dot_(reference_s_dot),
+        reference_line_(reference_line) {}
+
+  double Evaluate(const PtrTrajectory1d& lon_trajectory,
+                  const PtrTrajectory1d& lat_trajectory) const {
+    double lon_objective_cost = LonObjectiveCost(lon_trajectory);
+    double lon_jerk_cost = LonComfortCost(lon_trajectory);
+    double lon_collision_cost = LonCollisionCost(lon_trajectory);
+    double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
+    double evaluation_horizon =
+        std::min(FLAGS_decision_horizon,
+                 lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
+    std::vector<double> s_values;
+    for (double s = 0.0; s < evaluation_horizon;
+         s += FLAGS_trajectory_space_resolution) {
+      s_values.emplace_back(s);
+    }
+    double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+    double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
+    return lon_objective_cost * FLAGS_weight_lon_objective +
+           lon_jerk_cost * FLAGS_weight_lon_jerk +
+           lon_collision_cost * FLAGS_weight_lon_collision +
+           centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
+           lat_offset_cost * FLAGS_weight_lat_offset +
+           lat_comfort_cost * FLAGS_weight_lat_comfort;
+  }
+
+ private:
+  double LatOffsetCost(const PtrTrajectory1d& lat_trajectory,
+                       const std::vector<double>& s_values) const {
+    double lat_offset_start = lat_trajectory->Evaluate(0, 0.0);
+    double cost_sqr_sum = 0.0;
+    double cost_abs_sum = 0.0;
+    for (const auto& s : s_values) {
+      double lat_offset = lat_trajectory->Evaluate(0, s);
+      double cost = lat_offset / FLAGS_lat_offset_bound;
+      if (lat_offset * lat_offset_start < 0.0) {
+        cost_sqr_sum += cost * cost * FLAGS_weight_opposite_side_offset;
+        cost_abs_sum += std::fabs(cost) * FLAGS_weight_opposite_side_offset;
+      } else {
+        cost_sqr_sum += cost * cost * FLAGS_weight_same_side_offset;
+        cost_abs_sum += std::fabs(cost) * FLAGS_weight_same_side_offset;
+      }
+    }
+    return cost_sqr_sum / (cost_abs_sum + FLAGS_lattice_epsilon);
+  }
+
+  double LatComfortCost(const PtrTrajectory1d& lon_trajectory,
+                        const PtrTrajectory1d& lat_trajectory) const {
+    double max_cost = 0.0;
+    for (double t = 0.0; t < FLAGS_trajectory_time_length;
+         t += FLAGS_trajectory_time_resolution) {
+      double s = lon_trajectory->Evaluate(0, t);
+      double s_dot = lon_trajectory->Evaluate(1, t);
+      double s_dotdot = lon_trajectory->Evaluate(2, t);
+      double l_prime = lat_trajectory->Evaluate(1, s);
+      double l_primeprime = lat_trajectory->Evaluate(2, s);
+      double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
+      max_cost = std::max(max_cost, std::fabs(cost));
+    }
+    return max_cost;
+  }
+
+  double LonComfortCost(const PtrTrajectory1d& lon_trajectory) const {
+    double cost_sqr_sum = 0.0;
+    double cost_abs_sum = 0.0;
+    for (double t = 0.0; t < FLAGS_trajectory_time_length;
+         t += FLAGS_trajectory_time_resolution) {
+      double jerk = lon_trajectory->Evaluate(3, t);
+      double cost = jerk / FLAGS_longitudinal_jerk_upper_bound;
+      cost_sqr_sum += cost * cost;
+      cost_abs_sum += std::fabs(cost);
+    }
+    return cost_sqr_sum / (cost_abs_sum + FLAGS_lattice_epsilon);
+  }
+
+  double LonObjectiveCost(const PtrTrajectory1d& lon_trajectory) const {
+    double t_max = lon_trajectory->ParamLength();
+    double dist_s =
+        lon_trajectory->Evaluate(0, t_max) - lon_trajectory->Evaluate(0, 0.0);
+    double speed_cost_sqr_sum = 0.0;
+    double speed_cost_weight_sum = 0.0;
+    for (std::size_t i = 0; i < reference_s_dot_.size(); ++i) {
+      double t = i * FLAGS_trajectory_time_resolution;
+      double cost = reference_s_dot_[i] - lon_trajectory->Evaluate(1, t);
+      speed_cost_sqr_sum += t * t * std::fabs(cost);
+      speed_cost_weight_sum += t * t;
+    }
+    double speed_cost =
+        speed_cost_sqr_sum / (speed_cost_weight_sum + FLAGS_lattice_epsilon);
+    double dist_travelled_cost = 1.0 / (1.0 + dist_s);
+    return (speed_cost * FLAGS_weight_target_speed +
+            dist_travelled_cost * FLAGS_weight_dist_travelled) /
+           (FLAGS_weight_target_speed + FLAGS_weight_dist_travelled);
+  }
+
+  double LonCollisionCost(const PtrTrajectory1d& lon_trajectory) const {
+    double cost_sqr_sum = 0.0;
+    double cost_abs_sum = 0.0;
+    for (std::size_t i = 0; i < path_time_intervals_.size(); ++i) {
+      const auto& pt_interval = path_time_intervals_[i];
+      if (pt_interval.empty()) {
+        continue;
+      }
+      double t = i * FLAGS_trajectory_time_resolution;
+      double traj_s = lon_trajectory->Evaluate(0, t);
+      double sigma = FLAGS_lon_collision_cost_std;
+      for (const auto& m : pt_interval) {
+        double dist = 0.0;
+        if (traj_s < m.first - FLAGS_lon_collision_yield_buffer) {
+          dist = m.first - FLAGS_lon_collision_yield_buffer - traj_s;
+        } else if (traj_s > m.second + FLAGS_lon_collision_overtake_buffer) {
+          dist = traj_s - m.second - FLAGS_lon_collision_overtake_buffer;
+        }
+        double cost = std::exp(-dist * dist / (2.0 * sigma * sigma));
+        cost_sqr_sum += cost * cost;
+        cost_abs_sum += cost;
+      }
+    }
+    return cost_sqr_sum / (cost_abs_sum + FLAGS_lattice_epsilon);
+  }
+
+  double CentripetalAccelerationCost(
+      const PtrTrajectory1d& lon_trajectory) const {
+    double centripetal_acc_sum = 0.0;
+    double centripetal_acc_sqr_sum = 0.0;
+    for (double t = 0.0; t < FLAGS_trajectory_time_length;
+         t += FLAGS_trajectory_time_resolution) {
+      double s = lon_trajectory->Evaluate(0, t);
+      double v = lon_trajectory->Evaluate(1, t);
+      PathPoint ref_point = PathMatcher::MatchToPath(reference_line_, s);
+      double centripetal_acc = v * v * ref_point.kappa();
+      centripetal_acc_sum += std::fabs(centripetal_acc);
+      centripetal_acc_sqr_sum += centripetal_acc * centripetal_acc;
+    }
+    return centripetal_acc_sqr_sum /
+           (centripetal_acc_sum + FLAGS_lattice_epsilon);
+  }
+
+  const std::vector<std::vector<std::pair<double, double>>>&
+      path_time_intervals_;
+  const std::vector<double>& reference_s_dot_;
+  const std::vector<PathPoint>& reference_line_;
+};
+
+struct CostComparator
+    : public std::binary_function<const PairCost&, const PairCost&, bool> {
+  bool operator()(const PairCost& left, const PairCost& right) const {
+    return left.second > right.second;
+  }
+};
+
+std::vector<PathPoint> CreateReferenceLine() {
+  std::vector<PathPoint> reference_line;
+  double x = 0.0;
+  double y = 0.0;
+  double theta = 0.0;
+  const double ds = 0.5;
+  for (int i = 0; i <= 800; ++i) {
+    const double s = i * ds;
+    const double kappa = 0.01 * std::sin(0.02 * s);
+    PathPoint point;
+    point.set_x(x);
+    point.set_y(y);
+    point.set_s(s);
+    point.set_theta(theta);
+    point.set_kappa(kappa);
+    point.set_dkappa(0.0002 * std::cos(0.02 * s));
+    reference_line.push_back(point);
+    x += ds * std::cos(theta);
+    y += ds * std::sin(theta);
+    theta += ds * kappa;
+  }
+  return reference_line;
+}
+
+std::size_t IndexOf(const std::vector<PtrTrajectory1d>& trajectories,
+                    const PtrTrajectory1d& trajectory) {
+  return std::find(trajectories.begin(), trajectories.end(), trajectory) -
+         trajectories.begin();
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+int Run() {
+  const std::array<double, 3> init_s = {0.0, 10.0, 0.0};
+  const std::array<double, 3> init_d = {0.3, 0.0, 0.0};
+  const double cruise_speed = 15.0;
+  PlanningTarget planning_target;
+  planning_target.set_cruise_speed(cruise_speed);
+
+  std::vector<PtrTrajectory1d> lon_trajectories;
+  for (int i = 0; i < FLAGS_benchmark_num_lon_speeds; ++i) {
+    const double v = cruise_speed * i / (FLAGS_benchmark_num_lon_speeds - 1);
+    for (int j = 1; j <= FLAGS_benchmark_num_lon_times; ++j) {
+      const double t = FLAGS_trajectory_time_length * j /
+                       FLAGS_benchmark_num_lon_times;
+      lon_trajectories.push_back(std::make_shared<LatticeTrajectory1d>(
+          PtrTrajectory1d(new QuarticPolynomialCurve1d(init_s, {v, 0.0}, t))));
+    }
+  }
+  std::vector<PtrTrajectory1d> lat_trajectories;
+  for (const double s : {10.0, 20.0, 40.0, 80.0}) {
+    for (const double d : {-0.5, 0.0, 0.5}) {
+      lat_trajectories.push_back(std::make_shared<LatticeTrajectory1d>(
+          PtrTrajectory1d(new QuinticPolynomialCurve1d(
+              init_d, {d, 0.0, 0.0}, s))));
+    }
+  }
+
+  auto reference_line =
+      std::make_shared<std::vector<PathPoint>>(CreateReferenceLine());
+  auto path_time_graph = std::make_shared<PathTimeGraph>(
+      std::vector<const Obstacle*>(), *reference_line, nullptr, init_s[0],
+      reference_line->back().s(), 0.0, FLAGS_trajectory_time_length, init_d);
+
+  // The guide velocity of cruising without a stop point.
+  PiecewiseAccelerationTrajectory1d guide_trajectory(init_s[0], cruise_speed);
+  guide_trajectory.AppendSegment(
+      0.0, FLAGS_trajectory_time_length + FLAGS_lattice_epsilon);
+  std::vector<double> reference_s_dot;
+  for (double t = 0.0; t < FLAGS_trajectory_time_length;
+       t += FLAGS_trajectory_time_resolution) {
+    reference_s_dot.push_back(guide_trajectory.Evaluate(1, t));
+  }
+  const auto path_time_intervals = path_time_graph->GetPathBlockingIntervals(
+      0.0, FLAGS_trajectory_time_length, FLAGS_trajectory_time_resolution);
+  const FormerEvaluator former_evaluator(path_time_intervals, reference_s_dot,
+                                         *reference_line);
+
+  Ranking former_ranking;
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < FLAGS_benchmark_num_runs; ++run) {
+    std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
+        cost_queue;
+    for (const auto& lon_trajectory : lon_trajectories) {
+      if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(
+              *lon_trajectory)) {
+        continue;
+      }
+      for (const auto& lat_trajectory : lat_trajectories) {
+        cost_queue.emplace(std::make_pair(lon_trajectory, lat_trajectory),
+                           former_evaluator.Evaluate(lon_trajectory,
+                                                     lat_trajectory));
+      }
+    }
+    former_ranking.clear();
+    while (!cost_queue.empty()) {
+      const PairCost& top = cost_queue.top();
+      former_ranking.emplace_back(IndexOf(lon_trajectories, top.first.first),
+                                  IndexOf(lat_trajectories, top.first.second),
+                                  top.second);
+      cost_queue.pop();
+    }
+  }
+  const double former_ms = ElapsedMs(start);
+
+  Ranking ranking;
+  start = std::chrono::steady_clock::now();
+  for (int run = 0; run < FLAGS_benchmark_num_runs; ++run) {
+    TrajectoryEvaluator evaluator(init_s, planning_target, lon_trajectories,
+                                  lat_trajectories, path_time_graph,
+                                  reference_line);
+    ranking.clear();
+    while (evaluator.has_more_trajectory_pairs()) {
+      const double cost = evaluator.top_trajectory_pair_cost();
+      const auto pair = evaluator.next_top_trajectory_pair();
+      ranking.emplace_back(IndexOf(lon_trajectories, pair.first),
+                           IndexOf(lat_trajectories, pair.second), cost);
+    }
+  }
+  const double evaluator_ms = ElapsedMs(start);
+
+  const int num_runs = FLAGS_benchmark_num_runs;
+  std::cout << "lon trajectories: " << lon_trajectories.size()
+            << ", lat trajectories: " << lat_trajectories.size()
+            << ", ranked pairs: " << ranking.size() << std::endl
+            << std::fixed << std::setprecision(3)
+            << "pairwise evaluation: " << former_ms / num_runs << " ms/run"
+            << std::endl
+            << "TrajectoryEvaluator: " << evaluator_ms / num_runs << " ms/run"
+            << std::endl
+            << "same ranking: " << (ranking == former_ranking ? "yes" : "no")
+            << std::endl;
+  return ranking == former_ranking ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::Run();
+}
@@ -127,7 +127,7 @@ int NaviObstacleDecider::ProcessPathObstacle(
       }
     }
 
-    const auto* dest_ptr = path_decision.Find(current_obstacle->Id());
+    const auto* dest_ptr = path_decision.Find(current_obstacle->Handle());
 
     if (fabs(dest_ptr->PerceptionSLBoundary().start_l()) <
         (min_lane_width / 2)) {
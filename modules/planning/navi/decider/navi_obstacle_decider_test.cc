@@ -52,6 +52,7 @@ TEST(NaviObstacleDeciderTest, ComputeNudgeDist1) {
   perception_obstacle.mutable_position()->set_x(2.0);
   perception_obstacle.mutable_position()->set_y(1.0);
   Obstacle b1("1", perception_obstacle);
+  b1.SetHandle(0);
 
   PathPoint p1 = MakePathPoint(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
   p1.set_s(0.0);
@@ -87,6 +88,7 @@ TEST(NaviObstacleDeciderTest, ComputeNudgeDist2) {
   perception_obstacle.mutable_position()->set_x(-2.0);
   perception_obstacle.mutable_position()->set_y(1.0);
   Obstacle b1("1", perception_obstacle);
+  b1.SetHandle(0);
   obstacle_boundary.set_start_l(1.7);
   PathObstacle path_obstacles(&b1);
   path_obstacles.SetPerceptionSlBoundary(obstacle_boundary);
@@ -123,6 +125,7 @@ TEST(NaviObstacleDeciderTest, ComputeNudgeDist3) {
   perception_obstacle.mutable_position()->set_x(3.0);
   perception_obstacle.mutable_position()->set_y(0.0);
   Obstacle b1("1", perception_obstacle);
+  b1.SetHandle(0);
   obstacle_boundary.set_start_l(1.6);
   PathObstacle path_obstacles1(&b1);
   path_obstacles1.SetPerceptionSlBoundary(obstacle_boundary);
@@ -134,6 +137,7 @@ TEST(NaviObstacleDeciderTest, ComputeNudgeDist3) {
   perception_obstacle.mutable_position()->set_x(4.0);
   perception_obstacle.mutable_position()->set_y(0.0);
   Obstacle b2("2", perception_obstacle);
+  b2.SetHandle(1);
   obstacle_boundary.set_start_l(1.5);
   PathObstacle path_obstacles2(&b2);
   path_obstacles2.SetPerceptionSlBoundary(obstacle_boundary);
@@ -17,6 +17,7 @@
 #include "modules/planning/planner/em/em_planner.h"
 
 #include <fstream>
+#include <future>
 #include <limits>
 #include <utility>
 
@@ -79,24 +80,44 @@ Status EMPlanner::Init(const PlanningConfig& config) {
   AINFO << "In EMPlanner::Init()";
   // 注册任务工厂
   RegisterTasks();
+  config_ = config;
+  tasks_.emplace_back();
+  return CreateTasks(&tasks_.back());
+}
+
+Status EMPlanner::CreateTasks(std::vector<std::unique_ptr<Task>>* tasks) {
   // 任务工厂生成对应的任务产品
-  for (const auto task : config.em_planner_config().task()) {
-    tasks_.emplace_back(
+  for (const auto task : config_.em_planner_config().task()) {
+    tasks->emplace_back(
         task_factory_.CreateObject(static_cast<TaskType>(task)));
-    AINFO << "Created task:" << tasks_.back()->Name();
+    AINFO << "Created task:" << tasks->back()->Name();
   }
   // 任务产品初始化
-  for (auto& task : tasks_) {
-    if (!task->Init(config)) {
+  for (auto& task : *tasks) {
+    if (!task->Init(config_)) {
       std::string msg(
           common::util::StrCat("Init task[", task->Name(), "] failed."));
       AERROR << msg;
       return Status(ErrorCode::PLANNING_ERROR, msg);
     }
   }
+  if (task_wrapper_) {
+    for (auto& task : *tasks) {
+      task = task_wrapper_(std::move(task));
+    }
+  }
   return Status::OK();
 }
 
+void EMPlanner::WrapTasks(const TaskWrapper& wrapper) {
+  task_wrapper_ = wrapper;
+  for (auto& tasks : tasks_) {
+    for (auto& task : tasks) {
+      task = task_wrapper_(std::move(task));
+    }
+  }
+}
+
 void EMPlanner::RecordObstacleDebugInfo(
     ReferenceLineInfo* reference_line_info) {
   if (!FLAGS_enable_record_debug) {
@@ -151,8 +172,46 @@ Status EMPlanner::Plan(const TrajectoryPoint& planning_start_point,
   auto status =
       Status(ErrorCode::PLANNING_ERROR, "reference line not drivable");
 
-  // 从frame中取出每一条reference_line_info来进行规划
+  std::vector<ReferenceLineInfo*> reference_line_infos;
   for (auto& reference_line_info : frame->reference_line_info()) {
+    reference_line_infos.push_back(&reference_line_info);
+  }
+
+  // Each reference line has its own tasks, path decision, path and speed
+  // data, so the lines are planned concurrently. The results are collected
+  // in the order of the lines, so the selection below is the same as when
+  // the lines are planned one by one.
+  const bool plan_in_parallel = FLAGS_enable_multi_thread_in_em_planner &&
+                                reference_line_infos.size() > 1;
+  std::vector<std::future<Status>> futures(reference_line_infos.size());
+  if (plan_in_parallel) {
+    while (tasks_.size() < reference_line_infos.size()) {
+      tasks_.emplace_back();
+      auto create_status = CreateTasks(&tasks_.back());
+      if (!create_status.ok()) {
+        tasks_.pop_back();
+        return create_status;
+      }
+    }
+    for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+      if (reference_line_infos[i]->IsDrivable()) {
+        futures[i] = std::async(
+            std::launch::async,
+            [this, &planning_start_point, frame, &reference_line_infos, i]() {
+              return PlanOnReferenceLine(planning_start_point, frame,
+                                         reference_line_infos[i], &tasks_[i]);
+            });
+      }
+    }
+  }
+
+  // 从frame中取出每一条reference_line_info来进行规划
+  for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+    auto& reference_line_info = *reference_line_infos[i];
+    auto cur_status = Status::OK();
+    if (futures[i].valid()) {
+      cur_status = futures[i].get();
+    }
     if (disable_low_priority_path) {
       reference_line_info.SetDrivable(false);
     }
@@ -161,8 +220,10 @@ Status EMPlanner::Plan(const TrajectoryPoint& planning_start_point,
       continue;
     }
 	// 进行规划
-    auto cur_status =
-        PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+    if (!plan_in_parallel) {
+      cur_status = PlanOnReferenceLine(planning_start_point, frame,
+                                       &reference_line_info, &tasks_.front());
+    }
 	// 如果基于当前循环的reference_line_info_规划成功，且reference_line_info_本身是IsDriveable()
     if (cur_status.ok() && reference_line_info.IsDrivable()) {
       has_drivable_reference_line = true;
@@ -181,6 +242,29 @@ Status EMPlanner::Plan(const TrajectoryPoint& planning_start_point,
 Status EMPlanner::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             &tasks_.front());
+}
+
+Status EMPlanner::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info,
+    std::vector<std::unique_ptr<Task>>* tasks) {
+  const double start_timestamp = Clock::NowInSeconds();
+  auto status = PlanTasksOnReferenceLine(planning_start_point, frame,
+                                         reference_line_info, tasks);
+  const double time_diff_ms = (Clock::NowInSeconds() - start_timestamp) * 1000;
+  reference_line_info->mutable_latency_stats()->set_total_time_ms(
+      time_diff_ms);
+  ADEBUG << "Reference line [" << reference_line_info->Lanes().Id()
+         << "] time spend: " << time_diff_ms << " ms.";
+  return status;
+}
+
+Status EMPlanner::PlanTasksOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info,
+    std::vector<std::unique_ptr<Task>>* tasks) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }// 如果不是换道参考线,那么要将该条参考线增加直行cost
@@ -201,7 +285,7 @@ Status EMPlanner::PlanOnReferenceLine(
 
   auto ret = Status::OK();
   // 各个任务产品开始执行(已在Init中完成了初始化)
-  for (auto& optimizer : tasks_) {
+  for (auto& optimizer : *tasks) {
     const double start_timestamp = Clock::NowInSeconds();
 	// 执行任务产品:dp_poly_path,path_decider,dp_st_speed_optimizer
     ret = optimizer->Execute(frame, reference_line_info);
@@ -17,6 +17,7 @@
 #ifndef MODULES_PLANNING_PLANNER_EM_EM_PLANNER_H_
 #define MODULES_PLANNING_PLANNER_EM_EM_PLANNER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -48,6 +49,9 @@ namespace planning {
 
 class EMPlanner : public Planner {
  public:
+  typedef std::function<std::unique_ptr<Task>(std::unique_ptr<Task>)>
+      TaskWrapper;
+
   /**
    * @brief Constructor
    */
@@ -81,9 +85,29 @@ class EMPlanner : public Planner {
       const common::TrajectoryPoint& planning_init_point, Frame* frame,
       ReferenceLineInfo* reference_line_info) override;
 
+  /**
+   * @brief Replaces each task with a wrapper of it, e.g. to profile the
+   * tasks in tools. The tasks created later for more reference lines are
+   * wrapped as well.
+   * @param wrapper Takes a task and returns its replacement.
+   */
+  void WrapTasks(const TaskWrapper& wrapper);
+
  private:
   void RegisterTasks();
 
+  common::Status CreateTasks(std::vector<std::unique_ptr<Task>>* tasks);
+
+  common::Status PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_init_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      std::vector<std::unique_ptr<Task>>* tasks);
+
+  common::Status PlanTasksOnReferenceLine(
+      const common::TrajectoryPoint& planning_init_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      std::vector<std::unique_ptr<Task>>* tasks);
+
   std::vector<common::SpeedPoint> GenerateInitSpeedProfile(
       const common::TrajectoryPoint& planning_init_point,
       const ReferenceLineInfo* reference_line_info);
@@ -117,7 +141,11 @@ class EMPlanner : public Planner {
                        const std::string& name, const double time_diff_ms);
 
   apollo::common::util::Factory<TaskType, Task> task_factory_;
-  std::vector<std::unique_ptr<Task>> tasks_;
+  PlanningConfig config_;
+  // The tasks of each reference line planned concurrently. Only the first
+  // list is used when the reference lines are planned one by one.
+  std::vector<std::vector<std::unique_ptr<Task>>> tasks_;
+  TaskWrapper task_wrapper_;
 };
 
 }  // namespace planning
@@ -32,6 +32,7 @@
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/collision_checker.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
@@ -132,6 +133,7 @@ Status LatticePlanner::Plan(const TrajectoryPoint& planning_start_point,
 Status LatticePlanner::PlanOnReferenceLine(
     const TrajectoryPoint& planning_init_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  TRACE_SPAN("LatticePlanner::PlanOnReferenceLine");
   static std::size_t num_planning_cycles = 0;
   static std::size_t num_planning_succeeded_cycles = 0;
 
@@ -449,11 +451,14 @@ bool LatticePlanner::MapFutureTrajectoryToSL(
     AERROR << "MapFutureTrajectoryToSL error";
     return false;
   }
+  // The future trajectory points move along the reference line.
+  auto path_cursor = PathMatcher::CreatePathCursor(discretized_reference_line);
   for (const common::TrajectoryPoint& trajectory_point :
        future_trajectory.trajectory_points()) {
     const PathPoint& path_point = trajectory_point.path_point();
-    PathPoint matched_point = PathMatcher::MatchToPath(
-        discretized_reference_line, path_point.x(), path_point.y());
+    PathPoint matched_point =
+        PathMatcher::MatchToPath(discretized_reference_line, path_point.x(),
+                                 path_point.y(), &path_cursor);
     std::array<double, 3> pose_s;
     std::array<double, 3> pose_d;
     ComputeInitFrenetState(matched_point, trajectory_point, &pose_s, &pose_d);
@@ -25,6 +25,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -48,6 +49,7 @@ using apollo::common::VehicleState;
 using apollo::common::VehicleStateProvider;
 using apollo::common::adapter::AdapterManager;
 using apollo::common::time::Clock;
+using apollo::common::trace::ScopedSpan;
 using apollo::hdmap::HDMapUtil;
 
 Planning::~Planning() { Stop(); }
@@ -219,6 +221,13 @@ void Planning::PublishPlanningPb(ADCTrajectory* trajectory_pb,
                                  double timestamp) {
   // 赋值消息头
   trajectory_pb->mutable_header()->set_timestamp_sec(timestamp);
+  // Carry the sensor timestamps for end-to-end latency tracing.
+  if (AdapterManager::GetPrediction() &&
+      !AdapterManager::GetPrediction()->Empty()) {
+    apollo::common::trace::PropagateOrigin(
+        AdapterManager::GetPrediction()->GetLatestObserved().header(),
+        trajectory_pb->mutable_header());
+  }
   // TODO(all): integrate reverse gear
   // 赋值挡位
   trajectory_pb->set_gear(canbus::Chassis::GEAR_DRIVE);
@@ -250,8 +259,14 @@ void Planning::PublishPlanningPb(ADCTrajectory* trajectory_pb,
 }
 
 void Planning::RunOnce() {
+  ScopedSpan span("Planning::RunOnce");
   // snapshot all coming data
   AdapterManager::Observe();
+  if (AdapterManager::GetPrediction() &&
+      !AdapterManager::GetPrediction()->Empty()) {
+    span.SetOrigin(
+        AdapterManager::GetPrediction()->GetLatestObserved().header());
+  }
 
   const double start_timestamp = Clock::NowInSeconds();
 
@@ -568,6 +583,7 @@ void Planning::ExportReferenceLineDebug(planning_internal::Debug* debug) {
     rl_debug->set_is_drivable(reference_line_info.IsDrivable());
     rl_debug->set_is_protected(reference_line_info.GetRightOfWayStatus() ==
                                ADCTrajectory::PROTECTED);
+    rl_debug->set_time_ms(reference_line_info.latency_stats().total_time_ms());
   }
 }
 
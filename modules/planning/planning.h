@@ -87,6 +87,11 @@ class Planning : public apollo::common::ApolloApp {
    */
   void SetLastPublishableTrajectory(const ADCTrajectory& adc_trajectory);
 
+  /**
+   * @brief the planner created by Init(), for the tools which instrument it
+   */
+  Planner* planner() { return planner_.get(); }
+
  private:
   // Watch dog timer
   void OnTimer(const ros::TimerEvent&);
@@ -118,8 +118,9 @@ bool ReferenceLine::Stitch(const ReferenceLine& other) {
     reference_points_.insert(reference_points_.end(),
                              other_points.begin() + end_i, other_points.end());
   }
-  map_path_ = MapPath(std::move(std::vector<hdmap::MapPathPoint>(
-      reference_points_.begin(), reference_points_.end())));
+  map_path_ = MapPath(map_path_, std::vector<hdmap::MapPathPoint>(
+                                     reference_points_.begin(),
+                                     reference_points_.end()));
   return true;
 }
 
@@ -167,8 +168,9 @@ bool ReferenceLine::Shrink(const common::math::Vec2d& point,
     AERROR << "Too few reference points after shrinking.";
     return false;
   }
-  map_path_ = MapPath(std::move(std::vector<hdmap::MapPathPoint>(
-      reference_points_.begin(), reference_points_.end())));
+  map_path_ = MapPath(map_path_, std::vector<hdmap::MapPathPoint>(
+                                     reference_points_.begin(),
+                                     reference_points_.end()));
   return true;
 }
 
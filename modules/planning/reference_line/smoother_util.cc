@@ -18,13 +18,16 @@
  * @file
  **/
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "gflags/gflags.h"
 #include "modules/common/log.h"
 #include "modules/common/math/vec2d.h"
+#include "modules/common/time/time.h"
 #include "modules/common/util/util.h"
 #include "modules/map/pnc_map/path.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -41,6 +44,7 @@ namespace planning {
 
 using common::math::LineSegment2d;
 using common::math::Vec2d;
+using common::time::Clock;
 using common::util::DistanceXY;
 using hdmap::MapPathPoint;
 
@@ -62,6 +66,9 @@ class SmootherUtil {
                                          &config_))
         << "Failed to read smoother config file: "
         << FLAGS_smoother_config_filename;
+    // The same smoother smooths all the windows, like the reference line
+    // provider does, so it may warm start from the previous window.
+    smoother_ = std::make_unique<SpiralReferenceLineSmoother>(config_);
   }
 
   bool Smooth() {
@@ -80,15 +87,11 @@ class SmootherUtil {
         s += segment.length();
       }
       ReferenceLine init_ref(ref_points);
-      // Prefer "std::make_unique" to direct use of "new".
-      // Reference "https://herbsutter.com/gotw/_102/" for details.
-      auto smoother_ptr =
-          std::make_unique<SpiralReferenceLineSmoother>(config_);
       auto anchors =
           CreateAnchorPoints(init_ref.reference_points().front(), init_ref);
-      smoother_ptr->SetAnchorPoints(anchors);
+      smoother_->SetAnchorPoints(anchors);
       ReferenceLine smoothed_init_ref;
-      if (!smoother_ptr->Smooth(init_ref, &smoothed_init_ref)) {
+      if (!smoother_->Smooth(init_ref, &smoothed_init_ref)) {
         AERROR << "smooth initial reference line failed";
         return false;
       }
@@ -122,20 +125,30 @@ class SmootherUtil {
       i = j;
       ReferenceLine local_ref(ref_points);
       auto anchors = CreateAnchorPoints(ref_points.front(), local_ref);
-      // Prefer "std::make_unique" to direct use of "new".
-      // Reference "https://herbsutter.com/gotw/_102/" for details.
-      auto smoother_ptr =
-          std::make_unique<SpiralReferenceLineSmoother>(config_);
-      smoother_ptr->SetAnchorPoints(anchors);
+      smoother_->SetAnchorPoints(anchors);
       ReferenceLine smoothed_local_ref;
-      if (!smoother_ptr->Smooth(local_ref, &smoothed_local_ref)) {
+      const double start_timestamp = Clock::NowInSeconds();
+      if (!smoother_->Smooth(local_ref, &smoothed_local_ref)) {
         AERROR << "Failed to smooth reference line";
         return false;
       }
+      window_time_ms_.push_back((Clock::NowInSeconds() - start_timestamp) *
+                                1000.0);
       ref_points_.insert(ref_points_.end(),
                          smoothed_local_ref.reference_points().begin(),
                          smoothed_local_ref.reference_points().end());
     }
+    if (!window_time_ms_.empty()) {
+      double total_time_ms = 0.0;
+      for (const double time_ms : window_time_ms_) {
+        total_time_ms += time_ms;
+      }
+      AINFO << "Smoothed " << window_time_ms_.size() << " windows, mean "
+            << total_time_ms / window_time_ms_.size() << " ms, max "
+            << *std::max_element(window_time_ms_.begin(),
+                                 window_time_ms_.end())
+            << " ms.";
+    }
     return true;
   }
 
@@ -213,6 +226,8 @@ class SmootherUtil {
   std::vector<ReferencePoint> ref_points_;
   ReferenceLine smoothed_ref_;
   ReferenceLineSmootherConfig config_;
+  std::unique_ptr<SpiralReferenceLineSmoother> smoother_;
+  std::vector<double> window_time_ms_;
 };
 
 }  // namespace planning
@@ -58,6 +58,8 @@ SpiralProblemInterface::SpiralProblemInterface(
   }
 
   piecewise_paths_.resize(num_of_points_ - 1);
+  has_warm_start_point_.resize(num_of_points_, false);
+  warm_start_points_.resize(num_of_points_);
 }
 
 void SpiralProblemInterface::get_optimization_results(
@@ -247,6 +249,18 @@ bool SpiralProblemInterface::get_starting_point(int n, bool init_x, double* x,
   }
   x[1] = x[6];
 
+  for (std::size_t i = 0; i < num_of_points_; ++i) {
+    if (!has_warm_start_point_[i]) {
+      continue;
+    }
+    std::size_t index = i * 5;
+    const Eigen::Vector3d& point = warm_start_points_[i];
+    x[index] = relative_theta_[i] +
+               common::math::AngleDiff(relative_theta_[i], point[0]);
+    x[index + 1] = point[1];
+    x[index + 2] = point[2];
+  }
+
   if (has_fixed_start_point_) {
     x[0] = start_theta_;
     x[1] = start_kappa_;
@@ -864,6 +878,15 @@ void SpiralProblemInterface::set_end_point_position(const double x,
   end_y_ = y;
 }
 
+void SpiralProblemInterface::set_warm_start_point(const std::size_t i,
+                                                  const double theta,
+                                                  const double kappa,
+                                                  const double dkappa) {
+  CHECK_LT(i, num_of_points_);
+  has_warm_start_point_[i] = true;
+  warm_start_points_[i] << theta, kappa, dkappa;
+}
+
 void SpiralProblemInterface::set_element_weight_curve_length(
     const double weight_curve_length) {
   weight_curve_length_ = weight_curve_length;
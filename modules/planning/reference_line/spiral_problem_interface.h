@@ -47,6 +47,11 @@ class SpiralProblemInterface : public Ipopt::TNLP {
 
   void set_end_point_position(const double x, const double y);
 
+  // Initial guess of the heading and curvature at point i, e.g., from the
+  // solution of the previous planning cycle.
+  void set_warm_start_point(const std::size_t i, const double theta,
+                            const double kappa, const double dkappa);
+
   void set_element_weight_curve_length(const double weight_curve_length);
 
   void set_element_weight_kappa(const double weight_kappa);
@@ -143,6 +148,10 @@ class SpiralProblemInterface : public Ipopt::TNLP {
 
   std::vector<double> relative_theta_;
 
+  std::vector<bool> has_warm_start_point_;
+
+  std::vector<Eigen::Vector3d> warm_start_points_;
+
   std::vector<QuinticSpiralPath> piecewise_paths_;
 
   bool has_fixed_start_point_ = false;
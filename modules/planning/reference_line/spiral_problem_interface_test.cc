@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/reference_line/spiral_problem_interface.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(SpiralProblemInterface, WarmStartPoint) {
+  std::vector<Eigen::Vector2d> points = {
+      {0.0, 0.0}, {10.0, 0.0}, {20.0, 1.0}, {30.0, 3.0}};
+  SpiralProblemInterface problem(points);
+  problem.set_warm_start_point(1, 0.05 + 2.0 * M_PI, 0.01, 0.001);
+
+  int n = 0;
+  int m = 0;
+  int nnz_jac_g = 0;
+  int nnz_h_lag = 0;
+  Ipopt::TNLP::IndexStyleEnum index_style;
+  ASSERT_TRUE(problem.get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style));
+  std::vector<double> x(n, 0.0);
+  ASSERT_TRUE(problem.get_starting_point(n, true, x.data(), false, nullptr,
+                                         nullptr, m, false, nullptr));
+
+  // The warm start heading is unwrapped to the initial heading of the point.
+  EXPECT_NEAR(0.05, x[5], 1e-9);
+  EXPECT_NEAR(0.01, x[6], 1e-9);
+  EXPECT_NEAR(0.001, x[7], 1e-9);
+
+  // Other points keep the initial guess from the raw points.
+  EXPECT_NEAR(std::atan2(2.0, 10.0), x[10], 1e-9);
+  EXPECT_NEAR(0.0, x[12], 1e-9);
+  EXPECT_NEAR(20.0, x[13], 1e-9);
+  EXPECT_NEAR(1.0, x[14], 1e-9);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -25,23 +25,43 @@
 #include <limits>
 #include <utility>
 
-#include "IpIpoptApplication.hpp"
 #include "IpSolveStatistics.hpp"
 
 #include "modules/common/time/time.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/math/curve1d/quintic_spiral_path.h"
-#include "modules/planning/reference_line/spiral_problem_interface.h"
 
 namespace apollo {
 namespace planning {
 
 using apollo::common::time::Clock;
 
+namespace {
+
+// Warm start points further than this from the last solution are not used.
+constexpr double kMaxWarmStartDistance = 0.5;
+
+}  // namespace
+
 SpiralReferenceLineSmoother::SpiralReferenceLineSmoother(
     const ReferenceLineSmootherConfig& config)
     : ReferenceLineSmoother(config) {
   default_max_point_deviation_ = config.spiral().max_deviation();
+
+  app_ = IpoptApplicationFactory();
+  app_->Options()->SetStringValue("hessian_approximation", "limited-memory");
+  app_->Options()->SetIntegerValue("print_level", 0);
+  app_->Options()->SetIntegerValue("max_iter",
+                                   config_.spiral().max_iteration());
+  app_->Options()->SetIntegerValue("acceptable_iter",
+                                   config_.spiral().opt_acceptable_iteration());
+  app_->Options()->SetNumericValue("tol", config_.spiral().opt_tol());
+  app_->Options()->SetNumericValue("acceptable_tol",
+                                   config_.spiral().opt_acceptable_tol());
+  if (app_->Initialize() != Ipopt::Solve_Succeeded) {
+    AERROR << "Failed to initialize Ipopt for spiral smoother.";
+    app_ = nullptr;
+  }
 }
 
 bool SpiralReferenceLineSmoother::Smooth(
@@ -54,6 +74,8 @@ bool SpiralReferenceLineSmoother::Smooth(
   std::vector<double> opt_kappa;
   std::vector<double> opt_dkappa;
   std::vector<double> opt_s;
+  bool solved = false;
+  fixed_start_point_ = false;
 
   if (anchor_points_.empty()) {
     const double piecewise_length = config_.spiral().piecewise_length();
@@ -72,8 +94,8 @@ bool SpiralReferenceLineSmoother::Smooth(
       raw_point2d.emplace_back(rlp.x(), rlp.y());
     }
 
-    Smooth(raw_point2d, &opt_theta, &opt_kappa, &opt_dkappa, &opt_s, &opt_x,
-           &opt_y);
+    solved = Smooth(raw_point2d, &opt_theta, &opt_kappa, &opt_dkappa, &opt_s,
+                    &opt_x, &opt_y);
   } else {
     std::size_t start_index = 0;
     for (const auto& anchor_point : anchor_points_) {
@@ -129,8 +151,8 @@ bool SpiralReferenceLineSmoother::Smooth(
       fixed_end_x_ = end_anchor_point.path_point.x();
       fixed_end_y_ = end_anchor_point.path_point.y();
 
-      Smooth(raw_point2d, &opt_theta, &opt_kappa, &opt_dkappa, &opt_s, &opt_x,
-             &opt_y);
+      solved = Smooth(raw_point2d, &opt_theta, &opt_kappa, &opt_dkappa, &opt_s,
+                      &opt_x, &opt_y);
 
       opt_theta.insert(opt_theta.begin(), overhead_theta.begin(),
                        overhead_theta.end());
@@ -153,6 +175,9 @@ bool SpiralReferenceLineSmoother::Smooth(
   std::vector<common::PathPoint> smoothed_point2d =
       Interpolate(opt_theta, opt_kappa, opt_dkappa, opt_s, opt_x, opt_y,
                   config_.resolution());
+  if (solved && config_.spiral().warm_start()) {
+    last_smoothed_points_ = smoothed_point2d;
+  }
 
   std::vector<ReferencePoint> ref_points;
   for (const auto& p : smoothed_point2d) {
@@ -211,36 +236,26 @@ bool SpiralReferenceLineSmoother::Smooth(std::vector<Eigen::Vector2d> point2d,
   ptop->set_element_weight_kappa(config_.spiral().opt_weight_kappa());
   ptop->set_element_weight_dkappa(config_.spiral().opt_weight_dkappa());
   ptop->set_element_weight_d2kappa(config_.spiral().opt_weight_d2kappa());
+  if (!anchor_points_.empty() && !last_smoothed_points_.empty()) {
+    SetWarmStartPoints(point2d, ptop);
+  }
 
   Ipopt::SmartPtr<Ipopt::TNLP> problem = ptop;
 
-  // Create an instance of the IpoptApplication
-  Ipopt::SmartPtr<Ipopt::IpoptApplication> app = IpoptApplicationFactory();
-
-  app->Options()->SetStringValue("hessian_approximation", "limited-memory");
-  app->Options()->SetIntegerValue("print_level", 0);
-  app->Options()->SetIntegerValue("max_iter", config_.spiral().max_iteration());
-  app->Options()->SetIntegerValue("acceptable_iter",
-                                  config_.spiral().opt_acceptable_iteration());
-  app->Options()->SetNumericValue("tol", config_.spiral().opt_tol());
-  app->Options()->SetNumericValue("acceptable_tol",
-                                  config_.spiral().opt_acceptable_tol());
-
-  Ipopt::ApplicationReturnStatus status = app->Initialize();
-  if (status != Ipopt::Solve_Succeeded) {
+  if (Ipopt::IsNull(app_)) {
     ADEBUG << "*** Error during initialization!";
     return false;
   }
 
-  status = app->OptimizeTNLP(problem);
+  Ipopt::ApplicationReturnStatus status = app_->OptimizeTNLP(problem);
 
   if (status == Ipopt::Solve_Succeeded ||
       status == Ipopt::Solved_To_Acceptable_Level) {
     // Retrieve some statistics about the solve
-    Ipopt::Index iter_count = app->Statistics()->IterationCount();
+    Ipopt::Index iter_count = app_->Statistics()->IterationCount();
     ADEBUG << "*** The problem solved in " << iter_count << " iterations!";
 
-    Ipopt::Number final_obj = app->Statistics()->FinalObjective();
+    Ipopt::Number final_obj = app_->Statistics()->FinalObjective();
     ADEBUG << "*** The final value of the objective function is " << final_obj
            << '.';
   } else {
@@ -254,6 +269,32 @@ bool SpiralReferenceLineSmoother::Smooth(std::vector<Eigen::Vector2d> point2d,
          status == Ipopt::Solved_To_Acceptable_Level;
 }
 
+void SpiralReferenceLineSmoother::SetWarmStartPoints(
+    const std::vector<Eigen::Vector2d>& point2d,
+    SpiralProblemInterface* const problem) const {
+  // Both the points and the last smoothed points are ordered along the
+  // reference line, so the nearest last smoothed point only moves forward.
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < point2d.size(); ++i) {
+    const double x = point2d[i].x() + zero_x_;
+    const double y = point2d[i].y() + zero_y_;
+    auto square_distance = [&](const std::size_t j) {
+      const auto& p = last_smoothed_points_[j];
+      return (p.x() - x) * (p.x() - x) + (p.y() - y) * (p.y() - y);
+    };
+    while (index + 1 < last_smoothed_points_.size() &&
+           square_distance(index + 1) <= square_distance(index)) {
+      ++index;
+    }
+    if (square_distance(index) >
+        kMaxWarmStartDistance * kMaxWarmStartDistance) {
+      continue;
+    }
+    const auto& p = last_smoothed_points_[index];
+    problem->set_warm_start_point(i, p.theta(), p.kappa(), p.dkappa());
+  }
+}
+
 std::vector<common::PathPoint> SpiralReferenceLineSmoother::Interpolate(
     const std::vector<double>& theta, const std::vector<double>& kappa,
     const std::vector<double>& dkappa, const std::vector<double>& s,
@@ -24,12 +24,14 @@
 #include <vector>
 
 #include "Eigen/Dense"
+#include "IpIpoptApplication.hpp"
 
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/planning/reference_line/reference_line.h"
 #include "modules/planning/reference_line/reference_line_smoother.h"
 #include "modules/planning/reference_line/reference_point.h"
+#include "modules/planning/reference_line/spiral_problem_interface.h"
 
 namespace apollo {
 namespace planning {
@@ -52,6 +54,11 @@ class SpiralReferenceLineSmoother : public ReferenceLineSmoother {
               std::vector<double>* ptr_dkappa, std::vector<double>* ptr_s,
               std::vector<double>* ptr_x, std::vector<double>* ptr_y) const;
 
+  // Initialize the heading and curvature of the points (in the frame of the
+  // anchor points) from the solution of the last call.
+  void SetWarmStartPoints(const std::vector<Eigen::Vector2d>& point2d,
+                          SpiralProblemInterface* const problem) const;
+
   std::vector<common::PathPoint> Interpolate(const std::vector<double>& theta,
                                              const std::vector<double>& kappa,
                                              const std::vector<double>& dkappa,
@@ -94,6 +101,12 @@ class SpiralReferenceLineSmoother : public ReferenceLineSmoother {
   double zero_x_ = 0.0;
 
   double zero_y_ = 0.0;
+
+  // Reused by all calls, so Ipopt is only initialized once.
+  Ipopt::SmartPtr<Ipopt::IpoptApplication> app_;
+
+  // The smoothed points of the last successful call in the world frame.
+  std::vector<common::PathPoint> last_smoothed_points_;
 };
 
 }  // namespace planning
@@ -58,6 +58,7 @@ TrajectoryCost::TrajectoryCost(
    //  config.eval_time_interval()是障碍物预测中所使用的时间步长=0.1s
   num_of_time_stamps_ = static_cast<uint32_t>(
       std::floor(total_time / config.eval_time_interval()));
+  dynamic_obstacle_boxes_.resize(num_of_time_stamps_ + 1);
    // 遍历每一个障碍物
   for (const auto *ptr_path_obstacle : obstacles) {
   	// 如果是无人车可忽略的障碍物，这里就不需要考虑。因为其对无人车前进无影响；
@@ -97,7 +98,6 @@ TrajectoryCost::TrajectoryCost(
                is_bycycle_or_pedestrian) {
       static_obstacle_sl_boundaries_.push_back(std::move(sl_boundary));
     } else {
-      std::vector<Box2d> box_by_time;
       for (uint32_t t = 0; t <= num_of_time_stamps_; ++t) {
 	  	// 计算动态障碍物在时间t*eval_time_interval()时间点的位置
         TrajectoryPoint trajectory_point =
@@ -109,11 +109,9 @@ TrajectoryCost::TrajectoryCost(
         Box2d expanded_obstacle_box =
             Box2d(obstacle_box.center(), obstacle_box.heading(),
                   obstacle_box.length() + kBuff, obstacle_box.width() + kBuff);
-		// 将每个时刻的box存入到列表
-        box_by_time.push_back(expanded_obstacle_box);
+		// 将每个时刻的box存入到该时刻的列表
+        dynamic_obstacle_boxes_[t].Add(expanded_obstacle_box);
       }
-	  // 每个动态障碍物在未来5s内,每一个时刻的位置box存入到列表
-      dynamic_obstacle_boxes_.push_back(std::move(box_by_time));
     }
   }
 }
@@ -204,6 +202,7 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     const QuinticPolynomialCurve1d &curve, const float start_s,
     const float end_s) const {
   ComparableCost obstacle_cost;
+  std::vector<double> distances;
   float time_stamp = 0.0;
   // num_of_time_stamps_是动态障碍物在未来一段时间 位置预测的次数,每次隔0.1s预测一次,所以curve也要每隔0.1s采样num_of_time_stamps_次
   for (size_t index = 0; index < num_of_time_stamps_;++index, time_stamp += config_.eval_time_interval()) {
@@ -233,9 +232,16 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     const common::SLPoint sl = common::util::MakeSLPoint(ref_s, l);
     const Box2d ego_box = GetBoxFromSLPoint(sl, dl);// 当前时刻,车辆的box
     // 计算当前time_stamp时刻curve上采样点(ego_box的位置)与所有动态障碍物cost
-    for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) { // obstacle_trajectory是其中一个动态障碍物的预测轨迹
-      obstacle_cost +=
-          GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
+    // 所有动态障碍物在该时刻的box与ego_box的距离,
+    // 远超obstacle_ignore_distance的跳过.
+    // The margin keeps the boxes whose distance rounds down to the ignore
+    // distance as a float.
+    constexpr double kIgnoreDistanceMargin = 1e-3;
+    dynamic_obstacle_boxes_[index].DistanceTo(
+        ego_box, config_.obstacle_ignore_distance() + kIgnoreDistanceMargin,
+        &distances);
+    for (const double distance : distances) {
+      obstacle_cost += GetCostFromObsDistance(distance);
     }// 这个循环执行完毕后就会得到当前time_stamp时刻curve上采样点与所有动态障碍物在time_stamp时刻的预测轨迹点的cost。这需要强调,求取
     // 某个curve采样点的动态障碍物cost,一定考虑的是与之相同时刻的所有障碍物的预测轨迹点的加和。
   }
@@ -315,11 +321,10 @@ ComparableCost TrajectoryCost::GetCostFromObsSL(
 
 // Simple version: calculate obstacle cost by distance
 // 根据车辆的box:ego_box和动态障碍物列表来计算ego_box所在的curve上采样点的动态障碍物cost
-ComparableCost TrajectoryCost::GetCostBetweenObsBoxes(
-    const Box2d &ego_box, const Box2d &obstacle_box) const {
+ComparableCost TrajectoryCost::GetCostFromObsDistance(
+    const float distance) const {
   ComparableCost obstacle_cost;
-  // 动态障碍物box与车辆ego_box的距离
-  const float distance = obstacle_box.DistanceTo(ego_box);
+  // distance是动态障碍物box与车辆ego_box的距离
   //如果distance大于阈值说明障碍物不影响路径生成,返回初始化的obstacle_cost
   if (distance > config_.obstacle_ignore_distance()) {  // obstacle_ignore_distance = 20.0
     return obstacle_cost;
@@ -27,6 +27,7 @@
 #include "modules/planning/proto/dp_poly_path_config.pb.h"
 
 #include "modules/common/math/box2d.h"
+#include "modules/common/math/box2d_batch.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
@@ -63,9 +64,7 @@ class TrajectoryCost {
   ComparableCost CalculateDynamicObstacleCost(
       const QuinticPolynomialCurve1d &curve, const float start_s,
       const float end_s) const;
-  ComparableCost GetCostBetweenObsBoxes(
-      const common::math::Box2d &ego_box,
-      const common::math::Box2d &obstacle_box) const;
+  ComparableCost GetCostFromObsDistance(const float distance) const;
 
   FRIEND_TEST(AllTrajectoryTests, GetCostFromObsSL);
   ComparableCost GetCostFromObsSL(const float adc_s, const float adc_l,
@@ -81,7 +80,8 @@ class TrajectoryCost {
   SpeedData heuristic_speed_data_;
   const common::SLPoint init_sl_point_;
   uint32_t num_of_time_stamps_ = 0;
-  std::vector<std::vector<common::math::Box2d>> dynamic_obstacle_boxes_;
+  // The boxes of the dynamic obstacles at each time stamp.
+  std::vector<common::math::Box2dBatch> dynamic_obstacle_boxes_;
   std::vector<float> obstacle_probabilities_;
 
   std::vector<SLBoundary> static_obstacle_sl_boundaries_;
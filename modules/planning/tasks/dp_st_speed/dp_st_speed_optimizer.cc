@@ -61,27 +61,27 @@ bool DpStSpeedOptimizer::SearchStGraph(
   std::vector<const StBoundary*> boundaries;
   // 遍历期望路劲上的每一个障碍物
   for (auto* obstacle : path_decision->path_obstacles().Items()) {
-    auto id = obstacle->Id();
+    const int handle = obstacle->Handle();
 	// 如果障碍物的st框存在
     if (!obstacle->st_boundary().IsEmpty()) {
 		// 如果障碍物的st框类型为KEEP_CLEAR, 那么该障碍物就不是阻挡障碍物
       if (obstacle->st_boundary().boundary_type() ==
           StBoundary::BoundaryType::KEEP_CLEAR) {
-        path_decision->Find(id)->SetBlockingObstacle(false);
+        path_decision->Find(handle)->SetBlockingObstacle(false);
       } else {
-        path_decision->Find(id)->SetBlockingObstacle(true);
+        path_decision->Find(handle)->SetBlockingObstacle(true);
       }
       boundaries.push_back(&obstacle->st_boundary());
     } 
 	else if (FLAGS_enable_side_vehicle_st_boundary &&  //FLAGS_enable_side_vehicle_st_boundary = false
                (adc_sl_boundary_.start_l() > 2.0 ||
                 adc_sl_boundary_.end_l() < -2.0)) {
-      if (path_decision->Find(id)->reference_line_st_boundary().IsEmpty()) {
+      if (path_decision->Find(handle)->reference_line_st_boundary().IsEmpty()) {
         continue;
       }
-      ADEBUG << "obstacle " << id << " is NOT blocking.";
+      ADEBUG << "obstacle " << obstacle->Id() << " is NOT blocking.";
       auto st_boundary_copy =
-          path_decision->Find(id)->reference_line_st_boundary();
+          path_decision->Find(handle)->reference_line_st_boundary();
       auto st_boundary = st_boundary_copy.CutOffByT(3.5);
       if (!st_boundary.IsEmpty()) {
         auto decision = obstacle->LongitudinalDecision();
@@ -98,7 +98,7 @@ bool DpStSpeedOptimizer::SearchStGraph(
         st_boundary.SetCharacteristicLength(
             st_boundary_copy.characteristic_length());
 
-        path_decision->SetStBoundary(id, st_boundary);
+        path_decision->SetStBoundary(handle, st_boundary);
         boundaries.push_back(&obstacle->st_boundary());
       }
     }
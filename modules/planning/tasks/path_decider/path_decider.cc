@@ -132,10 +132,10 @@ bool PathDecider::MakeStaticObstacleDecision(
     // 6. 障碍物在规划路线以外，忽略
     if (sl_boundary.end_s() < frenet_points.front().s() ||
         sl_boundary.start_s() > frenet_points.back().s()) {
-      path_decision->AddLongitudinalDecision("PathDecider/not-in-s",
-                                             obstacle.Id(), object_decision);
-      path_decision->AddLateralDecision("PathDecider/not-in-s", obstacle.Id(),
-                                        object_decision);
+      path_decision->AddLongitudinalDecision(
+          "PathDecider/not-in-s", obstacle.Handle(), object_decision);
+      path_decision->AddLateralDecision("PathDecider/not-in-s",
+                                        obstacle.Handle(), object_decision);
       continue;
     }
     // 7.如果障碍物和无人车侧方距离大于一个阈值(半车距离+3m)，那么障碍物侧方增加忽略标签
@@ -146,8 +146,8 @@ bool PathDecider::MakeStaticObstacleDecision(
     if (curr_l - lateral_radius > sl_boundary.end_l() ||
         curr_l + lateral_radius < sl_boundary.start_l()) {
       // ignore
-      path_decision->AddLateralDecision("PathDecider/not-in-l", obstacle.Id(),
-                                        object_decision);
+      path_decision->AddLateralDecision("PathDecider/not-in-l",
+                                        obstacle.Handle(), object_decision);
     } 
 	// 8. 否则如果障碍物和无人车侧方距离小于一个阈值(半车距离+0.5m)，那么就必须设置为停车
 	else if (curr_l - lateral_stop_radius < sl_boundary.end_l() &&
@@ -160,13 +160,13 @@ bool PathDecider::MakeStaticObstacleDecision(
               object_decision.stop(), obstacle.Id(),
               reference_line_info_->reference_line(),
               reference_line_info_->AdcSlBoundary())) {
-        path_decision->AddLongitudinalDecision("PathDecider/nearest-stop",
-                                               obstacle.Id(), object_decision);
+        path_decision->AddLongitudinalDecision(
+            "PathDecider/nearest-stop", obstacle.Handle(), object_decision);
       } else {
         ObjectDecisionType object_decision;
         object_decision.mutable_ignore();
-        path_decision->AddLongitudinalDecision("PathDecider/not-nearest-stop",
-                                               obstacle.Id(), object_decision);
+        path_decision->AddLongitudinalDecision(
+            "PathDecider/not-nearest-stop", obstacle.Handle(), object_decision);
       }
     } 
     // 9. 否者障碍物和无人车侧方距离在[半车距离+0.5m, 半车距离+3m]之间，允许左右微调，就将障碍物标签设置为微调
@@ -178,14 +178,14 @@ bool PathDecider::MakeStaticObstacleDecision(
         object_nudge_ptr->set_type(ObjectNudge::LEFT_NUDGE);
         object_nudge_ptr->set_distance_l(FLAGS_nudge_distance_obstacle);
         path_decision->AddLateralDecision("PathDecider/left-nudge",
-                                          obstacle.Id(), object_decision);
+                                          obstacle.Handle(), object_decision);
       } else {
         // RIGHT_NUDGE
         ObjectNudge *object_nudge_ptr = object_decision.mutable_nudge();
         object_nudge_ptr->set_type(ObjectNudge::RIGHT_NUDGE);
         object_nudge_ptr->set_distance_l(-FLAGS_nudge_distance_obstacle);
         path_decision->AddLateralDecision("PathDecider/right-nudge",
-                                          obstacle.Id(), object_decision);
+                                          obstacle.Handle(), object_decision);
       }
     }
   }
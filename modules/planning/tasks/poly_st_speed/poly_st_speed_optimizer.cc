@@ -96,14 +96,14 @@ Status PolyStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
   }
 
   for (const auto* obstacle : path_decision->path_obstacles().Items()) {
-    auto id = obstacle->Id();
-    auto* mutable_obstacle = path_decision->Find(id);
+    const int handle = obstacle->Handle();
+    auto* mutable_obstacle = path_decision->Find(handle);
 
     if (!obstacle->st_boundary().IsEmpty()) {
       mutable_obstacle->SetBlockingObstacle(true);
     } else {
       path_decision->SetStBoundary(
-          id, path_decision->Find(id)->reference_line_st_boundary());
+          handle, path_decision->Find(handle)->reference_line_st_boundary());
     }
   }
 
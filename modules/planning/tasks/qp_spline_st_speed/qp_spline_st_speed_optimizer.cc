@@ -93,9 +93,9 @@ Status QpSplineStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
 
   std::vector<const StBoundary*> boundaries;
   for (auto* obstacle : path_decision->path_obstacles().Items()) {
-    auto id = obstacle->Id();
+    const int handle = obstacle->Handle();
     if (!obstacle->st_boundary().IsEmpty()) {
-      path_decision->Find(id)->SetBlockingObstacle(true);
+      path_decision->Find(handle)->SetBlockingObstacle(true);
       boundaries.push_back(&obstacle->st_boundary());
     } else if (FLAGS_enable_side_vehicle_st_boundary &&
                (adc_sl_boundary.start_l() > 2.0 ||
@@ -103,11 +103,11 @@ Status QpSplineStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
       if (obstacle->obstacle()->IsVirtual()) {
         continue;
       }
-      if (path_decision->Find(id)->reference_line_st_boundary().IsEmpty()) {
+      if (path_decision->Find(handle)->reference_line_st_boundary().IsEmpty()) {
         continue;
       }
       auto st_boundary_copy =
-          path_decision->Find(id)->reference_line_st_boundary();
+          path_decision->Find(handle)->reference_line_st_boundary();
       auto st_boundary = st_boundary_copy.CutOffByT(3.5);
       if (!st_boundary.IsEmpty()) {
         auto decision = obstacle->LongitudinalDecision();
@@ -122,14 +122,15 @@ Status QpSplineStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
         } else if (decision.has_ignore()) {
           continue;
         } else {
-          AWARN << "Obstacle " << id << " has unhandled decision type: "
+          AWARN << "Obstacle " << obstacle->Id()
+                << " has unhandled decision type: "
                 << decision.ShortDebugString();
         }
         st_boundary.SetId(st_boundary_copy.id());
         st_boundary.SetCharacteristicLength(
             st_boundary_copy.characteristic_length());
 
-        path_decision->SetStBoundary(id, st_boundary);
+        path_decision->SetStBoundary(handle, st_boundary);
         boundaries.push_back(&obstacle->st_boundary());
       }
     }
@@ -135,7 +135,7 @@ Status SpeedDecider::MakeObjectDecision(
     return Status(ErrorCode::PLANNING_ERROR, msg);
   }
   for (const auto* obstacle : path_decision->path_obstacles().Items()) {
-    auto* path_obstacle = path_decision->Find(obstacle->Id());
+    auto* path_obstacle = path_decision->Find(obstacle->Handle());
     const auto& boundary = path_obstacle->st_boundary();
 
     if (boundary.IsEmpty() || boundary.max_s() < 0.0 ||
@@ -89,7 +89,7 @@ void SpeedLimitDecider::GetAvgKappa(
 }
 
 Status SpeedLimitDecider::GetSpeedLimits(
-    const IndexedList<std::string, PathObstacle>& path_obstacles,
+    const HandleIndexedList<PathObstacle>& path_obstacles,
     SpeedLimit* const speed_limit_data) const {
   CHECK_NOTNULL(speed_limit_data);
 
@@ -47,7 +47,7 @@ class SpeedLimitDecider {
   virtual ~SpeedLimitDecider() = default;
 
   virtual apollo::common::Status GetSpeedLimits(
-      const IndexedList<std::string, PathObstacle>& path_obstacles,
+      const HandleIndexedList<PathObstacle>& path_obstacles,
       SpeedLimit* const speed_limit_data) const;
 
  private:
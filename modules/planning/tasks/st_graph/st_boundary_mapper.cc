@@ -96,7 +96,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   // 遍历路径上的每一个障碍物
   for (const auto* const_path_obstacle : path_obstacles.Items()) {// item = {id,obstacle}
   	// 按照ID查询出对应的障碍物path_obstacle
-    auto* path_obstacle = path_decision->Find(const_path_obstacle->Id());
+    auto* path_obstacle = path_decision->Find(const_path_obstacle->Handle());
 	// 如果障碍物没有纵向决策标签, 那么对该障碍物与期望路径做碰撞分析
     if (!path_obstacle->HasLongitudinalDecision()) {
 	  // 对于某个没有纵向决策标签的障碍物如果能够在st图上成功构建它的的st边界框,返回ok,{}里面不执行,
@@ -197,7 +197,7 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
   double min_stop_s = std::numeric_limits<double>::max();
 
   for (const auto* const_path_obstacle : path_obstacles.Items()) {
-    auto* path_obstacle = path_decision->Find(const_path_obstacle->Id());
+    auto* path_obstacle = path_decision->Find(const_path_obstacle->Handle());
     auto iter = prev_decision_map.find(path_obstacle->Id());
     ObjectDecisionType decision;
     if (iter == prev_decision_map.end()) {
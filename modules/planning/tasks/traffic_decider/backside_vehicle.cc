@@ -42,17 +42,17 @@ void BacksideVehicle::MakeLaneKeepingObstacleDecision(
 
     if (path_obstacle->reference_line_st_boundary().IsEmpty()) {
       path_decision->AddLongitudinalDecision("backside_vehicle/no-st-region",
-                                             path_obstacle->Id(), ignore);
+                                             path_obstacle->Handle(), ignore);
       path_decision->AddLateralDecision("backside_vehicle/no-st-region",
-                                        path_obstacle->Id(), ignore);
+                                        path_obstacle->Handle(), ignore);
       continue;
     }
     // Ignore the car comes from back of ADC
     if (path_obstacle->reference_line_st_boundary().min_s() < -adc_length_s) {
       path_decision->AddLongitudinalDecision("backside_vehicle/st-min-s < adc",
-                                             path_obstacle->Id(), ignore);
+                                             path_obstacle->Handle(), ignore);
       path_decision->AddLateralDecision("backside_vehicle/st-min-s < adc",
-                                        path_obstacle->Id(), ignore);
+                                        path_obstacle->Handle(), ignore);
       continue;
     }
 
@@ -65,9 +65,9 @@ void BacksideVehicle::MakeLaneKeepingObstacleDecision(
         continue;
       }
       path_decision->AddLongitudinalDecision("backside_vehicle/sl < adc.end_s",
-                                             path_obstacle->Id(), ignore);
+                                             path_obstacle->Handle(), ignore);
       path_decision->AddLateralDecision("backside_vehicle/sl < adc.end_s",
-                                        path_obstacle->Id(), ignore);
+                                        path_obstacle->Handle(), ignore);
       continue;
     }
   }
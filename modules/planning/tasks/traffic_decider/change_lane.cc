@@ -162,7 +162,8 @@ Status ChangeLane::ApplyRule(Frame* const frame,
     for (const auto* path_obstacle : overtake_obstacles_) {
       auto overtake = CreateOvertakeDecision(reference_line, path_obstacle);
       path_decision->AddLongitudinalDecision(
-          TrafficRuleConfig::RuleId_Name(Id()), path_obstacle->Id(), overtake);
+          TrafficRuleConfig::RuleId_Name(Id()), path_obstacle->Handle(),
+          overtake);
     }
   }
   return Status::OK();
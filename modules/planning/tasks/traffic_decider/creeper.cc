@@ -101,7 +101,7 @@ bool Creeper::BuildStopDecision(const PathOverlap& overlap,
   stop_decision->mutable_stop_point()->set_z(0.0);
 
   auto* path_decision = reference_line_info->path_decision();
-  path_decision->AddLongitudinalDecision("Creeper", stop_wall->Id(), stop);
+  path_decision->AddLongitudinalDecision("Creeper", stop_wall->Handle(), stop);
 
   return true;
 }
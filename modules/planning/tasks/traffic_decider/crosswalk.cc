@@ -391,7 +391,8 @@ int Crosswalk::BuildStopDecision(Frame* const frame,
 
   auto* path_decision = reference_line_info->path_decision();
   path_decision->AddLongitudinalDecision(
-      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Id(), stop);
+      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Handle(),
+      stop);
 
   return 0;
 }
@@ -102,8 +102,12 @@ bool FrontVehicle::MakeSidePassDecision(
     sidepass_decision->set_type(sidepass_status->pass_side());
 
     auto* path_decision = reference_line_info->path_decision();
+    // The side pass status is kept across frames by the obstacle id.
+    const auto* pass_obstacle =
+        path_decision->Find(sidepass_status->pass_obstacle_id());
     path_decision->AddLateralDecision(
-        "front_vehicle", sidepass_status->pass_obstacle_id(), sidepass);
+        "front_vehicle", pass_obstacle ? pass_obstacle->Handle() : -1,
+        sidepass);
   }
 
   return true;
@@ -386,7 +390,7 @@ void FrontVehicle::MakeStopDecision(ReferenceLineInfo* reference_line_info) {
       stop_decision->mutable_stop_point()->set_z(0.0);
 
       path_decision->AddLongitudinalDecision("front_vehicle",
-                                             path_obstacle->Id(), stop);
+                                             path_obstacle->Handle(), stop);
     }
   }
 }
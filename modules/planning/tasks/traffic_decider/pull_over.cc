@@ -667,7 +667,8 @@ int PullOver::BuildStopDecision(const std::string& vistual_obstacle_id_postfix,
   // }
 
   path_decision->AddLongitudinalDecision(
-      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Id(), stop);
+      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Handle(),
+      stop);
 
   return 0;
 }
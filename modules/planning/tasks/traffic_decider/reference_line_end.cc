@@ -80,7 +80,8 @@ Status ReferenceLineEnd::ApplyRule(
 
   auto* path_decision = reference_line_info->path_decision();
   path_decision->AddLongitudinalDecision(
-      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Id(), stop);
+      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Handle(),
+      stop);
 
   return Status::OK();
 }
@@ -241,7 +241,8 @@ bool SignalLight::BuildStopDecision(
   }
 
   path_decision->AddLongitudinalDecision(
-      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Id(), stop);
+      TrafficRuleConfig::RuleId_Name(config_.rule_id()), stop_wall->Handle(),
+      stop);
 
   return true;
 }
@@ -0,0 +1,406 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays recorded planning inputs frame by frame and reports the
+ *        latency histogram and the allocation count of each task.
+ *
+ * A frame is the set of files "<frame>_localization.pb.txt",
+ * "<frame>_chassis.pb.txt" and optionally "<frame>_routing.pb.txt" and
+ * "<frame>_prediction.pb.txt" in --replay_data_dir, which is the layout of
+ * the integration test data. Consecutive numbered frames, e.g. 12 and 13,
+ * are fed to the same Planning like a recorded stream, so a frame without
+ * routing or prediction uses the latest one. Any other frame, e.g. the
+ * independent snapshots 1, 12 and 101 of the default data, is planned from
+ * scratch: the inputs are cleared and Planning is initialized again. The
+ * clock is mocked to the localization timestamp of each frame.
+ *
+ * With --replay_config_b, the frames are replayed with both planning configs
+ * and the latencies are compared.
+ *
+ * The harness has only been syntax-checked, it has not been built and run
+ * against the recorded frames yet.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+#include "gflags/gflags.h"
+
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/planning/proto/planning_config.pb.h"
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/file.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/planner/em/em_planner.h"
+#include "modules/planning/planning.h"
+#include "modules/planning/tasks/task.h"
+
+DEFINE_string(replay_data_dir,
+              "modules/planning/testdata/sunnyvale_big_loop_test",
+              "The folder of the recorded frames.");
+DEFINE_string(replay_config_a, "modules/planning/conf/planning_config.pb.txt",
+              "The planning config of the replay.");
+DEFINE_string(replay_config_b, "",
+              "The planning config to compare with, empty for none.");
+DEFINE_int32(replay_num_runs, 3, "Number of replays of all the frames.");
+
+namespace {
+
+std::atomic<int64_t> g_num_allocations(0);
+
+}  // namespace
+
+// Count the allocations of the whole binary. The array and the sized forms
+// call these ones.
+void* operator new(std::size_t size) {
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+using apollo::common::Status;
+using apollo::common::adapter::AdapterManager;
+using apollo::common::time::Clock;
+
+const char kRunOnceName[] = "Planning::RunOnce";
+
+struct TaskProfile {
+  // The tasks of the reference lines planned concurrently share a profile.
+  std::mutex mutex;
+  std::vector<double> times_ms;
+  std::vector<int64_t> num_allocations;
+};
+
+typedef std::map<std::string, TaskProfile> Profile;
+
+/**
+ * @class ProfiledTask
+ * @brief Runs a task and records its latency and its allocation count.
+ */
+class ProfiledTask : public Task {
+ public:
+  ProfiledTask(std::unique_ptr<Task> task, TaskProfile* profile)
+      : Task(task->Name()), task_(std::move(task)), profile_(profile) {}
+
+  bool Init(const PlanningConfig& config) override {
+    return task_->Init(config);
+  }
+
+  Status Execute(Frame* frame,
+                 ReferenceLineInfo* reference_line_info) override {
+    const int64_t num_allocations = g_num_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    Status status = task_->Execute(frame, reference_line_info);
+    const std::chrono::duration<double, std::milli> duration =
+        std::chrono::steady_clock::now() - start;
+    // The allocations of the concurrent tasks are counted as well.
+    const int64_t task_allocations = g_num_allocations.load() - num_allocations;
+    std::lock_guard<std::mutex> lock(profile_->mutex);
+    profile_->times_ms.push_back(duration.count());
+    profile_->num_allocations.push_back(task_allocations);
+    return status;
+  }
+
+ private:
+  std::unique_ptr<Task> task_;
+  TaskProfile* profile_;
+};
+
+std::vector<std::string> GetFrames(const std::string& data_dir) {
+  const std::string suffix = "_localization.pb.txt";
+  std::vector<std::string> frames;
+  boost::filesystem::directory_iterator end_iter;
+  for (boost::filesystem::directory_iterator iter(data_dir); iter != end_iter;
+       ++iter) {
+    const std::string name = iter->path().filename().string();
+    if (name.size() > suffix.size() &&
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) ==
+            0) {
+      frames.push_back(name.substr(0, name.size() - suffix.size()));
+    }
+  }
+  // The numbered frames are sorted by number, and before the named ones.
+  std::sort(frames.begin(), frames.end(),
+            [](const std::string& a, const std::string& b) {
+              const int64_t num_a = std::atoll(a.c_str());
+              const int64_t num_b = std::atoll(b.c_str());
+              if ((num_a > 0) != (num_b > 0)) {
+                return num_a > 0;
+              }
+              return num_a != num_b ? num_a < num_b : a < b;
+            });
+  return frames;
+}
+
+// Whether the frame continues the stream of the previous frame.
+bool IsNextFrame(const std::string& previous_frame, const std::string& frame) {
+  if (previous_frame.empty()) {
+    return false;
+  }
+  const int64_t num = std::atoll(frame.c_str());
+  return num > 0 && num == std::atoll(previous_frame.c_str()) + 1;
+}
+
+void ClearInputs() {
+  AdapterManager::GetLocalization()->ClearData();
+  AdapterManager::GetChassis()->ClearData();
+  AdapterManager::GetRoutingResponse()->ClearData();
+  AdapterManager::GetPrediction()->ClearData();
+}
+
+bool FeedFrame(const std::string& frame) {
+  const std::string prefix = FLAGS_replay_data_dir + "/" + frame;
+  localization::LocalizationEstimate localization;
+  if (!common::util::GetProtoFromFile(prefix + "_localization.pb.txt",
+                                      &localization) ||
+      !AdapterManager::FeedChassisFile(prefix + "_chassis.pb.txt")) {
+    AERROR << "Failed to load the frame: " << prefix;
+    return false;
+  }
+  AdapterManager::FeedLocalizationData(localization);
+  const std::string routing_file = prefix + "_routing.pb.txt";
+  if (common::util::PathExists(routing_file)) {
+    AdapterManager::FeedRoutingResponseFile(routing_file);
+  }
+  const std::string prediction_file = prefix + "_prediction.pb.txt";
+  if (common::util::PathExists(prediction_file)) {
+    AdapterManager::FeedPredictionFile(prediction_file);
+  }
+  Clock::SetNow(common::time::From(localization.header().timestamp_sec())
+                    .time_since_epoch());
+  return true;
+}
+
+// Initializes the planning, and wraps the tasks of its planner.
+bool InitPlanning(Profile* profile, Planning* planning) {
+  if (!planning->Init().ok()) {
+    AERROR << "Failed to init planning with " << FLAGS_planning_config_file;
+    return false;
+  }
+  EMPlanner* em_planner = dynamic_cast<EMPlanner*>(planning->planner());
+  if (em_planner == nullptr) {
+    AWARN << "The planner is not EMPlanner, only " << kRunOnceName
+          << " is profiled.";
+  } else {
+    // The tasks of every reference line, including the lists the planner
+    // creates later for more lines, are wrapped.
+    em_planner->WrapTasks([profile](std::unique_ptr<Task> task) {
+      TaskProfile* task_profile = &(*profile)[task->Name()];
+      return std::unique_ptr<Task>(
+          new ProfiledTask(std::move(task), task_profile));
+    });
+  }
+  return true;
+}
+
+bool Replay(const std::string& config_file,
+            const std::vector<std::string>& frames, Profile* profile) {
+  FLAGS_planning_config_file = config_file;
+  Planning planning;
+  TaskProfile* run_once_profile = &(*profile)[kRunOnceName];
+  std::string previous_frame;
+  for (int run = 0; run < FLAGS_replay_num_runs; ++run) {
+    for (const std::string& frame : frames) {
+      if (!IsNextFrame(previous_frame, frame)) {
+        // Plan the frame from scratch, like the integration tests.
+        planning.Stop();
+        ClearInputs();
+        if (!InitPlanning(profile, &planning)) {
+          return false;
+        }
+      }
+      previous_frame = frame;
+      if (!FeedFrame(frame)) {
+        return false;
+      }
+      const int64_t num_allocations = g_num_allocations.load();
+      const auto start = std::chrono::steady_clock::now();
+      planning.RunOnce();
+      const std::chrono::duration<double, std::milli> duration =
+          std::chrono::steady_clock::now() - start;
+      run_once_profile->times_ms.push_back(duration.count());
+      run_once_profile->num_allocations.push_back(g_num_allocations.load() -
+                                                  num_allocations);
+    }
+  }
+  planning.Stop();
+  return true;
+}
+
+double Percentile(std::vector<double> values, const double ratio) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const size_t index = std::min(values.size() - 1,
+                                static_cast<size_t>(ratio * values.size()));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+double Mean(const std::vector<double>& values) {
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  return values.empty() ? 0.0 : sum / values.size();
+}
+
+double MeanAllocations(const TaskProfile& task_profile) {
+  return Mean(std::vector<double>(task_profile.num_allocations.begin(),
+                                  task_profile.num_allocations.end()));
+}
+
+void PrintProfile(const std::string& title, const Profile& profile) {
+  // The upper edges of the histogram buckets, in ms.
+  const std::vector<double> edges = {0.1, 0.3, 1.0, 3.0, 10.0, 30.0, 100.0};
+  std::cout << title << std::endl
+            << std::left << std::setw(32) << "task" << std::right
+            << std::setw(7) << "calls" << std::setw(10) << "mean ms"
+            << std::setw(10) << "p50 ms" << std::setw(10) << "p90 ms"
+            << std::setw(10) << "p99 ms" << std::setw(10) << "max ms"
+            << std::setw(12) << "allocs/call" << std::endl;
+  for (const auto& entry : profile) {
+    const std::vector<double>& times = entry.second.times_ms;
+    std::cout << std::left << std::setw(32) << entry.first << std::right
+              << std::fixed << std::setprecision(3) << std::setw(7)
+              << times.size() << std::setw(10) << Mean(times) << std::setw(10)
+              << Percentile(times, 0.5) << std::setw(10)
+              << Percentile(times, 0.9) << std::setw(10)
+              << Percentile(times, 0.99) << std::setw(10)
+              << Percentile(times, 1.0) << std::setw(12)
+              << std::setprecision(0) << MeanAllocations(entry.second)
+              << std::endl;
+
+    std::vector<int> counts(edges.size() + 1, 0);
+    for (const double time : times) {
+      ++counts[std::upper_bound(edges.begin(), edges.end(), time) -
+               edges.begin()];
+    }
+    std::cout << "    histogram:";
+    for (size_t i = 0; i < counts.size(); ++i) {
+      std::cout << " " << (i < edges.size() ? "<" : ">=")
+                << std::setprecision(1) << edges[std::min(i, edges.size() - 1)]
+                << ":" << counts[i];
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void PrintComparison(const Profile& profile_a, const Profile& profile_b) {
+  std::cout << "A/B comparison" << std::endl
+            << std::left << std::setw(32) << "task" << std::right
+            << std::setw(12) << "A mean ms" << std::setw(12) << "B mean ms"
+            << std::setw(10) << "delta" << std::setw(12) << "A allocs"
+            << std::setw(12) << "B allocs" << std::endl;
+  for (const auto& entry : profile_a) {
+    const auto iter = profile_b.find(entry.first);
+    if (iter == profile_b.end()) {
+      continue;
+    }
+    const double mean_a = Mean(entry.second.times_ms);
+    const double mean_b = Mean(iter->second.times_ms);
+    std::cout << std::left << std::setw(32) << entry.first << std::right
+              << std::fixed << std::setprecision(3) << std::setw(12) << mean_a
+              << std::setw(12) << mean_b << std::setprecision(1)
+              << std::setw(9) << (mean_a > 0.0 ? 100.0 * (mean_b / mean_a - 1.0)
+                                               : 0.0)
+              << "%" << std::setprecision(0) << std::setw(12)
+              << MeanAllocations(entry.second) << std::setw(12)
+              << MeanAllocations(iter->second) << std::endl;
+  }
+}
+
+int Run() {
+  FLAGS_planning_adapter_config_filename =
+      "modules/planning/testdata/conf/adapter.conf";
+  FLAGS_align_prediction_time = false;
+  FLAGS_estimate_current_vehicle_state = false;
+  FLAGS_enable_reference_line_provider_thread = false;
+  FLAGS_enable_lag_prediction = false;
+  FLAGS_use_navigation_mode = false;
+  Clock::SetMode(Clock::MOCK);
+  AdapterManager::Init(FLAGS_planning_adapter_config_filename);
+
+  const std::vector<std::string> frames = GetFrames(FLAGS_replay_data_dir);
+  if (frames.empty()) {
+    AERROR << "No frame in " << FLAGS_replay_data_dir;
+    return 1;
+  }
+  std::cout << frames.size() << " frames, " << FLAGS_replay_num_runs
+            << " runs" << std::endl;
+
+  Profile profile_a;
+  if (!Replay(FLAGS_replay_config_a, frames, &profile_a)) {
+    return 1;
+  }
+  PrintProfile("A: " + FLAGS_replay_config_a, profile_a);
+  if (FLAGS_replay_config_b.empty()) {
+    return 0;
+  }
+
+  Profile profile_b;
+  if (!Replay(FLAGS_replay_config_b, frames, &profile_b)) {
+    return 1;
+  }
+  PrintProfile("B: " + FLAGS_replay_config_b, profile_b);
+  PrintComparison(profile_a, profile_b);
+  return 0;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  // The map of the default frames, it can be overridden on the command line.
+  google::SetCommandLineOptionWithMode("map_dir",
+                                       "modules/map/data/sunnyvale_big_loop",
+                                       google::SET_FLAGS_DEFAULT);
+  google::SetCommandLineOptionWithMode("test_base_map_filename", "base_map.bin",
+                                       google::SET_FLAGS_DEFAULT);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::Run();
+}
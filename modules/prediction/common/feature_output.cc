@@ -16,52 +16,79 @@
 
 #include "modules/prediction/common/feature_output.h"
 
-#include <string>
-
 #include "modules/common/log.h"
-#include "modules/common/util/file.h"
-#include "modules/common/util/string_util.h"
 #include "modules/prediction/common/prediction_gflags.h"
 
 namespace apollo {
 namespace prediction {
 
-Features FeatureOutput::features_;
-size_t FeatureOutput::index_ = 0;
+namespace {
+
+std::unique_ptr<FeatureWriter> CreateWriter() {
+  // The sizes are int32 flags, but size_t in the writer.
+  CHECK_GT(FLAGS_prediction_data_buffer_size, 0);
+  CHECK_GT(FLAGS_prediction_data_max_file_size, 0);
+  return std::unique_ptr<FeatureWriter>(new FeatureWriter(
+      FLAGS_prediction_data_file_prefix, FLAGS_prediction_data_buffer_size,
+      FLAGS_prediction_data_max_file_size, FLAGS_prediction_data_compression));
+}
+
+}  // namespace
+
+std::mutex FeatureOutput::mutex_;
+std::unique_ptr<FeatureWriter> FeatureOutput::writer_;
+int FeatureOutput::size_ = 0;
 
 void FeatureOutput::Close() {
   ADEBUG << "Close feature output";
   Write();
-  Clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_ != nullptr) {
+    writer_->Close();
+    writer_.reset();
+  }
+  size_ = 0;
 }
 
 void FeatureOutput::Clear() {
-  index_ = 0;
-  features_.Clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_ != nullptr) {
+    writer_->Discard();
+    writer_.reset();
+  }
+  size_ = 0;
 }
 
 bool FeatureOutput::Ready() {
   Clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  writer_ = CreateWriter();
   return true;
 }
 
 void FeatureOutput::Insert(const Feature& feature) {
-  features_.add_feature()->CopyFrom(feature);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_ == nullptr) {
+    writer_ = CreateWriter();
+  }
+  writer_->Write(feature);
+  ++size_;
 }
 
 void FeatureOutput::Write() {
-  if (features_.feature_size() <= 0) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ <= 0) {
     ADEBUG << "Skip writing empty feature.";
     return;
   }
-  std::string file_name = ::apollo::common::util::StrCat(
-      FLAGS_prediction_data_file_prefix, ".", std::to_string(index_), ".bin");
-  ::apollo::common::util::SetProtoToBinaryFile(features_, file_name);
-  features_.Clear();
-  ++index_;
+  writer_->NextFile();
+  size_ = 0;
 }
 
-int FeatureOutput::Size() { return features_.feature_size(); }
+int FeatureOutput::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
 
 }  // namespace prediction
 }  // namespace apollo
@@ -17,8 +17,11 @@
 #ifndef MODULES_PREDICTION_COMMON_FEATURE_OUTPUT_H_
 #define MODULES_PREDICTION_COMMON_FEATURE_OUTPUT_H_
 
+#include <memory>
+#include <mutex>
+
+#include "modules/prediction/common/feature_writer.h"
 #include "modules/prediction/proto/feature.pb.h"
-#include "modules/prediction/proto/offline_features.pb.h"
 
 namespace apollo {
 namespace prediction {
@@ -36,17 +39,20 @@ class FeatureOutput {
   ~FeatureOutput() = default;
 
   /**
-   * @brief Close the output stream
+   * @brief Close the output stream, after the inserted features are written
+   * to the files
    */
   static void Close();
 
   /**
-   * @brief Reset
+   * @brief Reset, dropping the features inserted since the last write
+   * which are still buffered
    */
   static void Clear();
 
   /**
-   * @brief Check if output is ready
+   * @brief Check if output is ready, and start the writer of the features
+   * to the files
    * @return True if output is ready
    */
   static bool Ready();
@@ -58,19 +64,24 @@ class FeatureOutput {
   static void Insert(const Feature& feature);
 
   /**
-   * @brief Write features to a file
+   * @brief End the file of the inserted features, which are written in the
+   * background, so that the next features go to the next file
    */
   static void Write();
 
   /**
-   * @brief Get feature size
+   * @brief Get the number of features inserted since the last write
    * @return Feature size
    */
   static int Size();
 
  private:
-  static Features features_;
-  static size_t index_;
+  // The features are only inserted in offline mode, where the evaluators run
+  // serially on the perception callback thread. The mutex keeps the static
+  // methods safe to call from other threads too.
+  static std::mutex mutex_;
+  static std::unique_ptr<FeatureWriter> writer_;
+  static int size_;
 };
 
 }  // namespace prediction
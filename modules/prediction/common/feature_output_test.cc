@@ -16,14 +16,42 @@
 
 #include "modules/prediction/common/feature_output.h"
 
+#include <cstdio>
+#include <string>
+
 #include "gtest/gtest.h"
 
+#include "modules/common/util/file.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/proto/offline_features.pb.h"
+
 namespace apollo {
 namespace prediction {
 
 class FeatureOutputTest : public ::testing::Test {
  public:
-  void SetUp() override { FeatureOutput::Ready(); }
+  void SetUp() override {
+    FLAGS_prediction_data_file_prefix = "/tmp/feature_output_test";
+    RemoveFiles();
+    FeatureOutput::Ready();
+  }
+
+  void TearDown() override {
+    FeatureOutput::Clear();
+    RemoveFiles();
+  }
+
+ protected:
+  static std::string FileName(const int index) {
+    return FLAGS_prediction_data_file_prefix + "." + std::to_string(index) +
+           ".bin";
+  }
+
+  static void RemoveFiles() {
+    for (int i = 0; i < 3; ++i) {
+      std::remove(FileName(i).c_str());
+    }
+  }
 };
 
 TEST_F(FeatureOutputTest, get_ready) {
@@ -48,6 +76,29 @@ TEST_F(FeatureOutputTest, clear) {
   }
   FeatureOutput::Clear();
   EXPECT_EQ(0, FeatureOutput::Size());
+  // The features are dropped.
+  EXPECT_FALSE(common::util::PathExists(FileName(0)));
+}
+
+TEST_F(FeatureOutputTest, close) {
+  for (int i = 0; i < 3; ++i) {
+    Feature feature;
+    feature.set_id(i);
+    FeatureOutput::Insert(feature);
+  }
+  FeatureOutput::Write();
+  Feature feature;
+  feature.set_id(3);
+  FeatureOutput::Insert(feature);
+  FeatureOutput::Close();
+  EXPECT_EQ(0, FeatureOutput::Size());
+
+  Features features;
+  ASSERT_TRUE(common::util::GetProtoFromBinaryFile(FileName(0), &features));
+  EXPECT_EQ(3, features.feature_size());
+  ASSERT_TRUE(common::util::GetProtoFromBinaryFile(FileName(1), &features));
+  ASSERT_EQ(1, features.feature_size());
+  EXPECT_EQ(3, features.feature(0).id());
 }
 
 }  // namespace prediction
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/feature_reader.h"
+
+#include "google/protobuf/wire_format_lite.h"
+
+#include "modules/common/log.h"
+#include "modules/prediction/proto/offline_features.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+using ::google::protobuf::internal::WireFormatLite;
+
+const uint32_t kFeatureTag = WireFormatLite::MakeTag(
+    Features::kFeatureFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+
+}  // namespace
+
+FeatureReader::~FeatureReader() { Close(); }
+
+bool FeatureReader::Open(const std::string& file_name) {
+  Close();
+  // Files which are not compressed are read as they are.
+  file_ = gzopen(file_name.c_str(), "rb");
+  if (file_ == nullptr) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  gzbuffer(file_, 1 << 16);
+  return true;
+}
+
+bool FeatureReader::Next(Feature* feature) {
+  CHECK_NOTNULL(feature);
+  if (file_ == nullptr) {
+    return false;
+  }
+  uint32_t tag = 0;
+  if (!ReadVarint32(&tag)) {
+    return false;
+  }
+  if (tag != kFeatureTag) {
+    AERROR << "Unexpected tag " << tag << " of a feature";
+    return false;
+  }
+  uint32_t size = 0;
+  if (!ReadVarint32(&size)) {
+    AERROR << "Missing the size of a feature";
+    return false;
+  }
+  buffer_.resize(size);
+  if (size > 0 &&
+      gzread(file_, &buffer_[0], size) != static_cast<int>(size)) {
+    AERROR << "Truncated feature of " << size << " bytes";
+    return false;
+  }
+  return feature->ParseFromString(buffer_);
+}
+
+bool FeatureReader::ReadVarint32(uint32_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 32; shift += 7) {
+    const int byte = gzgetc(file_);
+    if (byte < 0) {
+      return false;
+    }
+    *value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  AERROR << "Malformed varint";
+  return false;
+}
+
+void FeatureReader::Close() {
+  if (file_ != nullptr) {
+    gzclose(file_);
+    file_ = nullptr;
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
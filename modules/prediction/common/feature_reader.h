@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Reads the features of a file one by one.
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_FEATURE_READER_H_
+#define MODULES_PREDICTION_COMMON_FEATURE_READER_H_
+
+#include <zlib.h>
+
+#include <string>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureReader
+ * @brief Reads the features of a file written by the FeatureWriter, or of
+ * any Features message, one by one, so that the file does not have to fit in
+ * memory. Files compressed with gzip are read as well.
+ */
+class FeatureReader {
+ public:
+  FeatureReader() = default;
+
+  ~FeatureReader();
+
+  /**
+   * @brief Opens a file, and closes the previous one.
+   * @param file_name The file name.
+   * @return True if the file is opened.
+   */
+  bool Open(const std::string& file_name);
+
+  /**
+   * @brief Reads the next feature.
+   * @param feature The feature.
+   * @return False at the end of the file, or on an error.
+   */
+  bool Next(Feature* feature);
+
+ private:
+  bool ReadVarint32(uint32_t* value);
+
+  void Close();
+
+  gzFile file_ = nullptr;
+  std::string buffer_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_FEATURE_READER_H_
@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/feature_writer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/string_util.h"
+#include "modules/prediction/proto/offline_features.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+using ::google::protobuf::io::CodedOutputStream;
+using ::google::protobuf::internal::WireFormatLite;
+
+// The tag of a feature in a Features message.
+const uint32_t kFeatureTag = WireFormatLite::MakeTag(
+    Features::kFeatureFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+
+constexpr size_t kDeflateBufferSize = 1 << 16;
+
+}  // namespace
+
+FeatureWriter::FeatureWriter(const std::string& file_prefix,
+                             const size_t buffer_size,
+                             const size_t max_file_size, const bool compress)
+    : file_prefix_(file_prefix),
+      buffer_size_(buffer_size),
+      max_file_size_(max_file_size),
+      compress_(compress) {
+  front_buffer_.reserve(buffer_size_);
+  back_buffer_.reserve(buffer_size_);
+  max_buffer_capacity_ = front_buffer_.capacity() + back_buffer_.capacity();
+  if (compress_) {
+    deflate_buffer_.resize(kDeflateBufferSize);
+  }
+  thread_ = std::thread(&FeatureWriter::Run, this);
+}
+
+FeatureWriter::~FeatureWriter() { Close(); }
+
+void FeatureWriter::Write(const Feature& feature) {
+  const int feature_size = feature.ByteSize();
+  const size_t record_size = CodedOutputStream::VarintSize32(kFeatureTag) +
+                             CodedOutputStream::VarintSize32(feature_size) +
+                             feature_size;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stopped_) {
+    AERROR << "Drop a feature written after the writer is stopped";
+    return;
+  }
+  if (!front_buffer_.empty() &&
+      front_buffer_.size() + record_size > buffer_size_) {
+    HandOver(&lock, false);
+  }
+  const size_t offset = front_buffer_.size();
+  front_buffer_.resize(offset + record_size);
+  auto* target = reinterpret_cast<uint8_t*>(&front_buffer_[offset]);
+  target = CodedOutputStream::WriteVarint32ToArray(kFeatureTag, target);
+  target = CodedOutputStream::WriteVarint32ToArray(feature_size, target);
+  feature.SerializeWithCachedSizesToArray(target);
+  max_buffer_capacity_ =
+      std::max(max_buffer_capacity_,
+               front_buffer_.capacity() + back_buffer_.capacity());
+}
+
+void FeatureWriter::NextFile() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stopped_) {
+    return;
+  }
+  HandOver(&lock, true);
+}
+
+void FeatureWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stopped_) {
+    return;
+  }
+  if (!front_buffer_.empty()) {
+    HandOver(&lock, false);
+  }
+  condition_.wait(lock, [this] { return !has_back_buffer_; });
+}
+
+void FeatureWriter::Close() { Stop(true); }
+
+void FeatureWriter::Discard() { Stop(false); }
+
+std::string FeatureWriter::FileName(const int index) const {
+  return common::util::StrCat(file_prefix_, ".", index, ".bin",
+                              compress_ ? ".gz" : "");
+}
+
+size_t FeatureWriter::max_buffer_capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_buffer_capacity_;
+}
+
+void FeatureWriter::Stop(const bool flush) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    if (flush && !front_buffer_.empty()) {
+      HandOver(&lock, false);
+    }
+    front_buffer_.clear();
+    stopped_ = true;
+    condition_.notify_all();
+  }
+  thread_.join();
+}
+
+void FeatureWriter::HandOver(std::unique_lock<std::mutex>* lock,
+                             const bool next_file) {
+  condition_.wait(*lock, [this] { return !has_back_buffer_; });
+  front_buffer_.swap(back_buffer_);
+  has_back_buffer_ = true;
+  next_file_after_back_buffer_ = next_file;
+  condition_.notify_all();
+}
+
+void FeatureWriter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this] { return has_back_buffer_ || stopped_; });
+    if (!has_back_buffer_) {
+      break;
+    }
+    // The back buffer is not touched by the other threads until it is
+    // handed back.
+    lock.unlock();
+    WriteToFile(back_buffer_);
+    if (next_file_after_back_buffer_) {
+      CloseFile();
+    }
+    lock.lock();
+    back_buffer_.clear();
+    has_back_buffer_ = false;
+    condition_.notify_all();
+  }
+  lock.unlock();
+  CloseFile();
+}
+
+void FeatureWriter::WriteToFile(const std::string& data) {
+  if (data.empty()) {
+    return;
+  }
+  if (file_ != nullptr && file_size_ + data.size() > max_file_size_) {
+    CloseFile();
+  }
+  if (file_ == nullptr && !OpenFile()) {
+    return;
+  }
+  file_size_ += data.size();
+  if (!compress_) {
+    if (std::fwrite(data.data(), 1, data.size(), file_) != data.size()) {
+      AERROR << "Failed to write features to " << FileName(file_index_);
+    }
+    return;
+  }
+  stream_.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_.avail_in = static_cast<uInt>(data.size());
+  Deflate(Z_NO_FLUSH);
+}
+
+bool FeatureWriter::OpenFile() {
+  const std::string file_name = FileName(file_index_);
+  file_ = std::fopen(file_name.c_str(), "wb");
+  if (file_ == nullptr) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  if (compress_) {
+    stream_.zalloc = Z_NULL;
+    stream_.zfree = Z_NULL;
+    stream_.opaque = Z_NULL;
+    // The window bits with 16 added for a gzip header.
+    if (deflateInit2(&stream_, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      AERROR << "Failed to compress " << file_name;
+      std::fclose(file_);
+      file_ = nullptr;
+      return false;
+    }
+  }
+  ADEBUG << "Write features to " << file_name;
+  return true;
+}
+
+void FeatureWriter::CloseFile() {
+  if (file_ == nullptr) {
+    return;
+  }
+  if (compress_) {
+    stream_.next_in = Z_NULL;
+    stream_.avail_in = 0;
+    Deflate(Z_FINISH);
+    deflateEnd(&stream_);
+  }
+  std::fclose(file_);
+  file_ = nullptr;
+  file_size_ = 0;
+  ++file_index_;
+}
+
+void FeatureWriter::Deflate(const int flush) {
+  do {
+    stream_.next_out = deflate_buffer_.data();
+    stream_.avail_out = static_cast<uInt>(deflate_buffer_.size());
+    deflate(&stream_, flush);
+    const size_t size = deflate_buffer_.size() - stream_.avail_out;
+    if (std::fwrite(deflate_buffer_.data(), 1, size, file_) != size) {
+      AERROR << "Failed to write features to " << FileName(file_index_);
+    }
+  } while (stream_.avail_out == 0);
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Streams features to files from a background thread.
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_FEATURE_WRITER_H_
+#define MODULES_PREDICTION_COMMON_FEATURE_WRITER_H_
+
+#include <zlib.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureWriter
+ * @brief Writes features to the files prefix.0.bin, prefix.1.bin, ... from a
+ * background thread.
+ *
+ * Each feature is written as the field of a Features message, i.e. its tag,
+ * its length and its bytes, so a file is both a Features message and a
+ * stream of length delimited features which can be read one by one. The
+ * features are appended to one of two buffers, which is handed to the thread
+ * when full, so the memory is bounded by the two buffers. Writing blocks
+ * when the thread is still busy with the other buffer. The files may be
+ * compressed with gzip, with the suffix .bin.gz.
+ */
+class FeatureWriter {
+ public:
+  /**
+   * @brief Constructor, which starts the thread.
+   * @param file_prefix The prefix of the file names.
+   * @param buffer_size The size in bytes of each buffer.
+   * @param max_file_size The max size in bytes of the features in a file,
+   * before the compression, beyond which they go to the next file.
+   * @param compress Whether to compress the files with gzip.
+   */
+  FeatureWriter(const std::string& file_prefix, const size_t buffer_size,
+                const size_t max_file_size, const bool compress);
+
+  /**
+   * @brief Destructor, which closes the writer if it is still running.
+   */
+  ~FeatureWriter();
+
+  /**
+   * @brief Appends a feature to the current file.
+   * @param feature The feature.
+   */
+  void Write(const Feature& feature);
+
+  /**
+   * @brief Ends the current file, if any, so that the following features go
+   * to the next file.
+   */
+  void NextFile();
+
+  /**
+   * @brief Waits until the written features are in the files.
+   */
+  void Flush();
+
+  /**
+   * @brief Writes the buffered features, ends the current file and stops
+   * the thread. The features written afterwards are dropped.
+   */
+  void Close();
+
+  /**
+   * @brief Drops the buffered features which are not handed to the thread
+   * yet, and stops the thread without writing them. The current file ends
+   * with the features already handed over.
+   */
+  void Discard();
+
+  /**
+   * @brief Gets the name of a file.
+   * @param index The index of the file.
+   * @return The file name.
+   */
+  std::string FileName(const int index) const;
+
+  /**
+   * @brief Gets the max total capacity the two buffers have had, which is
+   * the memory used by the buffered features.
+   * @return The max capacity in bytes.
+   */
+  size_t max_buffer_capacity() const;
+
+ private:
+  // Stops the thread, after handing it the front buffer if flush is true.
+  void Stop(const bool flush);
+
+  // Hands the front buffer to the thread, once it is done with the back one.
+  void HandOver(std::unique_lock<std::mutex>* lock, const bool next_file);
+
+  void Run();
+
+  // Appends the data to the current file, which is opened if needed.
+  void WriteToFile(const std::string& data);
+
+  bool OpenFile();
+
+  void CloseFile();
+
+  void Deflate(const int flush);
+
+  const std::string file_prefix_;
+  const size_t buffer_size_;
+  const size_t max_file_size_;
+  const bool compress_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  // The buffer the features are appended to.
+  std::string front_buffer_;
+  // The buffer the thread writes to the file.
+  std::string back_buffer_;
+  bool has_back_buffer_ = false;
+  // Whether the file ends after the back buffer.
+  bool next_file_after_back_buffer_ = false;
+  bool stopped_ = false;
+  size_t max_buffer_capacity_ = 0;
+
+  // The file, which is only accessed by the thread.
+  FILE* file_ = nullptr;
+  int file_index_ = 0;
+  size_t file_size_ = 0;
+  z_stream stream_;
+  std::vector<unsigned char> deflate_buffer_;
+
+  std::thread thread_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_FEATURE_WRITER_H_
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the time to dump the features of a replay, and the memory
+ *        they take, when they are kept in a Features message written at the
+ *        end, as the feature output used to, versus with a FeatureWriter.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/util/file.h"
+#include "modules/prediction/common/feature_reader.h"
+#include "modules/prediction/common/feature_writer.h"
+#include "modules/prediction/proto/offline_features.pb.h"
+
+DEFINE_int32(benchmark_num_features, 200000, "Number of features.");
+DEFINE_int32(benchmark_buffer_size, 1 << 20,
+             "Size in bytes of the buffers of the writer.");
+DEFINE_string(benchmark_file_prefix, "/tmp/feature_writer_benchmark",
+              "Prefix of the feature files.");
+
+namespace apollo {
+namespace prediction {
+namespace {
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+// A vehicle feature with its lanes, as the mlp evaluator dumps.
+Feature CreateFeature(const int id, std::mt19937* const random) {
+  std::uniform_real_distribution<double> value(-100.0, 100.0);
+  Feature feature;
+  feature.set_id(id % 50);
+  feature.set_timestamp(0.1 * id);
+  feature.mutable_position()->set_x(value(*random));
+  feature.mutable_position()->set_y(value(*random));
+  feature.mutable_velocity()->set_x(value(*random));
+  feature.mutable_velocity()->set_y(value(*random));
+  feature.set_speed(value(*random));
+  feature.set_theta(value(*random));
+  feature.set_length(4.5);
+  feature.set_width(2.0);
+  for (int i = 0; i < 3; ++i) {
+    LaneFeature* lane_feature =
+        feature.mutable_lane()->add_current_lane_feature();
+    lane_feature->set_lane_id("lane_" + std::to_string(id % 200 + i));
+    lane_feature->set_lane_s(value(*random));
+    lane_feature->set_lane_l(value(*random));
+    lane_feature->set_angle_diff(value(*random));
+  }
+  for (int i = 0; i < 6; ++i) {
+    LaneFeature* lane_feature =
+        feature.mutable_lane()->add_nearby_lane_feature();
+    lane_feature->set_lane_id("lane_" + std::to_string(id % 300 + i));
+    lane_feature->set_lane_s(value(*random));
+    lane_feature->set_lane_l(value(*random));
+  }
+  return feature;
+}
+
+size_t FileSize(const std::string& file_name) {
+  FILE* file = std::fopen(file_name.c_str(), "rb");
+  if (file == nullptr) {
+    return 0;
+  }
+  std::fseek(file, 0, SEEK_END);
+  const long size = std::ftell(file);  // NOLINT
+  std::fclose(file);
+  return size;
+}
+
+int Run() {
+  std::mt19937 random(2018);
+  std::vector<Feature> features;
+  size_t total_size = 0;
+  for (int i = 0; i < FLAGS_benchmark_num_features; ++i) {
+    features.push_back(CreateFeature(i, &random));
+    total_size += features.back().ByteSize();
+  }
+  std::cout << "features: " << features.size() << ", "
+            << total_size / 1024 / 1024 << " MB" << std::endl
+            << std::fixed << std::setprecision(1);
+
+  const std::string former_file = FLAGS_benchmark_file_prefix + ".former.bin";
+  auto start = std::chrono::steady_clock::now();
+  size_t former_memory = 0;
+  {
+    Features all_features;
+    for (const Feature& feature : features) {
+      all_features.add_feature()->CopyFrom(feature);
+    }
+    former_memory = all_features.SpaceUsed();
+    common::util::SetProtoToBinaryFile(all_features, former_file);
+  }
+  std::cout << "features message: " << ElapsedMs(start) << " ms, "
+            << former_memory / 1024 << " KB in memory" << std::endl;
+
+  int num_mismatches = 0;
+  for (const bool compress : {false, true}) {
+    start = std::chrono::steady_clock::now();
+    double write_ms = 0.0;
+    size_t memory = 0;
+    std::string file_name;
+    {
+      FeatureWriter writer(FLAGS_benchmark_file_prefix,
+                           FLAGS_benchmark_buffer_size, 1ul << 40, compress);
+      for (const Feature& feature : features) {
+        writer.Write(feature);
+      }
+      write_ms = ElapsedMs(start);
+      writer.Flush();
+      memory = writer.max_buffer_capacity();
+      file_name = writer.FileName(0);
+    }
+    std::cout << "feature writer" << (compress ? ", gzip" : "") << ": "
+              << write_ms << " ms in the caller, " << ElapsedMs(start)
+              << " ms to the file, " << memory / 1024 << " KB in memory, "
+              << FileSize(file_name) / 1024 << " KB file"
+              << std::endl;
+
+    FeatureReader reader;
+    reader.Open(file_name);
+    Feature feature;
+    size_t num_features = 0;
+    while (reader.Next(&feature)) {
+      if (num_features >= features.size() ||
+          feature.SerializeAsString() !=
+              features[num_features].SerializeAsString()) {
+        ++num_mismatches;
+      }
+      ++num_features;
+    }
+    if (num_features != features.size()) {
+      ++num_mismatches;
+    }
+    std::remove(file_name.c_str());
+  }
+  std::remove(former_file.c_str());
+  std::cout << "mismatched features: " << num_mismatches << std::endl;
+  return num_mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::prediction::Run();
+}
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/feature_writer.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/file.h"
+#include "modules/prediction/common/feature_reader.h"
+#include "modules/prediction/proto/offline_features.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+class FeatureWriterTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    prefix_ = "/tmp/feature_writer_test";
+    RemoveFiles();
+  }
+
+  void TearDown() override { RemoveFiles(); }
+
+ protected:
+  static Feature CreateFeature(const int id) {
+    Feature feature;
+    feature.set_id(id);
+    feature.set_timestamp(0.1 * id);
+    for (int i = 0; i < 10; ++i) {
+      feature.mutable_lane()->add_current_lane_feature()->set_lane_id(
+          "lane_" + std::to_string(i));
+    }
+    return feature;
+  }
+
+  static std::vector<int> ReadIds(const std::string& file_name) {
+    std::vector<int> ids;
+    FeatureReader reader;
+    if (!reader.Open(file_name)) {
+      return ids;
+    }
+    Feature feature;
+    while (reader.Next(&feature)) {
+      ids.push_back(feature.id());
+    }
+    return ids;
+  }
+
+  void RemoveFiles() {
+    for (int i = 0; i < 100; ++i) {
+      std::remove((prefix_ + "." + std::to_string(i) + ".bin").c_str());
+      std::remove((prefix_ + "." + std::to_string(i) + ".bin.gz").c_str());
+    }
+  }
+
+  std::string prefix_;
+};
+
+TEST_F(FeatureWriterTest, write_and_read) {
+  {
+    FeatureWriter writer(prefix_, 1 << 10, 1 << 20, false);
+    for (int i = 0; i < 100; ++i) {
+      writer.Write(CreateFeature(i));
+    }
+    EXPECT_EQ(prefix_ + ".0.bin", writer.FileName(0));
+  }
+  const std::vector<int> ids = ReadIds(prefix_ + ".0.bin");
+  ASSERT_EQ(100, ids.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, ids[i]);
+  }
+
+  // The file is a Features message as well.
+  Features features;
+  ASSERT_TRUE(common::util::GetProtoFromBinaryFile(prefix_ + ".0.bin",
+                                                   &features));
+  ASSERT_EQ(100, features.feature_size());
+  EXPECT_EQ(CreateFeature(42).DebugString(),
+            features.feature(42).DebugString());
+}
+
+TEST_F(FeatureWriterTest, next_file) {
+  {
+    FeatureWriter writer(prefix_, 1 << 10, 1 << 20, false);
+    writer.Write(CreateFeature(0));
+    writer.Write(CreateFeature(1));
+    writer.NextFile();
+    writer.NextFile();
+    writer.Write(CreateFeature(2));
+    writer.Flush();
+    EXPECT_EQ(std::vector<int>({0, 1}), ReadIds(prefix_ + ".0.bin"));
+  }
+  EXPECT_EQ(std::vector<int>({2}), ReadIds(prefix_ + ".1.bin"));
+  EXPECT_FALSE(common::util::PathExists(prefix_ + ".2.bin"));
+}
+
+TEST_F(FeatureWriterTest, rotation) {
+  const int feature_size = CreateFeature(0).ByteSize() + 2;
+  {
+    // A buffer of 4 features, and a file of 8.
+    FeatureWriter writer(prefix_, 4 * feature_size, 9 * feature_size, false);
+    for (int i = 0; i < 20; ++i) {
+      writer.Write(CreateFeature(i));
+    }
+  }
+  std::vector<int> ids;
+  for (int i = 0; i < 3; ++i) {
+    const std::vector<int> file_ids =
+        ReadIds(prefix_ + "." + std::to_string(i) + ".bin");
+    EXPECT_EQ(i < 2 ? 8 : 4, file_ids.size());
+    ids.insert(ids.end(), file_ids.begin(), file_ids.end());
+  }
+  ASSERT_EQ(20, ids.size());
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(i, ids[i]);
+  }
+}
+
+TEST_F(FeatureWriterTest, compression) {
+  {
+    FeatureWriter writer(prefix_, 1 << 10, 1 << 20, true);
+    for (int i = 0; i < 1000; ++i) {
+      writer.Write(CreateFeature(i));
+    }
+    EXPECT_EQ(prefix_ + ".0.bin.gz", writer.FileName(0));
+  }
+  const std::vector<int> ids = ReadIds(prefix_ + ".0.bin.gz");
+  ASSERT_EQ(1000, ids.size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i, ids[i]);
+  }
+}
+
+TEST_F(FeatureWriterTest, close) {
+  FeatureWriter writer(prefix_, 1 << 10, 1 << 20, false);
+  writer.Write(CreateFeature(0));
+  writer.Write(CreateFeature(1));
+  writer.Close();
+  EXPECT_EQ(std::vector<int>({0, 1}), ReadIds(prefix_ + ".0.bin"));
+  // Nothing is written after the writer is closed.
+  writer.Write(CreateFeature(2));
+  writer.NextFile();
+  writer.Flush();
+  writer.Close();
+  EXPECT_EQ(std::vector<int>({0, 1}), ReadIds(prefix_ + ".0.bin"));
+  EXPECT_FALSE(common::util::PathExists(prefix_ + ".1.bin"));
+}
+
+TEST_F(FeatureWriterTest, discard) {
+  {
+    FeatureWriter writer(prefix_, 1 << 10, 1 << 20, false);
+    writer.Write(CreateFeature(0));
+    writer.NextFile();
+    writer.Write(CreateFeature(1));
+    writer.Write(CreateFeature(2));
+    writer.Discard();
+  }
+  // The features of the ended file are kept, and the buffered ones dropped.
+  EXPECT_EQ(std::vector<int>({0}), ReadIds(prefix_ + ".0.bin"));
+  EXPECT_FALSE(common::util::PathExists(prefix_ + ".1.bin"));
+}
+
+TEST_F(FeatureWriterTest, memory_ceiling) {
+  const size_t buffer_size = 1 << 12;
+  size_t total_size = 0;
+  {
+    FeatureWriter writer(prefix_, buffer_size, 1 << 30, false);
+    for (int i = 0; i < 20000; ++i) {
+      const Feature feature = CreateFeature(i);
+      total_size += feature.ByteSize();
+      writer.Write(feature);
+    }
+    writer.Flush();
+    // The features far exceed the buffers, which never grow.
+    EXPECT_GT(total_size, 100 * buffer_size);
+    EXPECT_LE(writer.max_buffer_capacity(), 2 * buffer_size);
+  }
+  EXPECT_EQ(20000, ReadIds(prefix_ + ".0.bin").size());
+}
+
+}  // namespace prediction
+}  // namespace apollo
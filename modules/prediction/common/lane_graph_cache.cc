@@ -0,0 +1,204 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include <cmath>
+#include <functional>
+
+#include "modules/common/log.h"
+#include "modules/prediction/common/lane_id_interner.h"
+#include "modules/prediction/common/prediction_map.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::hdmap::LaneInfo;
+
+size_t LaneGraphCache::KeyHash::operator()(const Key& key) const {
+  size_t seed = std::hash<int32_t>()(key.lane_index);
+  seed ^= std::hash<int64_t>()(key.s_bucket) + 0x9e3779b9 + (seed << 6) +
+          (seed >> 2);
+  seed ^= std::hash<int64_t>()(key.length_bucket) + 0x9e3779b9 + (seed << 6) +
+          (seed >> 2);
+  return seed;
+}
+
+LaneGraphCache::LaneGraphCache(const size_t capacity,
+                               const double s_resolution,
+                               const double length_resolution)
+    : capacity_(capacity),
+      s_resolution_(s_resolution),
+      length_resolution_(length_resolution) {
+  CHECK_GT(capacity_, 0);
+  CHECK_GT(s_resolution_, 0.0);
+  CHECK_GT(length_resolution_, 0.0);
+}
+
+std::shared_ptr<const LaneGraph> LaneGraphCache::GetLaneGraph(
+    const double start_s, const double length,
+    std::shared_ptr<const LaneInfo> lane_info_ptr) {
+  if (lane_info_ptr == nullptr || length < 0.0) {
+    AERROR << "Invalid lane graph settings. Lane graph length = " << length;
+    return std::make_shared<const LaneGraph>();
+  }
+
+  // The graph is built from the quantized start s, with a length that still
+  // covers [start_s, start_s + length].
+  Key key;
+  key.lane_index = LaneIdInterner::Intern(lane_info_ptr->id().id());
+  key.s_bucket = static_cast<int64_t>(std::floor(start_s / s_resolution_));
+  const double quantized_start_s = key.s_bucket * s_resolution_;
+  key.length_bucket = static_cast<int64_t>(
+      std::ceil((start_s - quantized_start_s + length) / length_resolution_));
+  const double quantized_length = key.length_bucket * length_resolution_;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      ++num_hits_;
+      return it->second->second;
+    }
+    ++num_misses_;
+  }
+
+  std::shared_ptr<LaneGraph> lane_graph = std::make_shared<LaneGraph>();
+  std::vector<LaneSegment> lane_segments;
+  GetLaneNode(key.lane_index, lane_info_ptr);
+  ComputeLaneSequence(0.0, quantized_start_s, quantized_length,
+                      key.lane_index, &lane_segments, lane_graph.get());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // Another thread built the same graph in the meantime.
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+  entries_.emplace_front(key, lane_graph);
+  index_[key] = entries_.begin();
+  if (entries_.size() > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  return lane_graph;
+}
+
+void LaneGraphCache::Clear() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    num_hits_ = 0;
+    num_misses_ = 0;
+  }
+  std::lock_guard<std::mutex> lock(topology_mutex_);
+  lane_nodes_.clear();
+}
+
+size_t LaneGraphCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+uint64_t LaneGraphCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+uint64_t LaneGraphCache::num_misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+const LaneGraphCache::LaneNode* LaneGraphCache::GetLaneNode(
+    const int32_t lane_index, std::shared_ptr<const LaneInfo> lane_info_ptr) {
+  {
+    std::lock_guard<std::mutex> lock(topology_mutex_);
+    auto it = lane_nodes_.find(lane_index);
+    if (it != lane_nodes_.end()) {
+      return it->second.get();
+    }
+  }
+
+  if (lane_info_ptr == nullptr) {
+    lane_info_ptr =
+        PredictionMap::LaneById(LaneIdInterner::LaneId(lane_index));
+    if (lane_info_ptr == nullptr) {
+      return nullptr;
+    }
+  }
+  std::unique_ptr<LaneNode> lane_node(new LaneNode());
+  lane_node->total_length = lane_info_ptr->total_length();
+  lane_node->turn_type = static_cast<int>(lane_info_ptr->lane().turn());
+  lane_node->successors.reserve(lane_info_ptr->lane().successor_id_size());
+  for (const auto& successor_lane_id : lane_info_ptr->lane().successor_id()) {
+    lane_node->successors.push_back(
+        LaneIdInterner::Intern(successor_lane_id.id()));
+  }
+
+  std::lock_guard<std::mutex> lock(topology_mutex_);
+  auto& published = lane_nodes_[lane_index];
+  if (published == nullptr) {
+    published = std::move(lane_node);
+  }
+  return published.get();
+}
+
+void LaneGraphCache::ComputeLaneSequence(
+    const double accumulated_s, const double start_s, const double length,
+    const int32_t lane_index, std::vector<LaneSegment>* const lane_segments,
+    LaneGraph* const lane_graph_ptr) {
+  const LaneNode* lane_node = GetLaneNode(lane_index, nullptr);
+  if (lane_node == nullptr) {
+    AERROR << "Invalid lane.";
+    return;
+  }
+
+  const bool reaches_length =
+      accumulated_s + lane_node->total_length - start_s >= length;
+  LaneSegment lane_segment;
+  lane_segment.set_lane_id(LaneIdInterner::LaneId(lane_index));
+  lane_segment.set_start_s(start_s);
+  lane_segment.set_lane_turn_type(lane_node->turn_type);
+  if (reaches_length) {
+    lane_segment.set_end_s(length - accumulated_s + start_s);
+  } else {
+    lane_segment.set_end_s(lane_node->total_length);
+  }
+  lane_segment.set_total_length(lane_node->total_length);
+  lane_segments->push_back(std::move(lane_segment));
+
+  if (reaches_length || lane_node->successors.empty()) {
+    LaneSequence* sequence = lane_graph_ptr->add_lane_sequence();
+    *sequence->mutable_lane_segment() = {lane_segments->begin(),
+                                         lane_segments->end()};
+    sequence->set_label(0);
+  } else {
+    const double successor_accumulated_s =
+        accumulated_s + lane_node->total_length - start_s;
+    for (const int32_t successor_index : lane_node->successors) {
+      ComputeLaneSequence(successor_accumulated_s, 0.0, length,
+                          successor_index, lane_segments, lane_graph_ptr);
+    }
+  }
+  lane_segments->pop_back();
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Bounded, thread-safe cache of lane graphs.
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
+#define MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/prediction/proto/lane_graph.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+class LaneGraphCache {
+ public:
+  /**
+   * @brief Constructor
+   * @param capacity The maximal number of cached lane graphs.
+   * @param s_resolution The quantization step of the starting s.
+   * @param length_resolution The quantization step of the graph length.
+   */
+  LaneGraphCache(const size_t capacity, const double s_resolution,
+                 const double length_resolution);
+
+  /**
+   * @brief Obtain the lane graph of a lane, building it on a miss.
+   *        Graphs are built outside of the cache lock, so that different
+   *        threads can build different graphs concurrently.
+   * @param start_s The starting longitudinal s value.
+   * @param length The length to build the lane graph.
+   * @param lane_info_ptr The starting lane.
+   * @return The lane graph. The start_s of its first lane segments is the
+   *         quantized one, not the given one.
+   */
+  std::shared_ptr<const LaneGraph> GetLaneGraph(
+      const double start_s, const double length,
+      std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr);
+
+  /**
+   * @brief Remove all cached lane graphs and lane topology.
+   */
+  void Clear();
+
+  /**
+   * @brief Get the number of cached lane graphs.
+   * @return The number of cached lane graphs.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Get the number of lookups served from the cache.
+   * @return The number of cache hits.
+   */
+  uint64_t num_hits() const;
+
+  /**
+   * @brief Get the number of lookups that built a new lane graph.
+   * @return The number of cache misses.
+   */
+  uint64_t num_misses() const;
+
+ private:
+  struct Key {
+    int32_t lane_index;
+    int64_t s_bucket;
+    int64_t length_bucket;
+    bool operator==(const Key& other) const {
+      return lane_index == other.lane_index && s_bucket == other.s_bucket &&
+             length_bucket == other.length_bucket;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  // Immutable once published. Successors are dense LaneIdInterner indices.
+  struct LaneNode {
+    double total_length = 0.0;
+    int turn_type = 1;
+    std::vector<int32_t> successors;
+  };
+
+  const LaneNode* GetLaneNode(
+      const int32_t lane_index,
+      std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr);
+
+  void ComputeLaneSequence(const double accumulated_s, const double start_s,
+                           const double length, const int32_t lane_index,
+                           std::vector<LaneSegment>* const lane_segments,
+                           LaneGraph* const lane_graph_ptr);
+
+ private:
+  typedef std::pair<Key, std::shared_ptr<const LaneGraph>> Entry;
+
+  size_t capacity_ = 0;
+  double s_resolution_ = 1.0;
+  double length_resolution_ = 1.0;
+
+  mutable std::mutex mutex_;
+  // Most recently used entries are at the front.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  uint64_t num_hits_ = 0;
+  uint64_t num_misses_ = 0;
+
+  std::mutex topology_mutex_;
+  std::unordered_map<int32_t, std::unique_ptr<LaneNode>> lane_nodes_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
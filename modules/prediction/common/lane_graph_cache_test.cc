@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_map.h"
+#include "modules/prediction/common/road_graph.h"
+
+namespace apollo {
+namespace prediction {
+
+class LaneGraphCacheTest : public KMLMapBasedTest {};
+
+TEST_F(LaneGraphCacheTest, SameAsRoadGraph) {
+  auto lane = PredictionMap::LaneById("l9");
+  ASSERT_TRUE(lane != nullptr);
+  LaneGraphCache cache(10, 1.0, 1.0);
+
+  for (const double length : {10.0, 50.0, 100.0, 500.0}) {
+    LaneGraph expected;
+    RoadGraph road_graph(99.0, length, lane);
+    EXPECT_TRUE(road_graph.BuildLaneGraph(&expected).ok());
+
+    auto lane_graph = cache.GetLaneGraph(99.0, length, lane);
+    ASSERT_TRUE(lane_graph != nullptr);
+    EXPECT_EQ(expected.DebugString(), lane_graph->DebugString());
+  }
+}
+
+TEST_F(LaneGraphCacheTest, Quantization) {
+  auto lane = PredictionMap::LaneById("l9");
+  ASSERT_TRUE(lane != nullptr);
+  LaneGraphCache cache(10, 1.0, 5.0);
+
+  auto lane_graph = cache.GetLaneGraph(99.2, 48.0, lane);
+  EXPECT_EQ(0, cache.num_hits());
+  EXPECT_EQ(1, cache.num_misses());
+  EXPECT_EQ(lane_graph, cache.GetLaneGraph(99.7, 48.5, lane));
+  EXPECT_EQ(1, cache.num_hits());
+
+  // The graph starts at the quantized s and still covers the given range.
+  ASSERT_EQ(1, lane_graph->lane_sequence_size());
+  const LaneSequence& sequence = lane_graph->lane_sequence(0);
+  ASSERT_EQ(2, sequence.lane_segment_size());
+  EXPECT_DOUBLE_EQ(99.0, sequence.lane_segment(0).start_s());
+  EXPECT_EQ("l18", sequence.lane_segment(1).lane_id());
+  double total_length = 0.0;
+  for (const auto& lane_segment : sequence.lane_segment()) {
+    total_length += lane_segment.end_s() - lane_segment.start_s();
+  }
+  EXPECT_DOUBLE_EQ(50.0, total_length);
+
+  EXPECT_NE(lane_graph, cache.GetLaneGraph(99.2, 100.0, lane));
+  EXPECT_NE(lane_graph, cache.GetLaneGraph(10.0, 48.0, lane));
+  EXPECT_EQ(3, cache.size());
+}
+
+TEST_F(LaneGraphCacheTest, Eviction) {
+  auto lane = PredictionMap::LaneById("l9");
+  ASSERT_TRUE(lane != nullptr);
+  LaneGraphCache cache(2, 1.0, 1.0);
+
+  auto lane_graph_0 = cache.GetLaneGraph(0.0, 50.0, lane);
+  auto lane_graph_1 = cache.GetLaneGraph(1.0, 50.0, lane);
+  EXPECT_EQ(lane_graph_0, cache.GetLaneGraph(0.0, 50.0, lane));
+  cache.GetLaneGraph(2.0, 50.0, lane);
+  EXPECT_EQ(2, cache.size());
+
+  // The least recently used graph is evicted, handed out ones stay valid.
+  EXPECT_EQ(lane_graph_0, cache.GetLaneGraph(0.0, 50.0, lane));
+  EXPECT_NE(lane_graph_1, cache.GetLaneGraph(1.0, 50.0, lane));
+  EXPECT_EQ("l9", lane_graph_1->lane_sequence(0).lane_segment(0).lane_id());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.num_hits());
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_id_interner.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+constexpr int32_t LaneIdInterner::kInvalidIndex;
+std::mutex LaneIdInterner::mutex_;
+std::deque<std::string> LaneIdInterner::lane_ids_;
+std::unordered_map<std::string, int32_t> LaneIdInterner::indices_;
+
+int32_t LaneIdInterner::Intern(const std::string& lane_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = indices_.find(lane_id);
+  if (it != indices_.end()) {
+    return it->second;
+  }
+  const int32_t index = static_cast<int32_t>(lane_ids_.size());
+  lane_ids_.push_back(lane_id);
+  indices_.emplace(lane_id, index);
+  return index;
+}
+
+int32_t LaneIdInterner::Find(const std::string& lane_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = indices_.find(lane_id);
+  if (it == indices_.end()) {
+    return kInvalidIndex;
+  }
+  return it->second;
+}
+
+const std::string& LaneIdInterner::LaneId(const int32_t index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_GE(index, 0);
+  CHECK_LT(static_cast<size_t>(index), lane_ids_.size());
+  return lane_ids_[index];
+}
+
+size_t LaneIdInterner::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lane_ids_.size();
+}
+
+}  // namespace prediction
+}  // namespace apollo
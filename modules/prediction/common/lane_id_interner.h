@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Process-wide mapping between lane id strings and dense indices.
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_LANE_ID_INTERNER_H_
+#define MODULES_PREDICTION_COMMON_LANE_ID_INTERNER_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace apollo {
+namespace prediction {
+
+class LaneIdInterner {
+ public:
+  /**
+   * @brief Index returned for lanes that have not been interned.
+   */
+  static constexpr int32_t kInvalidIndex = -1;
+
+  /**
+   * @brief Get the dense index of a lane id, assigning a new one if needed.
+   * @param lane_id The lane id.
+   * @return The dense index of the lane id.
+   */
+  static int32_t Intern(const std::string& lane_id);
+
+  /**
+   * @brief Get the dense index of a lane id without assigning a new one.
+   * @param lane_id The lane id.
+   * @return The dense index, or kInvalidIndex if the lane id is unknown.
+   */
+  static int32_t Find(const std::string& lane_id);
+
+  /**
+   * @brief Get the lane id of a dense index.
+   * @param index The dense index returned by Intern().
+   * @return The lane id. The reference stays valid for the process lifetime.
+   */
+  static const std::string& LaneId(const int32_t index);
+
+  /**
+   * @brief Get the number of interned lane ids.
+   * @return The number of interned lane ids.
+   */
+  static size_t Size();
+
+ private:
+  static std::mutex mutex_;
+  // std::deque keeps references stable while growing.
+  static std::deque<std::string> lane_ids_;
+  static std::unordered_map<std::string, int32_t> indices_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_LANE_ID_INTERNER_H_
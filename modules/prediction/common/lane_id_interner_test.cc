@@ -0,0 +1,38 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_id_interner.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+TEST(LaneIdInternerTest, intern_and_lookup) {
+  const int32_t index_a = LaneIdInterner::Intern("interner_test_lane_a");
+  const int32_t index_b = LaneIdInterner::Intern("interner_test_lane_b");
+  EXPECT_NE(index_a, index_b);
+  EXPECT_EQ(index_a, LaneIdInterner::Intern("interner_test_lane_a"));
+  EXPECT_EQ(index_b, LaneIdInterner::Find("interner_test_lane_b"));
+  EXPECT_EQ("interner_test_lane_a", LaneIdInterner::LaneId(index_a));
+  EXPECT_EQ("interner_test_lane_b", LaneIdInterner::LaneId(index_b));
+  EXPECT_EQ(LaneIdInterner::kInvalidIndex,
+            LaneIdInterner::Find("interner_test_lane_unknown"));
+  EXPECT_GE(LaneIdInterner::Size(), 2);
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -29,6 +29,14 @@ DEFINE_string(prediction_adapter_config_filename,
               "Default conf file for prediction");
 DEFINE_string(prediction_data_file_prefix, "data/prediction/feature",
               "Prefix of files to store feature data");
+DEFINE_int32(prediction_data_buffer_size, 1 << 20,
+             "Size in bytes of each of the two buffers of the features to "
+             "write to the files");
+DEFINE_int32(prediction_data_max_file_size, 256 << 20,
+             "Max size in bytes of the features in a file, beyond which they "
+             "are written to the next file");
+DEFINE_bool(prediction_data_compression, false,
+            "Whether to compress the feature files with gzip");
 DEFINE_bool(prediction_test_mode, false, "Set prediction to test mode");
 DEFINE_double(
     prediction_test_duration, -1.0,
@@ -77,6 +85,23 @@ DEFINE_double(still_obstacle_position_std, 1.0,
 DEFINE_double(still_pedestrian_position_std, 0.5,
               "Position standard deviation for still obstacles");
 DEFINE_double(max_history_time, 7.0, "Obstacles' maximal historical time.");
+DEFINE_int32(max_num_feature_history, 80,
+             "Capacity of the per-obstacle feature history ring");
+DEFINE_bool(enable_batch_kf_tracking, false,
+            "Update obstacle motion KFs of a frame in one batch");
+DEFINE_bool(enable_parallel_lane_graph_building, false,
+            "Build the lane graphs of a frame's obstacles in parallel, "
+            "only effective with enable_batch_kf_tracking");
+DEFINE_int32(num_prediction_thread_pool, 4,
+             "Number of threads in the prediction thread pool");
+DEFINE_bool(enable_parallel_prediction, false,
+            "Run evaluators and predictors of obstacles in parallel");
+DEFINE_int32(max_num_lane_graph_cache, 1000,
+             "Max number of cached lane graphs");
+DEFINE_double(lane_graph_cache_s_resolution, 1.0,
+              "Quantization step of the starting s of cached lane graphs");
+DEFINE_double(lane_graph_cache_length_resolution, 1.0,
+              "Quantization step of the length of cached lane graphs");
 DEFINE_double(target_lane_gap, 2.0, "gap between two lane points.");
 DEFINE_int32(max_num_current_lane, 2, "Max number to search current lanes");
 DEFINE_int32(max_num_nearby_lane, 2, "Max number to search nearby lanes");
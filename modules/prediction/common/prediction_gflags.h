@@ -24,6 +24,9 @@ DECLARE_string(prediction_module_name);
 DECLARE_string(prediction_conf_file);
 DECLARE_string(prediction_adapter_config_filename);
 DECLARE_string(prediction_data_file_prefix);
+DECLARE_int32(prediction_data_buffer_size);
+DECLARE_int32(prediction_data_max_file_size);
+DECLARE_bool(prediction_data_compression);
 
 DECLARE_bool(prediction_test_mode);
 DECLARE_double(prediction_test_duration);
@@ -60,6 +63,14 @@ DECLARE_double(still_pedestrian_speed_threshold);
 DECLARE_double(still_obstacle_position_std);
 DECLARE_double(still_pedestrian_position_std);
 DECLARE_double(max_history_time);
+DECLARE_int32(max_num_feature_history);
+DECLARE_bool(enable_batch_kf_tracking);
+DECLARE_bool(enable_parallel_lane_graph_building);
+DECLARE_int32(num_prediction_thread_pool);
+DECLARE_bool(enable_parallel_prediction);
+DECLARE_int32(max_num_lane_graph_cache);
+DECLARE_double(lane_graph_cache_s_resolution);
+DECLARE_double(lane_graph_cache_length_resolution);
 DECLARE_double(target_lane_gap);
 DECLARE_int32(max_num_current_lane);
 DECLARE_int32(max_num_nearby_lane);
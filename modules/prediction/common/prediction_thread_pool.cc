@@ -0,0 +1,46 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/prediction_thread_pool.h"
+
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+PredictionThreadPool::PredictionThreadPool() {}
+
+void PredictionThreadPool::Init() {
+  if (is_initialized) {
+    if (thread_pool_->size() != FLAGS_num_prediction_thread_pool) {
+      thread_pool_->Resize(FLAGS_num_prediction_thread_pool);
+    }
+    return;
+  }
+  thread_pool_.reset(
+      new common::util::ThreadPool(FLAGS_num_prediction_thread_pool));
+  is_initialized = true;
+}
+
+void PredictionThreadPool::Synchronize() {
+  for (auto& future : futures_) {
+    future.wait();
+  }
+  futures_.clear();
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/batch_motion_tracker.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+bool BatchMotionTracker::IsInitialized(const int id) const {
+  return slots_.find(id) != slots_.end();
+}
+
+void BatchMotionTracker::Init(const int id,
+                              const Eigen::Matrix<double, 6, 1>& state,
+                              const double p_var) {
+  size_t slot = 0;
+  auto it = slots_.find(id);
+  if (it != slots_.end()) {
+    slot = it->second;
+  } else if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+    slots_.emplace(id, slot);
+  } else {
+    slot = x_.size();
+    slots_.emplace(id, slot);
+    for (auto* column : {&x_, &y_, &vx_, &vy_, &ax_, &ay_, &p00_, &p01_,
+                         &p02_, &p11_, &p12_, &p22_, &delta_ts_, &z_x_,
+                         &z_y_}) {
+      column->push_back(0.0);
+    }
+  }
+  x_[slot] = state(0, 0);
+  y_[slot] = state(1, 0);
+  vx_[slot] = state(2, 0);
+  vy_[slot] = state(3, 0);
+  ax_[slot] = state(4, 0);
+  ay_[slot] = state(5, 0);
+  p00_[slot] = p_var;
+  p01_[slot] = 0.0;
+  p02_[slot] = 0.0;
+  p11_[slot] = p_var;
+  p12_[slot] = 0.0;
+  p22_[slot] = p_var;
+  delta_ts_[slot] = 0.0;
+}
+
+void BatchMotionTracker::AddObservation(const int id, const double delta_ts,
+                                        const double x, const double y) {
+  const size_t slot = Slot(id);
+  delta_ts_[slot] = delta_ts;
+  z_x_[slot] = x;
+  z_y_[slot] = y;
+}
+
+void BatchMotionTracker::Update(const double q_var, const double r_var) {
+  const size_t num_slots = x_.size();
+  for (size_t i = 0; i < num_slots; ++i) {
+    const double dt = delta_ts_[i];
+    // Slots without an observation go through an identity update.
+    const double mask = dt > 0.0 ? 1.0 : 0.0;
+    const double half_dt2 = 0.5 * dt * dt;
+
+    // Predict: x' = F * x with F = [1 dt dt^2/2; 0 1 dt; 0 0 1] per axis.
+    const double x = x_[i] + dt * vx_[i] + half_dt2 * ax_[i];
+    const double y = y_[i] + dt * vy_[i] + half_dt2 * ay_[i];
+    const double vx = vx_[i] + dt * ax_[i];
+    const double vy = vy_[i] + dt * ay_[i];
+
+    // Predict: P' = F * P * F^T + Q.
+    const double fp00 = p00_[i] + dt * p01_[i] + half_dt2 * p02_[i];
+    const double fp01 = p01_[i] + dt * p11_[i] + half_dt2 * p12_[i];
+    const double fp02 = p02_[i] + dt * p12_[i] + half_dt2 * p22_[i];
+    const double fp11 = p11_[i] + dt * p12_[i];
+    const double fp12 = p12_[i] + dt * p22_[i];
+    const double pp00 = fp00 + dt * fp01 + half_dt2 * fp02 + mask * q_var;
+    const double pp01 = fp01 + dt * fp02;
+    const double pp02 = fp02;
+    const double pp11 = fp11 + dt * fp12 + mask * q_var;
+    const double pp12 = fp12;
+    const double pp22 = p22_[i] + mask * q_var;
+
+    // Correct with H = [1 0 0] per axis, both axes share the same gain.
+    const double s_inv = mask / (pp00 + r_var);
+    const double k0 = pp00 * s_inv;
+    const double k1 = pp01 * s_inv;
+    const double k2 = pp02 * s_inv;
+    const double innovation_x = z_x_[i] - x;
+    const double innovation_y = z_y_[i] - y;
+
+    x_[i] = x + k0 * innovation_x;
+    y_[i] = y + k0 * innovation_y;
+    vx_[i] = vx + k1 * innovation_x;
+    vy_[i] = vy + k1 * innovation_y;
+    ax_[i] += k2 * innovation_x;
+    ay_[i] += k2 * innovation_y;
+
+    p00_[i] = pp00 - k0 * pp00;
+    p01_[i] = pp01 - k0 * pp01;
+    p02_[i] = pp02 - k0 * pp02;
+    p11_[i] = pp11 - k1 * pp01;
+    p12_[i] = pp12 - k1 * pp02;
+    p22_[i] = pp22 - k2 * pp02;
+
+    delta_ts_[i] = 0.0;
+  }
+}
+
+Eigen::Matrix<double, 6, 1> BatchMotionTracker::GetStateEstimate(
+    const int id) const {
+  const size_t slot = Slot(id);
+  Eigen::Matrix<double, 6, 1> state;
+  state << x_[slot], y_[slot], vx_[slot], vy_[slot], ax_[slot], ay_[slot];
+  return state;
+}
+
+Eigen::Matrix<double, 6, 6> BatchMotionTracker::GetStateCovariance(
+    const int id) const {
+  const size_t slot = Slot(id);
+  Eigen::Matrix<double, 3, 3> axis_covariance;
+  axis_covariance << p00_[slot], p01_[slot], p02_[slot], p01_[slot],
+      p11_[slot], p12_[slot], p02_[slot], p12_[slot], p22_[slot];
+  // State order is [x, y, vx, vy, ax, ay], so axis a and order k map to
+  // index a + 2 * k.
+  Eigen::Matrix<double, 6, 6> covariance;
+  covariance.setZero();
+  for (int axis = 0; axis < 2; ++axis) {
+    for (int k = 0; k < 3; ++k) {
+      for (int m = 0; m < 3; ++m) {
+        covariance(axis + 2 * k, axis + 2 * m) = axis_covariance(k, m);
+      }
+    }
+  }
+  return covariance;
+}
+
+void BatchMotionTracker::Remove(const int id) {
+  auto it = slots_.find(id);
+  if (it == slots_.end()) {
+    return;
+  }
+  delta_ts_[it->second] = 0.0;
+  free_slots_.push_back(it->second);
+  slots_.erase(it);
+}
+
+void BatchMotionTracker::Clear() {
+  slots_.clear();
+  free_slots_.clear();
+  for (auto* column : {&x_, &y_, &vx_, &vy_, &ax_, &ay_, &p00_, &p01_, &p02_,
+                       &p11_, &p12_, &p22_, &delta_ts_, &z_x_, &z_y_}) {
+    column->clear();
+  }
+}
+
+size_t BatchMotionTracker::Slot(const int id) const {
+  auto it = slots_.find(id);
+  CHECK(it != slots_.end()) << "Obstacle [" << id << "] is not tracked.";
+  return it->second;
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Structure-of-arrays constant acceleration Kalman filters for all
+ *        tracked obstacles of a frame.
+ */
+
+#ifndef MODULES_PREDICTION_CONTAINER_OBSTACLES_BATCH_MOTION_TRACKER_H_
+#define MODULES_PREDICTION_CONTAINER_OBSTACLES_BATCH_MOTION_TRACKER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "Eigen/Dense"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class BatchMotionTracker
+ * @brief Runs the motion Kalman filter of Obstacle (state [x, y, vx, vy, ax,
+ *        ay], position observation) for many obstacles at once.
+ *
+ *        With identity initial covariance, isotropic transition and
+ *        observation noise and a position-only observation, the x and y
+ *        chains of the filter never couple and always share the same 3x3
+ *        covariance. Each obstacle therefore only stores six states and six
+ *        covariance entries, and predict/correct reduce to closed-form scalar
+ *        updates that run over contiguous arrays.
+ */
+class BatchMotionTracker {
+ public:
+  /**
+   * @brief Constructor
+   */
+  BatchMotionTracker() = default;
+
+  /**
+   * @brief Check if an obstacle has an initialized filter.
+   * @param id The obstacle id.
+   * @return True if the obstacle has an initialized filter.
+   */
+  bool IsInitialized(const int id) const;
+
+  /**
+   * @brief Initialize the filter of an obstacle.
+   * @param id The obstacle id.
+   * @param state The initial state [x, y, vx, vy, ax, ay].
+   * @param p_var The initial state variance.
+   */
+  void Init(const int id, const Eigen::Matrix<double, 6, 1>& state,
+            const double p_var);
+
+  /**
+   * @brief Queue a position observation to be fused by the next Update().
+   * @param id The obstacle id, must be initialized.
+   * @param delta_ts The time elapsed since the last update.
+   * @param x The observed x position.
+   * @param y The observed y position.
+   */
+  void AddObservation(const int id, const double delta_ts, const double x,
+                      const double y);
+
+  /**
+   * @brief Predict and correct all filters with a queued observation.
+   * @param q_var The transition noise variance.
+   * @param r_var The observation noise variance.
+   */
+  void Update(const double q_var, const double r_var);
+
+  /**
+   * @brief Get the state estimate of an obstacle.
+   * @param id The obstacle id, must be initialized.
+   * @return The state [x, y, vx, vy, ax, ay].
+   */
+  Eigen::Matrix<double, 6, 1> GetStateEstimate(const int id) const;
+
+  /**
+   * @brief Get the full state covariance of an obstacle.
+   * @param id The obstacle id, must be initialized.
+   * @return The 6x6 state covariance.
+   */
+  Eigen::Matrix<double, 6, 6> GetStateCovariance(const int id) const;
+
+  /**
+   * @brief Remove the filter of an obstacle.
+   * @param id The obstacle id.
+   */
+  void Remove(const int id);
+
+  /**
+   * @brief Remove all filters.
+   */
+  void Clear();
+
+  /**
+   * @brief Get the number of filters.
+   * @return The number of filters.
+   */
+  size_t size() const { return slots_.size(); }
+
+ private:
+  size_t Slot(const int id) const;
+
+ private:
+  std::unordered_map<int, size_t> slots_;
+  std::vector<size_t> free_slots_;
+
+  // State, one entry per slot.
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> vx_;
+  std::vector<double> vy_;
+  std::vector<double> ax_;
+  std::vector<double> ay_;
+
+  // Upper triangle of the per-axis covariance [p, v, a].
+  std::vector<double> p00_;
+  std::vector<double> p01_;
+  std::vector<double> p02_;
+  std::vector<double> p11_;
+  std::vector<double> p12_;
+  std::vector<double> p22_;
+
+  // Queued observations, delta_ts_ is zero for slots without one.
+  std::vector<double> delta_ts_;
+  std::vector<double> z_x_;
+  std::vector<double> z_y_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_CONTAINER_OBSTACLES_BATCH_MOTION_TRACKER_H_
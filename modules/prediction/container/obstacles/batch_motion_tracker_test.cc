@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/batch_motion_tracker.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/kalman_filter.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::math::KalmanFilter;
+
+namespace {
+
+constexpr double kPVar = 0.1;
+constexpr double kQVar = 0.01;
+constexpr double kRVar = 0.25;
+
+// Reference filter set up the same way as Obstacle::InitKFMotionTracker.
+KalmanFilter<double, 6, 2, 0> MakeReferenceFilter(
+    const Eigen::Matrix<double, 6, 1>& state) {
+  KalmanFilter<double, 6, 2, 0> kf;
+  Eigen::Matrix<double, 6, 6> F;
+  F.setIdentity();
+  kf.SetTransitionMatrix(F);
+  Eigen::Matrix<double, 2, 6> H;
+  H.setIdentity();
+  kf.SetObservationMatrix(H);
+  Eigen::Matrix<double, 6, 6> Q;
+  Q.setIdentity();
+  kf.SetTransitionNoise(Q * kQVar);
+  Eigen::Matrix<double, 2, 2> R;
+  R.setIdentity();
+  kf.SetObservationNoise(R * kRVar);
+  Eigen::Matrix<double, 6, 6> P;
+  P.setIdentity();
+  kf.SetStateEstimate(state, P * kPVar);
+  return kf;
+}
+
+void UpdateReferenceFilter(const double dt, const double x, const double y,
+                           KalmanFilter<double, 6, 2, 0>* kf) {
+  auto F = kf->GetTransitionMatrix();
+  F(0, 2) = dt;
+  F(0, 4) = 0.5 * dt * dt;
+  F(1, 3) = dt;
+  F(1, 5) = 0.5 * dt * dt;
+  F(2, 4) = dt;
+  F(3, 5) = dt;
+  kf->SetTransitionMatrix(F);
+  kf->Predict();
+  Eigen::Matrix<double, 2, 1> z;
+  z << x, y;
+  kf->Correct(z);
+}
+
+}  // namespace
+
+TEST(BatchMotionTrackerTest, matches_kalman_filter) {
+  BatchMotionTracker tracker;
+  std::vector<KalmanFilter<double, 6, 2, 0>> reference;
+  const int num_obstacles = 5;
+  for (int id = 0; id < num_obstacles; ++id) {
+    Eigen::Matrix<double, 6, 1> state;
+    state << id * 10.0, -id * 2.0, 5.0 + id, 1.0 - id, 0.1 * id, -0.2;
+    tracker.Init(id, state, kPVar);
+    reference.push_back(MakeReferenceFilter(state));
+  }
+
+  for (int frame = 1; frame <= 20; ++frame) {
+    for (int id = 0; id < num_obstacles; ++id) {
+      // Obstacle 3 misses every other frame.
+      if (id == 3 && frame % 2 == 0) {
+        continue;
+      }
+      const double dt = (id == 3) ? 0.2 : 0.1;
+      const double t = frame * 0.1;
+      const double x = id * 10.0 + (5.0 + id) * t + 0.05 * (frame % 3);
+      const double y = -id * 2.0 + (1.0 - id) * t - 0.03 * (frame % 2);
+      tracker.AddObservation(id, dt, x, y);
+      UpdateReferenceFilter(dt, x, y, &reference[id]);
+    }
+    tracker.Update(kQVar, kRVar);
+  }
+
+  for (int id = 0; id < num_obstacles; ++id) {
+    const auto state = tracker.GetStateEstimate(id);
+    const auto expected_state = reference[id].GetStateEstimate();
+    const auto covariance = tracker.GetStateCovariance(id);
+    const auto expected_covariance = reference[id].GetStateCovariance();
+    for (int i = 0; i < 6; ++i) {
+      EXPECT_NEAR(expected_state(i, 0), state(i, 0), 1e-9);
+      for (int j = 0; j < 6; ++j) {
+        EXPECT_NEAR(expected_covariance(i, j), covariance(i, j), 1e-9);
+      }
+    }
+  }
+}
+
+TEST(BatchMotionTrackerTest, remove_and_reuse) {
+  BatchMotionTracker tracker;
+  Eigen::Matrix<double, 6, 1> state;
+  state.setZero();
+  tracker.Init(1, state, kPVar);
+  tracker.Init(2, state, kPVar);
+  EXPECT_EQ(2, tracker.size());
+  EXPECT_TRUE(tracker.IsInitialized(1));
+
+  tracker.Remove(1);
+  EXPECT_FALSE(tracker.IsInitialized(1));
+  EXPECT_EQ(1, tracker.size());
+
+  state(0, 0) = 3.0;
+  tracker.Init(7, state, kPVar);
+  EXPECT_TRUE(tracker.IsInitialized(7));
+  EXPECT_DOUBLE_EQ(3.0, tracker.GetStateEstimate(7)(0, 0));
+
+  // Without an observation the filter is left untouched.
+  tracker.Update(kQVar, kRVar);
+  EXPECT_DOUBLE_EQ(3.0, tracker.GetStateEstimate(7)(0, 0));
+  EXPECT_DOUBLE_EQ(kPVar, tracker.GetStateCovariance(7)(0, 0));
+
+  tracker.Clear();
+  EXPECT_EQ(0, tracker.size());
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,285 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include <algorithm>
+
+#include "modules/common/log.h"
+#include "modules/prediction/common/lane_id_interner.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::perception::PerceptionObstacle;
+
+namespace {
+
+constexpr size_t kMinAllocatedSlots = 4;
+
+}  // namespace
+
+void CompactFeature::FromFeature(const Feature& feature) {
+  presence = 0;
+  if (feature.has_id()) {
+    presence |= kHasId;
+  }
+  id = feature.id();
+  type = static_cast<int32_t>(feature.type());
+  timestamp = feature.timestamp();
+  position[0] = feature.position().x();
+  position[1] = feature.position().y();
+  position[2] = feature.position().z();
+  if (feature.has_t_position()) {
+    presence |= kHasTPosition;
+  }
+  t_position[0] = feature.t_position().x();
+  t_position[1] = feature.t_position().y();
+  t_position[2] = feature.t_position().z();
+  velocity[0] = feature.velocity().x();
+  velocity[1] = feature.velocity().y();
+  velocity[2] = feature.velocity().z();
+  acceleration[0] = feature.acceleration().x();
+  acceleration[1] = feature.acceleration().y();
+  acceleration[2] = feature.acceleration().z();
+  velocity_heading = feature.velocity_heading();
+  speed = feature.speed();
+  acc = feature.acc();
+  theta = feature.theta();
+  length = feature.length();
+  width = feature.width();
+  height = feature.height();
+  if (feature.is_still()) {
+    presence |= kIsStill;
+  }
+
+  lane_id_index = LaneIdInterner::kInvalidIndex;
+  if (feature.has_lane()) {
+    presence |= kHasLane;
+    if (feature.lane().has_lane_feature()) {
+      presence |= kHasLaneFeature;
+      const LaneFeature& lane_feature = feature.lane().lane_feature();
+      if (lane_feature.has_lane_id()) {
+        lane_id_index = LaneIdInterner::Intern(lane_feature.lane_id());
+      }
+      lane_turn_type = lane_feature.lane_turn_type();
+      lane_s = lane_feature.lane_s();
+      lane_l = lane_feature.lane_l();
+      angle_diff = lane_feature.angle_diff();
+      dist_to_left_boundary = lane_feature.dist_to_left_boundary();
+      dist_to_right_boundary = lane_feature.dist_to_right_boundary();
+    }
+  }
+}
+
+void CompactFeature::ToFeature(Feature* feature) const {
+  CHECK_NOTNULL(feature);
+  feature->Clear();
+  if (has(kHasId)) {
+    feature->set_id(id);
+  }
+  feature->set_type(static_cast<PerceptionObstacle::Type>(type));
+  feature->set_timestamp(timestamp);
+  feature->mutable_position()->set_x(position[0]);
+  feature->mutable_position()->set_y(position[1]);
+  feature->mutable_position()->set_z(position[2]);
+  if (has(kHasTPosition)) {
+    feature->mutable_t_position()->set_x(t_position[0]);
+    feature->mutable_t_position()->set_y(t_position[1]);
+    feature->mutable_t_position()->set_z(t_position[2]);
+  }
+  feature->mutable_velocity()->set_x(velocity[0]);
+  feature->mutable_velocity()->set_y(velocity[1]);
+  feature->mutable_velocity()->set_z(velocity[2]);
+  feature->mutable_acceleration()->set_x(acceleration[0]);
+  feature->mutable_acceleration()->set_y(acceleration[1]);
+  feature->mutable_acceleration()->set_z(acceleration[2]);
+  feature->set_velocity_heading(velocity_heading);
+  feature->set_speed(speed);
+  feature->set_acc(acc);
+  feature->set_theta(theta);
+  feature->set_length(length);
+  feature->set_width(width);
+  feature->set_height(height);
+  feature->set_is_still(is_still());
+
+  if (has(kHasLane)) {
+    Lane* lane = feature->mutable_lane();
+    if (has(kHasLaneFeature)) {
+      LaneFeature* lane_feature = lane->mutable_lane_feature();
+      if (lane_id_index != LaneIdInterner::kInvalidIndex) {
+        lane_feature->set_lane_id(LaneIdInterner::LaneId(lane_id_index));
+      }
+      lane_feature->set_lane_turn_type(lane_turn_type);
+      lane_feature->set_lane_s(lane_s);
+      lane_feature->set_lane_l(lane_l);
+      lane_feature->set_angle_diff(angle_diff);
+      lane_feature->set_dist_to_left_boundary(dist_to_left_boundary);
+      lane_feature->set_dist_to_right_boundary(dist_to_right_boundary);
+    }
+  }
+}
+
+FeatureHistory::FeatureHistory(const size_t capacity) : capacity_(capacity) {
+  CHECK_GT(capacity_, 0);
+}
+
+FeatureHistory::FeatureHistory(const FeatureHistory& other) {
+  *this = other;
+}
+
+FeatureHistory& FeatureHistory::operator=(const FeatureHistory& other) {
+  if (this == &other) {
+    return *this;
+  }
+  capacity_ = other.capacity_;
+  head_ = other.head_;
+  size_ = other.size_;
+  compact_features_ = other.compact_features_;
+  latest_.reset();
+  if (other.latest_ != nullptr) {
+    latest_.reset(new Feature(*other.latest_));
+  }
+  materialized_.clear();
+  materialized_.resize(compact_features_.size());
+  materialized_slots_.clear();
+  return *this;
+}
+
+void FeatureHistory::PushFront(Feature* feature) {
+  CHECK_NOTNULL(feature);
+  ReleaseMaterialized();
+  if (size_ > 0) {
+    // The current latest frame becomes history and is compacted.
+    compact_features_[head_].FromFeature(*latest_);
+  }
+  if (size_ == compact_features_.size()) {
+    if (compact_features_.size() < capacity_) {
+      Grow();
+    } else {
+      // Overwrite the earliest frame.
+      --size_;
+    }
+  }
+  const size_t num_slots = compact_features_.size();
+  head_ = (head_ + num_slots - 1) % num_slots;
+  ++size_;
+
+  if (latest_ == nullptr) {
+    latest_.reset(new Feature());
+  }
+  latest_->Clear();
+  latest_->Swap(feature);
+}
+
+void FeatureHistory::PopBack() {
+  if (size_ == 0) {
+    return;
+  }
+  const size_t slot = Slot(size_ - 1);
+  if (materialized_[slot] != nullptr) {
+    materialized_[slot].reset();
+  }
+  --size_;
+  if (size_ == 0 && latest_ != nullptr) {
+    latest_->Clear();
+  }
+}
+
+void FeatureHistory::Clear() {
+  ReleaseMaterialized();
+  head_ = 0;
+  size_ = 0;
+  if (latest_ != nullptr) {
+    latest_->Clear();
+  }
+}
+
+const Feature& FeatureHistory::feature(const size_t i) const {
+  CHECK_LT(i, size_);
+  if (i == 0) {
+    return *latest_;
+  }
+  const size_t slot = Slot(i);
+  if (materialized_[slot] == nullptr) {
+    materialized_[slot].reset(new Feature());
+    compact_features_[slot].ToFeature(materialized_[slot].get());
+    materialized_slots_.push_back(slot);
+  }
+  return *materialized_[slot];
+}
+
+Feature* FeatureHistory::mutable_feature(const size_t i) {
+  return const_cast<Feature*>(&feature(i));
+}
+
+const CompactFeature& FeatureHistory::compact_feature(const size_t i) const {
+  CHECK_LT(i, size_);
+  if (i == 0) {
+    // The latest frame may have been modified through mutable_feature(0).
+    compact_features_[head_].FromFeature(*latest_);
+  }
+  return compact_features_[Slot(i)];
+}
+
+double FeatureHistory::timestamp(const size_t i) const {
+  CHECK_LT(i, size_);
+  if (i == 0) {
+    return latest_->timestamp();
+  }
+  return compact_features_[Slot(i)].timestamp;
+}
+
+size_t FeatureHistory::SpaceUsed() const {
+  size_t space = compact_features_.capacity() * sizeof(CompactFeature) +
+                 materialized_.capacity() * sizeof(std::unique_ptr<Feature>);
+  if (latest_ != nullptr) {
+    space += latest_->SpaceUsed();
+  }
+  for (const size_t slot : materialized_slots_) {
+    if (materialized_[slot] != nullptr) {
+      space += materialized_[slot]->SpaceUsed();
+    }
+  }
+  return space;
+}
+
+size_t FeatureHistory::Slot(const size_t i) const {
+  return (head_ + i) % compact_features_.size();
+}
+
+void FeatureHistory::Grow() {
+  const size_t num_slots = std::min(
+      capacity_, std::max(kMinAllocatedSlots, 2 * compact_features_.size()));
+  std::vector<CompactFeature> compact_features(num_slots);
+  for (size_t i = 0; i < size_; ++i) {
+    compact_features[i] = compact_features_[Slot(i)];
+  }
+  compact_features_.swap(compact_features);
+  materialized_.clear();
+  materialized_.resize(num_slots);
+  head_ = 0;
+}
+
+void FeatureHistory::ReleaseMaterialized() {
+  for (const size_t slot : materialized_slots_) {
+    materialized_[slot].reset();
+  }
+  materialized_slots_.clear();
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Fixed-capacity ring of compact historical obstacle features.
+ */
+
+#ifndef MODULES_PREDICTION_CONTAINER_OBSTACLES_FEATURE_HISTORY_H_
+#define MODULES_PREDICTION_CONTAINER_OBSTACLES_FEATURE_HISTORY_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @struct CompactFeature
+ * @brief Plain-old-data subset of a Feature kept for historical frames.
+ *        Only the most likely current lane feature is retained; lane graphs,
+ *        current and nearby lane features are dropped once a frame is no
+ *        longer the latest one.
+ */
+struct CompactFeature {
+  enum PresenceBit : uint32_t {
+    kHasTPosition = 1u << 0,
+    kHasLane = 1u << 1,
+    kHasLaneFeature = 1u << 2,
+    kIsStill = 1u << 3,
+    kHasId = 1u << 4,
+  };
+
+  double timestamp = 0.0;
+  double position[3] = {0.0, 0.0, 0.0};
+  double t_position[3] = {0.0, 0.0, 0.0};
+  double velocity[3] = {0.0, 0.0, 0.0};
+  double acceleration[3] = {0.0, 0.0, 0.0};
+  double velocity_heading = 0.0;
+  double speed = 0.0;
+  double acc = 0.0;
+  double theta = 0.0;
+  double length = 0.0;
+  double width = 0.0;
+  double height = 0.0;
+
+  // Most likely current lane, the lane id is interned by LaneIdInterner.
+  int32_t lane_id_index = -1;
+  uint32_t lane_turn_type = 0;
+  double lane_s = 0.0;
+  double lane_l = 0.0;
+  double angle_diff = 0.0;
+  double dist_to_left_boundary = 0.0;
+  double dist_to_right_boundary = 0.0;
+
+  int32_t id = 0;
+  int32_t type = 0;
+  uint32_t presence = 0;
+
+  bool has(const PresenceBit bit) const { return (presence & bit) != 0; }
+  bool is_still() const { return has(kIsStill); }
+  bool has_lane_feature() const { return has(kHasLaneFeature); }
+
+  /**
+   * @brief Fill the compact feature from a full feature.
+   * @param feature The full feature.
+   */
+  void FromFeature(const Feature& feature);
+
+  /**
+   * @brief Materialize the compact feature into a full feature.
+   * @param feature The full feature to be filled.
+   */
+  void ToFeature(Feature* feature) const;
+};
+
+/**
+ * @class FeatureHistory
+ * @brief Ring buffer of obstacle features ordered from latest to earliest.
+ *        The latest frame is kept as a full Feature since evaluators and
+ *        predictors read and write its lane graph. Earlier frames are kept as
+ *        CompactFeature and only materialized into a Feature on request; a
+ *        materialized historical feature stays valid until the next
+ *        PushFront() and changes made to it are not written back.
+ */
+class FeatureHistory {
+ public:
+  /**
+   * @brief Constructor
+   * @param capacity The maximal number of frames to keep.
+   */
+  explicit FeatureHistory(const size_t capacity);
+
+  FeatureHistory(const FeatureHistory& other);
+  FeatureHistory& operator=(const FeatureHistory& other);
+  FeatureHistory(FeatureHistory&& other) = default;
+  FeatureHistory& operator=(FeatureHistory&& other) = default;
+
+  /**
+   * @brief Insert a feature as the latest frame. The earliest frame is
+   *        dropped if the history is full.
+   * @param feature The feature to insert, its content is swapped out.
+   */
+  void PushFront(Feature* feature);
+
+  /**
+   * @brief Remove the earliest frame.
+   */
+  void PopBack();
+
+  /**
+   * @brief Remove all frames.
+   */
+  void Clear();
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  size_t capacity() const { return capacity_; }
+
+  /**
+   * @brief Get the ith feature from latest to earliest.
+   * @param i The index of the feature.
+   * @return The ith feature.
+   */
+  const Feature& feature(const size_t i) const;
+
+  /**
+   * @brief Get a pointer to the ith feature from latest to earliest.
+   * @param i The index of the feature.
+   * @return A pointer to the ith feature.
+   */
+  Feature* mutable_feature(const size_t i);
+
+  /**
+   * @brief Get the compact form of the ith feature from latest to earliest.
+   * @param i The index of the feature.
+   * @return The compact ith feature.
+   */
+  const CompactFeature& compact_feature(const size_t i) const;
+
+  /**
+   * @brief Get the timestamp of the ith feature without materializing it.
+   * @param i The index of the feature.
+   * @return The timestamp of the ith feature.
+   */
+  double timestamp(const size_t i) const;
+
+  /**
+   * @brief Estimate the heap memory used by the history in bytes.
+   * @return The estimated memory usage.
+   */
+  size_t SpaceUsed() const;
+
+ private:
+  size_t Slot(const size_t i) const;
+
+  void Grow();
+
+  void ReleaseMaterialized();
+
+ private:
+  size_t capacity_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  // Ring storage, slot head_ holds the latest frame.
+  mutable std::vector<CompactFeature> compact_features_;
+  // Full feature of the latest frame.
+  std::unique_ptr<Feature> latest_;
+  // Lazily materialized historical features, indexed by slot.
+  mutable std::vector<std::unique_ptr<Feature>> materialized_;
+  mutable std::vector<size_t> materialized_slots_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_CONTAINER_OBSTACLES_FEATURE_HISTORY_H_
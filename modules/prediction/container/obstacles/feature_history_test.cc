@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+Feature MakeFeature(const double timestamp) {
+  Feature feature;
+  feature.set_timestamp(timestamp);
+  feature.mutable_position()->set_x(timestamp * 10.0);
+  feature.mutable_position()->set_y(-timestamp);
+  feature.mutable_position()->set_z(0.0);
+  feature.set_speed(10.0);
+  LaneFeature* lane_feature =
+      feature.mutable_lane()->add_current_lane_feature();
+  lane_feature->set_lane_id("l" + std::to_string(static_cast<int>(timestamp)));
+  lane_feature->set_lane_l(0.5);
+  lane_feature->set_angle_diff(0.1);
+  feature.mutable_lane()->mutable_lane_feature()->CopyFrom(*lane_feature);
+  feature.mutable_lane()->mutable_lane_graph()->add_lane_sequence();
+  return feature;
+}
+
+}  // namespace
+
+TEST(FeatureHistoryTest, push_and_access) {
+  FeatureHistory history(8);
+  for (int i = 0; i < 3; ++i) {
+    Feature feature = MakeFeature(static_cast<double>(i));
+    history.PushFront(&feature);
+  }
+  EXPECT_EQ(3, history.size());
+
+  // The latest frame keeps the full feature.
+  const Feature& latest = history.feature(0);
+  EXPECT_DOUBLE_EQ(2.0, latest.timestamp());
+  EXPECT_EQ(1, latest.lane().lane_graph().lane_sequence_size());
+  EXPECT_EQ(1, latest.lane().current_lane_feature_size());
+
+  // Historical frames keep the scalars and the most likely lane feature.
+  const Feature& earliest = history.feature(2);
+  EXPECT_DOUBLE_EQ(0.0, earliest.timestamp());
+  EXPECT_DOUBLE_EQ(0.0, earliest.position().x());
+  EXPECT_DOUBLE_EQ(10.0, earliest.speed());
+  EXPECT_EQ("l0", earliest.lane().lane_feature().lane_id());
+  EXPECT_DOUBLE_EQ(0.5, earliest.lane().lane_feature().lane_l());
+  EXPECT_FALSE(earliest.lane().has_lane_graph());
+  EXPECT_FALSE(earliest.has_t_position());
+
+  const CompactFeature& middle = history.compact_feature(1);
+  EXPECT_DOUBLE_EQ(1.0, middle.timestamp);
+  EXPECT_DOUBLE_EQ(10.0, middle.position[0]);
+  EXPECT_TRUE(middle.has_lane_feature());
+  EXPECT_DOUBLE_EQ(0.1, middle.angle_diff);
+  EXPECT_DOUBLE_EQ(1.0, history.timestamp(1));
+}
+
+TEST(FeatureHistoryTest, ring_overwrite) {
+  FeatureHistory history(5);
+  for (int i = 0; i < 12; ++i) {
+    Feature feature = MakeFeature(static_cast<double>(i));
+    history.PushFront(&feature);
+  }
+  EXPECT_EQ(5, history.size());
+  for (size_t i = 0; i < history.size(); ++i) {
+    EXPECT_DOUBLE_EQ(11.0 - static_cast<double>(i), history.timestamp(i));
+    EXPECT_DOUBLE_EQ(11.0 - static_cast<double>(i),
+                     history.feature(i).timestamp());
+  }
+}
+
+TEST(FeatureHistoryTest, pop_back_and_clear) {
+  FeatureHistory history(5);
+  for (int i = 0; i < 4; ++i) {
+    Feature feature = MakeFeature(static_cast<double>(i));
+    history.PushFront(&feature);
+  }
+  history.PopBack();
+  EXPECT_EQ(3, history.size());
+  EXPECT_DOUBLE_EQ(1.0, history.timestamp(2));
+
+  Feature feature = MakeFeature(4.0);
+  history.PushFront(&feature);
+  EXPECT_EQ(4, history.size());
+  EXPECT_DOUBLE_EQ(4.0, history.timestamp(0));
+  EXPECT_DOUBLE_EQ(1.0, history.timestamp(3));
+
+  history.Clear();
+  EXPECT_TRUE(history.empty());
+}
+
+TEST(FeatureHistoryTest, latest_modification) {
+  FeatureHistory history(5);
+  Feature feature = MakeFeature(0.0);
+  history.PushFront(&feature);
+  history.mutable_feature(0)->set_is_still(true);
+  EXPECT_TRUE(history.compact_feature(0).is_still());
+
+  // The modification survives the compaction of the latest frame.
+  feature = MakeFeature(1.0);
+  history.PushFront(&feature);
+  EXPECT_TRUE(history.compact_feature(1).is_still());
+  EXPECT_TRUE(history.feature(1).is_still());
+  EXPECT_FALSE(history.feature(0).is_still());
+}
+
+TEST(FeatureHistoryTest, copy) {
+  FeatureHistory history(5);
+  for (int i = 0; i < 3; ++i) {
+    Feature feature = MakeFeature(static_cast<double>(i));
+    history.PushFront(&feature);
+  }
+  FeatureHistory copied(history);
+  EXPECT_EQ(3, copied.size());
+  EXPECT_DOUBLE_EQ(2.0, copied.feature(0).timestamp());
+  EXPECT_DOUBLE_EQ(0.0, copied.feature(2).timestamp());
+  EXPECT_NE(&history.feature(0), &copied.feature(0));
+}
+
+}  // namespace prediction
+}  // namespace apollo
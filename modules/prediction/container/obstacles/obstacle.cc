@@ -53,7 +53,7 @@ double Damp(const double x, const double sigma) {
 
 }  // namespace
 
-Obstacle::Obstacle() {
+Obstacle::Obstacle() : feature_history_(FLAGS_max_num_feature_history) {
   double heading_filter_param = FLAGS_heading_filter_param;
   CHECK_LT(heading_filter_param, 1.0);
   CHECK_GT(heading_filter_param, 0.0);
@@ -67,7 +67,7 @@ int Obstacle::id() const { return id_; }
 
 double Obstacle::timestamp() const {
   if (feature_history_.size() > 0) {
-    return feature_history_.front().timestamp();
+    return feature_history_.timestamp(0);
   } else {
     return 0.0;
   }
@@ -75,26 +75,35 @@ double Obstacle::timestamp() const {
 
 const Feature& Obstacle::feature(size_t i) const {
   CHECK(i < feature_history_.size());
-  return feature_history_[i];
+  return feature_history_.feature(i);
 }
 
 Feature* Obstacle::mutable_feature(size_t i) {
   CHECK(i < feature_history_.size());
-  return &feature_history_[i];
+  return feature_history_.mutable_feature(i);
+}
+
+const CompactFeature& Obstacle::compact_feature(size_t i) const {
+  CHECK(i < feature_history_.size());
+  return feature_history_.compact_feature(i);
 }
 
 const Feature& Obstacle::latest_feature() const {
   CHECK_GT(feature_history_.size(), 0);
-  return feature_history_.front();
+  return feature_history_.feature(0);
 }
 
 Feature* Obstacle::mutable_latest_feature() {
   CHECK_GT(feature_history_.size(), 0);
-  return &(feature_history_.front());
+  return feature_history_.mutable_feature(0);
 }
 
 size_t Obstacle::history_size() const { return feature_history_.size(); }
 
+size_t Obstacle::HistorySpaceUsed() const {
+  return feature_history_.SpaceUsed();
+}
+
 const KalmanFilter<double, 6, 2, 0>& Obstacle::kf_motion_tracker() const {
   return kf_motion_tracker_;
 }
@@ -105,16 +114,16 @@ const KalmanFilter<double, 2, 2, 4>& Obstacle::kf_pedestrian_tracker() const {
 
 bool Obstacle::IsStill() {
   if (feature_history_.size() > 0) {
-    return feature_history_.front().is_still();
+    return latest_feature().is_still();
   }
   return true;
 }
 
 bool Obstacle::IsOnLane() {
   if (feature_history_.size() > 0) {
-    if (feature_history_.front().has_lane() &&
-        (feature_history_.front().lane().current_lane_feature_size() > 0 ||
-         feature_history_.front().lane().nearby_lane_feature_size() > 0)) {
+    if (latest_feature().has_lane() &&
+        (latest_feature().lane().current_lane_feature_size() > 0 ||
+         latest_feature().lane().nearby_lane_feature_size() > 0)) {
       ADEBUG << "Obstacle [" << id_ << "] is on lane.";
       return true;
     }
@@ -135,49 +144,93 @@ bool Obstacle::IsNearJunction() {
 
 void Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
                       const double timestamp) {
+  Feature feature;
+  if (!PrepareInsertion(perception_obstacle, timestamp, &feature)) {
+    return;
+  }
+
+  if (!FLAGS_use_navigation_mode) {
+    // Update KF
+    if (!kf_motion_tracker_.IsInitialized()) {
+      InitKFMotionTracker(feature);
+    }
+    UpdateKFMotionTracker(feature);
+  }
+
+  InsertFeature(&feature);
+}
+
+bool Obstacle::PrepareInsertion(const PerceptionObstacle& perception_obstacle,
+                                const double timestamp, Feature* feature) {
   if (feature_history_.size() > 0 &&
-      timestamp <= feature_history_.front().timestamp()) {
+      timestamp <= feature_history_.timestamp(0)) {
     AERROR << "Obstacle [" << id_ << "] received an older frame ["
            << std::setprecision(20) << timestamp
            << "] than the most recent timestamp [ "
-           << feature_history_.front().timestamp() << "].";
-    return;
+           << feature_history_.timestamp(0) << "].";
+    return false;
   }
 
-  Feature feature;
-  if (SetId(perception_obstacle, &feature) == ErrorCode::PREDICTION_ERROR) {
-    return;
+  if (SetId(perception_obstacle, feature) == ErrorCode::PREDICTION_ERROR) {
+    return false;
   }
-  if (SetType(perception_obstacle, &feature) == ErrorCode::PREDICTION_ERROR) {
-    return;
+  if (SetType(perception_obstacle, feature) == ErrorCode::PREDICTION_ERROR) {
+    return false;
   }
 
   // Set obstacle observation for KF tracking
-  SetStatus(perception_obstacle, timestamp, &feature);
+  SetStatus(perception_obstacle, timestamp, feature);
+  return true;
+}
+
+void Obstacle::ObserveMotion(const Feature& feature,
+                             BatchMotionTracker* tracker) const {
+  CHECK_NOTNULL(tracker);
+  if (FLAGS_use_navigation_mode) {
+    return;
+  }
+  if (!tracker->IsInitialized(id_)) {
+    tracker->Init(id_, MotionState(feature), FLAGS_p_var);
+  }
+  double delta_ts = 0.0;
+  if (feature_history_.size() > 0) {
+    delta_ts = feature.timestamp() - feature_history_.timestamp(0);
+  }
+  if (delta_ts > FLAGS_double_precision) {
+    tracker->AddObservation(id_, delta_ts, feature.position().x(),
+                            feature.position().y());
+  }
+}
 
+void Obstacle::CompleteInsertion(const BatchMotionTracker& tracker,
+                                 Feature* feature) {
+  if (!FLAGS_use_navigation_mode && tracker.IsInitialized(id_)) {
+    // Mirror the batch estimate so kf_motion_tracker() stays meaningful.
+    kf_motion_tracker_.SetStateEstimate(tracker.GetStateEstimate(id_),
+                                        tracker.GetStateCovariance(id_));
+  }
+  InsertFeature(feature);
+}
+
+void Obstacle::InsertFeature(Feature* feature) {
   if (!FLAGS_use_navigation_mode) {
-    // Update KF
-    if (!kf_motion_tracker_.IsInitialized()) {
-      InitKFMotionTracker(feature);
-    }
-    UpdateKFMotionTracker(feature);
     if (type_ == PerceptionObstacle::PEDESTRIAN) {
       if (!kf_pedestrian_tracker_.IsInitialized()) {
-        InitKFPedestrianTracker(feature);
+        InitKFPedestrianTracker(*feature);
       }
-      UpdateKFPedestrianTracker(feature);
+      UpdateKFPedestrianTracker(*feature);
     }
 
     // Update obstacle status based on KF if enabled
     if (FLAGS_enable_kf_tracking) {
-      UpdateStatus(&feature);
+      UpdateStatus(feature);
     }
   }
 
   // Set obstacle lane features
-  SetCurrentLanes(&feature);
-  SetNearbyLanes(&feature);
-  SetLaneGraphFeature(&feature);
+  SetCurrentLanes(feature);
+  SetNearbyLanes(feature);
+  SetLaneGraphFeature(feature);
 
   // Insert obstacle feature to history
   InsertFeatureToHistory(feature);
@@ -380,11 +433,11 @@ void Obstacle::SetVelocity(const PerceptionObstacle& perception_obstacle,
       FLAGS_adjust_velocity_by_position_shift &&
       history_size() > 0) {
     double diff_x =
-        feature->position().x() - feature_history_.front().position().x();
+        feature->position().x() - latest_feature().position().x();
     double diff_y =
-        feature->position().y() - feature_history_.front().position().y();
-    double prev_obstacle_size = std::max(feature_history_.front().length(),
-                                         feature_history_.front().width());
+        feature->position().y() - latest_feature().position().y();
+    double prev_obstacle_size = std::max(latest_feature().length(),
+                                         latest_feature().width());
     double obstacle_size =
         std::max(perception_obstacle.length(), perception_obstacle.width());
     double size_diff = std::abs(obstacle_size - prev_obstacle_size);
@@ -449,10 +502,10 @@ void Obstacle::SetAcceleration(Feature* feature) {
 
   if (feature_history_.size() > 0) {
     double curr_ts = feature->timestamp();
-    double prev_ts = feature_history_.front().timestamp();
+    double prev_ts = feature_history_.timestamp(0);
 
     const Point3D& curr_velocity = feature->velocity();
-    const Point3D& prev_velocity = feature_history_.front().velocity();
+    const Point3D& prev_velocity = latest_feature().velocity();
 
     if (curr_ts > prev_ts) {
       /*
@@ -568,6 +621,10 @@ void Obstacle::InitKFMotionTracker(const Feature& feature) {
   P *= FLAGS_p_var;
 
   // Set initial state
+  kf_motion_tracker_.SetStateEstimate(MotionState(feature), P);
+}
+
+Eigen::Matrix<double, 6, 1> Obstacle::MotionState(const Feature& feature) {
   Eigen::Matrix<double, 6, 1> x;
   x(0, 0) = feature.position().x();
   x(1, 0) = feature.position().y();
@@ -575,14 +632,13 @@ void Obstacle::InitKFMotionTracker(const Feature& feature) {
   x(3, 0) = feature.velocity().y();
   x(4, 0) = feature.acceleration().x();
   x(5, 0) = feature.acceleration().y();
-
-  kf_motion_tracker_.SetStateEstimate(x, P);
+  return x;
 }
 
 void Obstacle::UpdateKFMotionTracker(const Feature& feature) {
   double delta_ts = 0.0;
   if (feature_history_.size() > 0) {
-    delta_ts = feature.timestamp() - feature_history_.front().timestamp();
+    delta_ts = feature.timestamp() - feature_history_.timestamp(0);
   }
   if (delta_ts > FLAGS_double_precision) {
     // Set tansition matrix and predict
@@ -649,7 +705,7 @@ void Obstacle::InitKFPedestrianTracker(const Feature& feature) {
 void Obstacle::UpdateKFPedestrianTracker(const Feature& feature) {
   double delta_ts = 0.0;
   if (!feature_history_.empty()) {
-    delta_ts = feature.timestamp() - feature_history_.front().timestamp();
+    delta_ts = feature.timestamp() - feature_history_.timestamp(0);
   }
   if (delta_ts > std::numeric_limits<double>::epsilon()) {
     Eigen::Matrix<double, 2, 4> B = kf_pedestrian_tracker_.GetControlMatrix();
@@ -826,14 +882,18 @@ void Obstacle::SetLaneGraphFeature(Feature* feature) {
   for (auto& lane : feature->lane().current_lane_feature()) {
     std::shared_ptr<const LaneInfo> lane_info =
         PredictionMap::LaneById(lane.lane_id());
-    const LaneGraph& lane_graph = ObstacleClusters::GetLaneGraph(
-        lane.lane_s(), road_graph_distance, lane_info);
-    if (lane_graph.lane_sequence_size() > 0) {
+    std::shared_ptr<const LaneGraph> lane_graph =
+        ObstacleClusters::GetLaneGraph(lane.lane_s(), road_graph_distance,
+                                       lane_info);
+    if (lane_graph->lane_sequence_size() > 0) {
       ++curr_lane_count;
     }
-    for (const auto& lane_seq : lane_graph.lane_sequence()) {
+    for (const auto& lane_seq : lane_graph->lane_sequence()) {
       LaneSequence seq(lane_seq);
       seq.set_lane_sequence_id(seq_id++);
+      if (seq.lane_segment_size() > 0) {
+        seq.mutable_lane_segment(0)->set_start_s(lane.lane_s());
+      }
       feature->mutable_lane()
           ->mutable_lane_graph()
           ->add_lane_sequence()
@@ -850,14 +910,18 @@ void Obstacle::SetLaneGraphFeature(Feature* feature) {
   for (auto& lane : feature->lane().nearby_lane_feature()) {
     std::shared_ptr<const LaneInfo> lane_info =
         PredictionMap::LaneById(lane.lane_id());
-    const LaneGraph& lane_graph = ObstacleClusters::GetLaneGraph(
-        lane.lane_s(), road_graph_distance, lane_info);
-    if (lane_graph.lane_sequence_size() > 0) {
+    std::shared_ptr<const LaneGraph> lane_graph =
+        ObstacleClusters::GetLaneGraph(lane.lane_s(), road_graph_distance,
+                                       lane_info);
+    if (lane_graph->lane_sequence_size() > 0) {
       ++nearby_lane_count;
     }
-    for (const auto& lane_seq : lane_graph.lane_sequence()) {
+    for (const auto& lane_seq : lane_graph->lane_sequence()) {
       LaneSequence seq(lane_seq);
       seq.set_lane_sequence_id(seq_id++);
+      if (seq.lane_segment_size() > 0) {
+        seq.mutable_lane_segment(0)->set_start_s(lane.lane_s());
+      }
       feature->mutable_lane()
           ->mutable_lane_graph()
           ->add_lane_sequence()
@@ -986,7 +1050,7 @@ void Obstacle::SetMotionStatus() {
     ADEBUG << "Obstacle [" << id_ << "] has no history and "
            << "is considered moving.";
     if (history_size > 0) {
-      feature_history_.front().set_is_still(false);
+      mutable_latest_feature()->set_is_still(false);
     }
     return;
   }
@@ -999,14 +1063,14 @@ void Obstacle::SetMotionStatus() {
   len = std::max(len, FLAGS_min_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  const CompactFeature& earliest_feature =
+      feature_history_.compact_feature(history_size - 1);
+  start_x = earliest_feature.position[0];
+  start_y = earliest_feature.position[1];
+  for (int i = history_size - 2; i >= 0; --i) {
+    const CompactFeature& feature = feature_history_.compact_feature(i);
+    avg_drift_x += (feature.position[0] - start_x) / (len - 1);
+    avg_drift_y += (feature.position[1] - start_y) / (len - 1);
   }
 
   double std = FLAGS_still_obstacle_position_std;
@@ -1016,28 +1080,28 @@ void Obstacle::SetMotionStatus() {
     speed_threshold = FLAGS_still_pedestrian_speed_threshold;
     std = FLAGS_still_pedestrian_position_std;
   }
-  double delta_ts = feature_history_.front().timestamp() -
-                    feature_history_.back().timestamp();
+  double delta_ts = feature_history_.timestamp(0) -
+                    feature_history_.timestamp(history_size - 1);
   double speed_sensibility =
       std::sqrt(2 * history_size) * 4 * std / ((history_size + 1) * delta_ts);
-  double speed = feature_history_.front().speed();
+  double speed = latest_feature().speed();
   if (speed < speed_threshold) {
     ADEBUG << "Obstacle [" << id_ << "] has a small speed [" << speed
            << "] and is considered stationary.";
-    feature_history_.front().set_is_still(true);
+    mutable_latest_feature()->set_is_still(true);
   } else if (speed_sensibility < speed_threshold) {
     ADEBUG << "Obstacle [" << id_ << "]"
            << "] considered moving [sensibility = " << speed_sensibility << "]";
-    feature_history_.front().set_is_still(false);
+    mutable_latest_feature()->set_is_still(false);
   } else {
     double distance = std::hypot(avg_drift_x, avg_drift_y);
     double distance_std = std::sqrt(2.0 / len) * std;
     if (distance > 2.0 * distance_std) {
       ADEBUG << "Obstacle [" << id_ << "] is moving.";
-      feature_history_.front().set_is_still(false);
+      mutable_latest_feature()->set_is_still(false);
     } else {
       ADEBUG << "Obstacle [" << id_ << "] is stationary.";
-      feature_history_.front().set_is_still(true);
+      mutable_latest_feature()->set_is_still(true);
     }
   }
 }
@@ -1048,25 +1112,25 @@ void Obstacle::SetMotionStatusBySpeed() {
     ADEBUG << "Obstacle [" << id_ << "] has no history and "
            << "is considered moving.";
     if (history_size > 0) {
-      feature_history_.front().set_is_still(false);
+      mutable_latest_feature()->set_is_still(false);
     }
     return;
   }
 
   double speed_threshold = FLAGS_still_obstacle_speed_threshold;
-  double speed = feature_history_.front().speed();
+  double speed = latest_feature().speed();
 
   if (FLAGS_use_navigation_mode) {
     if (speed < speed_threshold) {
-      feature_history_.front().set_is_still(true);
+      mutable_latest_feature()->set_is_still(true);
     } else {
-      feature_history_.front().set_is_still(false);
+      mutable_latest_feature()->set_is_still(false);
     }
   }
 }
 
-void Obstacle::InsertFeatureToHistory(const Feature& feature) {
-  feature_history_.emplace_front(feature);
+void Obstacle::InsertFeatureToHistory(Feature* feature) {
+  feature_history_.PushFront(feature);
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
@@ -1075,11 +1139,11 @@ void Obstacle::Trim() {
     return;
   }
   int count = 0;
-  const double latest_ts = feature_history_.front().timestamp();
+  const double latest_ts = feature_history_.timestamp(0);
   while (!feature_history_.empty() &&
-         latest_ts - feature_history_.back().timestamp() >=
+         latest_ts - feature_history_.timestamp(feature_history_.size() - 1) >=
              FLAGS_max_history_time) {
-    feature_history_.pop_back();
+    feature_history_.PopBack();
     ++count;
   }
   if (count > 0) {
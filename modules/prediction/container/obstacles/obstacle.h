@@ -22,7 +22,6 @@
 #ifndef MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_H_
 #define MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_H_
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -37,6 +36,8 @@
 
 #include "modules/common/math/kalman_filter.h"
 #include "modules/map/hdmap/hdmap_common.h"
+#include "modules/prediction/container/obstacles/batch_motion_tracker.h"
+#include "modules/prediction/container/obstacles/feature_history.h"
 
 /**
  * @namespace apollo::prediction
@@ -69,6 +70,36 @@ class Obstacle {
   void Insert(const perception::PerceptionObstacle& perception_obstacle,
               const double timestamp);
 
+  /**
+   * @brief First step of a batched insertion: build the feature of a
+   *        perception obstacle without updating any tracker.
+   * @param perception_obstacle The obstacle from perception.
+   * @param timestamp The timestamp when the perception obstacle was detected.
+   * @param feature The feature to be built.
+   * @return True if the perception obstacle can be inserted.
+   */
+  bool PrepareInsertion(
+      const perception::PerceptionObstacle& perception_obstacle,
+      const double timestamp, Feature* feature);
+
+  /**
+   * @brief Second step of a batched insertion: queue the position of a
+   *        prepared feature into a batch motion tracker.
+   * @param feature The feature built by PrepareInsertion().
+   * @param tracker The batch motion tracker.
+   */
+  void ObserveMotion(const Feature& feature,
+                     BatchMotionTracker* tracker) const;
+
+  /**
+   * @brief Last step of a batched insertion, after the batch motion tracker
+   *        has been updated: finish the feature and add it to the history.
+   * @param tracker The updated batch motion tracker.
+   * @param feature The feature built by PrepareInsertion(), its content is
+   *        moved into the history.
+   */
+  void CompleteInsertion(const BatchMotionTracker& tracker, Feature* feature);
+
   /**
    * @brief Get the type of perception obstacle's type.
    * @return The type pf perception obstacle.
@@ -101,6 +132,14 @@ class Obstacle {
    */
   Feature* mutable_feature(size_t i);
 
+  /**
+   * @brief Get the compact form of the ith feature from latest to earliest.
+   *        Unlike feature(), this never materializes a historical proto.
+   * @param i The index of the feature.
+   * @return The compact ith feature.
+   */
+  const CompactFeature& compact_feature(size_t i) const;
+
   /**
    * @brief Get the latest feature.
    * @return The latest feature.
@@ -119,6 +158,12 @@ class Obstacle {
    */
   size_t history_size() const;
 
+  /**
+   * @brief Estimate the memory used by the historical features.
+   * @return The estimated memory usage in bytes.
+   */
+  size_t HistorySpaceUsed() const;
+
   /**
    * @brief Get the motion Kalman filter.
    * @return The motion Kalman filter.
@@ -209,6 +254,10 @@ class Obstacle {
       const perception::PerceptionObstacle& perception_obstacle,
       Feature* feature);
 
+  static Eigen::Matrix<double, 6, 1> MotionState(const Feature& feature);
+
+  void InsertFeature(Feature* feature);
+
   void InitKFMotionTracker(const Feature& feature);
 
   void UpdateKFMotionTracker(const Feature& feature);
@@ -233,7 +282,7 @@ class Obstacle {
 
   void SetMotionStatusBySpeed();
 
-  void InsertFeatureToHistory(const Feature& feature);
+  void InsertFeatureToHistory(Feature* feature);
 
   void Trim();
 
@@ -241,7 +290,7 @@ class Obstacle {
   int id_ = -1;
   perception::PerceptionObstacle::Type type_ =
       perception::PerceptionObstacle::UNKNOWN_UNMOVABLE;
-  std::deque<Feature> feature_history_;
+  FeatureHistory feature_history_;
   common::math::KalmanFilter<double, 6, 2, 0> kf_motion_tracker_;
   common::math::KalmanFilter<double, 2, 2, 4> kf_pedestrian_tracker_;
   common::DigitalFilter heading_filter_;
@@ -16,43 +16,28 @@
 
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 
-#include "modules/prediction/common/road_graph.h"
+#include "modules/prediction/common/prediction_gflags.h"
 
 namespace apollo {
 namespace prediction {
 
 using ::apollo::hdmap::LaneInfo;
 
-std::unordered_map<std::string, LaneGraph> ObstacleClusters::lane_graphs_;
+LaneGraphCache* ObstacleClusters::lane_graph_cache() {
+  static LaneGraphCache cache(FLAGS_max_num_lane_graph_cache,
+                              FLAGS_lane_graph_cache_s_resolution,
+                              FLAGS_lane_graph_cache_length_resolution);
+  return &cache;
+}
 
-void ObstacleClusters::Clear() { lane_graphs_.clear(); }
+void ObstacleClusters::Clear() { lane_graph_cache()->Clear(); }
 
 void ObstacleClusters::Init() { Clear(); }
 
-const LaneGraph& ObstacleClusters::GetLaneGraph(
+std::shared_ptr<const LaneGraph> ObstacleClusters::GetLaneGraph(
     const double start_s, const double length,
     std::shared_ptr<const LaneInfo> lane_info_ptr) {
-  std::string lane_id = lane_info_ptr->id().id();
-  if (lane_graphs_.find(lane_id) != lane_graphs_.end()) {
-    LaneGraph* lane_graph = &lane_graphs_[lane_id];
-    for (int i = 0; i < lane_graph->lane_sequence_size(); ++i) {
-      LaneSequence* lane_seq_ptr = lane_graph->mutable_lane_sequence(i);
-      if (lane_seq_ptr->lane_segment_size() == 0) {
-        continue;
-      }
-      LaneSegment* first_lane_seg_ptr = lane_seq_ptr->mutable_lane_segment(0);
-      if (first_lane_seg_ptr->lane_id() != lane_id) {
-        continue;
-      }
-      first_lane_seg_ptr->set_start_s(start_s);
-    }
-    return lane_graphs_[lane_id];
-  }
-  RoadGraph road_graph(start_s, length, lane_info_ptr);
-  LaneGraph lane_graph;
-  road_graph.BuildLaneGraph(&lane_graph);
-  lane_graphs_[lane_id] = std::move(lane_graph);
-  return lane_graphs_[lane_id];
+  return lane_graph_cache()->GetLaneGraph(start_s, length, lane_info_ptr);
 }
 
 }  // namespace prediction
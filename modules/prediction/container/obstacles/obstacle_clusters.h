@@ -18,12 +18,10 @@
 #define MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_CLUSTERS_H_
 
 #include <memory>
-#include <string>
-#include <unordered_map>
-#include <utility>
 
 #include "modules/common/macro.h"
 #include "modules/map/hdmap/hdmap_common.h"
+#include "modules/prediction/common/lane_graph_cache.h"
 #include "modules/prediction/proto/lane_graph.pb.h"
 
 namespace apollo {
@@ -37,13 +35,15 @@ class ObstacleClusters {
   static void Init();
 
   /**
-   * @brief Obtain a lane graph given a lane info and s
+   * @brief Obtain a lane graph given a lane info and s, it is safe to call
+   *        from multiple threads
    * @param lane start s
    * @param lane total length
    * @param lane info
-   * @return a corresponding lane graph
+   * @return a corresponding lane graph, whose first lane segments start at
+   *         the quantized s
    */
-  static const LaneGraph& GetLaneGraph(
+  static std::shared_ptr<const LaneGraph> GetLaneGraph(
       const double start_s, const double length,
       std::shared_ptr<const apollo::hdmap::LaneInfo> lane_info_ptr);
 
@@ -52,8 +52,7 @@ class ObstacleClusters {
 
   static void Clear();
 
- private:
-  static std::unordered_map<std::string, LaneGraph> lane_graphs_;
+  static LaneGraphCache* lane_graph_cache();
 };
 
 }  // namespace prediction
@@ -29,22 +29,21 @@ TEST_F(ObstacleClustersTest, ObstacleClusters) {
   double start_s = 99.0;
   double length = 100.0;
 
-  const LaneGraph &lane_graph =
-      ObstacleClusters::GetLaneGraph(start_s, length, lane);
-  EXPECT_EQ(1, lane_graph.lane_sequence_size());
-  EXPECT_EQ(3, lane_graph.lane_sequence(0).lane_segment_size());
-  EXPECT_EQ("l9", lane_graph.lane_sequence(0).lane_segment(0).lane_id());
-  EXPECT_EQ("l18", lane_graph.lane_sequence(0).lane_segment(1).lane_id());
-  EXPECT_EQ("l21", lane_graph.lane_sequence(0).lane_segment(2).lane_id());
-
+  auto lane_graph = ObstacleClusters::GetLaneGraph(start_s, length, lane);
+  EXPECT_EQ(1, lane_graph->lane_sequence_size());
+  EXPECT_EQ(3, lane_graph->lane_sequence(0).lane_segment_size());
+  EXPECT_EQ("l9", lane_graph->lane_sequence(0).lane_segment(0).lane_id());
+  EXPECT_EQ("l18", lane_graph->lane_sequence(0).lane_segment(1).lane_id());
+  EXPECT_EQ("l21", lane_graph->lane_sequence(0).lane_segment(2).lane_id());
+  EXPECT_EQ(lane_graph, ObstacleClusters::GetLaneGraph(start_s, length, lane));
+
+  // Lane graphs are keyed by length as well, a shorter one stops at l18.
   double length_2 = 50.0;
-  const LaneGraph &lane_graph_2 =
-      ObstacleClusters::GetLaneGraph(start_s, length_2, lane);
-  EXPECT_EQ(1, lane_graph_2.lane_sequence_size());
-  EXPECT_EQ(3, lane_graph_2.lane_sequence(0).lane_segment_size());
-  EXPECT_EQ("l9", lane_graph_2.lane_sequence(0).lane_segment(0).lane_id());
-  EXPECT_EQ("l18", lane_graph_2.lane_sequence(0).lane_segment(1).lane_id());
-  EXPECT_EQ("l21", lane_graph_2.lane_sequence(0).lane_segment(2).lane_id());
+  auto lane_graph_2 = ObstacleClusters::GetLaneGraph(start_s, length_2, lane);
+  EXPECT_EQ(1, lane_graph_2->lane_sequence_size());
+  EXPECT_EQ(2, lane_graph_2->lane_sequence(0).lane_segment_size());
+  EXPECT_EQ("l9", lane_graph_2->lane_sequence(0).lane_segment(0).lane_id());
+  EXPECT_EQ("l18", lane_graph_2->lane_sequence(0).lane_segment(1).lane_id());
 }
 
 }  // namespace prediction
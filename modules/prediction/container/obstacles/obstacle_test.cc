@@ -198,5 +198,75 @@ TEST_F(ObstacleTest, PedestrianHeading) {
   EXPECT_DOUBLE_EQ(latest_feature.theta(), 1.220);
 }
 
+TEST_F(ObstacleTest, BatchKFTracking) {
+  FLAGS_enable_batch_kf_tracking = true;
+  ObstaclesContainer batch_container;
+  for (int i = 1; i <= 3; ++i) {
+    const auto filename = common::util::StrCat(
+        "modules/prediction/testdata/frame_sequence/frame_", i, ".pb.txt");
+    perception::PerceptionObstacles perception_obstacles;
+    common::util::GetProtoFromFile(filename, &perception_obstacles);
+    batch_container.Insert(perception_obstacles);
+  }
+  FLAGS_enable_batch_kf_tracking = false;
+
+  for (const int id : {1, 101}) {
+    Obstacle* obstacle_ptr = container_.GetObstacle(id);
+    Obstacle* batch_obstacle_ptr = batch_container.GetObstacle(id);
+    ASSERT_TRUE(batch_obstacle_ptr != nullptr);
+    EXPECT_EQ(obstacle_ptr->history_size(), batch_obstacle_ptr->history_size());
+    for (size_t i = 0; i < obstacle_ptr->history_size(); ++i) {
+      const Feature& feature = obstacle_ptr->feature(i);
+      const Feature& batch_feature = batch_obstacle_ptr->feature(i);
+      EXPECT_NEAR(feature.t_position().x(), batch_feature.t_position().x(),
+                  1e-6);
+      EXPECT_NEAR(feature.t_position().y(), batch_feature.t_position().y(),
+                  1e-6);
+      EXPECT_NEAR(feature.velocity().x(), batch_feature.velocity().x(), 1e-6);
+      EXPECT_NEAR(feature.velocity().y(), batch_feature.velocity().y(), 1e-6);
+    }
+  }
+}
+
+TEST_F(ObstacleTest, ParallelLaneGraphBuilding) {
+  FLAGS_enable_batch_kf_tracking = true;
+  FLAGS_enable_parallel_lane_graph_building = true;
+  ObstaclesContainer parallel_container;
+  for (int i = 1; i <= 3; ++i) {
+    const auto filename = common::util::StrCat(
+        "modules/prediction/testdata/frame_sequence/frame_", i, ".pb.txt");
+    perception::PerceptionObstacles perception_obstacles;
+    common::util::GetProtoFromFile(filename, &perception_obstacles);
+    parallel_container.Insert(perception_obstacles);
+  }
+  FLAGS_enable_parallel_lane_graph_building = false;
+  FLAGS_enable_batch_kf_tracking = false;
+
+  for (const int id : {1, 101}) {
+    Obstacle* obstacle_ptr = container_.GetObstacle(id);
+    Obstacle* parallel_obstacle_ptr = parallel_container.GetObstacle(id);
+    ASSERT_TRUE(parallel_obstacle_ptr != nullptr);
+    const LaneGraph& lane_graph =
+        obstacle_ptr->latest_feature().lane().lane_graph();
+    const LaneGraph& parallel_lane_graph =
+        parallel_obstacle_ptr->latest_feature().lane().lane_graph();
+    ASSERT_EQ(lane_graph.lane_sequence_size(),
+              parallel_lane_graph.lane_sequence_size());
+    for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+      const LaneSequence& sequence = lane_graph.lane_sequence(i);
+      const LaneSequence& parallel_sequence =
+          parallel_lane_graph.lane_sequence(i);
+      EXPECT_EQ(sequence.lane_sequence_id(),
+                parallel_sequence.lane_sequence_id());
+      ASSERT_EQ(sequence.lane_segment_size(),
+                parallel_sequence.lane_segment_size());
+      for (int j = 0; j < sequence.lane_segment_size(); ++j) {
+        EXPECT_EQ(sequence.lane_segment(j).lane_id(),
+                  parallel_sequence.lane_segment(j).lane_id());
+      }
+    }
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
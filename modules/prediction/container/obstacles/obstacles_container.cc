@@ -16,12 +16,15 @@
 
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
+#include <functional>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "modules/common/math/math_utils.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_gflags.h"
-#include "modules/prediction/container/obstacles/obstacle_clusters.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 
 namespace apollo {
 namespace prediction {
@@ -47,6 +50,7 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
       FeatureOutput::Write();
     }
     obstacles_.Clear();
+    motion_tracker_.Clear();
     ADEBUG << "Replay mode is enabled.";
   } else if (timestamp <= timestamp_) {
     AERROR << "Invalid timestamp curr [" << timestamp << "] v.s. prev ["
@@ -56,7 +60,10 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
 
   timestamp_ = timestamp;
   ADEBUG << "Current timestamp is [" << timestamp_ << "]";
-  ObstacleClusters::Init();
+  if (FLAGS_enable_batch_kf_tracking) {
+    InsertPerceptionObstacles(perception_obstacles, timestamp_);
+    return;
+  }
   for (const PerceptionObstacle& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
@@ -73,6 +80,7 @@ Obstacle* ObstaclesContainer::GetObstacle(const int id) {
 
 void ObstaclesContainer::Clear() {
   obstacles_.Clear();
+  motion_tracker_.Clear();
   timestamp_ = -1.0;
 }
 
@@ -93,7 +101,92 @@ void ObstaclesContainer::InsertPerceptionObstacle(
   } else {
     Obstacle obstacle;
     obstacle.Insert(perception_obstacle, timestamp);
-    obstacles_.Put(id, std::move(obstacle));
+    PutObstacle(id, &obstacle);
+  }
+}
+
+void ObstaclesContainer::InsertPerceptionObstacles(
+    const PerceptionObstacles& perception_obstacles, const double timestamp) {
+  const int num_obstacles = perception_obstacles.perception_obstacle_size();
+  std::vector<int> ids;
+  std::vector<Feature> features(num_obstacles);
+  std::unordered_set<int> inserted_ids;
+  ids.reserve(num_obstacles);
+
+  // Build features and queue the observations of all obstacles.
+  for (const PerceptionObstacle& perception_obstacle :
+       perception_obstacles.perception_obstacle()) {
+    const int id = perception_obstacle.id();
+    if (id < -1) {
+      AERROR << "Invalid ID [" << id << "]";
+      continue;
+    }
+    if (!IsPredictable(perception_obstacle)) {
+      ADEBUG << "Perception obstacle [" << id << "] is not predictable.";
+      continue;
+    }
+    if (!inserted_ids.insert(id).second) {
+      AERROR << "Perception obstacle [" << id << "] is duplicated.";
+      continue;
+    }
+    Obstacle* obstacle_ptr = obstacles_.GetSilently(id);
+    if (obstacle_ptr == nullptr) {
+      Obstacle obstacle;
+      PutObstacle(id, &obstacle);
+      obstacle_ptr = obstacles_.GetSilently(id);
+      if (obstacle_ptr == nullptr) {
+        continue;
+      }
+    }
+    Feature* feature = &features[ids.size()];
+    if (!obstacle_ptr->PrepareInsertion(perception_obstacle, timestamp,
+                                        feature)) {
+      continue;
+    }
+    obstacle_ptr->ObserveMotion(*feature, &motion_tracker_);
+    ids.push_back(id);
+  }
+
+  // Predict and correct the motion filters of all obstacles at once.
+  motion_tracker_.Update(FLAGS_q_var, FLAGS_r_var);
+
+  // Look the obstacles up again, they may have been evicted by later ones.
+  std::vector<Obstacle*> obstacle_ptrs(ids.size(), nullptr);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    obstacle_ptrs[i] = obstacles_.GetSilently(ids[i]);
+  }
+
+  // Lane features and lane graphs only touch their own obstacle and the
+  // shared thread-safe lane graph cache, so obstacles can run in parallel.
+  if (FLAGS_enable_parallel_lane_graph_building && ids.size() > 1) {
+    PredictionThreadPool::instance()->Init();
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (obstacle_ptrs[i] == nullptr) {
+        continue;
+      }
+      PredictionThreadPool::instance()->Push(
+          std::bind(&Obstacle::CompleteInsertion, obstacle_ptrs[i],
+                    std::cref(motion_tracker_), &features[i]));
+    }
+    PredictionThreadPool::instance()->Synchronize();
+    return;
+  }
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (obstacle_ptrs[i] == nullptr) {
+      continue;
+    }
+    obstacle_ptrs[i]->CompleteInsertion(motion_tracker_, &features[i]);
+    ADEBUG << "Perception obstacle [" << ids[i] << "] was inserted";
+  }
+}
+
+void ObstaclesContainer::PutObstacle(const int id, Obstacle* obstacle) {
+  const bool evicting = obstacles_.Full();
+  int obsolete_id = id;
+  obstacles_.PutAndGetObsolete(id, obstacle, &obsolete_id);
+  if (evicting && obsolete_id != id) {
+    motion_tracker_.Remove(obsolete_id);
   }
 }
 
@@ -24,7 +24,9 @@
 
 #include "modules/common/macro.h"
 #include "modules/common/util/lru_cache.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/prediction/container/container.h"
+#include "modules/prediction/container/obstacles/batch_motion_tracker.h"
 #include "modules/prediction/container/obstacles/obstacle.h"
 #include "modules/prediction/container/pose/pose_container.h"
 
@@ -58,6 +60,16 @@ class ObstaclesContainer : public Container {
       const perception::PerceptionObstacle& perception_obstacle,
       const double timestamp);
 
+  /**
+   * @brief Insert all perception obstacles of a frame, updating their motion
+   *        Kalman filters in one batch
+   * @param Perception obstacles
+   *        Timestamp
+   */
+  void InsertPerceptionObstacles(
+      const perception::PerceptionObstacles& perception_obstacles,
+      const double timestamp);
+
   /**
    * @brief Get obstacle pointer
    * @param Obstacle ID
@@ -78,9 +90,18 @@ class ObstaclesContainer : public Container {
    */
   bool IsPredictable(const perception::PerceptionObstacle& perception_obstacle);
 
+  /**
+   * @brief Put an obstacle into the cache and drop the motion filter of the
+   *        obstacle evicted by it, if any
+   * @param Obstacle ID
+   *        Obstacle to be moved into the cache
+   */
+  void PutObstacle(const int id, Obstacle* obstacle);
+
  private:
   double timestamp_ = -1.0;
   common::util::LRUCache<int, Obstacle> obstacles_;
+  BatchMotionTracker motion_tracker_;
 };
 
 }  // namespace prediction
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures per-frame insertion time and per-obstacle history memory of
+ *        ObstaclesContainer with and without batched KF tracking.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+
+DEFINE_int32(benchmark_num_obstacles, 500, "Number of tracked obstacles.");
+DEFINE_int32(benchmark_num_frames, 100, "Number of perception frames.");
+
+namespace apollo {
+namespace prediction {
+namespace {
+
+using apollo::common::time::Clock;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+// Origin close to the lanes of the KML test map.
+constexpr double kOriginX = -458.941;
+constexpr double kOriginY = -159.240;
+constexpr double kHeading = -0.352;
+constexpr double kFramePeriod = 0.1;
+
+PerceptionObstacles MakeFrame(const int frame_index) {
+  PerceptionObstacles frame;
+  const double timestamp = frame_index * kFramePeriod;
+  frame.mutable_header()->set_timestamp_sec(timestamp);
+  const int num_columns = 25;
+  for (int i = 0; i < FLAGS_benchmark_num_obstacles; ++i) {
+    const double speed = 2.0 + (i % 10);
+    const double base_x = kOriginX + (i % num_columns) * 6.0;
+    const double base_y = kOriginY + (i / num_columns) * 4.0;
+    PerceptionObstacle* obstacle = frame.add_perception_obstacle();
+    obstacle->set_id(i);
+    obstacle->set_type(i % 5 == 0 ? PerceptionObstacle::PEDESTRIAN
+                                  : PerceptionObstacle::VEHICLE);
+    obstacle->set_timestamp(timestamp);
+    obstacle->set_theta(kHeading);
+    obstacle->mutable_position()->set_x(base_x +
+                                        speed * timestamp * std::cos(kHeading));
+    obstacle->mutable_position()->set_y(base_y +
+                                        speed * timestamp * std::sin(kHeading));
+    obstacle->mutable_position()->set_z(0.0);
+    obstacle->mutable_velocity()->set_x(speed * std::cos(kHeading));
+    obstacle->mutable_velocity()->set_y(speed * std::sin(kHeading));
+    obstacle->mutable_velocity()->set_z(0.0);
+    obstacle->set_length(4.5);
+    obstacle->set_width(2.0);
+    obstacle->set_height(1.5);
+  }
+  return frame;
+}
+
+void Run(const bool batch_kf_tracking,
+         const std::vector<PerceptionObstacles>& frames) {
+  FLAGS_enable_batch_kf_tracking = batch_kf_tracking;
+  ObstaclesContainer container;
+
+  std::vector<double> frame_times;
+  frame_times.reserve(frames.size());
+  for (const auto& frame : frames) {
+    const double start = Clock::NowInSeconds();
+    container.Insert(frame);
+    frame_times.push_back((Clock::NowInSeconds() - start) * 1e3);
+  }
+
+  size_t history_bytes = 0;
+  size_t full_proto_bytes = 0;
+  int num_obstacles = 0;
+  for (int id = 0; id < FLAGS_benchmark_num_obstacles; ++id) {
+    const Obstacle* obstacle = container.GetObstacle(id);
+    if (obstacle == nullptr || obstacle->history_size() == 0) {
+      continue;
+    }
+    ++num_obstacles;
+    history_bytes += obstacle->HistorySpaceUsed();
+    // What a history of full Feature protos would have held.
+    full_proto_bytes += obstacle->history_size() *
+                        obstacle->latest_feature().SpaceUsed();
+  }
+
+  std::sort(frame_times.begin(), frame_times.end());
+  double total_time = 0.0;
+  for (const double t : frame_times) {
+    total_time += t;
+  }
+  const size_t n = frame_times.size();
+  std::cout << std::fixed << std::setprecision(3)
+            << (batch_kf_tracking ? "batch KF" : "per-obstacle KF") << ": "
+            << num_obstacles << " obstacles, " << n << " frames"
+            << ", mean " << total_time / n << " ms"
+            << ", p50 " << frame_times[n / 2] << " ms"
+            << ", p99 " << frame_times[std::min(n - 1, n * 99 / 100)] << " ms"
+            << ", history " << history_bytes / std::max(num_obstacles, 1)
+            << " B/obstacle (full protos ~"
+            << full_proto_bytes / std::max(num_obstacles, 1)
+            << " B/obstacle)" << std::endl;
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  FLAGS_map_dir = "modules/prediction/testdata";
+  FLAGS_base_map_filename = "kml_map.bin";
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_max_num_obstacles =
+      std::max(FLAGS_max_num_obstacles, FLAGS_benchmark_num_obstacles);
+  FLAGS_enable_kf_tracking = true;
+
+  std::vector<apollo::perception::PerceptionObstacles> frames;
+  for (int i = 0; i < FLAGS_benchmark_num_frames; ++i) {
+    frames.push_back(apollo::prediction::MakeFrame(i));
+  }
+  apollo::prediction::Run(false, frames);
+  apollo::prediction::Run(true, frames);
+  return 0;
+}
@@ -17,6 +17,8 @@
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
 #include "modules/common/log.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
@@ -96,7 +98,12 @@ void EvaluatorManager::Run(
           AdapterConfig::PERCEPTION_OBSTACLES));
   CHECK_NOTNULL(container);
 
+  // Pick evaluators serially, so that parallel runs evaluate the same
+  // obstacles with the same evaluators as serial ones.
+  std::vector<std::pair<Obstacle*, ObstacleConf::EvaluatorType>>
+      obstacle_evaluators;
   Evaluator* evaluator = nullptr;
+  ObstacleConf::EvaluatorType evaluator_type = vehicle_on_lane_evaluator_;
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     if (!perception_obstacle.has_id()) {
@@ -118,14 +125,16 @@ void EvaluatorManager::Run(
     switch (perception_obstacle.type()) {
       case PerceptionObstacle::VEHICLE: {
         if (obstacle->IsOnLane()) {
-          evaluator = GetEvaluator(vehicle_on_lane_evaluator_);
+          evaluator_type = vehicle_on_lane_evaluator_;
+          evaluator = GetEvaluator(evaluator_type);
           CHECK_NOTNULL(evaluator);
         }
         break;
       }
       case PerceptionObstacle::BICYCLE: {
         if (obstacle->IsOnLane()) {
-          evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
+          evaluator_type = cyclist_on_lane_evaluator_;
+          evaluator = GetEvaluator(evaluator_type);
           CHECK_NOTNULL(evaluator);
         }
         break;
@@ -135,16 +144,84 @@ void EvaluatorManager::Run(
       }
       default: {
         if (obstacle->IsOnLane()) {
-          evaluator = GetEvaluator(default_on_lane_evaluator_);
+          evaluator_type = default_on_lane_evaluator_;
+          evaluator = GetEvaluator(evaluator_type);
           CHECK_NOTNULL(evaluator);
         }
         break;
       }
     }
     if (evaluator != nullptr) {
-      evaluator->Evaluate(obstacle);
+      obstacle_evaluators.emplace_back(obstacle, evaluator_type);
     }
   }
+
+  // Offline mode writes features from within the evaluators.
+  if (FLAGS_enable_parallel_prediction && !FLAGS_prediction_offline_mode &&
+      FLAGS_num_prediction_thread_pool > 1 && obstacle_evaluators.size() > 1) {
+    RunInParallel(obstacle_evaluators);
+    return;
+  }
+  for (const auto& obstacle_evaluator : obstacle_evaluators) {
+    GetEvaluator(obstacle_evaluator.second)->Evaluate(obstacle_evaluator.first);
+  }
+}
+
+bool EvaluatorManager::IsParallelizable(
+    const ObstacleConf::EvaluatorType& type) {
+  // RNN evaluators share the state of the RnnModel singleton.
+  return type != ObstacleConf::RNN_EVALUATOR;
+}
+
+void EvaluatorManager::RunInParallel(
+    const std::vector<std::pair<Obstacle*, ObstacleConf::EvaluatorType>>&
+        obstacle_evaluators) {
+  const int num_shards = FLAGS_num_prediction_thread_pool;
+  if (static_cast<int>(shard_evaluators_.size()) < num_shards) {
+    shard_evaluators_.resize(num_shards);
+  }
+  // Evaluator instances are created serially before any shard runs.
+  std::vector<std::vector<std::pair<Obstacle*, Evaluator*>>> shards(
+      num_shards);
+  std::vector<std::pair<Obstacle*, Evaluator*>> serial_evaluations;
+  for (const auto& obstacle_evaluator : obstacle_evaluators) {
+    Obstacle* obstacle = obstacle_evaluator.first;
+    const ObstacleConf::EvaluatorType& type = obstacle_evaluator.second;
+    if (!IsParallelizable(type)) {
+      serial_evaluations.emplace_back(obstacle, GetEvaluator(type));
+      continue;
+    }
+    // Sharding by id keeps duplicated obstacles on one thread.
+    const int shard = obstacle->id() % num_shards;
+    Evaluator* evaluator = nullptr;
+    if (shard == 0) {
+      evaluator = GetEvaluator(type);
+    } else {
+      auto& shard_evaluator = shard_evaluators_[shard][type];
+      if (shard_evaluator == nullptr) {
+        shard_evaluator = CreateEvaluator(type);
+      }
+      evaluator = shard_evaluator.get();
+    }
+    CHECK_NOTNULL(evaluator);
+    shards[shard].emplace_back(obstacle, evaluator);
+  }
+
+  PredictionThreadPool::instance()->Init();
+  for (const auto& shard : shards) {
+    if (shard.empty()) {
+      continue;
+    }
+    PredictionThreadPool::instance()->Push([&shard](int thread_id) {
+      for (const auto& evaluation : shard) {
+        evaluation.second->Evaluate(evaluation.first);
+      }
+    });
+  }
+  for (const auto& evaluation : serial_evaluations) {
+    evaluation.second->Evaluate(evaluation.first);
+  }
+  PredictionThreadPool::instance()->Synchronize();
 }
 
 std::unique_ptr<Evaluator> EvaluatorManager::CreateEvaluator(
@@ -24,6 +24,8 @@
 
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -58,7 +60,8 @@ class EvaluatorManager {
   Evaluator* GetEvaluator(const ObstacleConf::EvaluatorType& type);
 
   /**
-   * @brief Run evaluators
+   * @brief Run evaluators, in parallel over obstacles if
+   *        FLAGS_enable_parallel_prediction is set
    * @param Perception obstacles
    */
   void Run(const perception::PerceptionObstacles& perception_obstacles);
@@ -83,9 +86,29 @@ class EvaluatorManager {
    */
   void RegisterEvaluators();
 
+  /**
+   * @brief Check if an evaluator type can have one instance per thread
+   * @param Evaluator type
+   * @return True if instances of the type do not share state
+   */
+  static bool IsParallelizable(const ObstacleConf::EvaluatorType& type);
+
+  /**
+   * @brief Evaluate obstacles on the thread pool, each shard of obstacles
+   *        with its own evaluator instances
+   * @param Obstacles and the types of their evaluators
+   */
+  void RunInParallel(
+      const std::vector<std::pair<Obstacle*, ObstacleConf::EvaluatorType>>&
+          obstacle_evaluators);
+
  private:
   std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>> evaluators_;
 
+  // Evaluators of the parallel shards, shard 0 uses evaluators_.
+  std::vector<std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>>>
+      shard_evaluators_;
+
   ObstacleConf::EvaluatorType vehicle_on_lane_evaluator_ =
       ObstacleConf::MLP_EVALUATOR;
 
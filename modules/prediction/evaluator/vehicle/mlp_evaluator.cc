@@ -162,22 +162,19 @@ void MLPEvaluator::SetObstacleFeatureValues(
   double duration = obstacle_ptr->timestamp() - FLAGS_prediction_duration;
   int count = 0;
   for (std::size_t i = 0; i < obstacle_ptr->history_size(); ++i) {
-    const Feature& feature = obstacle_ptr->feature(i);
-    if (!feature.IsInitialized()) {
-      continue;
-    }
-    if (feature.timestamp() < duration) {
+    // Historical frames are read in compact form to avoid materializing them.
+    const CompactFeature& feature = obstacle_ptr->compact_feature(i);
+    if (feature.timestamp < duration) {
       break;
     }
-    if (feature.has_lane() && feature.lane().has_lane_feature()) {
-      thetas.push_back(feature.lane().lane_feature().angle_diff());
-      lane_ls.push_back(feature.lane().lane_feature().lane_l());
-      dist_lbs.push_back(feature.lane().lane_feature().dist_to_left_boundary());
-      dist_rbs.push_back(
-          feature.lane().lane_feature().dist_to_right_boundary());
-      lane_types.push_back(feature.lane().lane_feature().lane_turn_type());
-      timestamps.push_back(feature.timestamp());
-      speeds.push_back(feature.speed());
+    if (feature.has_lane_feature()) {
+      thetas.push_back(feature.angle_diff);
+      lane_ls.push_back(feature.lane_l);
+      dist_lbs.push_back(feature.dist_to_left_boundary);
+      dist_rbs.push_back(feature.dist_to_right_boundary);
+      lane_types.push_back(feature.lane_turn_type);
+      timestamps.push_back(feature.timestamp);
+      speeds.push_back(feature.speed);
       ++count;
     }
   }
@@ -21,6 +21,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
 #include "modules/common/util/file.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_gflags.h"
@@ -47,6 +48,17 @@ using ::apollo::localization::LocalizationEstimate;
 using ::apollo::perception::PerceptionObstacle;
 using ::apollo::perception::PerceptionObstacles;
 
+namespace {
+
+void AddStageStats(const std::string& name, const double start_timestamp,
+                   const double end_timestamp, LatencyStats* latency_stats) {
+  auto* stage_stats = latency_stats->add_stage_stats();
+  stage_stats->set_name(name);
+  stage_stats->set_time_ms((end_timestamp - start_timestamp) * 1000);
+}
+
+}  // namespace
+
 std::string Prediction::Name() const { return FLAGS_prediction_module_name; }
 
 Status Prediction::Init() {
@@ -134,6 +146,7 @@ void Prediction::OnPlanning(const planning::ADCTrajectory& adc_trajectory) {
 }
 
 void Prediction::RunOnce(const PerceptionObstacles& perception_obstacles) {
+  TRACE_SPAN_FROM("Prediction::RunOnce", perception_obstacles.header());
   if (FLAGS_prediction_test_mode && FLAGS_prediction_test_duration > 0 &&
       (Clock::NowInSeconds() - start_time_ > FLAGS_prediction_test_duration)) {
     AINFO << "Prediction finished running in test mode";
@@ -179,8 +192,11 @@ void Prediction::RunOnce(const PerceptionObstacles& perception_obstacles) {
     adc_container->SetPosition(adc_position);
   }
 
+  const double container_end_timestamp = Clock::NowInSeconds();
+
   // Make evaluations
   EvaluatorManager::instance()->Run(perception_obstacles);
+  const double evaluator_end_timestamp = Clock::NowInSeconds();
 
   // No prediction for offline mode
   if (FLAGS_prediction_offline_mode) {
@@ -192,8 +208,20 @@ void Prediction::RunOnce(const PerceptionObstacles& perception_obstacles) {
 
   auto prediction_obstacles =
       PredictorManager::instance()->prediction_obstacles();
+  const double end_timestamp = Clock::NowInSeconds();
   prediction_obstacles.set_start_timestamp(start_timestamp);
-  prediction_obstacles.set_end_timestamp(Clock::NowInSeconds());
+  prediction_obstacles.set_end_timestamp(end_timestamp);
+
+  auto* latency_stats = prediction_obstacles.mutable_latency_stats();
+  latency_stats->set_total_time_ms((end_timestamp - start_timestamp) * 1000);
+  latency_stats->set_num_threads(
+      FLAGS_enable_parallel_prediction ? FLAGS_num_prediction_thread_pool : 1);
+  AddStageStats("container", start_timestamp, container_end_timestamp,
+                latency_stats);
+  AddStageStats("evaluator", container_end_timestamp, evaluator_end_timestamp,
+                latency_stats);
+  AddStageStats("predictor", evaluator_end_timestamp, end_timestamp,
+                latency_stats);
 
   if (FLAGS_prediction_test_mode) {
     for (auto const& prediction_obstacle :
@@ -210,6 +238,8 @@ void Prediction::RunOnce(const PerceptionObstacles& perception_obstacles) {
     }
   }
 
+  apollo::common::trace::PropagateOrigin(
+      perception_obstacles.header(), prediction_obstacles.mutable_header());
   Publish(&prediction_obstacles);
 }
 
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures how evaluator and predictor latency scale with the number
+ *        of prediction threads.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/file.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/container/container_manager.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/evaluator/evaluator_manager.h"
+#include "modules/prediction/predictor/predictor_manager.h"
+#include "modules/prediction/proto/prediction_conf.pb.h"
+
+DEFINE_int32(benchmark_num_obstacles, 200, "Number of obstacles per frame.");
+DEFINE_int32(benchmark_num_frames, 20, "Number of perception frames.");
+DEFINE_int32(benchmark_max_threads, 16, "Max number of prediction threads.");
+
+namespace apollo {
+namespace prediction {
+namespace {
+
+using apollo::common::adapter::AdapterConfig;
+using apollo::common::time::Clock;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+// Origin close to the lanes of the KML test map.
+constexpr double kOriginX = -458.941;
+constexpr double kOriginY = -159.240;
+constexpr double kHeading = -0.352;
+constexpr double kFramePeriod = 0.1;
+
+PerceptionObstacles MakeFrame(const int frame_index) {
+  PerceptionObstacles frame;
+  const double timestamp = frame_index * kFramePeriod;
+  frame.mutable_header()->set_timestamp_sec(timestamp);
+  const int num_columns = 25;
+  for (int i = 0; i < FLAGS_benchmark_num_obstacles; ++i) {
+    const double speed = 2.0 + (i % 10);
+    PerceptionObstacle* obstacle = frame.add_perception_obstacle();
+    obstacle->set_id(i);
+    obstacle->set_type(i % 5 == 0 ? PerceptionObstacle::PEDESTRIAN
+                                  : PerceptionObstacle::VEHICLE);
+    obstacle->set_timestamp(timestamp);
+    obstacle->set_theta(kHeading);
+    obstacle->mutable_position()->set_x(
+        kOriginX + (i % num_columns) * 6.0 +
+        speed * timestamp * std::cos(kHeading));
+    obstacle->mutable_position()->set_y(
+        kOriginY + (i / num_columns) * 4.0 +
+        speed * timestamp * std::sin(kHeading));
+    obstacle->mutable_position()->set_z(0.0);
+    obstacle->mutable_velocity()->set_x(speed * std::cos(kHeading));
+    obstacle->mutable_velocity()->set_y(speed * std::sin(kHeading));
+    obstacle->mutable_velocity()->set_z(0.0);
+    obstacle->set_length(4.5);
+    obstacle->set_width(2.0);
+    obstacle->set_height(1.5);
+  }
+  return frame;
+}
+
+double Mean(const std::vector<double>& times) {
+  double total_time = 0.0;
+  for (const double t : times) {
+    total_time += t;
+  }
+  return times.empty() ? 0.0 : total_time / times.size();
+}
+
+void Run(const int num_threads, const std::vector<PerceptionObstacles>& frames,
+         double* serial_time) {
+  FLAGS_enable_parallel_prediction = num_threads > 1;
+  FLAGS_num_prediction_thread_pool = num_threads;
+
+  ObstaclesContainer* obstacles_container = dynamic_cast<ObstaclesContainer*>(
+      ContainerManager::instance()->GetContainer(
+          AdapterConfig::PERCEPTION_OBSTACLES));
+  CHECK_NOTNULL(obstacles_container);
+  obstacles_container->Clear();
+
+  std::vector<double> evaluator_times;
+  std::vector<double> predictor_times;
+  for (const auto& frame : frames) {
+    obstacles_container->Insert(frame);
+    const double start = Clock::NowInSeconds();
+    EvaluatorManager::instance()->Run(frame);
+    const double evaluated = Clock::NowInSeconds();
+    PredictorManager::instance()->Run(frame);
+    const double predicted = Clock::NowInSeconds();
+    evaluator_times.push_back((evaluated - start) * 1e3);
+    predictor_times.push_back((predicted - evaluated) * 1e3);
+  }
+
+  const double total_time = Mean(evaluator_times) + Mean(predictor_times);
+  if (num_threads == 1) {
+    *serial_time = total_time;
+  }
+  std::cout << std::fixed << std::setprecision(3) << std::setw(2)
+            << num_threads << " threads: evaluator "
+            << Mean(evaluator_times) << " ms, predictor "
+            << Mean(predictor_times) << " ms, speedup "
+            << *serial_time / std::max(total_time, 1e-9) << "x" << std::endl;
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  FLAGS_map_dir = "modules/prediction/testdata";
+  FLAGS_base_map_filename = "kml_map.bin";
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_max_num_obstacles =
+      std::max(FLAGS_max_num_obstacles, FLAGS_benchmark_num_obstacles);
+  FLAGS_enable_trim_prediction_trajectory = false;
+
+  apollo::common::adapter::AdapterManagerConfig adapter_conf;
+  CHECK(apollo::common::util::GetProtoFromFile(
+      "modules/prediction/testdata/adapter_conf.pb.txt", &adapter_conf));
+  apollo::prediction::PredictionConf prediction_conf;
+  CHECK(apollo::common::util::GetProtoFromFile(FLAGS_prediction_conf_file,
+                                               &prediction_conf));
+  apollo::prediction::ContainerManager::instance()->Init(adapter_conf);
+  apollo::prediction::EvaluatorManager::instance()->Init(prediction_conf);
+  apollo::prediction::PredictorManager::instance()->Init(prediction_conf);
+
+  std::vector<apollo::perception::PerceptionObstacles> frames;
+  for (int i = 0; i < FLAGS_benchmark_num_frames; ++i) {
+    frames.push_back(apollo::prediction::MakeFrame(i));
+  }
+  double serial_time = 0.0;
+  for (int num_threads = 1; num_threads <= FLAGS_benchmark_max_threads;
+       num_threads *= 2) {
+    apollo::prediction::Run(num_threads, frames, &serial_time);
+  }
+  return 0;
+}
@@ -17,8 +17,10 @@
 #include "modules/prediction/predictor/predictor_manager.h"
 
 #include <memory>
+#include <vector>
 
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
@@ -138,7 +140,7 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
 
   CHECK_NOTNULL(obstacles_container);
 
-  Predictor* predictor = nullptr;
+  std::vector<const PerceptionObstacle*> valid_perception_obstacles;
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     if (!perception_obstacle.has_id()) {
@@ -151,69 +153,146 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
       AERROR << "A perception obstacle has invalid id [" << id << "].";
       continue;
     }
+    valid_perception_obstacles.push_back(&perception_obstacle);
+  }
 
-    PredictionObstacle prediction_obstacle;
-    prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
-    Obstacle* obstacle = obstacles_container->GetObstacle(id);
-    if (obstacle != nullptr) {
-      if (obstacle->IsStill()) {
-        predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
-      } else {
-        switch (perception_obstacle.type()) {
-          case PerceptionObstacle::VEHICLE: {
-            if (obstacle->IsOnLane()) {
-              predictor = GetPredictor(vehicle_on_lane_predictor_);
-            } else {
-              predictor = GetPredictor(vehicle_off_lane_predictor_);
-            }
-            break;
-          }
-          case PerceptionObstacle::PEDESTRIAN: {
-            predictor = GetPredictor(pedestrian_predictor_);
-            break;
-          }
-          case PerceptionObstacle::BICYCLE: {
-            if (obstacle->IsOnLane() && !obstacle->IsNearJunction()) {
-              predictor = GetPredictor(cyclist_on_lane_predictor_);
-            } else {
-              predictor = GetPredictor(cyclist_off_lane_predictor_);
-            }
-            break;
-          }
-          default: {
-            if (obstacle->IsOnLane()) {
-              predictor = GetPredictor(default_on_lane_predictor_);
-            } else {
-              predictor = GetPredictor(default_off_lane_predictor_);
-            }
-            break;
-          }
-        }
+  if (FLAGS_enable_parallel_prediction &&
+      FLAGS_num_prediction_thread_pool > 1 &&
+      valid_perception_obstacles.size() > 1) {
+    RunInParallel(valid_perception_obstacles, obstacles_container,
+                  adc_trajectory_container);
+  } else {
+    for (const PerceptionObstacle* perception_obstacle :
+         valid_perception_obstacles) {
+      Obstacle* obstacle =
+          obstacles_container->GetObstacle(perception_obstacle->id());
+      Predictor* predictor = nullptr;
+      if (obstacle != nullptr) {
+        predictor =
+            GetPredictor(SelectPredictor(*perception_obstacle, obstacle));
       }
+      PredictObstacle(*perception_obstacle, obstacle, predictor,
+                      adc_trajectory_container,
+                      prediction_obstacles_.add_prediction_obstacle());
+    }
+  }
+  prediction_obstacles_.set_perception_error_code(
+      perception_obstacles.error_code());
+}
 
-      if (predictor != nullptr) {
-        predictor->Predict(obstacle);
-        if (FLAGS_enable_trim_prediction_trajectory &&
-            obstacle->type() == PerceptionObstacle::VEHICLE) {
-          CHECK_NOTNULL(adc_trajectory_container);
-          predictor->TrimTrajectories(obstacle, adc_trajectory_container);
-        }
-        for (const auto& trajectory : predictor->trajectories()) {
-          prediction_obstacle.add_trajectory()->CopyFrom(trajectory);
-        }
+ObstacleConf::PredictorType PredictorManager::SelectPredictor(
+    const PerceptionObstacle& perception_obstacle,
+    Obstacle* obstacle) const {
+  if (obstacle->IsStill()) {
+    return ObstacleConf::EMPTY_PREDICTOR;
+  }
+  switch (perception_obstacle.type()) {
+    case PerceptionObstacle::VEHICLE: {
+      return obstacle->IsOnLane() ? vehicle_on_lane_predictor_
+                                 : vehicle_off_lane_predictor_;
+    }
+    case PerceptionObstacle::PEDESTRIAN: {
+      return pedestrian_predictor_;
+    }
+    case PerceptionObstacle::BICYCLE: {
+      return obstacle->IsOnLane() && !obstacle->IsNearJunction()
+                 ? cyclist_on_lane_predictor_
+                 : cyclist_off_lane_predictor_;
+    }
+    default: {
+      return obstacle->IsOnLane() ? default_on_lane_predictor_
+                                 : default_off_lane_predictor_;
+    }
+  }
+}
+
+void PredictorManager::PredictObstacle(
+    const PerceptionObstacle& perception_obstacle, Obstacle* obstacle,
+    Predictor* predictor,
+    const ADCTrajectoryContainer* adc_trajectory_container,
+    PredictionObstacle* const prediction_obstacle) {
+  prediction_obstacle->set_timestamp(perception_obstacle.timestamp());
+  if (obstacle != nullptr) {
+    if (predictor != nullptr) {
+      predictor->Predict(obstacle);
+      if (FLAGS_enable_trim_prediction_trajectory &&
+          obstacle->type() == PerceptionObstacle::VEHICLE) {
+        CHECK_NOTNULL(adc_trajectory_container);
+        predictor->TrimTrajectories(obstacle, adc_trajectory_container);
+      }
+      for (const auto& trajectory : predictor->trajectories()) {
+        prediction_obstacle->add_trajectory()->CopyFrom(trajectory);
       }
-      prediction_obstacle.set_timestamp(obstacle->timestamp());
     }
+    prediction_obstacle->set_timestamp(obstacle->timestamp());
+  }
+
+  prediction_obstacle->set_predicted_period(FLAGS_prediction_duration);
+  prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
+      perception_obstacle);
+}
 
-    prediction_obstacle.set_predicted_period(FLAGS_prediction_duration);
-    prediction_obstacle.mutable_perception_obstacle()->CopyFrom(
-        perception_obstacle);
+void PredictorManager::RunInParallel(
+    const std::vector<const PerceptionObstacle*>& perception_obstacles,
+    ObstaclesContainer* obstacles_container,
+    const ADCTrajectoryContainer* adc_trajectory_container) {
+  struct ObstaclePrediction {
+    const PerceptionObstacle* perception_obstacle;
+    Obstacle* obstacle;
+    Predictor* predictor;
+    PredictionObstacle* prediction_obstacle;
+  };
 
-    prediction_obstacles_.add_prediction_obstacle()->CopyFrom(
-        prediction_obstacle);
+  const int num_shards = FLAGS_num_prediction_thread_pool;
+  if (static_cast<int>(shard_predictors_.size()) < num_shards) {
+    shard_predictors_.resize(num_shards);
   }
-  prediction_obstacles_.set_perception_error_code(
-      perception_obstacles.error_code());
+
+  // Output slots, obstacles and predictor instances are all set up serially,
+  // the shards only write to their own slots.
+  std::vector<std::vector<ObstaclePrediction>> shards(num_shards);
+  for (const PerceptionObstacle* perception_obstacle : perception_obstacles) {
+    // Sharding by id keeps duplicated obstacles on one thread.
+    const int shard = perception_obstacle->id() % num_shards;
+    ObstaclePrediction prediction;
+    prediction.perception_obstacle = perception_obstacle;
+    prediction.obstacle =
+        obstacles_container->GetObstacle(perception_obstacle->id());
+    prediction.predictor = nullptr;
+    prediction.prediction_obstacle =
+        prediction_obstacles_.add_prediction_obstacle();
+    if (prediction.obstacle != nullptr) {
+      const ObstacleConf::PredictorType type =
+          SelectPredictor(*perception_obstacle, prediction.obstacle);
+      if (shard == 0) {
+        prediction.predictor = GetPredictor(type);
+      } else {
+        auto& shard_predictor = shard_predictors_[shard][type];
+        if (shard_predictor == nullptr) {
+          shard_predictor = CreatePredictor(type);
+        }
+        prediction.predictor = shard_predictor.get();
+      }
+    }
+    shards[shard].push_back(prediction);
+  }
+
+  PredictionThreadPool::instance()->Init();
+  for (const auto& shard : shards) {
+    if (shard.empty()) {
+      continue;
+    }
+    PredictionThreadPool::instance()->Push(
+        [&shard, adc_trajectory_container](int thread_id) {
+          for (const ObstaclePrediction& prediction : shard) {
+            PredictObstacle(*prediction.perception_obstacle,
+                            prediction.obstacle, prediction.predictor,
+                            adc_trajectory_container,
+                            prediction.prediction_obstacle);
+          }
+        });
+  }
+  PredictionThreadPool::instance()->Synchronize();
 }
 
 std::unique_ptr<Predictor> PredictorManager::CreatePredictor(
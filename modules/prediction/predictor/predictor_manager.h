@@ -24,12 +24,14 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 #include "modules/common/macro.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/predictor/predictor.h"
 
 /**
@@ -59,7 +61,9 @@ class PredictorManager {
   Predictor* GetPredictor(const ObstacleConf::PredictorType& type);
 
   /**
-   * @brief Execute the predictor generation on perception obstacles
+   * @brief Execute the predictor generation on perception obstacles, in
+   *        parallel over obstacles if FLAGS_enable_parallel_prediction is set.
+   *        Prediction obstacles are in the order of perception obstacles.
    * @param Perception obstacles
    */
   void Run(const perception::PerceptionObstacles& perception_obstacles);
@@ -90,9 +94,50 @@ class PredictorManager {
    */
   void RegisterPredictors();
 
+  /**
+   * @brief Select the predictor type of an obstacle
+   * @param Perception obstacle
+   * @param Obstacle
+   * @return The predictor type
+   */
+  ObstacleConf::PredictorType SelectPredictor(
+      const perception::PerceptionObstacle& perception_obstacle,
+      Obstacle* obstacle) const;
+
+  /**
+   * @brief Predict an obstacle into a prediction obstacle
+   * @param Perception obstacle
+   * @param Obstacle, nullptr if it is not in the container
+   * @param Predictor, nullptr for no prediction
+   * @param ADC trajectory container
+   * @param The output prediction obstacle
+   */
+  static void PredictObstacle(
+      const perception::PerceptionObstacle& perception_obstacle,
+      Obstacle* obstacle, Predictor* predictor,
+      const ADCTrajectoryContainer* adc_trajectory_container,
+      PredictionObstacle* const prediction_obstacle);
+
+  /**
+   * @brief Predict obstacles on the thread pool, each shard of obstacles
+   *        with its own predictor instances
+   * @param Perception obstacles with valid ids
+   * @param Obstacles container
+   * @param ADC trajectory container
+   */
+  void RunInParallel(
+      const std::vector<const perception::PerceptionObstacle*>&
+          perception_obstacles,
+      ObstaclesContainer* obstacles_container,
+      const ADCTrajectoryContainer* adc_trajectory_container);
+
  private:
   std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>> predictors_;
 
+  // Predictors of the parallel shards, shard 0 uses predictors_.
+  std::vector<std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>>>
+      shard_predictors_;
+
   ObstacleConf::PredictorType vehicle_on_lane_predictor_ =
       ObstacleConf::LANE_SEQUENCE_PREDICTOR;
 
@@ -79,5 +79,43 @@ TEST_F(PredictorManagerTest, General) {
   EXPECT_EQ(prediction_obstacles.prediction_obstacle_size(), 1);
 }
 
+TEST_F(PredictorManagerTest, Parallel) {
+  FLAGS_enable_trim_prediction_trajectory = false;
+  std::string conf_file = "modules/prediction/testdata/adapter_conf.pb.txt";
+  EXPECT_TRUE(common::util::GetProtoFromFile(conf_file, &adapter_conf_));
+  perception::PerceptionObstacles perception_obstacles;
+  EXPECT_TRUE(common::util::GetProtoFromFile(
+      "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt",
+      &perception_obstacles));
+
+  ContainerManager::instance()->Init(adapter_conf_);
+  EvaluatorManager::instance()->Init(prediction_conf_);
+  PredictorManager::instance()->Init(prediction_conf_);
+
+  ObstaclesContainer* obstacles_container = dynamic_cast<ObstaclesContainer*>(
+      ContainerManager::instance()->GetContainer(
+          AdapterConfig::PERCEPTION_OBSTACLES));
+  CHECK_NOTNULL(obstacles_container);
+  obstacles_container->Insert(perception_obstacles);
+
+  EvaluatorManager::instance()->Run(perception_obstacles);
+  PredictorManager::instance()->Run(perception_obstacles);
+  const PredictionObstacles serial_prediction_obstacles =
+      PredictorManager::instance()->prediction_obstacles();
+
+  FLAGS_enable_parallel_prediction = true;
+  FLAGS_num_prediction_thread_pool = 3;
+  EvaluatorManager::instance()->Run(perception_obstacles);
+  PredictorManager::instance()->Run(perception_obstacles);
+  FLAGS_enable_parallel_prediction = false;
+
+  const PredictionObstacles& prediction_obstacles =
+      PredictorManager::instance()->prediction_obstacles();
+  EXPECT_EQ(perception_obstacles.perception_obstacle_size(),
+            prediction_obstacles.prediction_obstacle_size());
+  EXPECT_EQ(serial_prediction_obstacles.DebugString(),
+            prediction_obstacles.DebugString());
+}
+
 }  // namespace prediction
 }  // namespace apollo
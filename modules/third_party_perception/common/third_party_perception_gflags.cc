@@ -87,3 +87,14 @@ DEFINE_double(max_mobileye_obstacle_width, 12.7,
 
 DEFINE_bool(overwrite_mobileye_theta, true,
             "overrite mobileye raw theta output");
+
+// flags to fuse mobileye and radar obstacles
+DEFINE_string(mobileye_radar_association, "all",
+              "how the overlapping mobileye and radar obstacles are "
+              "associated: 'all' fuses a mobileye obstacle with every "
+              "overlapping radar obstacle, 'greedy' pairs the nearest "
+              "obstacles first and 'optimal' pairs them with the least total "
+              "distance, one radar obstacle per mobileye obstacle");
+DEFINE_double(fusion_grid_cell_size, 10.0,
+              "size in meters of the grid cells which the radar obstacles "
+              "are put into to find those overlapping a mobileye obstacle");
@@ -62,4 +62,8 @@ DECLARE_double(max_mobileye_obstacle_length);
 DECLARE_double(max_mobileye_obstacle_width);
 DECLARE_bool(overwrite_mobileye_theta);
 
+// flags to fuse mobileye and radar obstacles
+DECLARE_string(mobileye_radar_association);
+DECLARE_double(fusion_grid_cell_size);
+
 #endif
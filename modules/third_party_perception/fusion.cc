@@ -20,9 +20,16 @@
 
 #include "modules/third_party_perception/fusion.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
 #include <vector>
 
+#include "modules/common/log.h"
 #include "modules/common/math/polygon2d.h"
+#include "modules/common/math/polygon2d_batch.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/third_party_perception/common/third_party_perception_gflags.h"
 #include "modules/third_party_perception/common/third_party_perception_util.h"
@@ -35,6 +42,8 @@ namespace apollo {
 namespace third_party_perception {
 namespace fusion {
 
+using apollo::common::math::Polygon2d;
+using apollo::common::math::Polygon2dBatch;
 using apollo::common::math::Vec2d;
 using apollo::perception::PerceptionObstacle;
 using apollo::perception::PerceptionObstacles;
@@ -48,44 +57,348 @@ std::vector<Vec2d> PerceptionObstacleToVectorVec2d(
   return result;
 }
 
-bool HasOverlap(const PerceptionObstacle& obstacle_1,
+namespace {
+
+// The obstacles with more grid cells than this are tested against all the
+// others instead.
+constexpr int kMaxGridCellsPerObstacle = 256;
+// The cost of a pair which does not overlap in the optimal assignment.
+constexpr double kNoOverlapCost = 1e9;
+
+// The polygon of an obstacle, which is built once per frame.
+struct ObstaclePolygon {
+  bool valid = false;
+  Polygon2d polygon;
+};
+
+struct ObstaclePair {
+  int mobileye_index;
+  int radar_index;
+  double distance;
+};
+
+std::vector<ObstaclePolygon> BuildPolygons(
+    const PerceptionObstacles& obstacles) {
+  std::vector<ObstaclePolygon> polygons(obstacles.perception_obstacle_size());
+  for (int i = 0; i < obstacles.perception_obstacle_size(); ++i) {
+    const auto& obstacle = obstacles.perception_obstacle(i);
+    if (obstacle.polygon_point_size() >= 3) {
+      polygons[i].valid = true;
+      polygons[i].polygon =
+          Polygon2d(PerceptionObstacleToVectorVec2d(obstacle));
+    }
+  }
+  return polygons;
+}
+
+// Builds the polygons of the obstacles with 3 points at least into a batch,
+// and sets the index of the obstacle of each polygon.
+Polygon2dBatch BuildPolygonBatch(const PerceptionObstacles& obstacles,
+                                 std::vector<int>* obstacle_indices) {
+  Polygon2dBatch polygons;
+  polygons.Reserve(obstacles.perception_obstacle_size());
+  obstacle_indices->clear();
+  for (int i = 0; i < obstacles.perception_obstacle_size(); ++i) {
+    const auto& obstacle = obstacles.perception_obstacle(i);
+    if (obstacle.polygon_point_size() >= 3) {
+      polygons.Add(Polygon2d(PerceptionObstacleToVectorVec2d(obstacle)));
+      obstacle_indices->push_back(i);
+    }
+  }
+  return polygons;
+}
+
+// A uniform grid of the radar polygons, keyed by the cells which their
+// bounding boxes cover.
+class RadarGrid {
+ public:
+  RadarGrid(const Polygon2dBatch& polygons, const double cell_size)
+      : inverse_cell_size_(1.0 / cell_size),
+        last_query_(polygons.size(), -1) {
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      const Polygon2d& polygon = polygons.polygon(i);
+      if (!ForEachCell(polygon, [&](const uint64_t key) {
+            cells_.emplace_back(key, static_cast<int>(i));
+          })) {
+        large_obstacles_.push_back(static_cast<int>(i));
+      }
+    }
+    std::sort(cells_.begin(), cells_.end());
+  }
+
+  // Returns the radar polygons sharing a grid cell with the polygon, in
+  // ascending order.
+  const std::vector<int>& Query(const Polygon2d& polygon) {
+    ++num_queries_;
+    candidates_.clear();
+    const auto add_candidate = [this](const int index) {
+      if (last_query_[index] != num_queries_) {
+        last_query_[index] = num_queries_;
+        candidates_.push_back(index);
+      }
+    };
+    const bool is_small = ForEachCell(polygon, [&](const uint64_t key) {
+      auto iter = std::lower_bound(cells_.begin(), cells_.end(),
+                                   std::make_pair(key, -1));
+      for (; iter != cells_.end() && iter->first == key; ++iter) {
+        add_candidate(iter->second);
+      }
+    });
+    if (!is_small) {
+      for (const auto& cell : cells_) {
+        add_candidate(cell.second);
+      }
+    }
+    for (const int index : large_obstacles_) {
+      add_candidate(index);
+    }
+    std::sort(candidates_.begin(), candidates_.end());
+    return candidates_;
+  }
+
+ private:
+  // Calls the function with the key of every cell covered by the bounding box
+  // of the polygon, unless there are more than kMaxGridCellsPerObstacle.
+  template <typename Function>
+  bool ForEachCell(const Polygon2d& polygon, const Function& function) const {
+    const double min_x = std::floor(polygon.min_x() * inverse_cell_size_);
+    const double max_x = std::floor(polygon.max_x() * inverse_cell_size_);
+    const double min_y = std::floor(polygon.min_y() * inverse_cell_size_);
+    const double max_y = std::floor(polygon.max_y() * inverse_cell_size_);
+    if (!((max_x - min_x + 1.0) * (max_y - min_y + 1.0) <=
+          kMaxGridCellsPerObstacle)) {
+      return false;
+    }
+    for (int64_t x = static_cast<int64_t>(min_x); x <= max_x; ++x) {
+      for (int64_t y = static_cast<int64_t>(min_y); y <= max_y; ++y) {
+        function(static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 |
+                 static_cast<uint32_t>(y));
+      }
+    }
+    return true;
+  }
+
+  const double inverse_cell_size_;
+  // The cells of the radar obstacles, sorted by key.
+  std::vector<std::pair<uint64_t, int>> cells_;
+  // The radar obstacles too large for the grid.
+  std::vector<int> large_obstacles_;
+  // The last query which returned each radar obstacle, to return it once.
+  std::vector<int> last_query_;
+  int num_queries_ = 0;
+  std::vector<int> candidates_;
+};
+
+double Distance(const PerceptionObstacle& obstacle_1,
                 const PerceptionObstacle& obstacle_2) {
-  common::math::Polygon2d polygon_1(
-      PerceptionObstacleToVectorVec2d(obstacle_1));
-  common::math::Polygon2d polygon_2(
-      PerceptionObstacleToVectorVec2d(obstacle_2));
-  return polygon_1.HasOverlap(polygon_2);
+  return std::hypot(obstacle_1.position().x() - obstacle_2.position().x(),
+                    obstacle_1.position().y() - obstacle_2.position().y());
 }
 
-bool HasOverlap(const PerceptionObstacle& obstacle,
-                const PerceptionObstacles& obstacles) {
-  for (const auto& current_obstacle : obstacles.perception_obstacle()) {
-    if (HasOverlap(obstacle, current_obstacle)) {
-      return true;
+// Finds the pairs of overlapping mobileye and radar obstacles, ordered by
+// the mobileye and then the radar obstacle.
+std::vector<ObstaclePair> FindOverlappingPairs(
+    const PerceptionObstacles& mobileye_obstacles,
+    const PerceptionObstacles& radar_obstacles) {
+  std::vector<ObstaclePair> pairs;
+  const auto mobileye_polygons = BuildPolygons(mobileye_obstacles);
+  std::vector<int> radar_indices;
+  const Polygon2dBatch radar_polygons =
+      BuildPolygonBatch(radar_obstacles, &radar_indices);
+  RadarGrid grid(radar_polygons, FLAGS_fusion_grid_cell_size);
+  std::vector<uint8_t> overlaps;
+  for (size_t i = 0; i < mobileye_polygons.size(); ++i) {
+    if (!mobileye_polygons[i].valid) {
+      continue;
+    }
+    const Polygon2d& polygon = mobileye_polygons[i].polygon;
+    const std::vector<int>& candidates = grid.Query(polygon);
+    radar_polygons.HasOverlap(polygon, candidates, &overlaps);
+    for (size_t k = 0; k < candidates.size(); ++k) {
+      if (overlaps[k]) {
+        const int j = radar_indices[candidates[k]];
+        pairs.push_back({static_cast<int>(i), j,
+                         Distance(mobileye_obstacles.perception_obstacle(i),
+                                  radar_obstacles.perception_obstacle(j))});
+      }
+    }
+  }
+  return pairs;
+}
+
+// Keeps the nearest pairs, such that every obstacle is in one pair at most.
+std::vector<ObstaclePair> AssignGreedily(std::vector<ObstaclePair> pairs,
+                                         const int num_mobileye_obstacles,
+                                         const int num_radar_obstacles) {
+  std::stable_sort(pairs.begin(), pairs.end(),
+                   [](const ObstaclePair& pair_1, const ObstaclePair& pair_2) {
+                     return pair_1.distance < pair_2.distance;
+                   });
+  std::vector<bool> mobileye_assigned(num_mobileye_obstacles, false);
+  std::vector<bool> radar_assigned(num_radar_obstacles, false);
+  std::vector<ObstaclePair> result;
+  for (const auto& pair : pairs) {
+    if (!mobileye_assigned[pair.mobileye_index] &&
+        !radar_assigned[pair.radar_index]) {
+      mobileye_assigned[pair.mobileye_index] = true;
+      radar_assigned[pair.radar_index] = true;
+      result.push_back(pair);
+    }
+  }
+  return result;
+}
+
+// Solves the assignment of the rows of the cost matrix to distinct columns
+// with the least total cost by the Hungarian algorithm, where there are no
+// more rows than columns. Returns the column of each row.
+std::vector<int> SolveAssignment(const std::vector<std::vector<double>>& cost) {
+  const int num_rows = static_cast<int>(cost.size());
+  const int num_columns = static_cast<int>(cost.front().size());
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  // The potentials of the rows and the columns, and the row assigned to each
+  // column, indexed from 1 with 0 as a sentinel.
+  std::vector<double> row_potential(num_rows + 1, 0.0);
+  std::vector<double> column_potential(num_columns + 1, 0.0);
+  std::vector<int> column_row(num_columns + 1, 0);
+  std::vector<int> previous_column(num_columns + 1, 0);
+  for (int row = 1; row <= num_rows; ++row) {
+    column_row[0] = row;
+    int column = 0;
+    std::vector<double> min_slack(num_columns + 1, kInfinity);
+    std::vector<bool> visited(num_columns + 1, false);
+    do {
+      visited[column] = true;
+      const int current_row = column_row[column];
+      double delta = kInfinity;
+      int next_column = 0;
+      for (int j = 1; j <= num_columns; ++j) {
+        if (visited[j]) {
+          continue;
+        }
+        const double slack = cost[current_row - 1][j - 1] -
+                             row_potential[current_row] - column_potential[j];
+        if (slack < min_slack[j]) {
+          min_slack[j] = slack;
+          previous_column[j] = column;
+        }
+        if (min_slack[j] < delta) {
+          delta = min_slack[j];
+          next_column = j;
+        }
+      }
+      for (int j = 0; j <= num_columns; ++j) {
+        if (visited[j]) {
+          row_potential[column_row[j]] += delta;
+          column_potential[j] -= delta;
+        } else {
+          min_slack[j] -= delta;
+        }
+      }
+      column = next_column;
+    } while (column_row[column] != 0);
+    // Flip the augmenting path.
+    do {
+      const int next_column = previous_column[column];
+      column_row[column] = column_row[next_column];
+      column = next_column;
+    } while (column != 0);
+  }
+
+  std::vector<int> row_column(num_rows, -1);
+  for (int j = 1; j <= num_columns; ++j) {
+    if (column_row[j] != 0) {
+      row_column[column_row[j] - 1] = j - 1;
     }
   }
-  return false;
+  return row_column;
 }
 
+// Keeps the pairs with the least total distance among the assignments with
+// the most pairs, such that every obstacle is in one pair at most.
+std::vector<ObstaclePair> AssignOptimally(
+    const std::vector<ObstaclePair>& pairs) {
+  if (pairs.empty()) {
+    return pairs;
+  }
+  // Only the obstacles in a pair take part in the assignment.
+  std::vector<int> mobileye_indices;
+  std::vector<int> radar_indices;
+  for (const auto& pair : pairs) {
+    mobileye_indices.push_back(pair.mobileye_index);
+    radar_indices.push_back(pair.radar_index);
+  }
+  for (auto* indices : {&mobileye_indices, &radar_indices}) {
+    std::sort(indices->begin(), indices->end());
+    indices->erase(std::unique(indices->begin(), indices->end()),
+                   indices->end());
+  }
+  const auto position = [](const std::vector<int>& indices, const int index) {
+    return static_cast<int>(
+        std::lower_bound(indices.begin(), indices.end(), index) -
+        indices.begin());
+  };
+
+  // The rows are the side with fewer obstacles.
+  const bool mobileye_rows = mobileye_indices.size() <= radar_indices.size();
+  const auto& row_indices = mobileye_rows ? mobileye_indices : radar_indices;
+  const auto& column_indices =
+      mobileye_rows ? radar_indices : mobileye_indices;
+  std::vector<std::vector<double>> cost(
+      row_indices.size(),
+      std::vector<double>(column_indices.size(), kNoOverlapCost));
+  std::vector<std::vector<int>> pair_index(
+      row_indices.size(), std::vector<int>(column_indices.size(), -1));
+  for (size_t k = 0; k < pairs.size(); ++k) {
+    const int mobileye = position(mobileye_indices, pairs[k].mobileye_index);
+    const int radar = position(radar_indices, pairs[k].radar_index);
+    const int row = mobileye_rows ? mobileye : radar;
+    const int column = mobileye_rows ? radar : mobileye;
+    cost[row][column] = pairs[k].distance;
+    pair_index[row][column] = static_cast<int>(k);
+  }
+
+  std::vector<ObstaclePair> result;
+  const auto row_column = SolveAssignment(cost);
+  for (size_t row = 0; row < row_column.size(); ++row) {
+    const int column = row_column[row];
+    if (column >= 0 && pair_index[row][column] >= 0) {
+      result.push_back(pairs[pair_index[row][column]]);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
 PerceptionObstacles MobileyeRadarFusion(
     const PerceptionObstacles& mobileye_obstacles,
     const PerceptionObstacles& radar_obstacles) {
   PerceptionObstacles mobileye_obstacles_fusion = mobileye_obstacles;
-  PerceptionObstacles radar_obstacles_fusion = radar_obstacles;
-
-  for (auto& mobileye_obstacle :
-       *(mobileye_obstacles_fusion.mutable_perception_obstacle())) {
-    for (auto& radar_obstacle :
-         *(radar_obstacles_fusion.mutable_perception_obstacle())) {
-      if (HasOverlap(mobileye_obstacle, radar_obstacle)) {
-        mobileye_obstacle.set_confidence(0.99);
-        mobileye_obstacle.mutable_velocity()->CopyFrom(
-            radar_obstacle.velocity());
-      }
-    }
+
+  std::vector<ObstaclePair> pairs =
+      FindOverlappingPairs(mobileye_obstacles, radar_obstacles);
+  if (FLAGS_mobileye_radar_association == "greedy") {
+    pairs = AssignGreedily(std::move(pairs),
+                           mobileye_obstacles.perception_obstacle_size(),
+                           radar_obstacles.perception_obstacle_size());
+  } else if (FLAGS_mobileye_radar_association == "optimal") {
+    pairs = AssignOptimally(pairs);
+  } else if (FLAGS_mobileye_radar_association != "all") {
+    AERROR_EVERY(100) << "Unknown mobileye radar association: "
+                      << FLAGS_mobileye_radar_association;
+  }
+
+  // With all the overlapping pairs, a mobileye obstacle gets the velocity of
+  // the last overlapping radar obstacle.
+  for (const auto& pair : pairs) {
+    auto* mobileye_obstacle =
+        mobileye_obstacles_fusion.mutable_perception_obstacle(
+            pair.mobileye_index);
+    mobileye_obstacle->set_confidence(0.99);
+    mobileye_obstacle->mutable_velocity()->CopyFrom(
+        radar_obstacles.perception_obstacle(pair.radar_index).velocity());
   }
 
-  // mobileye_obstacles_fusion.MergeFrom(radar_obstacles_fusion);
   return mobileye_obstacles_fusion;
 }
 
@@ -31,6 +31,14 @@ namespace apollo {
 namespace third_party_perception {
 namespace fusion {
 
+/**
+ * @brief Fuses the mobileye obstacles with the overlapping radar obstacles,
+ * which give them their velocity. The pairs are associated as set by
+ * FLAGS_mobileye_radar_association.
+ * @param mobileye_obstacles the mobileye obstacles.
+ * @param radar_obstacles the radar obstacles.
+ * @return The fused mobileye obstacles.
+ */
 apollo::perception::PerceptionObstacles MobileyeRadarFusion(
     const apollo::perception::PerceptionObstacles& mobileye_obstacles,
     const apollo::perception::PerceptionObstacles& radar_obstacles);
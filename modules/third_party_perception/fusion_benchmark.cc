@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the CPU time of MobileyeRadarFusion against the former
+ *        pairwise fusion. The frames are made of the obstacles of the
+ *        simple_fusion integration test data, which are split into the
+ *        mobileye and the radar obstacles by id, and copied with some
+ *        jitter up to the given numbers of obstacles.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/polygon2d.h"
+#include "modules/common/util/file.h"
+#include "modules/third_party_perception/common/third_party_perception_gflags.h"
+#include "modules/third_party_perception/fusion.h"
+
+DEFINE_string(benchmark_obstacles_file,
+              "modules/third_party_perception/testdata/simple_fusion/"
+              "1_perception_obstacles.pb.txt",
+              "File of the obstacles of both mobileye and radar.");
+DEFINE_int32(benchmark_num_frames, 200, "Number of frames.");
+DEFINE_int32(benchmark_num_mobileye_obstacles, 10,
+             "Number of mobileye obstacles per frame.");
+DEFINE_int32(benchmark_num_radar_obstacles, 128,
+             "Number of radar obstacles per frame.");
+
+namespace apollo {
+namespace third_party_perception {
+namespace {
+
+using apollo::common::math::Polygon2d;
+using apollo::common::math::Vec2d;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+std::vector<Vec2d> ToPoints(const PerceptionObstacle& obstacle) {
+  std::vector<Vec2d> points;
+  for (const auto& vertex : obstacle.polygon_point()) {
+    points.emplace_back(vertex.x(), vertex.y());
+  }
+  return points;
+}
+
+// The former MobileyeRadarFusion, which tests every pair of obstacles.
+PerceptionObstacles PairwiseFusion(
+    const PerceptionObstacles& mobileye_obstacles,
+    const PerceptionObstacles& radar_obstacles) {
+  PerceptionObstacles mobileye_obstacles_fusion = mobileye_obstacles;
+  PerceptionObstacles radar_obstacles_fusion = radar_obstacles;
+  for (auto& mobileye_obstacle :
+       *(mobileye_obstacles_fusion.mutable_perception_obstacle())) {
+    for (auto& radar_obstacle :
+         *(radar_obstacles_fusion.mutable_perception_obstacle())) {
+      Polygon2d polygon_1(ToPoints(mobileye_obstacle));
+      Polygon2d polygon_2(ToPoints(radar_obstacle));
+      if (polygon_1.HasOverlap(polygon_2)) {
+        mobileye_obstacle.set_confidence(0.99);
+        mobileye_obstacle.mutable_velocity()->CopyFrom(
+            radar_obstacle.velocity());
+      }
+    }
+  }
+  return mobileye_obstacles_fusion;
+}
+
+// Adds a copy of an obstacle moved by the offset.
+void AddCopy(const PerceptionObstacle& obstacle, const double dx,
+             const double dy, PerceptionObstacles* obstacles) {
+  PerceptionObstacle* copy = obstacles->add_perception_obstacle();
+  *copy = obstacle;
+  copy->mutable_position()->set_x(obstacle.position().x() + dx);
+  copy->mutable_position()->set_y(obstacle.position().y() + dy);
+  for (auto& point : *copy->mutable_polygon_point()) {
+    point.set_x(point.x() + dx);
+    point.set_y(point.y() + dy);
+  }
+}
+
+PerceptionObstacles CreateObstacles(
+    const std::vector<PerceptionObstacle>& originals, const int num_obstacles,
+    std::mt19937* random) {
+  std::normal_distribution<double> jitter(0.0, 2.0);
+  PerceptionObstacles obstacles;
+  for (int i = 0; i < num_obstacles; ++i) {
+    const PerceptionObstacle& original = originals[i % originals.size()];
+    if (i < static_cast<int>(originals.size())) {
+      AddCopy(original, 0.0, 0.0, &obstacles);
+    } else {
+      AddCopy(original, jitter(*random), jitter(*random), &obstacles);
+    }
+  }
+  return obstacles;
+}
+
+double ElapsedMs(const std::chrono::steady_clock::time_point start) {
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+  return duration.count();
+}
+
+int Run() {
+  PerceptionObstacles obstacles;
+  if (!common::util::GetProtoFromFile(FLAGS_benchmark_obstacles_file,
+                                      &obstacles)) {
+    std::cerr << "Failed to read " << FLAGS_benchmark_obstacles_file
+              << std::endl;
+    return 1;
+  }
+  std::vector<PerceptionObstacle> mobileye_originals;
+  std::vector<PerceptionObstacle> radar_originals;
+  for (const auto& obstacle : obstacles.perception_obstacle()) {
+    if (obstacle.id() >= FLAGS_radar_id_offset) {
+      radar_originals.push_back(obstacle);
+    } else {
+      mobileye_originals.push_back(obstacle);
+    }
+  }
+  if (mobileye_originals.empty() || radar_originals.empty()) {
+    std::cerr << "Expect both mobileye and radar obstacles." << std::endl;
+    return 1;
+  }
+
+  std::mt19937 random(2018);
+  std::vector<PerceptionObstacles> mobileye_frames;
+  std::vector<PerceptionObstacles> radar_frames;
+  for (int i = 0; i < FLAGS_benchmark_num_frames; ++i) {
+    mobileye_frames.push_back(CreateObstacles(
+        mobileye_originals, FLAGS_benchmark_num_mobileye_obstacles, &random));
+    radar_frames.push_back(CreateObstacles(
+        radar_originals, FLAGS_benchmark_num_radar_obstacles, &random));
+  }
+  const size_t num_frames = mobileye_frames.size();
+
+  std::vector<std::string> expected;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_frames; ++i) {
+    expected.push_back(PairwiseFusion(mobileye_frames[i], radar_frames[i])
+                           .SerializeAsString());
+  }
+  const double pairwise_ms = ElapsedMs(start);
+
+  std::cout << "frames: " << num_frames << ", mobileye obstacles: "
+            << FLAGS_benchmark_num_mobileye_obstacles
+            << ", radar obstacles: " << FLAGS_benchmark_num_radar_obstacles
+            << std::endl
+            << std::fixed << std::setprecision(3)
+            << "pairwise:       " << pairwise_ms / num_frames << " ms/frame"
+            << std::endl;
+
+  int num_mismatches = 0;
+  for (const std::string association : {"all", "greedy", "optimal"}) {
+    FLAGS_mobileye_radar_association = association;
+    std::vector<std::string> fused;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_frames; ++i) {
+      fused.push_back(
+          fusion::MobileyeRadarFusion(mobileye_frames[i], radar_frames[i])
+              .SerializeAsString());
+    }
+    const double grid_ms = ElapsedMs(start);
+    std::cout << "grid, " << std::setw(9) << std::left << association + ":"
+              << grid_ms / num_frames << " ms/frame" << std::endl;
+    // Only the fusion of all the overlapping pairs is the same as before.
+    if (association == "all" && fused != expected) {
+      ++num_mismatches;
+    }
+  }
+  std::cout << "mismatched runs: " << num_mismatches << std::endl;
+  return num_mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace third_party_perception
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::third_party_perception::Run();
+}
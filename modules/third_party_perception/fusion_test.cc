@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/third_party_perception/fusion.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/polygon2d.h"
+#include "modules/third_party_perception/common/third_party_perception_gflags.h"
+
+namespace apollo {
+namespace third_party_perception {
+namespace fusion {
+
+using apollo::common::math::Polygon2d;
+using apollo::common::math::Vec2d;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+namespace {
+
+// Adds an axis aligned obstacle, with its id as the x of its velocity.
+void AddObstacle(const int id, const double x, const double y,
+                 const double length, const double width,
+                 PerceptionObstacles* obstacles) {
+  PerceptionObstacle* obstacle = obstacles->add_perception_obstacle();
+  obstacle->set_id(id);
+  obstacle->mutable_position()->set_x(x);
+  obstacle->mutable_position()->set_y(y);
+  obstacle->mutable_velocity()->set_x(id);
+  obstacle->set_confidence(0.5);
+  const double dx[] = {-0.5, 0.5, 0.5, -0.5};
+  const double dy[] = {-0.5, -0.5, 0.5, 0.5};
+  for (int i = 0; i < 4; ++i) {
+    auto* point = obstacle->add_polygon_point();
+    point->set_x(x + dx[i] * length);
+    point->set_y(y + dy[i] * width);
+  }
+}
+
+// The radar id fused into each mobileye obstacle, or -1.
+std::vector<int> FusedRadarIds(const PerceptionObstacles& fused) {
+  std::vector<int> ids;
+  for (const auto& obstacle : fused.perception_obstacle()) {
+    ids.push_back(obstacle.confidence() == 0.99
+                      ? static_cast<int>(obstacle.velocity().x())
+                      : -1);
+  }
+  return ids;
+}
+
+std::vector<Vec2d> Points(const PerceptionObstacle& obstacle) {
+  std::vector<Vec2d> points;
+  for (const auto& point : obstacle.polygon_point()) {
+    points.emplace_back(point.x(), point.y());
+  }
+  return points;
+}
+
+}  // namespace
+
+class FusionTest : public ::testing::Test {
+ protected:
+  void TearDown() override { FLAGS_mobileye_radar_association = "all"; }
+};
+
+TEST_F(FusionTest, AllOverlapsAsBruteForce) {
+  std::mt19937 random(2018);
+  std::uniform_real_distribution<double> x(0.0, 150.0);
+  std::uniform_real_distribution<double> y(-20.0, 20.0);
+  std::uniform_real_distribution<double> size(0.5, 6.0);
+  for (int frame = 0; frame < 20; ++frame) {
+    PerceptionObstacles mobileye_obstacles;
+    PerceptionObstacles radar_obstacles;
+    for (int i = 0; i < 10; ++i) {
+      AddObstacle(i, x(random), y(random), size(random), size(random),
+                  &mobileye_obstacles);
+    }
+    // A radar obstacle larger than the grid cells, which the later overlapping
+    // radar obstacles take precedence over.
+    AddObstacle(999, 75.0, 0.0, 300.0, 300.0, &radar_obstacles);
+    for (int i = 0; i < 120; ++i) {
+      AddObstacle(1000 + i, x(random), y(random), size(random), size(random),
+                  &radar_obstacles);
+    }
+
+    PerceptionObstacles expected = mobileye_obstacles;
+    for (auto& mobileye_obstacle : *expected.mutable_perception_obstacle()) {
+      for (const auto& radar_obstacle : radar_obstacles.perception_obstacle()) {
+        if (Polygon2d(Points(mobileye_obstacle))
+                .HasOverlap(Polygon2d(Points(radar_obstacle)))) {
+          mobileye_obstacle.set_confidence(0.99);
+          mobileye_obstacle.mutable_velocity()->CopyFrom(
+              radar_obstacle.velocity());
+        }
+      }
+    }
+    EXPECT_EQ(expected.DebugString(),
+              MobileyeRadarFusion(mobileye_obstacles, radar_obstacles)
+                  .DebugString());
+  }
+}
+
+TEST_F(FusionTest, Association) {
+  // Mobileye obstacle 0 overlaps radar obstacles 1000 and 1001, of which
+  // 1000 is the nearest. Mobileye obstacle 1 only overlaps 1000.
+  PerceptionObstacles mobileye_obstacles;
+  AddObstacle(0, 0.0, 0.0, 4.0, 2.0, &mobileye_obstacles);
+  AddObstacle(1, 4.0, 0.0, 4.0, 2.0, &mobileye_obstacles);
+  AddObstacle(2, 50.0, 0.0, 4.0, 2.0, &mobileye_obstacles);
+  PerceptionObstacles radar_obstacles;
+  AddObstacle(1000, 1.6, 0.0, 1.0, 1.0, &radar_obstacles);
+  AddObstacle(1001, -1.7, 0.0, 1.0, 1.0, &radar_obstacles);
+  AddObstacle(1002, 30.0, 0.0, 1.0, 1.0, &radar_obstacles);
+
+  FLAGS_mobileye_radar_association = "all";
+  EXPECT_EQ(std::vector<int>({1001, 1000, -1}),
+            FusedRadarIds(
+                MobileyeRadarFusion(mobileye_obstacles, radar_obstacles)));
+
+  FLAGS_mobileye_radar_association = "greedy";
+  EXPECT_EQ(std::vector<int>({1000, -1, -1}),
+            FusedRadarIds(
+                MobileyeRadarFusion(mobileye_obstacles, radar_obstacles)));
+
+  FLAGS_mobileye_radar_association = "optimal";
+  EXPECT_EQ(std::vector<int>({1001, 1000, -1}),
+            FusedRadarIds(
+                MobileyeRadarFusion(mobileye_obstacles, radar_obstacles)));
+}
+
+}  // namespace fusion
+}  // namespace third_party_perception
+}  // namespace apollo
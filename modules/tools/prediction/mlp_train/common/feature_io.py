@@ -18,6 +18,7 @@
 
 import sys
 import copy
+import gzip
 import logging
 
 from google.protobuf.internal import decoder
@@ -43,18 +44,43 @@ def readVarint32(stream):
     return raw_varint32
 
 
+def open_feature_file(filename):
+    """
+    open a feature file, which may be compressed with gzip
+    """
+    if filename.endswith('.gz'):
+        return gzip.open(filename, 'rb')
+    return open(filename, 'rb')
+
+
+def iterate_protobuf(filename):
+    """
+    read the features of a Features message in protobuf binary one by one,
+    without loading the whole file
+    """
+    with open_feature_file(filename) as f:
+        tag = readVarint32(f)
+        while tag:
+            size = readVarint32(f)
+            if not size:
+                print "Fail to load protobuf"
+                break
+            read_bytes, _ = decoder._DecodeVarint32(size, 0)
+            data = f.read(read_bytes)
+            if len(data) < read_bytes:
+                print "Fail to load protobuf"
+                break
+            fea = feature_pb2.Feature()
+            fea.ParseFromString(data)
+            yield fea
+            tag = readVarint32(f)
+
+
 def load_protobuf(filename):
     """
     read a file in protobuf binary
     """
-    features = []
-    offline_features = offline_features_pb2.Features()
-    with open(filename, 'rb') as file_in:
-        offline_features.ParseFromString(file_in.read())
-    for i in range(len(offline_features.feature)):
-        features.append(offline_features.feature[i])
-
-    return features
+    return list(iterate_protobuf(filename))
 
 
 def load_label_feature(filename):
@@ -33,7 +33,11 @@ def label_file(input_file):
     """
     label each feature file
     """
-    file_name, file_ext = os.path.splitext(input_file)
+    # the labels of a compressed feature file are not compressed
+    if input_file.endswith('.gz'):
+        file_name, file_ext = os.path.splitext(input_file[:-len('.gz')])
+    else:
+        file_name, file_ext = os.path.splitext(input_file)
     output_file = file_name + ".label" + file_ext
 
     # read input file and save them in dict
@@ -69,7 +73,8 @@ if __name__ == "__main__":
     file = args.file
 
     if directory and os.path.isdir(directory):
-        for feature_file in glob.glob(directory + '/*.bin'):
+        for feature_file in glob.glob(directory + '/*.bin') + \
+                glob.glob(directory + '/*.bin.gz'):
             print "Processing feature file: ", feature_file
             label_file(feature_file)
 